@@ -1288,7 +1288,9 @@ class V8_EXPORT ScriptCompiler {
     kProduceParserCache,
     kConsumeParserCache,
     kProduceCodeCache,
-    kConsumeCodeCache
+    kConsumeCodeCache,
+    // Consumes a profile created with CreateCompileProfile.
+    kConsumeCompileProfile
   };
 
   /**
@@ -1382,6 +1384,46 @@ class V8_EXPORT ScriptCompiler {
    */
   static uint32_t CachedDataVersionTag();
 
+  /**
+   * Creates a code cache for a script that may already have run, which
+   * includes the code of all functions compiled so far, not just the top
+   * level. Call this after a warm-up run so that consumers of the cache do
+   * not have to compile the same functions lazily again.
+   *
+   * The script must have been compiled with kProduceCodeCache or
+   * kConsumeCodeCache, otherwise NULL is returned. Inline caches and type
+   * feedback of the script are cleared, since they depend on the context
+   * the script ran in.
+   *
+   * Caches of several runs can be merged by chaining them: a script compiled
+   * with kConsumeCodeCache keeps the code from the cache, so a cache created
+   * after it ran covers the functions of both runs.
+   *
+   * \param unbound_script The script, compiled from source.
+   * \param source The source string the script was compiled from.
+   * \return The cached data, owned by the caller, or NULL.
+   */
+  static CachedData* CreateCodeCache(Local<UnboundScript> unbound_script,
+                                     Local<String> source);
+
+  /**
+   * Creates a profile of the functions of a script that were compiled lazily
+   * shortly after the script itself. Recording is off unless
+   * --lazy-compile-profile-window is set to the length of that period in
+   * milliseconds.
+   * Compiling the same source with kConsumeCompileProfile and the profile
+   * compiles these functions eagerly along with the top-level code, instead
+   * of preparsing them first and parsing them again when they are called.
+   *
+   * The profile only refers to positions in the source, so it remains valid
+   * across versions of V8. It is rejected if the source is different.
+   *
+   * \param unbound_script The script, compiled from source.
+   * \return The profile, owned by the caller, or NULL if no function was
+   *   compiled lazily.
+   */
+  static CachedData* CreateCompileProfile(Local<UnboundScript> unbound_script);
+
   /**
    * Compile an ES6 module.
    *
@@ -4999,6 +5041,7 @@ class V8_EXPORT HeapStatistics {
   size_t total_available_size() { return total_available_size_; }
   size_t used_heap_size() { return used_heap_size_; }
   size_t heap_size_limit() { return heap_size_limit_; }
+  size_t pooled_zone_memory() { return pooled_zone_memory_; }
 
  private:
   size_t total_heap_size_;
@@ -5007,6 +5050,7 @@ class V8_EXPORT HeapStatistics {
   size_t total_available_size_;
   size_t used_heap_size_;
   size_t heap_size_limit_;
+  size_t pooled_zone_memory_;
 
   friend class V8;
   friend class Isolate;
@@ -5033,6 +5077,26 @@ class V8_EXPORT HeapSpaceStatistics {
 };
 
 
+class V8_EXPORT CompilationCacheStatistics {
+ public:
+  CompilationCacheStatistics();
+  const char* cache_name() { return cache_name_; }
+  size_t number_of_entries() { return number_of_entries_; }
+  size_t hits() { return hits_; }
+  size_t misses() { return misses_; }
+  size_t evictions() { return evictions_; }
+
+ private:
+  const char* cache_name_;
+  size_t number_of_entries_;
+  size_t hits_;
+  size_t misses_;
+  size_t evictions_;
+
+  friend class Isolate;
+};
+
+
 class V8_EXPORT HeapObjectStatistics {
  public:
   HeapObjectStatistics();
@@ -5051,6 +5115,28 @@ class V8_EXPORT HeapObjectStatistics {
 };
 
 
+/**
+ * Execution statistics for an interpreter bytecode, collected when V8 runs
+ * with --ignition-profile.
+ */
+class V8_EXPORT BytecodeStatistics {
+ public:
+  BytecodeStatistics();
+  const char* bytecode_name() { return bytecode_name_; }
+  size_t execution_count() { return execution_count_; }
+  // Time spent in the bytecode's handler, excluding calls made from it. The
+  // unit is CPU timestamp counter ticks on x86 and microseconds elsewhere.
+  size_t handler_ticks() { return handler_ticks_; }
+
+ private:
+  const char* bytecode_name_;
+  size_t execution_count_;
+  size_t handler_ticks_;
+
+  friend class Isolate;
+};
+
+
 class RetainedObjectInfo;
 
 
@@ -5192,7 +5278,8 @@ class V8_EXPORT Isolate {
           counter_lookup_callback(NULL),
           create_histogram_callback(NULL),
           add_histogram_sample_callback(NULL),
-          array_buffer_allocator(NULL) {}
+          array_buffer_allocator(NULL),
+          external_references(NULL) {}
 
     /**
      * The optional entry_hook allows the host application to provide the
@@ -5240,6 +5327,16 @@ class V8_EXPORT Isolate {
      * store of ArrayBuffers.
      */
     ArrayBuffer::Allocator* array_buffer_allocator;
+
+    /**
+     * Specifies an optional nullptr-terminated array of raw addresses in the
+     * embedder that V8 can match against during serialization and use for
+     * deserialization. This array and its content must stay valid for the
+     * entire lifetime of the isolate. It must list the same addresses, in the
+     * same order, as the array passed to the SnapshotCreator that created
+     * the snapshot blob.
+     */
+    intptr_t* external_references;
   };
 
 
@@ -5437,6 +5534,24 @@ class V8_EXPORT Isolate {
   bool GetHeapSpaceStatistics(HeapSpaceStatistics* space_statistics,
                               size_t index);
 
+  /**
+   * Returns the number of compilation caches, e.g. for scripts and for eval.
+   */
+  size_t NumberOfCompilationCaches();
+
+  /**
+   * Get the hit rate and size of a compilation cache. The counts accumulate
+   * over the lifetime of the isolate.
+   *
+   * \param cache_statistics The CompilationCacheStatistics object to fill in
+   *   statistics.
+   * \param index The index of the cache to get statistics from, which ranges
+   *   from 0 to NumberOfCompilationCaches() - 1.
+   * \returns true on success.
+   */
+  bool GetCompilationCacheStatistics(
+      CompilationCacheStatistics* cache_statistics, size_t index);
+
   /**
    * Returns the number of types of objects tracked in the heap at GC.
    */
@@ -5454,6 +5569,35 @@ class V8_EXPORT Isolate {
   bool GetHeapObjectStatisticsAtLastGC(HeapObjectStatistics* object_statistics,
                                        size_t type_index);
 
+  /**
+   * Returns the number of bytecodes of the interpreter.
+   */
+  size_t NumberOfBytecodes();
+
+  /**
+   * Get execution statistics about an interpreter bytecode. Statistics are
+   * only collected when V8 runs with --ignition-profile.
+   *
+   * \param bytecode_statistics The BytecodeStatistics object to fill in
+   *   statistics of the given bytecode.
+   * \param bytecode_index The index of the bytecode to fill details about,
+   *   which ranges from 0 to NumberOfBytecodes() - 1.
+   * \returns true on success.
+   */
+  bool GetBytecodeStatistics(BytecodeStatistics* bytecode_statistics,
+                             size_t bytecode_index);
+
+  /**
+   * Returns how often the interpreter went straight from executing the
+   * bytecode at |from_index| to executing the bytecode at |to_index|.
+   */
+  size_t GetBytecodeDispatchCount(size_t from_index, size_t to_index);
+
+  /**
+   * Resets the statistics collected for interpreter bytecodes.
+   */
+  void ResetBytecodeStatistics();
+
   /**
    * Get a call stack sample from the isolate.
    * \param state Execution state.
@@ -6303,6 +6447,64 @@ class V8_EXPORT V8 {
 };
 
 
+/**
+ * Helper class to create a snapshot data blob from a context the embedder set
+ * up, e.g. by running the bootstrap code of a framework. Isolates created
+ * with the blob as CreateParams::snapshot_blob start from a copy of that
+ * context instead of running the bootstrap code again.
+ *
+ * Functions instantiated from templates refer to their callbacks, which must
+ * be listed in the external references. Internal fields of objects created
+ * from templates must be empty or hold JavaScript objects; aligned pointers
+ * and integers cannot be serialized.
+ */
+class V8_EXPORT SnapshotCreator {
+ public:
+  /**
+   * Creates and enters an isolate set up for serialization.
+   * \param external_references a nullptr-terminated array of external
+   *   references. It must be the same as the one passed as
+   *   CreateParams::external_references to isolates that use the blob.
+   */
+  explicit SnapshotCreator(intptr_t* external_references = NULL);
+
+  /**
+   * Exits and disposes the isolate.
+   */
+  ~SnapshotCreator();
+
+  /**
+   * \returns the isolate prepared by the snapshot creator.
+   */
+  Isolate* GetIsolate();
+
+  /**
+   * Sets the context that Context::New returns for isolates created from the
+   * snapshot blob.
+   */
+  void SetDefaultContext(Local<Context> context);
+
+  /**
+   * Creates a snapshot data blob. This must be called once, after the
+   * default context has been set. The isolate cannot be used for anything
+   * else afterwards.
+   * \returns { NULL, 0 } on failure, and a startup snapshot on success. The
+   *   caller owns the data array in the return value. Creating the blob fails
+   *   if no default context has been set, if a callback is missing from the
+   *   external references, or if an internal field holds an aligned pointer
+   *   or an integer. The reason is printed to stderr.
+   */
+  StartupData CreateBlob();
+
+ private:
+  void* data_;
+
+  // Disallow copying and assigning.
+  SnapshotCreator(const SnapshotCreator&);
+  void operator=(const SnapshotCreator&);
+};
+
+
 /**
  * A simple Maybe type, representing an object which may or may not have a
  * value, see https://hackage.haskell.org/package/base/docs/Data-Maybe.html.
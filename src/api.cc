@@ -22,6 +22,7 @@
 #include "src/bootstrapper.h"
 #include "src/char-predicates-inl.h"
 #include "src/code-stubs.h"
+#include "src/compilation-cache.h"
 #include "src/compiler.h"
 #include "src/context-measure.h"
 #include "src/contexts.h"
@@ -35,8 +36,10 @@
 #include "src/heap-profiler.h"
 #include "src/heap-snapshot-generator-inl.h"
 #include "src/icu_util.h"
+#include "src/interpreter/interpreter.h"
 #include "src/isolate-inl.h"
 #include "src/json-parser.h"
+#include "src/lazy-compile-profiler.h"
 #include "src/messages.h"
 #include "src/parser.h"
 #include "src/pending-compilation-error-handler.h"
@@ -358,9 +361,179 @@ class ArrayBufferAllocator : public v8::ArrayBuffer::Allocator {
   virtual void Free(void* data, size_t) { free(data); }
 };
 
+
+// Serializes the isolate and the context into a startup snapshot. The context
+// handle is reset.
+StartupData SerializeIsolateAndContext(Isolate* isolate,
+                                       Persistent<Context>* context,
+                                       i::Snapshot::Metadata metadata) {
+  i::Isolate* internal_isolate = reinterpret_cast<i::Isolate*>(isolate);
+
+  // If we don't do this then we end up with a stray root pointing at the
+  // context even after we have disposed of the context.
+  internal_isolate->heap()->CollectAllAvailableGarbage("mksnapshot");
+
+  // GC may have cleared weak cells, so compact any WeakFixedArrays
+  // found on the heap.
+  i::HeapIterator iterator(internal_isolate->heap(),
+                           i::HeapIterator::kFilterUnreachable);
+  for (i::HeapObject* o = iterator.next(); o != NULL; o = iterator.next()) {
+    if (o->IsPrototypeInfo()) {
+      i::Object* prototype_users =
+          i::PrototypeInfo::cast(o)->prototype_users();
+      if (prototype_users->IsWeakFixedArray()) {
+        i::WeakFixedArray* array = i::WeakFixedArray::cast(prototype_users);
+        array->Compact<i::JSObject::PrototypeRegistryCompactionCallback>();
+      }
+    } else if (o->IsScript()) {
+      i::Object* shared_list = i::Script::cast(o)->shared_function_infos();
+      if (shared_list->IsWeakFixedArray()) {
+        i::WeakFixedArray* array = i::WeakFixedArray::cast(shared_list);
+        array->Compact<i::WeakFixedArray::NullCallback>();
+      }
+    }
+  }
+
+  i::Object* raw_context = *v8::Utils::OpenPersistent(*context);
+  context->Reset();
+
+  i::SnapshotByteSink snapshot_sink;
+  i::StartupSerializer ser(internal_isolate, &snapshot_sink);
+  ser.SerializeStrongReferences();
+
+  i::SnapshotByteSink context_sink;
+  i::PartialSerializer context_ser(internal_isolate, &ser, &context_sink);
+  context_ser.Serialize(&raw_context);
+  ser.SerializeWeakReferencesAndDeferred();
+
+  return i::Snapshot::CreateSnapshotBlob(ser, context_ser, metadata);
+}
+
+
+// Checks that the objects reachable from the roots and from the handles of
+// the isolate do not point into the embedder, except through the external
+// references the isolate was set up with. Prints the reason and returns false
+// if they do.
+bool CheckEmbedderReferences(Isolate* isolate) {
+  i::Isolate* internal_isolate = reinterpret_cast<i::Isolate*>(isolate);
+  i::ExternalReferenceEncoder encoder(internal_isolate);
+  bool result = true;
+  i::HeapIterator iterator(internal_isolate->heap(),
+                           i::HeapIterator::kFilterUnreachable);
+  for (i::HeapObject* o = iterator.next(); o != NULL; o = iterator.next()) {
+    if (o->IsForeign()) {
+      // Callbacks of templates and accessors are stored in Foreign objects.
+      i::Address address = i::Foreign::cast(o)->foreign_address();
+      if (address != NULL && !encoder.Contains(address)) {
+        base::OS::PrintError(
+            "v8::SnapshotCreator::CreateBlob: %p is not listed in the "
+            "external references of the snapshot creator\n",
+            reinterpret_cast<void*>(address));
+        result = false;
+      }
+    } else if (o->IsJSObject()) {
+      i::JSObject* object = i::JSObject::cast(o);
+      i::Object* constructor = object->map()->GetConstructor();
+      if (!constructor->IsJSFunction() ||
+          !i::JSFunction::cast(constructor)->shared()->IsApiFunction()) {
+        continue;
+      }
+      // Aligned pointers set by the embedder look like Smis. There is no way
+      // to restore them in another process, so all non-zero Smis are
+      // rejected.
+      for (int index = 0; index < object->GetInternalFieldCount(); index++) {
+        i::Object* field = object->GetInternalField(index);
+        if (field->IsSmi() && field != i::Smi::FromInt(0)) {
+          base::OS::PrintError(
+              "v8::SnapshotCreator::CreateBlob: internal field %d of an API "
+              "object holds an aligned pointer or a Smi\n",
+              index);
+          result = false;
+        }
+      }
+    }
+  }
+  return result;
+}
+
+
+struct SnapshotCreatorData {
+  explicit SnapshotCreatorData(Isolate* isolate)
+      : isolate_(isolate), created_(false) {}
+
+  static SnapshotCreatorData* cast(void* data) {
+    return reinterpret_cast<SnapshotCreatorData*>(data);
+  }
+
+  ArrayBufferAllocator allocator_;
+  Isolate* isolate_;
+  Persistent<Context> default_context_;
+  bool created_;
+};
+
 }  // namespace
 
 
+SnapshotCreator::SnapshotCreator(intptr_t* external_references) {
+  i::Isolate* internal_isolate = new i::Isolate(true);
+  Isolate* isolate = reinterpret_cast<Isolate*>(internal_isolate);
+  SnapshotCreatorData* data = new SnapshotCreatorData(isolate);
+  internal_isolate->set_array_buffer_allocator(&data->allocator_);
+  internal_isolate->set_api_external_references(external_references);
+  isolate->Enter();
+  internal_isolate->Init(NULL);
+  data_ = data;
+}
+
+
+SnapshotCreator::~SnapshotCreator() {
+  SnapshotCreatorData* data = SnapshotCreatorData::cast(data_);
+  Isolate* isolate = data->isolate_;
+  data->default_context_.Reset();
+  isolate->Exit();
+  isolate->Dispose();
+  delete data;
+}
+
+
+Isolate* SnapshotCreator::GetIsolate() {
+  return SnapshotCreatorData::cast(data_)->isolate_;
+}
+
+
+void SnapshotCreator::SetDefaultContext(Local<Context> context) {
+  DCHECK(!context.IsEmpty());
+  SnapshotCreatorData* data = SnapshotCreatorData::cast(data_);
+  DCHECK(!data->created_);
+  DCHECK_EQ(data->isolate_, context->GetIsolate());
+  data->default_context_.Reset(data->isolate_, context);
+}
+
+
+StartupData SnapshotCreator::CreateBlob() {
+  SnapshotCreatorData* data = SnapshotCreatorData::cast(data_);
+  Utils::ApiCheck(!data->created_, "v8::SnapshotCreator::CreateBlob",
+                  "CreateBlob() cannot be called more than once");
+  data->created_ = true;
+  StartupData result = {NULL, 0};
+  if (data->default_context_.IsEmpty()) return result;
+  if (!CheckEmbedderReferences(data->isolate_)) return result;
+  base::ElapsedTimer timer;
+  timer.Start();
+  // The context may have run arbitrary embedder code, so there is no fallback
+  // to bootstrapping if the snapshot cannot be used.
+  i::Snapshot::Metadata metadata;
+  metadata.set_embeds_script(true);
+  result = SerializeIsolateAndContext(data->isolate_, &data->default_context_,
+                                      metadata);
+  if (i::FLAG_profile_deserialization) {
+    i::PrintF("Creating snapshot took %0.3f ms\n",
+              timer.Elapsed().InMillisecondsF());
+  }
+  return result;
+}
+
+
 StartupData V8::CreateSnapshotDataBlob(const char* custom_source) {
   i::Isolate* internal_isolate = new i::Isolate(true);
   ArrayBufferAllocator allocator;
@@ -385,44 +558,7 @@ StartupData V8::CreateSnapshotDataBlob(const char* custom_source) {
       }
     }
     if (!context.IsEmpty()) {
-      // If we don't do this then we end up with a stray root pointing at the
-      // context even after we have disposed of the context.
-      internal_isolate->heap()->CollectAllAvailableGarbage("mksnapshot");
-
-      // GC may have cleared weak cells, so compact any WeakFixedArrays
-      // found on the heap.
-      i::HeapIterator iterator(internal_isolate->heap(),
-                               i::HeapIterator::kFilterUnreachable);
-      for (i::HeapObject* o = iterator.next(); o != NULL; o = iterator.next()) {
-        if (o->IsPrototypeInfo()) {
-          i::Object* prototype_users =
-              i::PrototypeInfo::cast(o)->prototype_users();
-          if (prototype_users->IsWeakFixedArray()) {
-            i::WeakFixedArray* array = i::WeakFixedArray::cast(prototype_users);
-            array->Compact<i::JSObject::PrototypeRegistryCompactionCallback>();
-          }
-        } else if (o->IsScript()) {
-          i::Object* shared_list = i::Script::cast(o)->shared_function_infos();
-          if (shared_list->IsWeakFixedArray()) {
-            i::WeakFixedArray* array = i::WeakFixedArray::cast(shared_list);
-            array->Compact<i::WeakFixedArray::NullCallback>();
-          }
-        }
-      }
-
-      i::Object* raw_context = *v8::Utils::OpenPersistent(context);
-      context.Reset();
-
-      i::SnapshotByteSink snapshot_sink;
-      i::StartupSerializer ser(internal_isolate, &snapshot_sink);
-      ser.SerializeStrongReferences();
-
-      i::SnapshotByteSink context_sink;
-      i::PartialSerializer context_ser(internal_isolate, &ser, &context_sink);
-      context_ser.Serialize(&raw_context);
-      ser.SerializeWeakReferencesAndDeferred();
-
-      result = i::Snapshot::CreateSnapshotBlob(ser, context_ser, metadata);
+      result = SerializeIsolateAndContext(isolate, &context, metadata);
     }
     if (i::FLAG_profile_deserialization) {
       i::PrintF("Creating snapshot took %0.3f ms\n",
@@ -1717,7 +1853,8 @@ MaybeLocal<UnboundScript> ScriptCompiler::CompileUnboundInternal(
   }
 
   i::ScriptData* script_data = NULL;
-  if (options == kConsumeParserCache || options == kConsumeCodeCache) {
+  if (options == kConsumeParserCache || options == kConsumeCodeCache ||
+      options == kConsumeCompileProfile) {
     DCHECK(source->cached_data);
     // ScriptData takes care of pointer-aligning the data.
     script_data = new i::ScriptData(source->cached_data->data,
@@ -1766,7 +1903,8 @@ MaybeLocal<UnboundScript> ScriptCompiler::CompileUnboundInternal(
       source->cached_data = new CachedData(
           script_data->data(), script_data->length(), CachedData::BufferOwned);
       script_data->ReleaseDataOwnership();
-    } else if (options == kConsumeParserCache || options == kConsumeCodeCache) {
+    } else if (options == kConsumeParserCache || options == kConsumeCodeCache ||
+               options == kConsumeCompileProfile) {
       source->cached_data->rejected = script_data->rejected();
     }
     delete script_data;
@@ -2043,6 +2181,47 @@ uint32_t ScriptCompiler::CachedDataVersionTag() {
 }
 
 
+ScriptCompiler::CachedData* ScriptCompiler::CreateCodeCache(
+    Local<UnboundScript> unbound_script, Local<String> source) {
+  i::Handle<i::SharedFunctionInfo> shared =
+      i::Handle<i::SharedFunctionInfo>::cast(
+          Utils::OpenHandle(*unbound_script));
+  i::Isolate* isolate = shared->GetIsolate();
+  // Don't produce any kind of cache when the debugger is loaded.
+  if (isolate->debug()->is_loaded()) return NULL;
+  ENTER_V8(isolate);
+  i::HandleScope scope(isolate);
+  i::ScriptData* script_data =
+      i::Compiler::CreateCodeCache(shared, Utils::OpenHandle(*source));
+  if (script_data == NULL) return NULL;
+  CachedData* result = new CachedData(
+      script_data->data(), script_data->length(), CachedData::BufferOwned);
+  script_data->ReleaseDataOwnership();
+  delete script_data;
+  return result;
+}
+
+
+ScriptCompiler::CachedData* ScriptCompiler::CreateCompileProfile(
+    Local<UnboundScript> unbound_script) {
+  i::Handle<i::SharedFunctionInfo> shared =
+      i::Handle<i::SharedFunctionInfo>::cast(
+          Utils::OpenHandle(*unbound_script));
+  i::Isolate* isolate = shared->GetIsolate();
+  if (!shared->script()->IsScript()) return NULL;
+  ENTER_V8(isolate);
+  i::HandleScope scope(isolate);
+  i::Handle<i::Script> script(i::Script::cast(shared->script()), isolate);
+  i::ScriptData* script_data = isolate->lazy_compile_profiler()->Export(script);
+  if (script_data == NULL) return NULL;
+  CachedData* result = new CachedData(
+      script_data->data(), script_data->length(), CachedData::BufferOwned);
+  script_data->ReleaseDataOwnership();
+  delete script_data;
+  return result;
+}
+
+
 MaybeLocal<Script> Script::Compile(Local<Context> context, Local<String> source,
                                    ScriptOrigin* origin) {
   if (origin) {
@@ -5345,7 +5524,8 @@ HeapStatistics::HeapStatistics(): total_heap_size_(0),
                                   total_heap_size_executable_(0),
                                   total_physical_size_(0),
                                   used_heap_size_(0),
-                                  heap_size_limit_(0) { }
+                                  heap_size_limit_(0),
+                                  pooled_zone_memory_(0) { }
 
 
 HeapSpaceStatistics::HeapSpaceStatistics(): space_name_(0),
@@ -5355,6 +5535,14 @@ HeapSpaceStatistics::HeapSpaceStatistics(): space_name_(0),
                                             physical_space_size_(0) { }
 
 
+CompilationCacheStatistics::CompilationCacheStatistics()
+    : cache_name_(nullptr),
+      number_of_entries_(0),
+      hits_(0),
+      misses_(0),
+      evictions_(0) {}
+
+
 HeapObjectStatistics::HeapObjectStatistics()
     : object_type_(nullptr),
       object_sub_type_(nullptr),
@@ -5362,6 +5550,10 @@ HeapObjectStatistics::HeapObjectStatistics()
       object_size_(0) {}
 
 
+BytecodeStatistics::BytecodeStatistics()
+    : bytecode_name_(nullptr), execution_count_(0), handler_ticks_(0) {}
+
+
 bool v8::V8::InitializeICU(const char* icu_data_file) {
   return i::InitializeICU(icu_data_file);
 }
@@ -7088,6 +7280,7 @@ Isolate* Isolate::New(const Isolate::CreateParams& params) {
   } else {
     isolate->set_snapshot_blob(i::Snapshot::DefaultSnapshotBlob());
   }
+  isolate->set_api_external_references(params.external_references);
   if (params.entry_hook) {
     isolate->set_function_entry_hook(params.entry_hook);
   }
@@ -7212,6 +7405,7 @@ void Isolate::GetHeapStatistics(HeapStatistics* heap_statistics) {
   heap_statistics->total_available_size_ = heap->Available();
   heap_statistics->used_heap_size_ = heap->SizeOfObjects();
   heap_statistics->heap_size_limit_ = heap->MaxReserved();
+  heap_statistics->pooled_zone_memory_ = i::ZoneSegmentPool::pooled_bytes();
 }
 
 
@@ -7239,6 +7433,31 @@ bool Isolate::GetHeapSpaceStatistics(HeapSpaceStatistics* space_statistics,
 }
 
 
+size_t Isolate::NumberOfCompilationCaches() {
+  return i::CompilationCache::kSubCacheCount;
+}
+
+
+bool Isolate::GetCompilationCacheStatistics(
+    CompilationCacheStatistics* cache_statistics, size_t index) {
+  if (!cache_statistics) return false;
+  if (index >= NumberOfCompilationCaches()) return false;
+
+  i::Isolate* isolate = reinterpret_cast<i::Isolate*>(this);
+  int subcache_index = static_cast<int>(index);
+  i::CompilationSubCache* subcache =
+      isolate->compilation_cache()->subcache(subcache_index);
+
+  cache_statistics->cache_name_ =
+      i::CompilationCache::SubCacheName(subcache_index);
+  cache_statistics->number_of_entries_ = subcache->NumberOfEntries();
+  cache_statistics->hits_ = subcache->hits();
+  cache_statistics->misses_ = subcache->misses();
+  cache_statistics->evictions_ = subcache->evictions();
+  return true;
+}
+
+
 size_t Isolate::NumberOfTrackedHeapObjectTypes() {
   i::Isolate* isolate = reinterpret_cast<i::Isolate*>(this);
   i::Heap* heap = isolate->heap();
@@ -7274,6 +7493,49 @@ bool Isolate::GetHeapObjectStatisticsAtLastGC(
 }
 
 
+size_t Isolate::NumberOfBytecodes() {
+  return i::interpreter::Interpreter::kNumberOfBytecodes;
+}
+
+
+bool Isolate::GetBytecodeStatistics(BytecodeStatistics* bytecode_statistics,
+                                    size_t bytecode_index) {
+  if (!bytecode_statistics) return false;
+  if (!i::FLAG_ignition_profile) return false;
+  if (bytecode_index >= NumberOfBytecodes()) return false;
+
+  i::Isolate* isolate = reinterpret_cast<i::Isolate*>(this);
+  i::interpreter::Interpreter* interpreter = isolate->interpreter();
+  i::interpreter::Bytecode bytecode = i::interpreter::Bytecodes::FromByte(
+      static_cast<uint8_t>(bytecode_index));
+  bytecode_statistics->bytecode_name_ =
+      i::interpreter::Bytecodes::ToString(bytecode);
+  bytecode_statistics->execution_count_ =
+      static_cast<size_t>(interpreter->execution_count(bytecode));
+  bytecode_statistics->handler_ticks_ =
+      static_cast<size_t>(interpreter->handler_ticks(bytecode));
+  return true;
+}
+
+
+size_t Isolate::GetBytecodeDispatchCount(size_t from_index, size_t to_index) {
+  if (!i::FLAG_ignition_profile) return 0;
+  if (from_index >= NumberOfBytecodes() || to_index >= NumberOfBytecodes()) {
+    return 0;
+  }
+  i::Isolate* isolate = reinterpret_cast<i::Isolate*>(this);
+  return static_cast<size_t>(isolate->interpreter()->dispatch_count(
+      i::interpreter::Bytecodes::FromByte(static_cast<uint8_t>(from_index)),
+      i::interpreter::Bytecodes::FromByte(static_cast<uint8_t>(to_index))));
+}
+
+
+void Isolate::ResetBytecodeStatistics() {
+  i::Isolate* isolate = reinterpret_cast<i::Isolate*>(this);
+  isolate->interpreter()->ResetProfile();
+}
+
+
 void Isolate::GetStackSample(const RegisterState& state, void** frames,
                              size_t frames_limit, SampleInfo* sample_info) {
   i::Isolate* isolate = reinterpret_cast<i::Isolate*>(this);
@@ -7397,6 +7659,7 @@ void Isolate::LowMemoryNotification() {
         isolate->counters()->gc_low_memory_notification());
     isolate->heap()->CollectAllAvailableGarbage("low memory notification");
   }
+  i::ZoneSegmentPool::Trim();
 }
 
 
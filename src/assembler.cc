@@ -50,6 +50,7 @@
 #include "src/execution.h"
 #include "src/ic/ic.h"
 #include "src/ic/stub-cache.h"
+#include "src/interpreter/interpreter.h"
 #include "src/regexp/jsregexp.h"
 #include "src/regexp/regexp-macro-assembler.h"
 #include "src/regexp/regexp-stack.h"
@@ -1114,6 +1115,21 @@ ExternalReference ExternalReference::log_leave_external_function(
 }
 
 
+ExternalReference ExternalReference::interpreter_profile_handler_entry_function(
+    Isolate* isolate) {
+  return ExternalReference(Redirect(
+      isolate,
+      FUNCTION_ADDR(interpreter::Interpreter::ProfileHandlerEntry)));
+}
+
+
+ExternalReference ExternalReference::interpreter_profile_handler_exit_function(
+    Isolate* isolate) {
+  return ExternalReference(Redirect(
+      isolate, FUNCTION_ADDR(interpreter::Interpreter::ProfileHandlerExit)));
+}
+
+
 ExternalReference ExternalReference::keyed_lookup_cache_keys(Isolate* isolate) {
   return ExternalReference(isolate->keyed_lookup_cache()->keys_address());
 }
@@ -912,6 +912,12 @@ class ExternalReference BASE_EMBEDDED {
   static ExternalReference log_enter_external_function(Isolate* isolate);
   static ExternalReference log_leave_external_function(Isolate* isolate);
 
+  // Interpreter profiling support.
+  static ExternalReference interpreter_profile_handler_entry_function(
+      Isolate* isolate);
+  static ExternalReference interpreter_profile_handler_exit_function(
+      Isolate* isolate);
+
   // Static data in the keyed lookup cache.
   static ExternalReference keyed_lookup_cache_keys(Isolate* isolate);
   static ExternalReference keyed_lookup_cache_field_offsets(Isolate* isolate);
@@ -2150,6 +2150,22 @@ class BinaryOperation final : public Expression {
 
   virtual void RecordToBooleanTypeFeedback(TypeFeedbackOracle* oracle) override;
 
+  // Type feedback information. Only the interpreter records operand feedback
+  // in the vector; full-codegen keeps using the BinaryOpIC.
+  FeedbackVectorRequirements ComputeFeedbackRequirements(
+      Isolate* isolate, const ICSlotCache* cache) override {
+    return FeedbackVectorRequirements(FLAG_ignition ? 1 : 0, 0);
+  }
+  void SetFirstFeedbackSlot(FeedbackVectorSlot slot) override {
+    DCHECK(FLAG_ignition);
+    feedback_slot_ = slot;
+  }
+
+  FeedbackVectorSlot BinaryOperationFeedbackSlot() const {
+    DCHECK(!feedback_slot_.IsInvalid());
+    return feedback_slot_;
+  }
+
  protected:
   BinaryOperation(Zone* zone, Token::Value op, Expression* left,
                   Expression* right, int pos)
@@ -2158,7 +2174,8 @@ class BinaryOperation final : public Expression {
         has_fixed_right_arg_(false),
         fixed_right_arg_value_(0),
         left_(left),
-        right_(right) {
+        right_(right),
+        feedback_slot_(FeedbackVectorSlot::Invalid()) {
     DCHECK(Token::IsBinaryOp(op));
   }
   static int parent_num_ids() { return Expression::num_ids(); }
@@ -2174,6 +2191,7 @@ class BinaryOperation final : public Expression {
   Expression* left_;
   Expression* right_;
   Handle<AllocationSite> allocation_site_;
+  FeedbackVectorSlot feedback_slot_;
 };
 
 
@@ -2617,6 +2635,16 @@ class FunctionLiteral final : public Expression {
     bitfield_ = ShouldBeUsedOnceHintBit::update(bitfield_, kShouldBeUsedOnce);
   }
 
+  // A hint that this function is expected to be called soon and should be
+  // parsed on a background thread once the script is compiled, see
+  // LazyCompileQueue.
+  bool should_parse_in_background() const {
+    return ParseInBackgroundBit::decode(bitfield_);
+  }
+  void set_should_parse_in_background() {
+    bitfield_ = ParseInBackgroundBit::update(bitfield_, true);
+  }
+
   FunctionKind kind() const { return FunctionKindBits::decode(bitfield_); }
 
   int ast_node_count() { return ast_properties_.node_count(); }
@@ -2661,7 +2689,8 @@ class FunctionLiteral final : public Expression {
                 IsFunction::encode(is_function) |
                 EagerCompileHintBit::encode(eager_compile_hint) |
                 FunctionKindBits::encode(kind) |
-                ShouldBeUsedOnceHintBit::encode(kDontKnowIfShouldBeUsedOnce);
+                ShouldBeUsedOnceHintBit::encode(kDontKnowIfShouldBeUsedOnce) |
+                ParseInBackgroundBit::encode(false);
     DCHECK(IsValidFunctionKind(kind));
   }
 
@@ -2690,6 +2719,7 @@ class FunctionLiteral final : public Expression {
   class FunctionKindBits : public BitField<FunctionKind, 6, 8> {};
   class ShouldBeUsedOnceHintBit : public BitField<ShouldBeUsedOnceHint, 15, 1> {
   };
+  class ParseInBackgroundBit : public BitField<bool, 16, 1> {};
 };
 
 
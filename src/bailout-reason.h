@@ -268,6 +268,7 @@ namespace internal {
   V(kUnsupportedCountOperationWithConst,                                       \
     "Unsupported count operation with const")                                  \
   V(kUnsupportedDoubleImmediate, "Unsupported double immediate")               \
+  V(kUnsupportedFunctionContext, "Unsupported function context")               \
   V(kUnsupportedLetCompoundAssignment, "Unsupported let compound assignment")  \
   V(kUnsupportedLookupSlotInDeclaration,                                       \
     "Unsupported lookup slot in declaration")                                  \
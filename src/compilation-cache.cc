@@ -5,17 +5,17 @@
 #include "src/compilation-cache.h"
 
 #include "src/assembler.h"
+#include "src/base/lazy-instance.h"
+#include "src/base/platform/mutex.h"
 #include "src/counters.h"
 #include "src/factory.h"
 #include "src/objects-inl.h"
+#include "src/preparse-data.h"
 
 namespace v8 {
 namespace internal {
 
 
-// The number of generations for each sub cache.
-static const int kRegExpGenerations = 2;
-
 // Initial size of each compilation cache table allocated.
 static const int kInitialCacheSize = 64;
 
@@ -25,7 +25,7 @@ CompilationCache::CompilationCache(Isolate* isolate)
       script_(isolate, 1),
       eval_global_(isolate, 1),
       eval_contextual_(isolate, 1),
-      reg_exp_(isolate, kRegExpGenerations),
+      reg_exp_(isolate, 1),
       enabled_(true) {
   CompilationSubCache* subcaches[kSubCacheCount] =
     {&script_, &eval_global_, &eval_contextual_, &reg_exp_};
@@ -53,22 +53,58 @@ Handle<CompilationCacheTable> CompilationSubCache::GetTable(int generation) {
 }
 
 
-void CompilationSubCache::Age() {
+int CompilationSubCache::Age() {
+  Object* undefined = isolate()->heap()->undefined_value();
+  int evicted = 0;
   // Don't directly age single-generation caches.
   if (generations_ == 1) {
-    if (tables_[0] != isolate()->heap()->undefined_value()) {
-      CompilationCacheTable::cast(tables_[0])->Age();
+    if (tables_[0] != undefined) {
+      evicted = CompilationCacheTable::cast(tables_[0])->Age();
     }
-    return;
+  } else {
+    if (tables_[generations_ - 1] != undefined) {
+      evicted = CompilationCacheTable::cast(tables_[generations_ - 1])
+                    ->NumberOfElements();
+    }
+
+    // Age the generations implicitly killing off the oldest.
+    for (int i = generations_ - 1; i > 0; i--) {
+      tables_[i] = tables_[i - 1];
+    }
+
+    // Set the first generation as unborn.
+    tables_[0] = undefined;
   }
+  evictions_ += evicted;
+  return evicted;
+}
 
-  // Age the generations implicitly killing off the oldest.
-  for (int i = generations_ - 1; i > 0; i--) {
-    tables_[i] = tables_[i - 1];
+
+int CompilationSubCache::NumberOfEntries() {
+  Object* undefined = isolate()->heap()->undefined_value();
+  int entries = 0;
+  for (int i = 0; i < generations_; i++) {
+    if (tables_[i] == undefined) continue;
+    CompilationCacheTable* table = CompilationCacheTable::cast(tables_[i]);
+    for (int entry = 0; entry < table->Capacity(); entry++) {
+      if (table->KeyAt(entry)->IsFixedArray()) entries++;
+    }
   }
+  return entries;
+}
+
+
+void CompilationSubCache::RecordHit(StatsCounter* counter) {
+  hits_++;
+  counter->Increment();
+  isolate()->counters()->compilation_cache_hits()->Increment();
+}
+
 
-  // Set the first generation as unborn.
-  tables_[0] = isolate()->heap()->undefined_value();
+void CompilationSubCache::RecordMiss(StatsCounter* counter) {
+  misses_++;
+  counter->Increment();
+  isolate()->counters()->compilation_cache_misses()->Increment();
 }
 
 
@@ -179,10 +215,10 @@ Handle<SharedFunctionInfo> CompilationCacheScript::Lookup(
     // If the script was found in a later generation, we promote it to
     // the first generation to let it survive longer in the cache.
     if (generation != 0) Put(source, context, language_mode, shared);
-    isolate()->counters()->compilation_cache_hits()->Increment();
+    RecordHit(isolate()->counters()->compilation_cache_script_hits());
     return shared;
   } else {
-    isolate()->counters()->compilation_cache_misses()->Increment();
+    RecordMiss(isolate()->counters()->compilation_cache_script_misses());
     return Handle<SharedFunctionInfo>::null();
   }
 }
@@ -220,10 +256,10 @@ MaybeHandle<SharedFunctionInfo> CompilationCacheEval::Lookup(
     if (generation != 0) {
       Put(source, outer_info, function_info, scope_position);
     }
-    isolate()->counters()->compilation_cache_hits()->Increment();
+    RecordHit(isolate()->counters()->compilation_cache_eval_hits());
     return scope.CloseAndEscape(function_info);
   } else {
-    isolate()->counters()->compilation_cache_misses()->Increment();
+    RecordMiss(isolate()->counters()->compilation_cache_eval_misses());
     return MaybeHandle<SharedFunctionInfo>();
   }
 }
@@ -260,10 +296,10 @@ MaybeHandle<FixedArray> CompilationCacheRegExp::Lookup(
     if (generation != 0) {
       Put(source, flags, data);
     }
-    isolate()->counters()->compilation_cache_hits()->Increment();
+    RecordHit(isolate()->counters()->compilation_cache_regexp_hits());
     return scope.CloseAndEscape(data);
   } else {
-    isolate()->counters()->compilation_cache_misses()->Increment();
+    RecordMiss(isolate()->counters()->compilation_cache_regexp_misses());
     return MaybeHandle<FixedArray>();
   }
 }
@@ -385,9 +421,20 @@ void CompilationCache::IterateFunctions(ObjectVisitor* v) {
 
 
 void CompilationCache::MarkCompactPrologue() {
-  for (int i = 0; i < kSubCacheCount; i++) {
-    subcaches_[i]->Age();
-  }
+  Counters* counters = isolate()->counters();
+  counters->compilation_cache_script_evictions()->Increment(script_.Age());
+  counters->compilation_cache_eval_evictions()->Increment(
+      eval_global_.Age() + eval_contextual_.Age());
+  counters->compilation_cache_regexp_evictions()->Increment(reg_exp_.Age());
+}
+
+
+// static
+const char* CompilationCache::SubCacheName(int index) {
+  static const char* const kNames[kSubCacheCount] = {
+      "script", "eval_global", "eval_contextual", "regexp"};
+  DCHECK(index >= 0 && index < kSubCacheCount);
+  return kNames[index];
 }
 
 
@@ -402,5 +449,292 @@ void CompilationCache::Disable() {
 }
 
 
+namespace {
+
+// The characters of a string copied out of the heap, in their original width.
+class OffHeapString {
+ public:
+  OffHeapString() : bytes_(NULL), length_(0), is_one_byte_(true) {}
+  ~OffHeapString() { DeleteArray(bytes_); }
+
+  void CopyFrom(String::FlatContent content) {
+    Vector<const byte> bytes = ToBytes(content);
+    bytes_ = NewArray<byte>(bytes.length());
+    CopyBytes(bytes_, bytes.start(), bytes.length());
+    length_ = bytes.length();
+    is_one_byte_ = content.IsOneByte();
+  }
+
+  bool Equals(String::FlatContent content) const {
+    if (content.IsOneByte() != is_one_byte_) return false;
+    Vector<const byte> bytes = ToBytes(content);
+    return bytes.length() == length_ &&
+           memcmp(bytes.start(), bytes_, length_) == 0;
+  }
+
+  size_t size() const { return length_; }
+
+ private:
+  static Vector<const byte> ToBytes(String::FlatContent content) {
+    DCHECK(content.IsFlat());
+    if (content.IsOneByte()) return content.ToOneByteVector();
+    return Vector<const byte>::cast(content.ToUC16Vector());
+  }
+
+  byte* bytes_;
+  int length_;
+  bool is_one_byte_;
+
+  DISALLOW_COPY_AND_ASSIGN(OffHeapString);
+};
+
+
+// Identifies a script by its source and origin. Only valid while no heap
+// allocation happens.
+class SharedCodeCacheKey {
+ public:
+  SharedCodeCacheKey(String* source, Object* name, int line_offset,
+                     int column_offset, ScriptOriginOptions resource_options)
+      : source_(source->GetFlatContent()),
+        name_(name->IsString() ? String::cast(name)->GetFlatContent()
+                               : source->GetHeap()->empty_string()
+                                     ->GetFlatContent()),
+        has_name_(name->IsString()),
+        line_offset_(line_offset),
+        column_offset_(column_offset),
+        origin_flags_(resource_options.Flags()) {
+    uint32_t hash = 2166136261u;
+    hash = Hash(hash, source_);
+    hash = Hash(hash, name_);
+    hash_ = static_cast<uint32_t>(base::hash_combine(
+        hash, has_name_, line_offset_, column_offset_, origin_flags_));
+  }
+
+  String::FlatContent source() const { return source_; }
+  String::FlatContent name() const { return name_; }
+  bool has_name() const { return has_name_; }
+  int line_offset() const { return line_offset_; }
+  int column_offset() const { return column_offset_; }
+  int origin_flags() const { return origin_flags_; }
+  uint32_t hash() const { return hash_; }
+
+ private:
+  template <typename Char>
+  static uint32_t Hash(uint32_t hash, Vector<const Char> chars) {
+    // FNV-1a. String::Hash() cannot be used, it only takes the length of
+    // long strings into account.
+    for (int i = 0; i < chars.length(); i++) {
+      hash = (hash ^ chars[i]) * 16777619u;
+    }
+    return hash;
+  }
+
+  static uint32_t Hash(uint32_t hash, String::FlatContent content) {
+    if (content.IsOneByte()) return Hash(hash, content.ToOneByteVector());
+    return Hash(hash, content.ToUC16Vector());
+  }
+
+  String::FlatContent source_;
+  String::FlatContent name_;
+  bool has_name_;
+  int line_offset_;
+  int column_offset_;
+  int origin_flags_;
+  uint32_t hash_;
+};
+
+
+class SharedCodeCacheEntry : public Malloced {
+ public:
+  explicit SharedCodeCacheEntry(const SharedCodeCacheKey& key)
+      : hash_(key.hash()),
+        has_name_(key.has_name()),
+        line_offset_(key.line_offset()),
+        column_offset_(key.column_offset()),
+        origin_flags_(key.origin_flags()),
+        data_(NULL),
+        data_length_(0),
+        newer_(NULL),
+        older_(NULL) {
+    source_.CopyFrom(key.source());
+    name_.CopyFrom(key.name());
+  }
+
+  ~SharedCodeCacheEntry() { DeleteArray(data_); }
+
+  bool Matches(const SharedCodeCacheKey& key) const {
+    return hash_ == key.hash() && has_name_ == key.has_name() &&
+           line_offset_ == key.line_offset() &&
+           column_offset_ == key.column_offset() &&
+           origin_flags_ == key.origin_flags() &&
+           source_.Equals(key.source()) && name_.Equals(key.name());
+  }
+
+  void SetData(const ScriptData* data) {
+    DeleteArray(data_);
+    data_ = NewArray<byte>(data->length());
+    CopyBytes(data_, data->data(), data->length());
+    data_length_ = data->length();
+  }
+
+  ScriptData* CopyData() const {
+    byte* copy = NewArray<byte>(data_length_);
+    CopyBytes(copy, data_, data_length_);
+    ScriptData* result = new ScriptData(copy, data_length_);
+    result->AcquireDataOwnership();
+    return result;
+  }
+
+  size_t size() const {
+    return sizeof(*this) + source_.size() + name_.size() + data_length_;
+  }
+
+  SharedCodeCacheEntry* newer() const { return newer_; }
+  void set_newer(SharedCodeCacheEntry* entry) { newer_ = entry; }
+  SharedCodeCacheEntry* older() const { return older_; }
+  void set_older(SharedCodeCacheEntry* entry) { older_ = entry; }
+
+ private:
+  uint32_t hash_;
+  bool has_name_;
+  int line_offset_;
+  int column_offset_;
+  int origin_flags_;
+  OffHeapString source_;
+  OffHeapString name_;
+  byte* data_;
+  int data_length_;
+  SharedCodeCacheEntry* newer_;
+  SharedCodeCacheEntry* older_;
+
+  DISALLOW_COPY_AND_ASSIGN(SharedCodeCacheEntry);
+};
+
+
+// The entries form a list from the most to the least recently used one.
+struct SharedCodeCacheState {
+  SharedCodeCacheState() : newest(NULL), oldest(NULL), size(0) {}
+
+  SharedCodeCacheEntry* Find(const SharedCodeCacheKey& key) {
+    for (SharedCodeCacheEntry* entry = newest; entry != NULL;
+         entry = entry->older()) {
+      if (entry->Matches(key)) return entry;
+    }
+    return NULL;
+  }
+
+  void Link(SharedCodeCacheEntry* entry) {
+    entry->set_newer(NULL);
+    entry->set_older(newest);
+    if (newest != NULL) newest->set_newer(entry);
+    newest = entry;
+    if (oldest == NULL) oldest = entry;
+  }
+
+  void Unlink(SharedCodeCacheEntry* entry) {
+    if (entry->newer() != NULL) {
+      entry->newer()->set_older(entry->older());
+    } else {
+      newest = entry->older();
+    }
+    if (entry->older() != NULL) {
+      entry->older()->set_newer(entry->newer());
+    } else {
+      oldest = entry->newer();
+    }
+  }
+
+  void Delete(SharedCodeCacheEntry* entry) {
+    Unlink(entry);
+    size -= entry->size();
+    delete entry;
+  }
+
+  base::Mutex mutex;
+  SharedCodeCacheEntry* newest;
+  SharedCodeCacheEntry* oldest;
+  size_t size;
+};
+
+
+base::LazyInstance<SharedCodeCacheState>::type shared_code_cache =
+    LAZY_INSTANCE_INITIALIZER;
+
+}  // namespace
+
+
+// static
+ScriptData* SharedCodeCache::Lookup(Handle<String> source, Handle<Object> name,
+                                    int line_offset, int column_offset,
+                                    ScriptOriginOptions resource_options) {
+  source = String::Flatten(source);
+  if (name.is_null()) {
+    name = source->GetIsolate()->factory()->undefined_value();
+  } else if (name->IsString()) {
+    name = String::Flatten(Handle<String>::cast(name));
+  }
+  DisallowHeapAllocation no_gc;
+  SharedCodeCacheKey key(*source, *name, line_offset, column_offset,
+                         resource_options);
+  SharedCodeCacheState* state = shared_code_cache.Pointer();
+  base::LockGuard<base::Mutex> lock_guard(&state->mutex);
+  SharedCodeCacheEntry* entry = state->Find(key);
+  if (entry == NULL) return NULL;
+  state->Unlink(entry);
+  state->Link(entry);
+  return entry->CopyData();
+}
+
+
+// static
+void SharedCodeCache::Put(Handle<String> source, Handle<Object> name,
+                          int line_offset, int column_offset,
+                          ScriptOriginOptions resource_options,
+                          ScriptData* data) {
+  size_t budget = static_cast<size_t>(FLAG_shared_code_cache_size) * MB;
+  source = String::Flatten(source);
+  if (name.is_null()) {
+    name = source->GetIsolate()->factory()->undefined_value();
+  } else if (name->IsString()) {
+    name = String::Flatten(Handle<String>::cast(name));
+  }
+  DisallowHeapAllocation no_gc;
+  SharedCodeCacheKey key(*source, *name, line_offset, column_offset,
+                         resource_options);
+  SharedCodeCacheState* state = shared_code_cache.Pointer();
+  base::LockGuard<base::Mutex> lock_guard(&state->mutex);
+  SharedCodeCacheEntry* entry = state->Find(key);
+  if (entry != NULL) {
+    // Another isolate compiled the same script in the meantime, or the data
+    // was rejected.
+    state->Delete(entry);
+  }
+  entry = new SharedCodeCacheEntry(key);
+  entry->SetData(data);
+  state->Link(entry);
+  state->size += entry->size();
+  // Evict the least recently used entries, including the new one if it does
+  // not fit on its own.
+  while (state->size > budget) state->Delete(state->oldest);
+}
+
+
+// static
+void SharedCodeCache::Clear() {
+  SharedCodeCacheState* state = shared_code_cache.Pointer();
+  base::LockGuard<base::Mutex> lock_guard(&state->mutex);
+  while (state->oldest != NULL) state->Delete(state->oldest);
+  DCHECK_EQ(0u, state->size);
+}
+
+
+// static
+size_t SharedCodeCache::size() {
+  SharedCodeCacheState* state = shared_code_cache.Pointer();
+  base::LockGuard<base::Mutex> lock_guard(&state->mutex);
+  return state->size;
+}
+
+
 }  // namespace internal
 }  // namespace v8
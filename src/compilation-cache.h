@@ -12,6 +12,9 @@
 namespace v8 {
 namespace internal {
 
+class ScriptData;
+class StatsCounter;
+
 // The compilation cache consists of several generational sub-caches which uses
 // this class as a base class. A sub-cache contains a compilation cache tables
 // for each generation of the sub-cache. Since the same source code string has
@@ -21,7 +24,10 @@ class CompilationSubCache {
  public:
   CompilationSubCache(Isolate* isolate, int generations)
       : isolate_(isolate),
-        generations_(generations) {
+        generations_(generations),
+        hits_(0),
+        misses_(0),
+        evictions_(0) {
     tables_ = NewArray<Object*>(generations);
   }
 
@@ -43,8 +49,8 @@ class CompilationSubCache {
   }
 
   // Age the sub-cache by evicting the oldest generation and creating a new
-  // young generation.
-  void Age();
+  // young generation. Returns the number of evicted entries.
+  int Age();
 
   // GC support.
   void Iterate(ObjectVisitor* v);
@@ -59,13 +65,28 @@ class CompilationSubCache {
   // Number of generations in this sub-cache.
   inline int generations() { return generations_; }
 
+  // Number of entries in all generations, not counting hashes of sources
+  // that have been compiled only once.
+  int NumberOfEntries();
+
+  // Statistics since the isolate was created.
+  size_t hits() const { return hits_; }
+  size_t misses() const { return misses_; }
+  size_t evictions() const { return evictions_; }
+
  protected:
   Isolate* isolate() { return isolate_; }
 
+  void RecordHit(StatsCounter* counter);
+  void RecordMiss(StatsCounter* counter);
+
  private:
   Isolate* isolate_;
   int generations_;  // Number of generations.
   Object** tables_;  // Compilation cache tables - one for each generation.
+  size_t hits_;
+  size_t misses_;
+  size_t evictions_;
 
   DISALLOW_IMPLICIT_CONSTRUCTORS(CompilationSubCache);
 };
@@ -206,15 +227,22 @@ class CompilationCache {
   void Enable();
   void Disable();
 
+  // The number of sub caches covering the different types to cache.
+  static const int kSubCacheCount = 4;
+
+  // Sub-caches by index, for statistics.
+  CompilationSubCache* subcache(int index) {
+    DCHECK(index >= 0 && index < kSubCacheCount);
+    return subcaches_[index];
+  }
+  static const char* SubCacheName(int index);
+
  private:
   explicit CompilationCache(Isolate* isolate);
   ~CompilationCache();
 
   HashMap* EagerOptimizingSet();
 
-  // The number of sub caches covering the different types to cache.
-  static const int kSubCacheCount = 4;
-
   bool IsEnabled() { return FLAG_compilation_cache && enabled_; }
 
   Isolate* isolate() { return isolate_; }
@@ -236,6 +264,33 @@ class CompilationCache {
 };
 
 
+// A process-wide cache of serialized scripts, shared by all isolates. When a
+// script misses the per-isolate compilation cache, an isolate deserializes the
+// code another isolate compiled for the same source and origin instead of
+// compiling it again. Entries hold code cache data produced by the
+// CodeSerializer outside of any heap. The least recently used entries are
+// evicted when the cache grows beyond --shared-code-cache-size.
+class SharedCodeCache : public AllStatic {
+ public:
+  // Returns a copy of the data cached for the script, owned by the caller, or
+  // NULL if there is none.
+  static ScriptData* Lookup(Handle<String> source, Handle<Object> name,
+                            int line_offset, int column_offset,
+                            ScriptOriginOptions resource_options);
+
+  // Stores a copy of the data for the script, replacing existing data.
+  static void Put(Handle<String> source, Handle<Object> name, int line_offset,
+                  int column_offset, ScriptOriginOptions resource_options,
+                  ScriptData* data);
+
+  // Drops all entries.
+  static void Clear();
+
+  // The number of bytes used by the entries.
+  static size_t size();
+};
+
+
 } }  // namespace v8::internal
 
 #endif  // V8_COMPILATION_CACHE_H_
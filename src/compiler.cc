@@ -10,6 +10,7 @@
 #include "src/bootstrapper.h"
 #include "src/codegen.h"
 #include "src/compilation-cache.h"
+#include "src/compiler/bytecode-graph-builder.h"
 #include "src/compiler/pipeline.h"
 #include "src/cpu-profiler.h"
 #include "src/debug/debug.h"
@@ -20,6 +21,8 @@
 #include "src/hydrogen.h"
 #include "src/interpreter/interpreter.h"
 #include "src/isolate-inl.h"
+#include "src/lazy-compile-profiler.h"
+#include "src/lazy-compile-queue.h"
 #include "src/lithium.h"
 #include "src/log-inl.h"
 #include "src/messages.h"
@@ -375,6 +378,18 @@ class HOptimizedGraphBuilderWithPositions: public HOptimizedGraphBuilder {
 };
 
 
+OptimizedCompileJob::OptimizedCompileJob(CompilationInfo* info)
+    : info_(info),
+      graph_builder_(NULL),
+      graph_(NULL),
+      chunk_(NULL),
+      last_status_(FAILED),
+      awaiting_install_(false) {}
+
+
+OptimizedCompileJob::~OptimizedCompileJob() {}
+
+
 OptimizedCompileJob::Status OptimizedCompileJob::CreateGraph() {
   DCHECK(info()->IsOptimizing());
 
@@ -395,13 +410,24 @@ OptimizedCompileJob::Status OptimizedCompileJob::CreateGraph() {
     return AbortOptimization(kHydrogenFilter);
   }
 
+  // Interpreted functions are optimized by TurboFan directly from their
+  // bytecode. There is no fullcode to deoptimize to, so the resulting code is
+  // compiled without deoptimization support.
+  bool compile_from_bytecode = info()->shared_info()->HasBytecodeArray();
+  if (compile_from_bytecode) {
+    BailoutReason reason =
+        compiler::BytecodeGraphBuilder::CheckSupported(info()->shared_info());
+    if (reason != kNoReason) return AbortOptimization(reason);
+  }
+
   // Optimization requires a version of fullcode with deoptimization support.
   // Recompile the unoptimized version of the code if the current version
   // doesn't have deoptimization support already.
   // Otherwise, if we are gathering compilation time and space statistics
   // for hydrogen, gather baseline statistics for a fullcode compilation.
-  bool should_recompile = !info()->shared_info()->has_deoptimization_support();
-  if (should_recompile || FLAG_hydrogen_stats) {
+  bool should_recompile = !compile_from_bytecode &&
+                          !info()->shared_info()->has_deoptimization_support();
+  if (should_recompile || (FLAG_hydrogen_stats && !compile_from_bytecode)) {
     base::ElapsedTimer timer;
     if (FLAG_hydrogen_stats) {
       timer.Start();
@@ -414,12 +440,14 @@ OptimizedCompileJob::Status OptimizedCompileJob::CreateGraph() {
     }
   }
 
-  DCHECK(info()->shared_info()->has_deoptimization_support());
+  DCHECK(compile_from_bytecode ||
+         info()->shared_info()->has_deoptimization_support());
   DCHECK(!info()->is_first_compile());
 
   // Check the enabling conditions for TurboFan.
   bool dont_crankshaft = info()->shared_info()->dont_crankshaft();
-  if (((FLAG_turbo_asm && info()->shared_info()->asm_function()) ||
+  if ((compile_from_bytecode ||
+       (FLAG_turbo_asm && info()->shared_info()->asm_function()) ||
        (dont_crankshaft && strcmp(FLAG_turbo_filter, "~~") == 0) ||
        info()->closure()->PassesFilter(FLAG_turbo_filter)) &&
       (FLAG_turbo_osr || !info()->is_osr())) {
@@ -435,25 +463,30 @@ OptimizedCompileJob::Status OptimizedCompileJob::CreateGraph() {
     if (info()->shared_info()->asm_function()) {
       if (info()->osr_frame()) info()->MarkAsFrameSpecializing();
       info()->MarkAsContextSpecializing();
-    } else if (FLAG_turbo_type_feedback) {
+    } else if (FLAG_turbo_type_feedback && !compile_from_bytecode) {
       info()->MarkAsTypeFeedbackEnabled();
       info()->EnsureFeedbackVector();
     }
-    if (!info()->shared_info()->asm_function() ||
-        FLAG_turbo_asm_deoptimization) {
+    if (!compile_from_bytecode &&
+        (!info()->shared_info()->asm_function() ||
+         FLAG_turbo_asm_deoptimization)) {
       info()->MarkAsDeoptimizationEnabled();
     }
 
+    // Only graph building, lowering and instruction selection need the main
+    // thread. Register allocation is left to OptimizeGraph, which may run on
+    // the concurrent recompilation thread.
     Timer t(this, &time_taken_to_create_graph_);
-    compiler::Pipeline pipeline(info());
-    pipeline.GenerateCode();
-    if (!info()->code().is_null()) {
+    pipeline_.Reset(new compiler::Pipeline(info()));
+    if (pipeline_->CreateGraph()) {
       return SetLastStatus(SUCCEEDED);
     }
+    pipeline_.Reset(nullptr);
   }
 
-  if (!isolate()->use_crankshaft() || dont_crankshaft) {
-    // Crankshaft is entirely disabled.
+  if (!isolate()->use_crankshaft() || dont_crankshaft ||
+      compile_from_bytecode) {
+    // Crankshaft is entirely disabled or can't deoptimize to the interpreter.
     return SetLastStatus(FAILED);
   }
 
@@ -529,12 +562,12 @@ OptimizedCompileJob::Status OptimizedCompileJob::OptimizeGraph() {
   DisallowCodeDependencyChange no_dependency_change;
 
   DCHECK(last_status() == SUCCEEDED);
-  // TODO(turbofan): Currently everything is done in the first phase.
-  if (!info()->code().is_null()) {
-    return last_status();
+  Timer t(this, &time_taken_to_optimize_);
+  if (!pipeline_.is_empty()) {
+    if (pipeline_->OptimizeGraph()) return SetLastStatus(SUCCEEDED);
+    return SetLastStatus(BAILED_OUT);
   }
 
-  Timer t(this, &time_taken_to_optimize_);
   DCHECK(graph_ != NULL);
   BailoutReason bailout_reason = kNoReason;
 
@@ -551,8 +584,17 @@ OptimizedCompileJob::Status OptimizedCompileJob::OptimizeGraph() {
 
 OptimizedCompileJob::Status OptimizedCompileJob::GenerateCode() {
   DCHECK(last_status() == SUCCEEDED);
-  // TODO(turbofan): Currently everything is done in the first phase.
-  if (!info()->code().is_null()) {
+  if (!pipeline_.is_empty()) {
+    DisallowJavascriptExecution no_js(isolate());
+    {  // Scope for timer.
+      Timer timer(this, &time_taken_to_codegen_);
+      Handle<Code> optimized_code = pipeline_->FinalizeCode();
+      pipeline_.Reset(nullptr);
+      if (optimized_code.is_null()) {
+        return AbortOptimization(kCodeGenerationFailed);
+      }
+    }
+    DCHECK(!info()->code().is_null());
     info()->dependencies()->Commit(info()->code());
     if (info()->is_deoptimization_enabled()) {
       info()->parse_info()->context()->native_context()->AddOptimizedCode(
@@ -711,13 +753,10 @@ static bool GenerateBytecode(CompilationInfo* info) {
 }
 
 
-MUST_USE_RESULT static MaybeHandle<Code> GetUnoptimizedCodeCommon(
+// Generates unoptimized code for a parsed function and installs it on the
+// shared function info.
+MUST_USE_RESULT static MaybeHandle<Code> GetUnoptimizedCodeForLiteral(
     CompilationInfo* info) {
-  VMState<COMPILER> state(info->isolate());
-  PostponeInterruptsScope postpone(info->isolate());
-
-  // Parse and update CompilationInfo with the results.
-  if (!Parser::ParseStatic(info->parse_info())) return MaybeHandle<Code>();
   Handle<SharedFunctionInfo> shared = info->shared_info();
   FunctionLiteral* lit = info->literal();
   shared->set_language_mode(lit->language_mode());
@@ -728,6 +767,13 @@ MUST_USE_RESULT static MaybeHandle<Code> GetUnoptimizedCodeCommon(
     // Compile bytecode for the interpreter.
     if (!GenerateBytecode(info)) return MaybeHandle<Code>();
   } else {
+    // Functions of scripts that go into a code cache are compiled for
+    // serialization, so that they can be included when the cache is created
+    // after they ran.
+    if (!info->script().is_null() && info->script()->will_serialize()) {
+      info->PrepareForSerializing();
+    }
+
     // Compile unoptimized code.
     if (!CompileUnoptimizedCode(info)) return MaybeHandle<Code>();
 
@@ -749,6 +795,17 @@ MUST_USE_RESULT static MaybeHandle<Code> GetUnoptimizedCodeCommon(
 }
 
 
+MUST_USE_RESULT static MaybeHandle<Code> GetUnoptimizedCodeCommon(
+    CompilationInfo* info) {
+  VMState<COMPILER> state(info->isolate());
+  PostponeInterruptsScope postpone(info->isolate());
+
+  // Parse and update CompilationInfo with the results.
+  if (!Parser::ParseStatic(info->parse_info())) return MaybeHandle<Code>();
+  return GetUnoptimizedCodeForLiteral(info);
+}
+
+
 MUST_USE_RESULT static MaybeHandle<Code> GetCodeFromOptimizedCodeMap(
     Handle<JSFunction> function, BailoutId osr_ast_id) {
   Handle<SharedFunctionInfo> shared(function->shared());
@@ -880,10 +937,10 @@ static bool GetOptimizedCodeLater(CompilationInfo* info) {
 
   TimerEventScope<TimerEventRecompileSynchronous> timer(info->isolate());
 
-  OptimizedCompileJob* job = new (info->zone()) OptimizedCompileJob(info);
+  base::SmartPointer<OptimizedCompileJob> job(new OptimizedCompileJob(info));
   OptimizedCompileJob::Status status = job->CreateGraph();
   if (status != OptimizedCompileJob::SUCCEEDED) return false;
-  isolate->optimizing_compile_dispatcher()->QueueForOptimization(job);
+  isolate->optimizing_compile_dispatcher()->QueueForOptimization(job.Detach());
 
   if (FLAG_trace_concurrent_recompilation) {
     PrintF("  ** Queued ");
@@ -940,6 +997,12 @@ MaybeHandle<Code> Compiler::GetLazyCode(Handle<JSFunction> function) {
     if (isolate->has_pending_exception()) isolate->clear_pending_exception();
   }
 
+  // The function may have been parsed on a background thread already.
+  if (isolate->lazy_compile_queue() != NULL) {
+    isolate->lazy_compile_queue()->FinishFunction(
+        handle(function->shared(), isolate));
+  }
+
   if (function->shared()->is_compiled()) {
     return Handle<Code>(function->shared()->code());
   }
@@ -948,6 +1011,7 @@ MaybeHandle<Code> Compiler::GetLazyCode(Handle<JSFunction> function) {
   Handle<Code> result;
   ASSIGN_RETURN_ON_EXCEPTION(isolate, result, GetUnoptimizedCodeCommon(&info),
                              Code);
+  isolate->lazy_compile_profiler()->FunctionCompiled(info.shared_info());
 
   if (FLAG_always_opt) {
     Handle<Code> opt_code;
@@ -1116,6 +1180,24 @@ bool Compiler::CompileDebugCode(Handle<SharedFunctionInfo> shared) {
 }
 
 
+bool Compiler::CompileParsedFunction(ParseInfo* parse_info) {
+  Isolate* isolate = parse_info->isolate();
+  DCHECK(parse_info->literal() != NULL);
+  // Bytecode generation is filtered on the closure, which is not known here.
+  DCHECK(!FLAG_ignition);
+  VMState<COMPILER> state(isolate);
+  PostponeInterruptsScope postpone(isolate);
+
+  parse_info->set_language_mode(parse_info->literal()->language_mode());
+  CompilationInfo info(parse_info);
+  if (GetUnoptimizedCodeForLiteral(&info).is_null()) {
+    if (isolate->has_pending_exception()) isolate->clear_pending_exception();
+    return false;
+  }
+  return true;
+}
+
+
 void Compiler::CompileForLiveEdit(Handle<Script> script) {
   // TODO(635): support extensions.
   Zone zone;
@@ -1243,6 +1325,17 @@ static Handle<SharedFunctionInfo> CompileToplevel(CompilationInfo* info) {
     if (!script.is_null())
       script->set_compilation_state(Script::COMPILATION_STATE_COMPILED);
 
+    if (parse_info->is_global() && parse_info->extension() == NULL &&
+        script->type()->value() == Script::TYPE_NORMAL) {
+      ScriptData* consumed_profile =
+          parse_info->compile_options() ==
+                  ScriptCompiler::kConsumeCompileProfile
+              ? *parse_info->cached_data()
+              : NULL;
+      isolate->lazy_compile_profiler()->ScriptCompiled(script,
+                                                       consumed_profile);
+    }
+
     live_edit_tracker.RecordFunctionInfo(result, lit, info->zone());
   }
 
@@ -1337,7 +1430,8 @@ Handle<SharedFunctionInfo> Compiler::CompileScript(
     DCHECK(!isolate->debug()->is_loaded());
   } else {
     DCHECK(compile_options == ScriptCompiler::kConsumeParserCache ||
-           compile_options == ScriptCompiler::kConsumeCodeCache);
+           compile_options == ScriptCompiler::kConsumeCodeCache ||
+           compile_options == ScriptCompiler::kConsumeCompileProfile);
     DCHECK(cached_data && *cached_data);
     DCHECK(extension == NULL);
   }
@@ -1353,6 +1447,14 @@ Handle<SharedFunctionInfo> Compiler::CompileScript(
 
   CompilationCache* compilation_cache = isolate->compilation_cache();
 
+  // Scripts compiled without cached data from the embedder go through the
+  // process-wide code cache shared with other isolates.
+  bool use_shared_code_cache =
+      FLAG_shared_code_cache && FLAG_serialize_toplevel &&
+      compile_options == ScriptCompiler::kNoCompileOptions &&
+      extension == NULL && natives == NOT_NATIVES_CODE && !is_module &&
+      !isolate->debug()->is_loaded() && !isolate->serializer_enabled();
+
   // Do a lookup in the compilation cache but not for extensions.
   MaybeHandle<SharedFunctionInfo> maybe_result;
   Handle<SharedFunctionInfo> result;
@@ -1375,6 +1477,21 @@ Handle<SharedFunctionInfo> Compiler::CompileScript(
       }
       // Deserializer failed. Fall through to compile.
     }
+    if (maybe_result.is_null() && use_shared_code_cache) {
+      base::SmartPointer<ScriptData> shared_data(SharedCodeCache::Lookup(
+          source, script_name, line_offset, column_offset, resource_options));
+      if (!shared_data.is_empty()) {
+        HistogramTimerScope timer(isolate->counters()->compile_deserialize());
+        Handle<SharedFunctionInfo> result;
+        if (CodeSerializer::Deserialize(isolate, shared_data.get(), source)
+                .ToHandle(&result)) {
+          compilation_cache->PutScript(source, context, language_mode, result);
+          return result;
+        }
+        // Deserializer failed. Fall through to compile, which replaces the
+        // shared entry.
+      }
+    }
   }
 
   base::ElapsedTimer timer;
@@ -1411,15 +1528,23 @@ Handle<SharedFunctionInfo> Compiler::CompileScript(
     } else {
       parse_info.set_global();
     }
+    if (compile_options == ScriptCompiler::kConsumeCompileProfile &&
+        !LazyCompileProfiler::Validate(*cached_data, source)) {
+      compile_options = ScriptCompiler::kNoCompileOptions;
+    }
     if (compile_options != ScriptCompiler::kNoCompileOptions) {
       parse_info.set_cached_data(cached_data);
     }
+    parse_info.set_parse_profile_in_background(
+        isolate->lazy_compile_queue() != NULL);
     parse_info.set_compile_options(compile_options);
     parse_info.set_extension(extension);
     parse_info.set_context(context);
-    if (FLAG_serialize_toplevel &&
-        compile_options == ScriptCompiler::kProduceCodeCache) {
+    if ((FLAG_serialize_toplevel &&
+         compile_options == ScriptCompiler::kProduceCodeCache) ||
+        use_shared_code_cache) {
       info.PrepareForSerializing();
+      script->set_will_serialize(true);
     }
 
     parse_info.set_language_mode(
@@ -1437,6 +1562,14 @@ Handle<SharedFunctionInfo> Compiler::CompileScript(
                  timer.Elapsed().InMillisecondsF());
         }
       }
+      if (use_shared_code_cache) {
+        HistogramTimerScope histogram_timer(
+            isolate->counters()->compile_serialize());
+        base::SmartPointer<ScriptData> shared_data(
+            CodeSerializer::Serialize(isolate, result, source));
+        SharedCodeCache::Put(source, script_name, line_offset, column_offset,
+                             resource_options, shared_data.get());
+      }
     }
 
     if (result.is_null()) {
@@ -1474,6 +1607,119 @@ Handle<SharedFunctionInfo> Compiler::CompileStreamedScript(
 }
 
 
+// State of a shared function info that Compiler::CreateCodeCache swaps out
+// while the script is serialized.
+struct SwappedFunctionState {
+  Code* code;
+  TypeFeedbackVector* feedback_vector;
+  Object* optimized_code_map;
+  int compiler_hints;
+  int opt_count_and_bailout_reason;
+  int counters;
+};
+
+
+ScriptData* Compiler::CreateCodeCache(Handle<SharedFunctionInfo> toplevel,
+                                      Handle<String> source) {
+  Isolate* isolate = toplevel->GetIsolate();
+  if (!FLAG_serialize_toplevel || !toplevel->script()->IsScript()) {
+    return NULL;
+  }
+  // Only scripts compiled for serialization have code that can be serialized.
+  Handle<Script> script(Script::cast(toplevel->script()), isolate);
+  Code* toplevel_code = toplevel->code();
+  if (!script->will_serialize() || toplevel_code->kind() != Code::FUNCTION ||
+      !toplevel_code->has_reloc_info_for_serialization()) {
+    return NULL;
+  }
+
+  base::ElapsedTimer timer;
+  if (FLAG_profile_deserialization) timer.Start();
+
+  // Inline caches, type feedback and optimized code refer to objects of the
+  // contexts the functions ran in, and the functions may still be running.
+  // Serialize copies of the code and the feedback vectors with that state
+  // dropped, like for a compilation cache hit, and leave the originals alone.
+  List<Handle<SharedFunctionInfo> > shared_infos;
+  {
+    WeakFixedArray::Iterator iterator(script->shared_function_infos());
+    SharedFunctionInfo* shared;
+    while ((shared = iterator.Next<SharedFunctionInfo>())) {
+      shared_infos.Add(handle(shared, isolate));
+    }
+  }
+  int length = shared_infos.length();
+  List<Handle<Code> > code_copies(length);
+  List<Handle<TypeFeedbackVector> > vector_copies(length);
+  for (int i = 0; i < length; i++) {
+    Handle<Code> code(shared_infos[i]->code(), isolate);
+    if (code->kind() == Code::FUNCTION) {
+      // Clearing the inline caches of the copy updates the IC counts of its
+      // type feedback info, so it gets its own.
+      int ic_total_count =
+          TypeFeedbackInfo::cast(code->type_feedback_info())->ic_total_count();
+      code = isolate->factory()->CopyCode(code);
+      Handle<TypeFeedbackInfo> info = isolate->factory()->NewTypeFeedbackInfo();
+      info->set_ic_total_count(ic_total_count);
+      code->set_type_feedback_info(*info);
+    }
+    code_copies.Add(code);
+    vector_copies.Add(TypeFeedbackVector::Copy(
+        isolate, handle(shared_infos[i]->feedback_vector(), isolate)));
+  }
+
+  ScriptData* result;
+  {
+    DisallowHeapAllocation no_gc;
+    HistogramTimerScope histogram_timer(
+        isolate->counters()->compile_serialize());
+    int ic_age = isolate->heap()->global_ic_age();
+    List<SwappedFunctionState> swapped(length);
+    for (int i = 0; i < length; i++) {
+      SharedFunctionInfo* shared = *shared_infos[i];
+      SwappedFunctionState state;
+      state.code = shared->code();
+      state.feedback_vector = shared->feedback_vector();
+      state.optimized_code_map = shared->optimized_code_map();
+      state.compiler_hints = shared->compiler_hints();
+      state.opt_count_and_bailout_reason =
+          shared->opt_count_and_bailout_reason();
+      state.counters = shared->counters();
+      swapped.Add(state);
+      shared->set_code(*code_copies[i]);
+      shared->set_feedback_vector(*vector_copies[i]);
+      shared->set_optimized_code_map(Smi::FromInt(0));
+      if (shared->code()->kind() == Code::FUNCTION) {
+        shared->ResetForNewContext(ic_age);
+      }
+      // Allocation sites survive clearing, but they refer to boilerplate
+      // objects of the context the function ran in.
+      shared->feedback_vector()->ClearAllocationSites();
+    }
+
+    result = CodeSerializer::Serialize(isolate, toplevel, source);
+
+    for (int i = 0; i < length; i++) {
+      SharedFunctionInfo* shared = *shared_infos[i];
+      const SwappedFunctionState& state = swapped[i];
+      shared->set_code(state.code);
+      shared->set_feedback_vector(state.feedback_vector);
+      shared->set_optimized_code_map(state.optimized_code_map);
+      shared->set_compiler_hints(state.compiler_hints);
+      shared->set_opt_count_and_bailout_reason(
+          state.opt_count_and_bailout_reason);
+      shared->set_counters(state.counters);
+    }
+  }
+
+  if (FLAG_profile_deserialization) {
+    PrintF("[Creating code cache after execution took %0.3f ms]\n",
+           timer.Elapsed().InMillisecondsF());
+  }
+  return result;
+}
+
+
 Handle<SharedFunctionInfo> Compiler::GetSharedFunctionInfo(
     FunctionLiteral* literal, Handle<Script> script,
     CompilationInfo* outer_info) {
@@ -1589,6 +1835,12 @@ Handle<SharedFunctionInfo> Compiler::GetSharedFunctionInfo(
     SetExpectedNofPropertiesFromEstimate(result,
                                          literal->expected_property_count());
     live_edit_tracker.RecordFunctionInfo(result, literal, info.zone());
+
+    // The parser skipped the function instead of compiling it eagerly, so
+    // that it is parsed on a background thread.
+    if (lazy && literal->should_parse_in_background()) {
+      isolate->lazy_compile_queue()->EnqueueOrCompile(result);
+    }
     return result;
   } else if (!lazy) {
     // Assert that we are not overwriting (possibly patched) debug code.
@@ -1676,9 +1928,10 @@ MaybeHandle<Code> Compiler::GetOptimizedCode(Handle<JSFunction> function,
 
 
 Handle<Code> Compiler::GetConcurrentlyOptimizedCode(OptimizedCompileJob* job) {
-  // Take ownership of compilation info.  Deleting compilation info
-  // also tears down the zone and the recompile job.
+  // Take ownership of compilation info and the recompile job.  Deleting
+  // compilation info also tears down the zone.
   base::SmartPointer<CompilationInfo> info(job->info());
+  base::SmartPointer<OptimizedCompileJob> job_scope(job);
   Isolate* isolate = info->isolate();
 
   VMState<COMPILER> state(isolate);
@@ -21,6 +21,10 @@ class JavaScriptFrame;
 class ParseInfo;
 class ScriptData;
 
+namespace compiler {
+class Pipeline;
+}  // namespace compiler
+
 struct OffsetRange {
   OffsetRange(int from, int to) : from(from), to(to) {}
   int from;
@@ -535,15 +539,13 @@ class LChunk;
 // fail, bail-out to the full code generator or succeed.  Apart from
 // their return value, the status of the phase last run can be checked
 // using last_status().
-class OptimizedCompileJob: public ZoneObject {
+// A compilation job is heap-allocated because it may own a TurboFan pipeline
+// whose zones have to be released together with the job. Whoever disposes of
+// the CompilationInfo is responsible for deleting the job as well.
+class OptimizedCompileJob : public Malloced {
  public:
-  explicit OptimizedCompileJob(CompilationInfo* info)
-      : info_(info),
-        graph_builder_(NULL),
-        graph_(NULL),
-        chunk_(NULL),
-        last_status_(FAILED),
-        awaiting_install_(false) { }
+  explicit OptimizedCompileJob(CompilationInfo* info);
+  ~OptimizedCompileJob();
 
   enum Status {
     FAILED, BAILED_OUT, SUCCEEDED
@@ -576,6 +578,7 @@ class OptimizedCompileJob: public ZoneObject {
 
  private:
   CompilationInfo* info_;
+  base::SmartPointer<compiler::Pipeline> pipeline_;
   HOptimizedGraphBuilder* graph_builder_;
   HGraph* graph_;
   LChunk* chunk_;
@@ -633,6 +636,9 @@ class Compiler : public AllStatic {
   static bool CompileDebugCode(Handle<JSFunction> function);
   static bool CompileDebugCode(Handle<SharedFunctionInfo> shared);
   static void CompileForLiveEdit(Handle<Script> script);
+  // Compiles a lazily compiled function that was parsed in advance, see
+  // LazyCompileQueue. Returns false without a pending exception on failure.
+  static bool CompileParsedFunction(ParseInfo* parse_info);
 
   // Parser::Parse, then Compiler::Analyze.
   static bool ParseAndAnalyze(ParseInfo* info);
@@ -662,6 +668,12 @@ class Compiler : public AllStatic {
                                                           ParseInfo* info,
                                                           int source_length);
 
+  // Serialize a script that may already have run, including the code of all
+  // its functions compiled so far. Returns NULL if the script was not
+  // compiled for serialization.
+  static ScriptData* CreateCodeCache(Handle<SharedFunctionInfo> toplevel,
+                                     Handle<String> source);
+
   // Create a shared function info object (the code may be lazily compiled).
   static Handle<SharedFunctionInfo> GetSharedFunctionInfo(
       FunctionLiteral* node, Handle<Script> script, CompilationInfo* outer);
@@ -157,6 +157,14 @@ FieldAccess AccessBuilder::ForPropertyCellValue() {
 }
 
 
+// static
+FieldAccess AccessBuilder::ForSimd128ValuePayload() {
+  FieldAccess access = {kTaggedBase, Simd128Value::kValueOffset,
+                        Handle<Name>(), Type::Internal(), kMachSimd128};
+  return access;
+}
+
+
 // static
 FieldAccess AccessBuilder::ForSharedFunctionInfoTypeFeedbackVector() {
   FieldAccess access = {kTaggedBase, SharedFunctionInfo::kFeedbackVectorOffset,
@@ -227,6 +235,14 @@ ElementAccess AccessBuilder::ForTypedArrayElement(ExternalArrayType type,
 }
 
 
+// static
+ElementAccess AccessBuilder::ForSimd128ValueLane(ExternalArrayType lane_type) {
+  ElementAccess access = ForTypedArrayElement(lane_type, false);
+  access.header_size = Simd128Value::kValueOffset;
+  return access;
+}
+
+
 // static
 ElementAccess AccessBuilder::ForSeqStringChar(String::Encoding encoding) {
   switch (encoding) {
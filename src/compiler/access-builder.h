@@ -70,6 +70,9 @@ class AccessBuilder final : public AllStatic {
   // Provides access to PropertyCell::value() field.
   static FieldAccess ForPropertyCellValue();
 
+  // Provides access to the 128-bit payload of a Simd128Value.
+  static FieldAccess ForSimd128ValuePayload();
+
   // Provides access to SharedFunctionInfo::feedback_vector() field.
   static FieldAccess ForSharedFunctionInfoTypeFeedbackVector();
 
@@ -80,6 +83,10 @@ class AccessBuilder final : public AllStatic {
   static ElementAccess ForTypedArrayElement(ExternalArrayType type,
                                             bool is_external);
 
+  // Provides access to the lanes of a Simd128Value with numeric lanes of the
+  // given element type.
+  static ElementAccess ForSimd128ValueLane(ExternalArrayType lane_type);
+
   // Provides access to the characters of sequential strings.
   static ElementAccess ForSeqStringChar(String::Encoding encoding);
 
@@ -5,6 +5,7 @@
 #include "src/compiler/bytecode-graph-builder.h"
 
 #include "src/compiler/linkage.h"
+#include "src/compiler/node-matchers.h"
 #include "src/compiler/operator-properties.h"
 #include "src/interpreter/bytecode-array-iterator.h"
 
@@ -123,6 +124,35 @@ Node* BytecodeGraphBuilder::GetFunctionContext() {
 }
 
 
+VectorSlotPair BytecodeGraphBuilder::CreateVectorSlotPair(int slot_index) {
+  Handle<TypeFeedbackVector> feedback_vector(
+      info()->shared_info()->feedback_vector());
+  return VectorSlotPair(feedback_vector,
+                        feedback_vector->ToICSlot(slot_index));
+}
+
+
+Node* BytecodeGraphBuilder::BuildLoadFeedbackVector() {
+  // The vector belongs to the SharedFunctionInfo, so all closures of the
+  // function share it.
+  return jsgraph()->HeapConstant(
+      handle(info()->shared_info()->feedback_vector()));
+}
+
+
+// static
+BailoutReason BytecodeGraphBuilder::CheckSupported(
+    Handle<SharedFunctionInfo> shared) {
+  DCHECK(shared->HasBytecodeArray());
+  // Building a function context is not implemented yet, see CreateGraph.
+  // Functions accessing the context they were called with are supported.
+  if (shared->scope_info()->ContextLength() > 0) {
+    return kUnsupportedFunctionContext;
+  }
+  return kNoReason;
+}
+
+
 bool BytecodeGraphBuilder::CreateGraph(bool stack_check) {
   // Set up the basic structure of the graph. Outputs for {Start} are
   // the formal parameters (including the receiver) plus context and
@@ -138,6 +168,7 @@ bool BytecodeGraphBuilder::CreateGraph(bool stack_check) {
   set_environment(&env);
 
   // Build function context only if there are context allocated variables.
+  // CheckSupported keeps such functions from getting here.
   if (info()->num_heap_slots() > 0) {
     UNIMPLEMENTED();  // TODO(oth): Write ast-graph-builder equivalent.
   } else {
@@ -179,6 +210,20 @@ void BytecodeGraphBuilder::VisitBytecodes() {
 }
 
 
+void BytecodeGraphBuilder::VisitWide(
+    const interpreter::BytecodeArrayIterator& iterator) {
+  // Consumed by the iterator.
+  UNREACHABLE();
+}
+
+
+void BytecodeGraphBuilder::VisitExtraWide(
+    const interpreter::BytecodeArrayIterator& iterator) {
+  // Consumed by the iterator.
+  UNREACHABLE();
+}
+
+
 void BytecodeGraphBuilder::VisitLdaZero(
     const interpreter::BytecodeArrayIterator& iterator) {
   Node* node = jsgraph()->ZeroConstant();
@@ -249,36 +294,104 @@ void BytecodeGraphBuilder::VisitStar(
 }
 
 
+void BytecodeGraphBuilder::VisitLdarStar(
+    const interpreter::BytecodeArrayIterator& iterator) {
+  Node* value = environment()->LookupRegister(iterator.GetRegisterOperand(0));
+  environment()->BindRegister(iterator.GetRegisterOperand(1), value);
+  environment()->BindAccumulator(value);
+}
+
+
+void BytecodeGraphBuilder::VisitLdaContextSlot(
+    const interpreter::BytecodeArrayIterator& iterator) {
+  // The bytecode doesn't tell whether the slot is ever assigned, so the load
+  // can't be marked immutable.
+  const Operator* op =
+      javascript()->LoadContext(0, iterator.GetIndexOperand(0), false);
+  Node* node = NewNode(op, environment()->Context());
+  environment()->BindAccumulator(node);
+}
+
+
+void BytecodeGraphBuilder::VisitStaContextSlot(
+    const interpreter::BytecodeArrayIterator& iterator) {
+  const Operator* op =
+      javascript()->StoreContext(0, iterator.GetIndexOperand(0));
+  Node* value = environment()->LookupAccumulator();
+  NewNode(op, environment()->Context(), value);
+}
+
+
+void BytecodeGraphBuilder::BuildPropertyLoad(
+    const interpreter::BytecodeArrayIterator& iterator) {
+  Node* object = environment()->LookupRegister(iterator.GetRegisterOperand(0));
+  Node* key = environment()->LookupAccumulator();
+  VectorSlotPair feedback = CreateVectorSlotPair(iterator.GetIndexOperand(1));
+
+  Node* node;
+  HeapObjectMatcher key_matcher(key);
+  if (key_matcher.HasValue() && key_matcher.Value()->IsName()) {
+    Handle<Name> name = Handle<Name>::cast(key_matcher.Value());
+    const Operator* op =
+        javascript()->LoadNamed(name, feedback, language_mode());
+    node = NewNode(op, object, BuildLoadFeedbackVector());
+  } else {
+    const Operator* op = javascript()->LoadProperty(feedback, language_mode());
+    node = NewNode(op, object, key, BuildLoadFeedbackVector());
+  }
+  PrepareFrameState(node);
+  environment()->BindAccumulator(node);
+}
+
+
+void BytecodeGraphBuilder::BuildPropertyStore(
+    const interpreter::BytecodeArrayIterator& iterator) {
+  Node* object = environment()->LookupRegister(iterator.GetRegisterOperand(0));
+  Node* key = environment()->LookupRegister(iterator.GetRegisterOperand(1));
+  Node* value = environment()->LookupAccumulator();
+  VectorSlotPair feedback = CreateVectorSlotPair(iterator.GetIndexOperand(2));
+
+  Node* node;
+  HeapObjectMatcher key_matcher(key);
+  if (key_matcher.HasValue() && key_matcher.Value()->IsName()) {
+    Handle<Name> name = Handle<Name>::cast(key_matcher.Value());
+    const Operator* op =
+        javascript()->StoreNamed(language_mode(), name, feedback);
+    node = NewNode(op, object, value, BuildLoadFeedbackVector());
+  } else {
+    const Operator* op = javascript()->StoreProperty(language_mode(), feedback);
+    node = NewNode(op, object, key, value, BuildLoadFeedbackVector());
+  }
+  PrepareFrameState(node);
+  // The accumulator keeps the stored value.
+}
+
+
 void BytecodeGraphBuilder::VisitLoadIC(
     const interpreter::BytecodeArrayIterator& iterator) {
-  UNIMPLEMENTED();
+  BuildPropertyLoad(iterator);
 }
 
 
 void BytecodeGraphBuilder::VisitKeyedLoadIC(
     const interpreter::BytecodeArrayIterator& iterator) {
-  UNIMPLEMENTED();
+  BuildPropertyLoad(iterator);
 }
 
 
 void BytecodeGraphBuilder::VisitStoreIC(
     const interpreter::BytecodeArrayIterator& iterator) {
-  UNIMPLEMENTED();
+  BuildPropertyStore(iterator);
 }
 
 
 void BytecodeGraphBuilder::VisitKeyedStoreIC(
     const interpreter::BytecodeArrayIterator& iterator) {
-  UNIMPLEMENTED();
+  BuildPropertyStore(iterator);
 }
 
 
-void BytecodeGraphBuilder::BuildBinaryOp(
-    const Operator* js_op, const interpreter::BytecodeArrayIterator& iterator) {
-  Node* left = environment()->LookupRegister(iterator.GetRegisterOperand(0));
-  Node* right = environment()->LookupAccumulator();
-  Node* node = NewNode(js_op, left, right);
-
+void BytecodeGraphBuilder::PrepareFrameState(Node* node) {
   // TODO(oth): Real frame state and environment check pointing.
   int frame_state_count =
       OperatorProperties::GetFrameStateInputCount(node->op());
@@ -286,6 +399,21 @@ void BytecodeGraphBuilder::BuildBinaryOp(
     NodeProperties::ReplaceFrameStateInput(node, i,
                                            jsgraph()->EmptyFrameState());
   }
+}
+
+
+void BytecodeGraphBuilder::BuildBinaryOp(
+    const Operator* js_op, const interpreter::BytecodeArrayIterator& iterator) {
+  Node* left = environment()->LookupRegister(iterator.GetRegisterOperand(0));
+  Node* right = environment()->LookupAccumulator();
+  BuildBinaryOp(js_op, left, right);
+}
+
+
+void BytecodeGraphBuilder::BuildBinaryOp(const Operator* js_op, Node* left,
+                                         Node* right) {
+  Node* node = NewNode(js_op, left, right);
+  PrepareFrameState(node);
   environment()->BindAccumulator(node);
 }
 
@@ -296,6 +424,14 @@ void BytecodeGraphBuilder::VisitAdd(
 }
 
 
+void BytecodeGraphBuilder::VisitAddSmi8(
+    const interpreter::BytecodeArrayIterator& iterator) {
+  Node* left = environment()->LookupRegister(iterator.GetRegisterOperand(0));
+  Node* right = jsgraph()->Constant(iterator.GetSmi8Operand(1));
+  BuildBinaryOp(javascript()->Add(language_mode()), left, right);
+}
+
+
 void BytecodeGraphBuilder::VisitSub(
     const interpreter::BytecodeArrayIterator& iterator) {
   BuildBinaryOp(javascript()->Subtract(language_mode()), iterator);
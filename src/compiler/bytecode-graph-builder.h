@@ -24,6 +24,10 @@ class BytecodeGraphBuilder {
   // Creates a graph by visiting bytecodes.
   bool CreateGraph(bool stack_check = true);
 
+  // Returns kNoReason if a graph can be built for the bytecode of {shared},
+  // otherwise the reason why it can't.
+  static BailoutReason CheckSupported(Handle<SharedFunctionInfo> shared);
+
   Graph* graph() const { return jsgraph_->graph(); }
 
  private:
@@ -55,6 +59,16 @@ class BytecodeGraphBuilder {
     return MakeNode(op, arraysize(buffer), buffer, false);
   }
 
+  Node* NewNode(const Operator* op, Node* n1, Node* n2, Node* n3) {
+    Node* buffer[] = {n1, n2, n3};
+    return MakeNode(op, arraysize(buffer), buffer, false);
+  }
+
+  Node* NewNode(const Operator* op, Node* n1, Node* n2, Node* n3, Node* n4) {
+    Node* buffer[] = {n1, n2, n3, n4};
+    return MakeNode(op, arraysize(buffer), buffer, false);
+  }
+
   Node* MakeNode(const Operator* op, int value_input_count, Node** value_inputs,
                  bool incomplete);
 
@@ -64,8 +78,19 @@ class BytecodeGraphBuilder {
 
   void UpdateControlDependencyToLeaveFunction(Node* exit);
 
+  // Helpers to create the feedback inputs of property accesses from the
+  // feedback vector index operand of the bytecode.
+  VectorSlotPair CreateVectorSlotPair(int slot_index);
+  Node* BuildLoadFeedbackVector();
+
+  // Fills in the frame state inputs of {node}.
+  void PrepareFrameState(Node* node);
+
   void BuildBinaryOp(const Operator* op,
                      const interpreter::BytecodeArrayIterator& iterator);
+  void BuildBinaryOp(const Operator* op, Node* left, Node* right);
+  void BuildPropertyLoad(const interpreter::BytecodeArrayIterator& iterator);
+  void BuildPropertyStore(const interpreter::BytecodeArrayIterator& iterator);
 
   // Growth increment for the temporary buffer used to construct input lists to
   // new nodes.
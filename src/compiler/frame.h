@@ -138,9 +138,10 @@ class Frame : public ZoneObject {
 
  private:
   int AllocateAlignedFrameSlot(int width) {
-    DCHECK(width == 4 || width == 8);
+    DCHECK(width == 4 || width == 8 || width == 16);
     // Skip one slot if necessary.
     if (width > kPointerSize) {
+      // 128-bit values are only supported on 64-bit targets.
       DCHECK(width == kPointerSize * 2);
       frame_slot_count_++;
       frame_slot_count_ |= 1;
@@ -21,6 +21,7 @@ namespace compiler {
 class BasicBlock;
 struct CallBuffer;  // TODO(bmeurer): Remove this.
 class FlagsContinuation;
+class InstructionScheduler;
 class Linkage;
 class OperandGenerator;
 struct SwitchInfo;
@@ -140,6 +141,12 @@ class InstructionSelector final {
  private:
   friend class OperandGenerator;
 
+  // Forward the selected instructions of a block to the sequence, through the
+  // instruction scheduler if it is enabled.
+  void StartBlock(RpoNumber rpo);
+  void EndBlock(RpoNumber rpo);
+  void AddInstruction(Instruction* instr);
+
   void EmitTableSwitch(const SwitchInfo& sw, InstructionOperand& index_operand);
   void EmitLookupSwitch(const SwitchInfo& sw,
                         InstructionOperand& value_operand);
@@ -158,6 +165,7 @@ class InstructionSelector final {
   void MarkAsWord64(Node* node) { MarkAsRepresentation(kRepWord64, node); }
   void MarkAsFloat32(Node* node) { MarkAsRepresentation(kRepFloat32, node); }
   void MarkAsFloat64(Node* node) { MarkAsRepresentation(kRepFloat64, node); }
+  void MarkAsSimd128(Node* node) { MarkAsRepresentation(kRepSimd128, node); }
   void MarkAsReference(Node* node) { MarkAsRepresentation(kRepTagged, node); }
 
   // Inform the register allocation of the representation of the unallocated
@@ -238,6 +246,7 @@ class InstructionSelector final {
   BoolVector defined_;
   BoolVector used_;
   IntVector virtual_registers_;
+  InstructionScheduler* scheduler_;
 };
 
 }  // namespace compiler
@@ -89,6 +89,9 @@ std::ostream& operator<<(std::ostream& os,
         case kRepTagged:
           os << "|t";
           break;
+        case kRepSimd128:
+          os << "|s128";
+          break;
         default:
           os << "|?";
           break;
@@ -592,6 +595,7 @@ static MachineType FilterRepresentation(MachineType rep) {
     case kRepFloat32:
     case kRepFloat64:
     case kRepTagged:
+    case kRepSimd128:
       return rep;
     default:
       break;
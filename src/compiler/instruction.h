@@ -396,6 +396,7 @@ class AllocatedOperand : public InstructionOperand {
       case kRepFloat32:
       case kRepFloat64:
       case kRepTagged:
+      case kRepSimd128:
         return true;
       default:
         return false;
@@ -1080,6 +1081,7 @@ class InstructionSequence final : public ZoneObject {
     switch (GetRepresentation(virtual_register)) {
       case kRepFloat32:
       case kRepFloat64:
+      case kRepSimd128:
         return true;
       default:
         return false;
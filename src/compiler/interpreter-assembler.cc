@@ -16,6 +16,7 @@
 #include "src/frames.h"
 #include "src/interface-descriptors.h"
 #include "src/interpreter/bytecodes.h"
+#include "src/interpreter/interpreter.h"
 #include "src/macro-assembler.h"
 #include "src/zone.h"
 
@@ -24,9 +25,11 @@ namespace internal {
 namespace compiler {
 
 
-InterpreterAssembler::InterpreterAssembler(Isolate* isolate, Zone* zone,
-                                           interpreter::Bytecode bytecode)
+InterpreterAssembler::InterpreterAssembler(
+    Isolate* isolate, Zone* zone, interpreter::Bytecode bytecode,
+    interpreter::OperandScale operand_scale)
     : bytecode_(bytecode),
+      operand_scale_(operand_scale),
       raw_assembler_(new RawMachineAssembler(
           isolate, new (zone) Graph(zone),
           Linkage::GetInterpreterDispatchDescriptor(zone), kMachPtr,
@@ -34,7 +37,9 @@ InterpreterAssembler::InterpreterAssembler(Isolate* isolate, Zone* zone,
       end_node_(nullptr),
       accumulator_(
           raw_assembler_->Parameter(Linkage::kInterpreterAccumulatorParameter)),
-      code_generated_(false) {}
+      code_generated_(false) {
+  if (FLAG_ignition_profile) ProfileHandlerEntry();
+}
 
 
 InterpreterAssembler::~InterpreterAssembler() {}
@@ -80,6 +85,13 @@ Node* InterpreterAssembler::ContextTaggedPointer() {
 }
 
 
+Node* InterpreterAssembler::LoadFunction() {
+  return raw_assembler_->Load(
+      kMachAnyTagged, RegisterFileRawPointer(),
+      IntPtrConstant(InterpreterFrameConstants::kFunctionFromRegisterPointer));
+}
+
+
 Node* InterpreterAssembler::RegisterFileRawPointer() {
   return raw_assembler_->Parameter(Linkage::kInterpreterRegisterFileParameter);
 }
@@ -118,21 +130,62 @@ Node* InterpreterAssembler::StoreRegister(Node* value, Node* reg_index) {
 }
 
 
-Node* InterpreterAssembler::BytecodeOperand(int operand_index) {
+int InterpreterAssembler::BytecodeOperandOffset(int operand_index) {
   DCHECK_LT(operand_index, interpreter::Bytecodes::NumberOfOperands(bytecode_));
+  return 1 + operand_index * static_cast<int>(operand_scale_);
+}
+
+
+Node* InterpreterAssembler::BytecodeOperandScaled(int operand_index,
+                                                  bool is_signed) {
+  DCHECK(operand_scale_ != interpreter::OperandScale::kSingle);
+  int operand_offset = BytecodeOperandOffset(operand_index);
+  int operand_size = static_cast<int>(operand_scale_);
+  Node* value = nullptr;
+  for (int i = 0; i < operand_size; i++) {
+    // Operands are stored in little-endian byte order.
+    Node* byte = raw_assembler_->Load(
+        kMachUint8, BytecodeArrayTaggedPointer(),
+        raw_assembler_->IntPtrAdd(BytecodeOffset(),
+                                  Int32Constant(operand_offset + i)));
+    if (i > 0) byte = raw_assembler_->Word32Shl(byte, Int32Constant(8 * i));
+    value = value == nullptr ? byte : raw_assembler_->Word32Or(value, byte);
+  }
+  if (is_signed && operand_size < 4) {
+    Node* shift = Int32Constant(32 - 8 * operand_size);
+    value = raw_assembler_->Word32Sar(raw_assembler_->Word32Shl(value, shift),
+                                      shift);
+  }
+  // Ensure that we extend to full pointer size.
+  if (kPointerSize == 8) {
+    value = is_signed ? raw_assembler_->ChangeInt32ToInt64(value)
+                      : raw_assembler_->ChangeUint32ToUint64(value);
+  }
+  return value;
+}
+
+
+Node* InterpreterAssembler::BytecodeOperand(int operand_index) {
+  if (operand_scale_ != interpreter::OperandScale::kSingle) {
+    return BytecodeOperandScaled(operand_index, false);
+  }
+  int operand_offset = BytecodeOperandOffset(operand_index);
   return raw_assembler_->Load(
       kMachUint8, BytecodeArrayTaggedPointer(),
       raw_assembler_->IntPtrAdd(BytecodeOffset(),
-                                Int32Constant(1 + operand_index)));
+                                Int32Constant(operand_offset)));
 }
 
 
 Node* InterpreterAssembler::BytecodeOperandSignExtended(int operand_index) {
-  DCHECK_LT(operand_index, interpreter::Bytecodes::NumberOfOperands(bytecode_));
+  if (operand_scale_ != interpreter::OperandScale::kSingle) {
+    return BytecodeOperandScaled(operand_index, true);
+  }
+  int operand_offset = BytecodeOperandOffset(operand_index);
   Node* load = raw_assembler_->Load(
       kMachInt8, BytecodeArrayTaggedPointer(),
       raw_assembler_->IntPtrAdd(BytecodeOffset(),
-                                Int32Constant(1 + operand_index)));
+                                Int32Constant(operand_offset)));
   // Ensure that we sign extend to full pointer size
   if (kPointerSize == 8) {
     load = raw_assembler_->ChangeInt32ToInt64(load);
@@ -224,10 +277,32 @@ Node* InterpreterAssembler::LoadContextSlot(int slot_index) {
 }
 
 
+Node* InterpreterAssembler::ContextSlotOffset(Node* slot_index) {
+  return raw_assembler_->IntPtrAdd(
+      IntPtrConstant(Context::kHeaderSize - kHeapObjectTag),
+      raw_assembler_->WordShl(slot_index, Int32Constant(kPointerSizeLog2)));
+}
+
+
+Node* InterpreterAssembler::LoadContextSlot(Node* context, Node* slot_index) {
+  return raw_assembler_->Load(kMachAnyTagged, context,
+                              ContextSlotOffset(slot_index));
+}
+
+
+Node* InterpreterAssembler::StoreContextSlot(Node* context, Node* slot_index,
+                                             Node* value) {
+  return raw_assembler_->Store(kMachAnyTagged, context,
+                               ContextSlotOffset(slot_index), value,
+                               kFullWriteBarrier);
+}
+
+
+Node* InterpreterAssembler::GetContext() { return ContextTaggedPointer(); }
+
+
 Node* InterpreterAssembler::LoadTypeFeedbackVector() {
-  Node* function = raw_assembler_->Load(
-      kMachAnyTagged, RegisterFileRawPointer(),
-      IntPtrConstant(InterpreterFrameConstants::kFunctionFromRegisterPointer));
+  Node* function = LoadFunction();
   Node* shared_info =
       LoadObjectField(function, JSFunction::kSharedFunctionInfoOffset);
   Node* vector =
@@ -271,6 +346,13 @@ Node* InterpreterAssembler::CallIC(CallInterfaceDescriptor descriptor,
 }
 
 
+Node* InterpreterAssembler::CallRuntime(Runtime::FunctionId function_id,
+                                        Node* arg1) {
+  return raw_assembler_->CallRuntime1(function_id, arg1,
+                                      ContextTaggedPointer());
+}
+
+
 Node* InterpreterAssembler::CallRuntime(Runtime::FunctionId function_id,
                                         Node* arg1, Node* arg2) {
   return raw_assembler_->CallRuntime2(function_id, arg1, arg2,
@@ -278,7 +360,313 @@ Node* InterpreterAssembler::CallRuntime(Runtime::FunctionId function_id,
 }
 
 
+Node* InterpreterAssembler::SmiTagBitsOf(Node* a, Node* b) {
+  return raw_assembler_->WordAnd(raw_assembler_->WordOr(a, b),
+                                 IntPtrConstant(kSmiTagMask));
+}
+
+
+namespace {
+
+Node* FeedbackConstant(RawMachineAssembler* m,
+                       interpreter::BinaryOperationFeedback feedback) {
+  return m->PointerConstant(Smi::FromInt(static_cast<int>(feedback)));
+}
+
+
+// Returns the value of the Smi or HeapNumber |value| as a float64, or jumps to
+// |if_not_number| if |value| is neither.
+Node* LoadNumberAsFloat64(RawMachineAssembler* m, Node* value,
+                          RawMachineAssembler::Label* if_not_number) {
+  RawMachineAssembler::Label if_smi, if_heap_object, if_heap_number, done;
+  m->Branch(m->WordEqual(m->WordAnd(value, m->IntPtrConstant(kSmiTagMask)),
+                         m->IntPtrConstant(0)),
+            &if_smi, &if_heap_object);
+
+  m->Bind(&if_smi);
+  Node* untagged =
+      m->WordSar(value, m->Int32Constant(kSmiShiftSize + kSmiTagSize));
+  if (SmiValuesAre32Bits()) untagged = m->TruncateInt64ToInt32(untagged);
+  Node* smi_value = m->ChangeInt32ToFloat64(untagged);
+  m->Goto(&done);
+
+  m->Bind(&if_heap_object);
+  Node* map =
+      m->Load(kMachAnyTagged, value,
+              m->IntPtrConstant(HeapObject::kMapOffset - kHeapObjectTag));
+  Node* heap_number_map =
+      m->HeapConstant(m->isolate()->factory()->heap_number_map());
+  m->Branch(m->WordEqual(map, heap_number_map), &if_heap_number,
+            if_not_number);
+
+  m->Bind(&if_heap_number);
+  Node* heap_number_value =
+      m->Load(kMachFloat64, value,
+              m->IntPtrConstant(HeapNumber::kValueOffset - kHeapObjectTag));
+  m->Goto(&done);
+
+  m->Bind(&done);
+  return m->Phi(kMachFloat64, smi_value, heap_number_value);
+}
+
+
+// Returns |value| as a Smi if it is an integer other than -0 in Smi range, or
+// jumps to |if_not_smi| otherwise.
+Node* ChangeFloat64ToSmi(RawMachineAssembler* m, Node* value,
+                         RawMachineAssembler::Label* if_not_smi) {
+  RawMachineAssembler::Label if_int32, if_zero, if_tag;
+  Node* int32_value = m->ChangeFloat64ToInt32(value);
+  m->Branch(m->Float64Equal(value, m->ChangeInt32ToFloat64(int32_value)),
+            &if_int32, if_not_smi);
+
+  m->Bind(&if_int32);
+  m->Branch(m->Word32Equal(int32_value, m->Int32Constant(0)), &if_zero,
+            &if_tag);
+
+  m->Bind(&if_zero);
+  // Only the sign bit tells -0 apart from 0.
+  m->Branch(m->Int32LessThan(m->Float64ExtractHighWord32(value),
+                             m->Int32Constant(0)),
+            if_not_smi, &if_tag);
+
+  m->Bind(&if_tag);
+  if (SmiValuesAre32Bits()) {
+    return m->WordShl(m->ChangeInt32ToInt64(int32_value),
+                      m->Int32Constant(kSmiShiftSize + kSmiTagSize));
+  }
+  // Tagging doubles the value, which overflows iff it is out of Smi range.
+  RawMachineAssembler::Label if_no_overflow;
+  Node* pair = m->Int32AddWithOverflow(int32_value, int32_value);
+  m->Branch(m->Projection(1, pair), if_not_smi, &if_no_overflow);
+  m->Bind(&if_no_overflow);
+  return m->Projection(0, pair);
+}
+
+
+// Returns a new HeapNumber holding |value|, allocated inline in new space, or
+// jumps to |if_failed| if the linear allocation area is exhausted. Only used
+// on 64-bit hosts, where HeapNumbers need no double alignment.
+Node* AllocateHeapNumber(RawMachineAssembler* m, Node* value,
+                         RawMachineAssembler::Label* if_failed) {
+  DCHECK_EQ(8, kPointerSize);
+  Isolate* isolate = m->isolate();
+  Node* top_address = m->ExternalConstant(
+      ExternalReference::new_space_allocation_top_address(isolate));
+  Node* limit_address = m->ExternalConstant(
+      ExternalReference::new_space_allocation_limit_address(isolate));
+  Node* top = m->Load(kMachPtr, top_address);
+  Node* limit = m->Load(kMachPtr, limit_address);
+  Node* new_top = m->IntPtrAdd(top, m->IntPtrConstant(HeapNumber::kSize));
+  RawMachineAssembler::Label if_fits;
+  m->Branch(m->Uint64LessThanOrEqual(new_top, limit), &if_fits, if_failed);
+
+  m->Bind(&if_fits);
+  m->Store(kMachPtr, top_address, new_top);
+  Node* heap_number = m->IntPtrAdd(top, m->IntPtrConstant(kHeapObjectTag));
+  m->Store(kMachAnyTagged, heap_number,
+           m->IntPtrConstant(HeapObject::kMapOffset - kHeapObjectTag),
+           m->HeapConstant(isolate->factory()->heap_number_map()));
+  m->Store(kMachFloat64, heap_number,
+           m->IntPtrConstant(HeapNumber::kValueOffset - kHeapObjectTag),
+           value);
+  return heap_number;
+}
+
+}  // namespace
+
+
+Node* InterpreterAssembler::BinaryOpWithFeedback(
+    Token::Value op, Runtime::FunctionId function_id, Node* lhs, Node* rhs,
+    Node* feedback_slot) {
+  typedef interpreter::BinaryOperationFeedback Feedback;
+  RawMachineAssembler* m = raw_assembler_.get();
+  RawMachineAssembler::Label if_numbers, if_heap_number, if_number_runtime,
+      if_any, if_runtime, done;
+  // The results and feedback of the paths joining at |done|, in the order in
+  // which they jump there.
+  Node* results[4];
+  Node* feedback[4];
+  int path_count = 0;
+
+  if (op == Token::ADD || op == Token::SUB) {
+    RawMachineAssembler::Label if_smis, if_no_overflow;
+    m->Branch(m->WordEqual(SmiTagBitsOf(lhs, rhs), IntPtrConstant(0)),
+              &if_smis, &if_numbers);
+
+    m->Bind(&if_smis);
+    // With 31-bit Smis the tagged values can be combined directly, since the
+    // tag is zero. With 32-bit Smis the payload lives in the upper word half.
+    Node* lhs_int = lhs;
+    Node* rhs_int = rhs;
+    if (SmiValuesAre32Bits()) {
+      lhs_int = m->TruncateInt64ToInt32(SmiUntag(lhs));
+      rhs_int = m->TruncateInt64ToInt32(SmiUntag(rhs));
+    }
+    Node* pair = op == Token::ADD ? m->Int32AddWithOverflow(lhs_int, rhs_int)
+                                  : m->Int32SubWithOverflow(lhs_int, rhs_int);
+    m->Branch(m->Projection(1, pair), &if_numbers, &if_no_overflow);
+
+    m->Bind(&if_no_overflow);
+    Node* smi_result = m->Projection(0, pair);
+    if (SmiValuesAre32Bits()) {
+      smi_result = SmiTag(m->ChangeInt32ToInt64(smi_result));
+    }
+    results[path_count] = smi_result;
+    feedback[path_count++] = FeedbackConstant(m, Feedback::kSignedSmall);
+    m->Goto(&done);
+  } else {
+    m->Goto(&if_numbers);
+  }
+
+  m->Bind(&if_numbers);
+  Node* lhs_value = LoadNumberAsFloat64(m, lhs, &if_any);
+  Node* rhs_value = LoadNumberAsFloat64(m, rhs, &if_any);
+  Node* value = nullptr;
+  switch (op) {
+    case Token::ADD:
+      value = m->Float64Add(lhs_value, rhs_value);
+      break;
+    case Token::SUB:
+      value = m->Float64Sub(lhs_value, rhs_value);
+      break;
+    case Token::MUL:
+      value = m->Float64Mul(lhs_value, rhs_value);
+      break;
+    case Token::DIV:
+      value = m->Float64Div(lhs_value, rhs_value);
+      break;
+    case Token::MOD:
+      value = m->Float64Mod(lhs_value, rhs_value);
+      break;
+    default:
+      UNREACHABLE();
+  }
+  results[path_count] = ChangeFloat64ToSmi(m, value, &if_heap_number);
+  // A Smi result is signed small feedback only if both operands were Smis.
+  // kNumber is kSignedSmall with the next bit set, so shifting the operands'
+  // tag bit into that position selects between the two.
+  STATIC_ASSERT(static_cast<int>(Feedback::kNumber) ==
+                (static_cast<int>(Feedback::kSignedSmall) | 0x2));
+  Node* number_bit = m->WordShl(
+      SmiTagBitsOf(lhs, rhs), Int32Constant(kSmiShiftSize + kSmiTagSize + 1));
+  feedback[path_count++] =
+      m->WordOr(FeedbackConstant(m, Feedback::kSignedSmall), number_bit);
+  m->Goto(&done);
+
+  m->Bind(&if_heap_number);
+  if (kPointerSize == 8 && FLAG_inline_new) {
+    results[path_count] = AllocateHeapNumber(m, value, &if_number_runtime);
+    feedback[path_count++] = FeedbackConstant(m, Feedback::kNumber);
+    m->Goto(&done);
+  } else {
+    m->Goto(&if_number_runtime);
+  }
+
+  // The runtime allocates the HeapNumbers which can't be allocated inline.
+  m->Bind(&if_number_runtime);
+  Node* number_feedback = FeedbackConstant(m, Feedback::kNumber);
+  m->Goto(&if_runtime);
+
+  m->Bind(&if_any);
+  Node* any_feedback = FeedbackConstant(m, Feedback::kAny);
+  m->Goto(&if_runtime);
+
+  m->Bind(&if_runtime);
+  results[path_count] = CallRuntime(function_id, lhs, rhs);
+  feedback[path_count++] =
+      m->Phi(kMachAnyTagged, number_feedback, any_feedback);
+  m->Goto(&done);
+
+  m->Bind(&done);
+  Node* result = m->NewNode(m->common()->Phi(kMachAnyTagged, path_count),
+                            path_count, results);
+  RecordBinaryOpFeedback(
+      m->NewNode(m->common()->Phi(kMachAnyTagged, path_count), path_count,
+                 feedback),
+      feedback_slot);
+  return result;
+}
+
+
+void InterpreterAssembler::RecordBinaryOpFeedback(Node* feedback,
+                                                  Node* feedback_slot) {
+  RawMachineAssembler* m = raw_assembler_.get();
+  Node* vector = LoadTypeFeedbackVector();
+  Node* offset = m->IntPtrAdd(
+      IntPtrConstant(FixedArray::kHeaderSize - kHeapObjectTag),
+      m->WordShl(feedback_slot, Int32Constant(kPointerSizeLog2)));
+  Node* old_feedback = m->Load(kMachAnyTagged, vector, offset);
+
+  // Slots start out holding the uninitialized sentinel, which counts as kNone.
+  RawMachineAssembler::Label if_smi, if_uninitialized, done;
+  m->Branch(m->WordEqual(m->WordAnd(old_feedback, IntPtrConstant(kSmiTagMask)),
+                         IntPtrConstant(0)),
+            &if_smi, &if_uninitialized);
+
+  m->Bind(&if_smi);
+  m->Goto(&done);
+
+  m->Bind(&if_uninitialized);
+  Node* no_feedback =
+      FeedbackConstant(m, interpreter::BinaryOperationFeedback::kNone);
+  m->Goto(&done);
+
+  m->Bind(&done);
+  // Smis are not tracked by the write barrier.
+  m->Store(kMachAnyTagged, vector, offset,
+           m->WordOr(m->Phi(kMachAnyTagged, old_feedback, no_feedback),
+                     feedback));
+}
+
+
+void InterpreterAssembler::UpdateInterruptBudgetOnReturn() {
+  // There are no jumps yet, so the offset of the current bytecode is the
+  // amount of bytecode executed by this invocation.
+  Node* executed = raw_assembler_->IntPtrAdd(
+      BytecodeOffset(),
+      IntPtrConstant(1 + kHeapObjectTag - BytecodeArray::kHeaderSize));
+  if (kPointerSize == 8) {
+    executed = raw_assembler_->TruncateInt64ToInt32(executed);
+  }
+  Node* budget_offset =
+      IntPtrConstant(BytecodeArray::kInterruptBudgetOffset - kHeapObjectTag);
+  Node* old_budget = raw_assembler_->Load(
+      kMachInt32, BytecodeArrayTaggedPointer(), budget_offset);
+  Node* new_budget = raw_assembler_->Int32Sub(old_budget, executed);
+
+  RawMachineAssembler::Label if_exhausted, if_not_exhausted, done;
+  raw_assembler_->Branch(
+      raw_assembler_->Int32LessThan(new_budget, Int32Constant(0)),
+      &if_exhausted, &if_not_exhausted);
+
+  raw_assembler_->Bind(&if_exhausted);
+  // The runtime resets the budget.
+  CallRuntime(Runtime::kBytecodeBudgetInterrupt, LoadFunction());
+  raw_assembler_->Goto(&done);
+
+  raw_assembler_->Bind(&if_not_exhausted);
+  raw_assembler_->Store(kMachInt32, BytecodeArrayTaggedPointer(),
+                        budget_offset, new_budget);
+  raw_assembler_->Goto(&done);
+
+  raw_assembler_->Bind(&done);
+}
+
+
+void InterpreterAssembler::ResetBytecodeAge() {
+  raw_assembler_->Store(
+      kMachUint8, BytecodeArrayTaggedPointer(),
+      IntPtrConstant(BytecodeArray::kBytecodeAgeOffset - kHeapObjectTag),
+      Int32Constant(BytecodeArray::kNoAgeBytecodeAge));
+}
+
+
 void InterpreterAssembler::Return() {
+  if (FLAG_ignition_profile) {
+    // The bytecode after the last one stands for returning.
+    ProfileHandlerExit(
+        Int32Constant(interpreter::Interpreter::kNumberOfBytecodes));
+  }
   Node* exit_trampoline_code_object =
       HeapConstant(isolate()->builtins()->InterpreterExitTrampoline());
   // If the order of the parameters you need to change the call signature below.
@@ -307,9 +695,28 @@ Node* InterpreterAssembler::Advance(int delta) {
 
 
 void InterpreterAssembler::Dispatch() {
-  Node* new_bytecode_offset = Advance(interpreter::Bytecodes::Size(bytecode_));
+  DispatchTo(Advance(interpreter::Bytecodes::Size(bytecode_, operand_scale_)),
+             0);
+}
+
+
+void InterpreterAssembler::DispatchWide(
+    interpreter::OperandScale operand_scale) {
+  DCHECK(interpreter::Bytecodes::IsPrefixScalingBytecode(bytecode_));
+  DispatchTo(Advance(interpreter::Bytecodes::Size(bytecode_)),
+             interpreter::Bytecodes::DispatchTableOffset(operand_scale));
+}
+
+
+void InterpreterAssembler::DispatchTo(Node* new_bytecode_offset,
+                                      int dispatch_table_offset) {
   Node* target_bytecode = raw_assembler_->Load(
       kMachUint8, BytecodeArrayTaggedPointer(), new_bytecode_offset);
+  if (FLAG_ignition_profile) ProfileHandlerExit(target_bytecode);
+  if (dispatch_table_offset != 0) {
+    target_bytecode = raw_assembler_->Int32Add(
+        target_bytecode, Int32Constant(dispatch_table_offset));
+  }
 
   // TODO(rmcilroy): Create a code target dispatch table to avoid conversion
   // from code object on every dispatch.
@@ -338,6 +745,35 @@ void InterpreterAssembler::Dispatch() {
 }
 
 
+void InterpreterAssembler::ProfileHandlerEntry() {
+  Node* function = raw_assembler_->ExternalConstant(
+      ExternalReference::interpreter_profile_handler_entry_function(
+          isolate()));
+  Node* isolate_address = raw_assembler_->ExternalConstant(
+      ExternalReference::isolate_address(isolate()));
+  raw_assembler_->CallCFunction2(kMachPtr, kMachPtr, kMachPtr, function,
+                                 isolate_address, RegisterFileRawPointer());
+}
+
+
+void InterpreterAssembler::ProfileHandlerExit(Node* target_bytecode) {
+  Node* function = raw_assembler_->ExternalConstant(
+      ExternalReference::interpreter_profile_handler_exit_function(isolate()));
+  Node* isolate_address = raw_assembler_->ExternalConstant(
+      ExternalReference::isolate_address(isolate()));
+  Node* dispatch = raw_assembler_->Int32Add(
+      target_bytecode,
+      Int32Constant(interpreter::Interpreter::ProfileDispatchIndex(bytecode_,
+                                                                   0)));
+  if (kPointerSize == 8) {
+    dispatch = raw_assembler_->ChangeUint32ToUint64(dispatch);
+  }
+  raw_assembler_->CallCFunction3(kMachPtr, kMachPtr, kMachPtr, kMachPtr,
+                                 function, isolate_address, dispatch,
+                                 RegisterFileRawPointer());
+}
+
+
 void InterpreterAssembler::SetEndInput(Node* input) {
   DCHECK(!end_node_);
   end_node_ = input;
@@ -13,6 +13,7 @@
 #include "src/frames.h"
 #include "src/interpreter/bytecodes.h"
 #include "src/runtime/runtime.h"
+#include "src/token.h"
 
 namespace v8 {
 namespace internal {
@@ -33,7 +34,9 @@ class Schedule;
 class InterpreterAssembler {
  public:
   InterpreterAssembler(Isolate* isolate, Zone* zone,
-                       interpreter::Bytecode bytecode);
+                       interpreter::Bytecode bytecode,
+                       interpreter::OperandScale operand_scale =
+                           interpreter::OperandScale::kSingle);
   virtual ~InterpreterAssembler();
 
   Handle<Code> GenerateCode();
@@ -78,6 +81,14 @@ class InterpreterAssembler {
   // Load |slot_index| from the current context.
   Node* LoadContextSlot(int slot_index);
 
+  // Load from and store to the context slot at the dynamic index
+  // |slot_index| of |context|.
+  Node* LoadContextSlot(Node* context, Node* slot_index);
+  Node* StoreContextSlot(Node* context, Node* slot_index, Node* value);
+
+  // Returns the current context.
+  Node* GetContext();
+
   // Load the TypeFeedbackVector for the current function.
   Node* LoadTypeFeedbackVector();
 
@@ -88,14 +99,35 @@ class InterpreterAssembler {
                Node* arg2, Node* arg3, Node* arg4, Node* arg5);
 
   // Call runtime function.
+  Node* CallRuntime(Runtime::FunctionId function_id, Node* arg1);
   Node* CallRuntime(Runtime::FunctionId function_id, Node* arg1, Node* arg2);
 
+  // Perform the binary operation |op| inline if |lhs| and |rhs| are Smis or
+  // HeapNumbers, otherwise call the runtime function |function_id|. The
+  // interpreter::BinaryOperationFeedback for the operands is recorded in the
+  // type feedback vector at index |feedback_slot|.
+  Node* BinaryOpWithFeedback(Token::Value op, Runtime::FunctionId function_id,
+                             Node* lhs, Node* rhs, Node* feedback_slot);
+
+  // Charges the bytecode executed up to the current bytecode against the
+  // function's interrupt budget, and calls into the runtime profiler once the
+  // budget is exhausted.
+  void UpdateInterruptBudgetOnReturn();
+
+  // Marks the bytecode of the function as recently used, so that it is not
+  // flushed by the code flusher.
+  void ResetBytecodeAge();
+
   // Returns from the function.
   void Return();
 
   // Dispatch to the bytecode.
   void Dispatch();
 
+  // Dispatch to the handler for the bytecode following the current scaling
+  // prefix, with its operands scaled by |operand_scale|.
+  void DispatchWide(interpreter::OperandScale operand_scale);
+
  protected:
   // Close the graph.
   void End();
@@ -115,13 +147,25 @@ class InterpreterAssembler {
   Node* DispatchTableRawPointer();
   // Returns a tagged pointer to the current context.
   Node* ContextTaggedPointer();
+  // Loads a tagged pointer to the current function from the frame.
+  Node* LoadFunction();
 
   // Returns the offset of register |index| relative to RegisterFilePointer().
   Node* RegisterFrameOffset(Node* index);
+  // Returns the offset of context slot |slot_index| from a tagged context.
+  Node* ContextSlotOffset(Node* slot_index);
 
   Node* SmiShiftBitsConstant();
+  // Returns a word which is zero iff both |a| and |b| are Smis.
+  Node* SmiTagBitsOf(Node* a, Node* b);
+  // Joins the Smi |feedback| into the feedback vector at |feedback_slot|.
+  void RecordBinaryOpFeedback(Node* feedback, Node* feedback_slot);
   Node* BytecodeOperand(int operand_index);
   Node* BytecodeOperandSignExtended(int operand_index);
+  // Returns the offset of operand |operand_index| from the current bytecode.
+  int BytecodeOperandOffset(int operand_index);
+  // Loads a scaled operand byte by byte, since it may not be aligned.
+  Node* BytecodeOperandScaled(int operand_index, bool is_signed);
 
   Node* CallIC(CallInterfaceDescriptor descriptor, Node* target, Node** args);
   Node* CallJSBuiltin(int context_index, Node* receiver, Node** js_args,
@@ -131,15 +175,25 @@ class InterpreterAssembler {
   // update BytecodeOffset() itself.
   Node* Advance(int delta);
 
+  // Tail calls the handler at |dispatch_table_offset| + the bytecode at
+  // |new_bytecode_offset| in the dispatch table.
+  void DispatchTo(Node* new_bytecode_offset, int dispatch_table_offset);
+
   // Sets the end node of the graph.
   void SetEndInput(Node* input);
 
+  // Calls into the interpreter's profiler on entry to the handler and when it
+  // dispatches to |target_bytecode| or returns, for --ignition-profile.
+  void ProfileHandlerEntry();
+  void ProfileHandlerExit(Node* target_bytecode);
+
   // Private helpers which delegate to RawMachineAssembler.
   Isolate* isolate();
   Schedule* schedule();
   Zone* zone();
 
   interpreter::Bytecode bytecode_;
+  interpreter::OperandScale operand_scale_;
   base::SmartPointer<RawMachineAssembler> raw_assembler_;
   Node* end_node_;
   Node* accumulator_;
@@ -19,6 +19,7 @@
 #include "src/parser.h"
 #include "src/rewriter.h"
 #include "src/scopes.h"
+#include "src/type-feedback-vector-inl.h"
 
 namespace v8 {
 namespace internal {
@@ -238,25 +239,154 @@ Node* JSInliner::CreateArgumentsAdaptorFrameState(
 }
 
 
-Reduction JSInliner::Reduce(Node* node) {
-  if (node->opcode() != IrOpcode::kJSCallFunction) return NoChange();
+struct JSInliner::Candidate {
+  explicit Candidate(Handle<JSFunction> function)
+      : parse_info(&zone, function), info(&parse_info) {}
+
+  Zone zone;
+  ParseInfo parse_info;
+  CompilationInfo info;
+};
+
+
+Reduction JSInliner::ReduceCallSite(Node* node) {
+  if (mode_ != kGeneralInlining) return NoChange();
+  // The dispatch on the target uses a simplified operator, which is only
+  // lowered if the graph is typed.
+  if (!info_->is_typing_enabled()) return NoChange();
+  if (cumulative_nodes_ >= FLAG_max_inlined_nodes_cumulative) return NoChange();
+
+  // Calls inside try-blocks are not specialized. Each specialized call would
+  // need its own exceptional edge merged into the handler.
+  if (NodeProperties::IsExceptionalCall(node)) return NoChange();
 
   JSCallFunctionAccessor call(node);
-  HeapObjectMatcher match(call.jsfunction());
-  if (!match.HasValue()) return NoChange();
+  Node* target = call.jsfunction();
+  Handle<JSFunction> candidates[kMaxCallPolymorphism];
+  int candidate_count = 0;
+  bool needs_fallback;
+  if (target->opcode() == IrOpcode::kPhi) {
+    // The target is one of a small set of known closures, i.e. the call site
+    // is polymorphic but no generic fallback is needed.
+    int const value_input_count = target->op()->ValueInputCount();
+    if (value_input_count > kMaxCallPolymorphism) return NoChange();
+    for (int i = 0; i < value_input_count; ++i) {
+      HeapObjectMatcher m(target->InputAt(i));
+      if (!m.HasValue() || !m.Value()->IsJSFunction()) return NoChange();
+      candidates[candidate_count++] = Handle<JSFunction>::cast(m.Value());
+    }
+    needs_fallback = false;
+  } else {
+    // Use the closure recorded by a monomorphic CallIC, if any.
+    CallFunctionParameters const& p = CallFunctionParametersOf(node->op());
+    if (!p.feedback().IsValid()) return NoChange();
+    CallICNexus nexus(p.feedback().vector(), p.feedback().slot());
+    Object* feedback = nexus.GetFeedback();
+    if (!feedback->IsWeakCell()) return NoChange();
+    WeakCell* cell = WeakCell::cast(feedback);
+    if (cell->cleared() || !cell->value()->IsJSFunction()) return NoChange();
+    candidates[candidate_count++] =
+        handle(JSFunction::cast(cell->value()), info_->isolate());
+    needs_fallback = true;
+  }
 
-  if (!match.Value()->IsJSFunction()) return NoChange();
-  Handle<JSFunction> function = Handle<JSFunction>::cast(match.Value());
-  if (mode_ == kRestrictedInlining && !function->shared()->force_inline()) {
+  // Only specialize if every candidate will be inlined afterwards, otherwise
+  // the graph would just grow by calls that are not any faster. The parsed
+  // candidates are kept for inlining them.
+  base::SmartPointer<Candidate> parsed[kMaxCallPolymorphism];
+  int node_count = 0;
+  for (int i = 0; i < candidate_count; ++i) {
+    parsed[i].Reset(new Candidate(candidates[i]));
+    if (!CanInline(&call, candidates[i], &parsed[i]->info)) return NoChange();
+    if (!candidates[i]->shared()->force_inline()) {
+      node_count += parsed[i]->info.literal()->ast_node_count();
+    }
+  }
+  if (cumulative_nodes_ + node_count > FLAG_max_inlined_nodes_cumulative) {
+    TRACE("Not specializing call #%d:%s in %s because cumulative budget is "
+          "exhausted\n",
+          node->id(), node->op()->mnemonic(),
+          info_->shared_info()->DebugName()->ToCString().get());
     return NoChange();
   }
+  return SpecializeCallSite(node, candidates, parsed, candidate_count,
+                            needs_fallback);
+}
+
+
+Reduction JSInliner::SpecializeCallSite(
+    Node* node, Handle<JSFunction>* candidates,
+    base::SmartPointer<Candidate>* parsed, int candidate_count,
+    bool needs_fallback) {
+  DCHECK_LT(0, candidate_count);
+  DCHECK_LE(candidate_count, kMaxCallPolymorphism);
+  TRACE("Specializing call #%d:%s in %s for %d target(s)%s\n", node->id(),
+        node->op()->mnemonic(),
+        info_->shared_info()->DebugName()->ToCString().get(), candidate_count,
+        needs_fallback ? " with generic fallback" : "");
+
+  Graph* graph = jsgraph_->graph();
+  CommonOperatorBuilder* common = jsgraph_->common();
+  Node* target = NodeProperties::GetValueInput(node, 0);
+  Node* control = NodeProperties::GetControlInput(node);
+  int const call_count = candidate_count + (needs_fallback ? 1 : 0);
+  Node* calls[kMaxCallPolymorphism + 1];
+  Node* controls[kMaxCallPolymorphism + 1];
+  for (int i = 0; i < candidate_count; ++i) {
+    Node* if_match = control;
+    if (i < call_count - 1) {
+      // Dispatch on the target, the last candidate needs no check unless there
+      // is a generic fallback.
+      Node* check =
+          graph->NewNode(simplified()->ReferenceEqual(Type::Any()), target,
+                         jsgraph_->HeapConstant(candidates[i]));
+      Node* branch = graph->NewNode(common->Branch(), check, control);
+      if_match = graph->NewNode(common->IfTrue(), branch);
+      control = graph->NewNode(common->IfFalse(), branch);
+    }
+    calls[i] = graph->CloneNode(node);
+    calls[i]->ReplaceInput(0, jsgraph_->HeapConstant(candidates[i]));
+    NodeProperties::ReplaceControlInput(calls[i], if_match);
+    controls[i] = calls[i];
+  }
+  if (needs_fallback) {
+    // The generic call drops the CallIC feedback, so that it is not
+    // specialized for the same target again.
+    CallFunctionParameters const& p = CallFunctionParametersOf(node->op());
+    calls[candidate_count] = graph->CloneNode(node);
+    calls[candidate_count]->set_op(jsgraph_->javascript()->CallFunction(
+        p.arity(), p.flags(), p.language_mode(), VectorSlotPair(),
+        p.AllowTailCalls() ? ALLOW_TAIL_CALLS : NO_TAIL_CALLS));
+    NodeProperties::ReplaceControlInput(calls[candidate_count], control);
+    controls[candidate_count] = calls[candidate_count];
+  }
 
+  Node* merge = graph->NewNode(common->Merge(call_count), call_count, controls);
+  Node* inputs[kMaxCallPolymorphism + 2];
+  for (int i = 0; i < call_count; ++i) inputs[i] = calls[i];
+  inputs[call_count] = merge;
+  Node* value = graph->NewNode(common->Phi(kMachAnyTagged, call_count),
+                               call_count + 1, inputs);
+  Node* effect_phi =
+      graph->NewNode(common->EffectPhi(call_count), call_count + 1, inputs);
+  ReplaceWithValue(node, value, effect_phi, merge);
+
+  // Inline the specialized calls with constant targets.
+  for (int i = 0; i < candidate_count; ++i) {
+    Inline(calls[i], candidates[i], &parsed[i]->info);
+  }
+  return Replace(value);
+}
+
+
+bool JSInliner::CanInline(JSCallFunctionAccessor* call,
+                          Handle<JSFunction> function, CompilationInfo* info) {
   if (function->shared()->HasDebugInfo()) {
     // Function contains break points.
     TRACE("Not inlining %s into %s because callee may contain break points\n",
           function->shared()->DebugName()->ToCString().get(),
           info_->shared_info()->DebugName()->ToCString().get());
-    return NoChange();
+    return false;
   }
 
   // Disallow cross native-context inlining for now. This means that all parts
@@ -272,64 +402,98 @@ Reduction JSInliner::Reduce(Node* node) {
     TRACE("Not inlining %s into %s because of different native contexts\n",
           function->shared()->DebugName()->ToCString().get(),
           info_->shared_info()->DebugName()->ToCString().get());
-    return NoChange();
+    return false;
   }
 
   // TODO(turbofan): TranslatedState::GetAdaptedArguments() currently relies on
   // not inlining recursive functions. We might want to relax that at some
   // point.
-  for (Node* frame_state = call.frame_state();
+  for (Node* frame_state = call->frame_state();
        frame_state->opcode() == IrOpcode::kFrameState;
        frame_state = frame_state->InputAt(kFrameStateOuterStateInput)) {
-    FrameStateInfo const& info = OpParameter<FrameStateInfo>(frame_state);
+    FrameStateInfo const& frame_info = OpParameter<FrameStateInfo>(frame_state);
     Handle<SharedFunctionInfo> shared_info;
-    if (info.shared_info().ToHandle(&shared_info) &&
+    if (frame_info.shared_info().ToHandle(&shared_info) &&
         *shared_info == function->shared()) {
       TRACE("Not inlining %s into %s because call is recursive\n",
             function->shared()->DebugName()->ToCString().get(),
             info_->shared_info()->DebugName()->ToCString().get());
-      return NoChange();
+      return false;
     }
   }
 
-  Zone zone;
-  ParseInfo parse_info(&zone, function);
-  CompilationInfo info(&parse_info);
-  if (info_->is_deoptimization_enabled()) info.MarkAsDeoptimizationEnabled();
+  if (info_->is_deoptimization_enabled()) info->MarkAsDeoptimizationEnabled();
 
-  if (!Compiler::ParseAndAnalyze(info.parse_info())) {
+  if (!Compiler::ParseAndAnalyze(info->parse_info())) {
     TRACE("Not inlining %s into %s because parsing failed\n",
           function->shared()->DebugName()->ToCString().get(),
           info_->shared_info()->DebugName()->ToCString().get());
     if (info_->isolate()->has_pending_exception()) {
       info_->isolate()->clear_pending_exception();
     }
-    return NoChange();
+    return false;
   }
 
-  if (!Compiler::EnsureDeoptimizationSupport(&info)) {
+  if (!Compiler::EnsureDeoptimizationSupport(info)) {
     TRACE("Not inlining %s into %s because deoptimization support failed\n",
           function->shared()->DebugName()->ToCString().get(),
           info_->shared_info()->DebugName()->ToCString().get());
-    return NoChange();
+    return false;
   }
 
-  if (info.scope()->arguments() != NULL && is_sloppy(info.language_mode())) {
+  if (info->scope()->arguments() != NULL && is_sloppy(info->language_mode())) {
     // For now do not inline functions that use their arguments array.
     TRACE("Not inlining %s into %s because inlinee uses arguments array\n",
           function->shared()->DebugName()->ToCString().get(),
           info_->shared_info()->DebugName()->ToCString().get());
+    return false;
+  }
+
+  // In strong mode, in case of too few arguments we need to throw a TypeError
+  // so we must not inline this call.
+  if (is_strong(info->language_mode()) &&
+      call->formal_arguments() <
+          static_cast<size_t>(info->scope()->num_parameters())) {
+    return false;
+  }
+
+  return true;
+}
+
+
+Reduction JSInliner::Reduce(Node* node) {
+  if (node->opcode() != IrOpcode::kJSCallFunction) return NoChange();
+
+  JSCallFunctionAccessor call(node);
+  HeapObjectMatcher match(call.jsfunction());
+  if (!match.HasValue()) return ReduceCallSite(node);
+
+  if (!match.Value()->IsJSFunction()) return NoChange();
+  Handle<JSFunction> function = Handle<JSFunction>::cast(match.Value());
+  if (mode_ == kRestrictedInlining && !function->shared()->force_inline()) {
     return NoChange();
   }
 
+  Zone zone;
+  ParseInfo parse_info(&zone, function);
+  CompilationInfo info(&parse_info);
+  if (!CanInline(&call, function, &info)) return NoChange();
+  return Inline(node, function, &info);
+}
+
+
+Reduction JSInliner::Inline(Node* node, Handle<JSFunction> function,
+                            CompilationInfo* info) {
+  JSCallFunctionAccessor call(node);
+
   TRACE("Inlining %s into %s\n",
         function->shared()->DebugName()->ToCString().get(),
         info_->shared_info()->DebugName()->ToCString().get());
 
-  Graph graph(info.zone());
-  JSGraph jsgraph(info.isolate(), &graph, jsgraph_->common(),
+  Graph graph(info->zone());
+  JSGraph jsgraph(info->isolate(), &graph, jsgraph_->common(),
                   jsgraph_->javascript(), jsgraph_->machine());
-  AstGraphBuilder graph_builder(local_zone_, &info, &jsgraph);
+  AstGraphBuilder graph_builder(local_zone_, info, &jsgraph);
   graph_builder.CreateGraph(false);
 
   // The inlinee specializes to the context from the JSFunction object.
@@ -338,7 +502,7 @@ Reduction JSInliner::Reduce(Node* node) {
   // type feedback in the compiler.
   Node* context = jsgraph_->Constant(handle(function->context()));
 
-  CopyVisitor visitor(&graph, jsgraph_->graph(), info.zone());
+  CopyVisitor visitor(&graph, jsgraph_->graph(), info->zone());
   visitor.CopyGraph();
 
   Node* start = visitor.GetCopy(graph.start());
@@ -348,18 +512,15 @@ Reduction JSInliner::Reduce(Node* node) {
   size_t const inlinee_formal_parameters = start->op()->ValueOutputCount() - 3;
   // Insert argument adaptor frame if required.
   if (call.formal_arguments() != inlinee_formal_parameters) {
-    // In strong mode, in case of too few arguments we need to throw a
-    // TypeError so we must not inline this call.
-    if (is_strong(info.language_mode()) &&
-        call.formal_arguments() < inlinee_formal_parameters) {
-      return NoChange();
-    }
-    frame_state = CreateArgumentsAdaptorFrameState(&call, info.shared_info(),
-                                                   info.zone());
+    frame_state = CreateArgumentsAdaptorFrameState(&call, info->shared_info(),
+                                                   info->zone());
   }
 
   // Remember that we inlined this function.
-  info_->AddInlinedFunction(info.shared_info());
+  info_->AddInlinedFunction(info->shared_info());
+  if (!function->shared()->force_inline()) {
+    cumulative_nodes_ += info->literal()->ast_node_count();
+  }
 
   return InlineCall(node, context, frame_state, start, end);
 }
@@ -5,8 +5,10 @@
 #ifndef V8_COMPILER_JS_INLINING_H_
 #define V8_COMPILER_JS_INLINING_H_
 
+#include "src/base/smart-pointers.h"
 #include "src/compiler/js-graph.h"
 #include "src/compiler/graph-reducer.h"
+#include "src/compiler/simplified-operator.h"
 
 namespace v8 {
 namespace internal {
@@ -29,15 +31,46 @@ class JSInliner final : public AdvancedReducer {
         mode_(mode),
         local_zone_(local_zone),
         info_(info),
-        jsgraph_(jsgraph) {}
+        jsgraph_(jsgraph),
+        simplified_(jsgraph->zone()),
+        cumulative_nodes_(0) {}
 
   Reduction Reduce(Node* node) final;
 
  private:
+  // Maximum number of distinct targets a single call site is specialized for.
+  static const int kMaxCallPolymorphism = 4;
+
   Mode const mode_;
   Zone* local_zone_;
   CompilationInfo* info_;
   JSGraph* jsgraph_;
+  SimplifiedOperatorBuilder simplified_;
+  // AST nodes inlined so far into {info_}. Like Crankshaft's budget this counts
+  // AST nodes, since inlinees are built from their AST. It only limits call
+  // site specialization; inlining calls to constant targets is not capped.
+  int cumulative_nodes_;
+
+  SimplifiedOperatorBuilder* simplified() { return &simplified_; }
+
+  // A candidate target, parsed once for both CanInline() and Inline().
+  struct Candidate;
+
+  Reduction ReduceCallSite(Node* node);
+  // Specializes a call to a non-constant target for the known {candidates},
+  // dispatching on the target and optionally falling back to a generic call.
+  // The resulting calls have constant targets and are then inlined.
+  Reduction SpecializeCallSite(Node* node, Handle<JSFunction>* candidates,
+                               base::SmartPointer<Candidate>* parsed,
+                               int candidate_count, bool needs_fallback);
+
+  // Checks whether {function} can be inlined at {call}, leaving it parsed in
+  // {info}. The cumulative budget is left to the caller.
+  bool CanInline(JSCallFunctionAccessor* call, Handle<JSFunction> function,
+                 CompilationInfo* info);
+  // Inlines {function}, parsed in {info}, at the call {node}.
+  Reduction Inline(Node* node, Handle<JSFunction> function,
+                   CompilationInfo* info);
 
   Node* CreateArgumentsAdaptorFrameState(JSCallFunctionAccessor* call,
                                          Handle<SharedFunctionInfo> shared_info,
@@ -8,6 +8,7 @@
 
 #include "src/compiler/access-builder.h"
 #include "src/compiler/js-graph.h"
+#include "src/compiler/machine-operator.h"
 #include "src/compiler/node-matchers.h"
 #include "src/compiler/node-properties.h"
 #include "src/compiler/operator-properties.h"
@@ -18,6 +19,17 @@ namespace v8 {
 namespace internal {
 namespace compiler {
 
+// SIMD types with numeric lanes, along with the element type and number of
+// their lanes.
+#define SIMD_NUMERIC_LANE_TYPES(V)          \
+  V(Float32x4, kExternalFloat32Array, 4)  \
+  V(Int32x4, kExternalInt32Array, 4)      \
+  V(Uint32x4, kExternalUint32Array, 4)    \
+  V(Int16x8, kExternalInt16Array, 8)      \
+  V(Uint16x8, kExternalUint16Array, 8)    \
+  V(Int8x16, kExternalInt8Array, 16)      \
+  V(Uint8x16, kExternalUint8Array, 16)
+
 JSIntrinsicLowering::JSIntrinsicLowering(Editor* editor, JSGraph* jsgraph,
                                          DeoptimizationMode mode)
     : AdvancedReducer(editor),
@@ -100,6 +112,32 @@ Reduction JSIntrinsicLowering::Reduce(Node* node) {
       return ReduceThrowNotDateError(node);
     case Runtime::kInlineCallFunction:
       return ReduceCallFunction(node);
+#define SIMD_BINOP_CASES(Name, name)                                         \
+  case Runtime::kInline##Name##Add:                                          \
+    return ReduceSimd128ValueBinop(                                          \
+        node, Type::Name(jsgraph()->isolate(), graph()->zone()),             \
+        machine()->Name##Add(), factory()->name##_map());                    \
+  case Runtime::kInline##Name##Sub:                                          \
+    return ReduceSimd128ValueBinop(                                          \
+        node, Type::Name(jsgraph()->isolate(), graph()->zone()),             \
+        machine()->Name##Sub(), factory()->name##_map());                    \
+  case Runtime::kInline##Name##Mul:                                          \
+    return ReduceSimd128ValueBinop(                                          \
+        node, Type::Name(jsgraph()->isolate(), graph()->zone()),             \
+        machine()->Name##Mul(), factory()->name##_map());
+      SIMD_BINOP_CASES(Float32x4, float32x4)
+      SIMD_BINOP_CASES(Int32x4, int32x4)
+#undef SIMD_BINOP_CASES
+#define SIMD_CASES(Name, lane_type, lane_count)                             \
+  case Runtime::kInline##Name##Check:                                       \
+    return ReduceSimd128ValueCheck(                                         \
+        node, Type::Name(jsgraph()->isolate(), graph()->zone()));           \
+  case Runtime::kInline##Name##ExtractLane:                                 \
+    return ReduceSimd128ValueExtractLane(                                   \
+        node, Type::Name(jsgraph()->isolate(), graph()->zone()), lane_type, \
+        lane_count);
+      SIMD_NUMERIC_LANE_TYPES(SIMD_CASES)
+#undef SIMD_CASES
     default:
       break;
   }
@@ -315,6 +353,86 @@ Reduction JSIntrinsicLowering::ReduceSeqStringSetChar(
 }
 
 
+Reduction JSIntrinsicLowering::ReduceSimd128ValueBinop(
+    Node* node, Type* type, const OptionalOperator& op, Handle<Map> map) {
+  Node* left = NodeProperties::GetValueInput(node, 0);
+  Node* right = NodeProperties::GetValueInput(node, 1);
+  Node* effect = NodeProperties::GetEffectInput(node);
+  Node* control = NodeProperties::GetControlInput(node);
+  if (!op.IsSupported() || !NodeProperties::IsTyped(left) ||
+      !NodeProperties::GetBounds(left).upper->Is(type) ||
+      !NodeProperties::IsTyped(right) ||
+      !NodeProperties::GetBounds(right).upper->Is(type)) {
+    return NoChange();
+  }
+  // Unbox both payloads, compute the lanes in a 128-bit register and box the
+  // result into a freshly allocated value of the same type.
+  FieldAccess const access = AccessBuilder::ForSimd128ValuePayload();
+  left = effect = graph()->NewNode(simplified()->LoadField(access), left,
+                                   effect, control);
+  right = effect = graph()->NewNode(simplified()->LoadField(access), right,
+                                    effect, control);
+  Node* value = graph()->NewNode(op.op(), left, right);
+  Node* allocation = effect =
+      graph()->NewNode(simplified()->Allocate(),
+                       jsgraph()->Constant(Simd128Value::kSize), effect,
+                       control);
+  effect = graph()->NewNode(simplified()->StoreField(AccessBuilder::ForMap()),
+                            allocation, jsgraph()->Constant(map), effect,
+                            control);
+  effect = graph()->NewNode(simplified()->StoreField(access), allocation,
+                            value, effect, control);
+  NodeProperties::SetBounds(allocation, NodeProperties::GetBounds(node));
+  ReplaceWithValue(node, node, effect);
+  node->ReplaceInput(0, allocation);
+  node->ReplaceInput(1, effect);
+  node->set_op(common()->Finish(1));
+  node->TrimInputCount(2);
+  return Changed(node);
+}
+
+
+Reduction JSIntrinsicLowering::ReduceSimd128ValueCheck(Node* node,
+                                                       Type* type) {
+  Node* value = NodeProperties::GetValueInput(node, 0);
+  if (NodeProperties::IsTyped(value) &&
+      NodeProperties::GetBounds(value).upper->Is(type)) {
+    // The check cannot fail, so it is just the identity on {value}.
+    ReplaceWithValue(node, value);
+    return Replace(value);
+  }
+  return NoChange();
+}
+
+
+Reduction JSIntrinsicLowering::ReduceSimd128ValueExtractLane(
+    Node* node, Type* type, ExternalArrayType lane_type, int lane_count) {
+  Node* value = NodeProperties::GetValueInput(node, 0);
+  Node* lane = NodeProperties::GetValueInput(node, 1);
+  Node* effect = NodeProperties::GetEffectInput(node);
+  Node* control = NodeProperties::GetControlInput(node);
+  if (!NodeProperties::IsTyped(value) ||
+      !NodeProperties::GetBounds(value).upper->Is(type)) {
+    return NoChange();
+  }
+  // Only constant lanes in range can be loaded directly; everything else
+  // has to go through the runtime, which throws on invalid lanes.
+  NumberMatcher mlane(lane);
+  if (!mlane.HasValue() || mlane.Value() < 0 || mlane.Value() >= lane_count ||
+      mlane.Value() != static_cast<int>(mlane.Value())) {
+    return NoChange();
+  }
+  int index = static_cast<int>(mlane.Value());
+#if defined(V8_TARGET_BIG_ENDIAN)
+  index = lane_count - index - 1;
+#endif
+  return Change(
+      node, simplified()->LoadElement(
+                AccessBuilder::ForSimd128ValueLane(lane_type)),
+      value, jsgraph()->Constant(index), effect, control);
+}
+
+
 Reduction JSIntrinsicLowering::ReduceStringGetLength(Node* node) {
   Node* value = NodeProperties::GetValueInput(node, 0);
   Node* effect = NodeProperties::GetEffectInput(node);
@@ -595,6 +713,10 @@ CommonOperatorBuilder* JSIntrinsicLowering::common() const {
   return jsgraph()->common();
 }
 
+
+Factory* JSIntrinsicLowering::factory() const { return jsgraph()->factory(); }
+
+
 JSOperatorBuilder* JSIntrinsicLowering::javascript() const {
   return jsgraph_->javascript();
 }
@@ -11,6 +11,11 @@
 
 namespace v8 {
 namespace internal {
+
+// Forward declarations.
+class Factory;
+
+
 namespace compiler {
 
 // Forward declarations.
@@ -18,6 +23,7 @@ class CommonOperatorBuilder;
 class JSOperatorBuilder;
 class JSGraph;
 class MachineOperatorBuilder;
+class OptionalOperator;
 
 
 // Lowers certain JS-level runtime calls.
@@ -48,6 +54,13 @@ class JSIntrinsicLowering final : public AdvancedReducer {
   Reduction ReduceMathFloor(Node* node);
   Reduction ReduceMathSqrt(Node* node);
   Reduction ReduceSeqStringGetChar(Node* node, String::Encoding encoding);
+  Reduction ReduceSimd128ValueBinop(Node* node, Type* type,
+                                    const OptionalOperator& op,
+                                    Handle<Map> map);
+  Reduction ReduceSimd128ValueCheck(Node* node, Type* type);
+  Reduction ReduceSimd128ValueExtractLane(Node* node, Type* type,
+                                          ExternalArrayType lane_type,
+                                          int lane_count);
   Reduction ReduceSeqStringSetChar(Node* node, String::Encoding encoding);
   Reduction ReduceStringGetLength(Node* node);
   Reduction ReduceUnLikely(Node* node, BranchHint hint);
@@ -70,6 +83,7 @@ class JSIntrinsicLowering final : public AdvancedReducer {
   Graph* graph() const;
   JSGraph* jsgraph() const { return jsgraph_; }
   CommonOperatorBuilder* common() const;
+  Factory* factory() const;
   JSOperatorBuilder* javascript() const;
   MachineOperatorBuilder* machine() const;
   DeoptimizationMode mode() const { return mode_; }
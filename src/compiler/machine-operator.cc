@@ -169,7 +169,13 @@ CheckedStoreRepresentation CheckedStoreRepresentationOf(Operator const* op) {
   V(Float64Min, Operator::kNoProperties, 2, 0, 1)           \
   V(Float64RoundDown, Operator::kNoProperties, 1, 0, 1)     \
   V(Float64RoundTruncate, Operator::kNoProperties, 1, 0, 1) \
-  V(Float64RoundTiesAway, Operator::kNoProperties, 1, 0, 1)
+  V(Float64RoundTiesAway, Operator::kNoProperties, 1, 0, 1) \
+  V(Float32x4Add, Operator::kCommutative, 2, 0, 1)          \
+  V(Float32x4Sub, Operator::kNoProperties, 2, 0, 1)         \
+  V(Float32x4Mul, Operator::kCommutative, 2, 0, 1)          \
+  V(Int32x4Add, Operator::kCommutative, 2, 0, 1)            \
+  V(Int32x4Sub, Operator::kNoProperties, 2, 0, 1)           \
+  V(Int32x4Mul, Operator::kCommutative, 2, 0, 1)
 
 
 #define MACHINE_TYPE_LIST(V) \
@@ -184,6 +190,7 @@ CheckedStoreRepresentation CheckedStoreRepresentationOf(Operator const* op) {
   V(MachInt64)               \
   V(MachUint64)              \
   V(MachAnyTagged)           \
+  V(MachSimd128)             \
   V(RepBit)                  \
   V(RepWord8)                \
   V(RepWord16)               \
@@ -117,9 +117,16 @@ class MachineOperatorBuilder final : public ZoneObject {
     kInt32DivIsSafe = 1u << 7,
     kUint32DivIsSafe = 1u << 8,
     kWord32ShiftIsSafe = 1u << 9,
+    kFloat32x4Add = 1u << 10,
+    kFloat32x4Sub = 1u << 11,
+    kFloat32x4Mul = 1u << 12,
+    kInt32x4Add = 1u << 13,
+    kInt32x4Sub = 1u << 14,
+    kInt32x4Mul = 1u << 15,
     kAllOptionalOps = kFloat32Max | kFloat32Min | kFloat64Max | kFloat64Min |
                       kFloat64RoundDown | kFloat64RoundTruncate |
-                      kFloat64RoundTiesAway
+                      kFloat64RoundTiesAway | kFloat32x4Add | kFloat32x4Sub |
+                      kFloat32x4Mul | kInt32x4Add | kInt32x4Sub | kInt32x4Mul
   };
   typedef base::Flags<Flag, unsigned> Flags;
 
@@ -247,6 +254,15 @@ class MachineOperatorBuilder final : public ZoneObject {
   const Operator* Float64InsertLowWord32();
   const Operator* Float64InsertHighWord32();
 
+  // Lane-wise arithmetic on 128-bit values (kRepSimd128), wrapping for the
+  // integer lanes.
+  const OptionalOperator Float32x4Add();
+  const OptionalOperator Float32x4Sub();
+  const OptionalOperator Float32x4Mul();
+  const OptionalOperator Int32x4Add();
+  const OptionalOperator Int32x4Sub();
+  const OptionalOperator Int32x4Mul();
+
   // load [base + index]
   const Operator* Load(LoadRepresentation rep);
 
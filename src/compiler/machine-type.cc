@@ -27,6 +27,7 @@ std::ostream& operator<<(std::ostream& os, const MachineType& type) {
   PRINT(kRepFloat32);
   PRINT(kRepFloat64);
   PRINT(kRepTagged);
+  PRINT(kRepSimd128);
 
   PRINT(kTypeBool);
   PRINT(kTypeInt32);
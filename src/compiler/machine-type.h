@@ -28,15 +28,16 @@ enum MachineType : uint16_t {
   kRepFloat32 = 1u << 5,
   kRepFloat64 = 1u << 6,
   kRepTagged = 1u << 7,
+  kRepSimd128 = 1u << 8,
 
   // Types.
-  kTypeBool = 1u << 8,
-  kTypeInt32 = 1u << 9,
-  kTypeUint32 = 1u << 10,
-  kTypeInt64 = 1u << 11,
-  kTypeUint64 = 1u << 12,
-  kTypeNumber = 1u << 13,
-  kTypeAny = 1u << 14,
+  kTypeBool = 1u << 9,
+  kTypeInt32 = 1u << 10,
+  kTypeUint32 = 1u << 11,
+  kTypeInt64 = 1u << 12,
+  kTypeUint64 = 1u << 13,
+  kTypeNumber = 1u << 14,
+  kTypeAny = 1u << 15,
 
   // Machine types.
   kMachNone = 0u,
@@ -54,7 +55,8 @@ enum MachineType : uint16_t {
   kMachIntPtr = (kPointerSize == 4) ? kMachInt32 : kMachInt64,
   kMachUintPtr = (kPointerSize == 4) ? kMachUint32 : kMachUint64,
   kMachPtr = (kPointerSize == 4) ? kRepWord32 : kRepWord64,
-  kMachAnyTagged = kRepTagged | kTypeAny
+  kMachAnyTagged = kRepTagged | kTypeAny,
+  kMachSimd128 = kRepSimd128
 };
 
 V8_INLINE size_t hash_value(MachineType type) {
@@ -68,7 +70,7 @@ typedef uint16_t MachineTypeUnion;
 // Globally useful machine types and constants.
 const MachineTypeUnion kRepMask = kRepBit | kRepWord8 | kRepWord16 |
                                   kRepWord32 | kRepWord64 | kRepFloat32 |
-                                  kRepFloat64 | kRepTagged;
+                                  kRepFloat64 | kRepTagged | kRepSimd128;
 const MachineTypeUnion kTypeMask = kTypeBool | kTypeInt32 | kTypeUint32 |
                                    kTypeInt64 | kTypeUint64 | kTypeNumber |
                                    kTypeAny;
@@ -102,6 +104,8 @@ inline int ElementSizeLog2Of(MachineType machine_type) {
       return 3;
     case kRepTagged:
       return kPointerSizeLog2;
+    case kRepSimd128:
+      return 4;
     default:
       break;
   }
@@ -121,6 +125,11 @@ inline bool IsFloatingPoint(MachineType type) {
   return rep == kRepFloat32 || rep == kRepFloat64;
 }
 
+// Values of 128-bit representation live in the floating point registers.
+inline bool IsSimd128(MachineType type) {
+  return RepresentationOf(type) == kRepSimd128;
+}
+
 typedef Signature<MachineType> MachineSignature;
 
 }  // namespace compiler
@@ -284,6 +284,12 @@
   V(Float64ExtractHighWord32)   \
   V(Float64InsertLowWord32)     \
   V(Float64InsertHighWord32)    \
+  V(Float32x4Add)               \
+  V(Float32x4Sub)               \
+  V(Float32x4Mul)               \
+  V(Int32x4Add)                 \
+  V(Int32x4Sub)                 \
+  V(Int32x4Mul)                 \
   V(LoadStackPointer)           \
   V(LoadFramePointer)           \
   V(CheckedLoad)                \
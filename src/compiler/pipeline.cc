@@ -92,7 +92,9 @@ class PipelineData {
         frame_(nullptr),
         register_allocation_zone_scope_(zone_pool_),
         register_allocation_zone_(register_allocation_zone_scope_.zone()),
-        register_allocation_data_(nullptr) {
+        register_allocation_data_(nullptr),
+        linkage_(nullptr),
+        profiler_data_(nullptr) {
     PhaseScope scope(pipeline_statistics, "init pipeline data");
     graph_ = new (graph_zone_) Graph(graph_zone_);
     source_positions_.Reset(new SourcePositionTable(graph_));
@@ -132,7 +134,9 @@ class PipelineData {
         frame_(nullptr),
         register_allocation_zone_scope_(zone_pool_),
         register_allocation_zone_(register_allocation_zone_scope_.zone()),
-        register_allocation_data_(nullptr) {}
+        register_allocation_data_(nullptr),
+        linkage_(nullptr),
+        profiler_data_(nullptr) {}
 
   // For register allocation testing entry point.
   PipelineData(ZonePool* zone_pool, CompilationInfo* info,
@@ -160,7 +164,9 @@ class PipelineData {
         frame_(nullptr),
         register_allocation_zone_scope_(zone_pool_),
         register_allocation_zone_(register_allocation_zone_scope_.zone()),
-        register_allocation_data_(nullptr) {}
+        register_allocation_data_(nullptr),
+        linkage_(nullptr),
+        profiler_data_(nullptr) {}
 
   ~PipelineData() {
     DeleteRegisterAllocationZone();
@@ -218,6 +224,24 @@ class PipelineData {
     return register_allocation_data_;
   }
 
+  Linkage* linkage() const { return linkage_; }
+  void set_linkage(Linkage* linkage) {
+    DCHECK_NULL(linkage_);
+    linkage_ = linkage;
+  }
+
+  BasicBlockProfiler::Data* profiler_data() const { return profiler_data_; }
+  void set_profiler_data(BasicBlockProfiler::Data* profiler_data) {
+    profiler_data_ = profiler_data;
+  }
+
+  std::string const& source_position_output() const {
+    return source_position_output_;
+  }
+  void set_source_position_output(std::string const& source_position_output) {
+    source_position_output_ = source_position_output;
+  }
+
   void DeleteGraphZone() {
     // Destroy objects with destructors first.
     source_positions_.Reset(nullptr);
@@ -241,6 +265,7 @@ class PipelineData {
     instruction_zone_ = nullptr;
     sequence_ = nullptr;
     frame_ = nullptr;
+    linkage_ = nullptr;
   }
 
   void DeleteRegisterAllocationZone() {
@@ -316,6 +341,12 @@ class PipelineData {
   Zone* register_allocation_zone_;
   RegisterAllocationData* register_allocation_data_;
 
+  // State carried from instruction selection over to code generation. The
+  // linkage is allocated in the instruction_zone_.
+  Linkage* linkage_;
+  BasicBlockProfiler::Data* profiler_data_;
+  std::string source_position_output_;
+
   DISALLOW_COPY_AND_ASSIGN(PipelineData);
 };
 
@@ -998,20 +1029,27 @@ void Pipeline::RunPrintAndVerify(const char* phase, bool untyped) {
 }
 
 
-Handle<Code> Pipeline::GenerateCode() {
+Pipeline::Pipeline(CompilationInfo* info) : info_(info), data_(nullptr) {}
+
+
+Pipeline::~Pipeline() {}
+
+
+bool Pipeline::CreateGraph() {
   // TODO(mstarzinger): This is just a temporary hack to make TurboFan work,
   // the correct solution is to restore the context register after invoking
   // builtins from full-codegen.
   if (Context::IsJSBuiltin(isolate()->native_context(), info()->closure())) {
-    return Handle<Code>::null();
+    return false;
   }
 
-  ZonePool zone_pool;
-  base::SmartPointer<PipelineStatistics> pipeline_statistics;
+  DCHECK_NULL(data_);
+  zone_pool_.Reset(new ZonePool());
 
   if (FLAG_turbo_stats) {
-    pipeline_statistics.Reset(new PipelineStatistics(info(), &zone_pool));
-    pipeline_statistics->BeginPhaseKind("initializing");
+    pipeline_statistics_.Reset(
+        new PipelineStatistics(info(), zone_pool_.get()));
+    pipeline_statistics_->BeginPhaseKind("initializing");
   }
 
   if (FLAG_trace_turbo) {
@@ -1039,7 +1077,9 @@ Handle<Code> Pipeline::GenerateCode() {
     }
   }
 
-  PipelineData data(&zone_pool, info(), pipeline_statistics.get());
+  owned_data_.Reset(
+      new PipelineData(zone_pool_.get(), info(), pipeline_statistics_.get()));
+  PipelineData& data = *owned_data_;
   this->data_ = &data;
 
   if (info()->is_type_feedback_enabled()) {
@@ -1065,7 +1105,7 @@ Handle<Code> Pipeline::GenerateCode() {
   }
 
   Run<GraphBuilderPhase>();
-  if (data.compilation_failed()) return Handle<Code>::null();
+  if (data.compilation_failed()) return false;
   RunPrintAndVerify("Initial untyped", true);
 
   // Perform OSR deconstruction.
@@ -1144,11 +1184,23 @@ Handle<Code> Pipeline::GenerateCode() {
   // Kill the Typer and thereby uninstall the decorator (if any).
   typer.Reset(nullptr);
 
-  return ScheduleAndGenerateCode(
+  return ScheduleAndSelectInstructions(
       Linkage::ComputeIncoming(data.instruction_zone(), info()));
 }
 
 
+bool Pipeline::OptimizeGraph() { return AllocateRegistersAndOptimizeJumps(); }
+
+
+Handle<Code> Pipeline::FinalizeCode() { return GenerateFinalCode(); }
+
+
+Handle<Code> Pipeline::GenerateCode() {
+  if (!CreateGraph() || !OptimizeGraph()) return Handle<Code>::null();
+  return FinalizeCode();
+}
+
+
 Handle<Code> Pipeline::GenerateCodeForInterpreter(
     Isolate* isolate, CallDescriptor* call_descriptor, Graph* graph,
     Schedule* schedule, const char* bytecode_name) {
@@ -1227,6 +1279,15 @@ bool Pipeline::AllocateRegistersForTesting(const RegisterConfiguration* config,
 
 Handle<Code> Pipeline::ScheduleAndGenerateCode(
     CallDescriptor* call_descriptor) {
+  if (!ScheduleAndSelectInstructions(call_descriptor) ||
+      !AllocateRegistersAndOptimizeJumps()) {
+    return Handle<Code>();
+  }
+  return GenerateFinalCode();
+}
+
+
+bool Pipeline::ScheduleAndSelectInstructions(CallDescriptor* call_descriptor) {
   PipelineData* data = this->data_;
 
   DCHECK_NOT_NULL(data->graph());
@@ -1234,17 +1295,16 @@ Handle<Code> Pipeline::ScheduleAndGenerateCode(
   if (data->schedule() == nullptr) Run<ComputeSchedulePhase>();
   TraceSchedule(data->info(), data->schedule());
 
-  BasicBlockProfiler::Data* profiler_data = NULL;
   if (FLAG_turbo_profiling) {
-    profiler_data = BasicBlockInstrumentor::Instrument(info(), data->graph(),
-                                                       data->schedule());
+    data->set_profiler_data(BasicBlockInstrumentor::Instrument(
+        info(), data->graph(), data->schedule()));
   }
 
   data->InitializeInstructionSequence();
 
   // Select and schedule instructions covering the scheduled graph.
-  Linkage linkage(call_descriptor);
-  Run<InstructionSelectionPhase>(&linkage);
+  data->set_linkage(new (data->instruction_zone()) Linkage(call_descriptor));
+  Run<InstructionSelectionPhase>(data->linkage());
 
   if (FLAG_trace_turbo && !data->MayHaveUnverifiableGraph()) {
     TurboCfgFile tcf(isolate());
@@ -1252,23 +1312,30 @@ Handle<Code> Pipeline::ScheduleAndGenerateCode(
                  data->sequence());
   }
 
-  std::ostringstream source_position_output;
   if (FLAG_trace_turbo) {
     // Output source position information before the graph is deleted.
+    std::ostringstream source_position_output;
     data_->source_positions()->Print(source_position_output);
+    data->set_source_position_output(source_position_output.str());
   }
 
   data->DeleteGraphZone();
+  return true;
+}
+
+
+bool Pipeline::AllocateRegistersAndOptimizeJumps() {
+  PipelineData* data = this->data_;
 
   BeginPhaseKind("register allocation");
 
   bool run_verifier = FLAG_turbo_verify_allocation;
   // Allocate registers.
-  AllocateRegisters(RegisterConfiguration::ArchDefault(), call_descriptor,
-                    run_verifier);
+  AllocateRegisters(RegisterConfiguration::ArchDefault(),
+                    data->linkage()->GetIncomingDescriptor(), run_verifier);
   if (data->compilation_failed()) {
     info()->AbortOptimization(kNotEnoughVirtualRegistersRegalloc);
-    return Handle<Code>();
+    return false;
   }
 
   BeginPhaseKind("code generation");
@@ -1277,16 +1344,22 @@ Handle<Code> Pipeline::ScheduleAndGenerateCode(
   if (FLAG_turbo_jt) {
     Run<JumpThreadingPhase>();
   }
+  return true;
+}
+
+
+Handle<Code> Pipeline::GenerateFinalCode() {
+  PipelineData* data = this->data_;
 
   // Generate final machine code.
-  Run<GenerateCodePhase>(&linkage);
+  Run<GenerateCodePhase>(data->linkage());
 
   Handle<Code> code = data->code();
-  if (profiler_data != NULL) {
+  if (data->profiler_data() != NULL) {
 #if ENABLE_DISASSEMBLER
     std::ostringstream os;
     code->Disassemble(NULL, os);
-    profiler_data->SetCode(&os);
+    data->profiler_data()->SetCode(&os);
 #endif
   }
 
@@ -1309,7 +1382,7 @@ Handle<Code> Pipeline::ScheduleAndGenerateCode(
 #endif  // ENABLE_DISASSEMBLER
       json_of << "\"}\n],\n";
       json_of << "\"nodePositions\":";
-      json_of << source_position_output.str();
+      json_of << data->source_position_output();
       json_of << "}";
       fclose(json_file);
     }
@@ -1352,6 +1425,8 @@ void Pipeline::AllocateRegisters(const RegisterConfiguration* config,
   Run<ResolvePhisPhase>();
   Run<BuildLiveRangesPhase>();
   if (FLAG_trace_turbo_graph) {
+    // Printing constants dereferences handles, even on the concurrent thread.
+    AllowHandleDereference allow_deref;
     OFStream os(stdout);
     PrintableInstructionSequence printable = {config, data->sequence()};
     os << "----- Instruction sequence before register allocation -----\n"
@@ -1393,6 +1468,7 @@ void Pipeline::AllocateRegisters(const RegisterConfiguration* config,
   }
 
   if (FLAG_trace_turbo_graph) {
+    AllowHandleDereference allow_deref;
     OFStream os(stdout);
     PrintableInstructionSequence printable = {config, data->sequence()};
     os << "----- Instruction sequence after register allocation -----\n"
@@ -18,16 +18,31 @@ class Graph;
 class InstructionSequence;
 class Linkage;
 class PipelineData;
+class PipelineStatistics;
 class RegisterConfiguration;
 class Schedule;
+class ZonePool;
 
 class Pipeline {
  public:
-  explicit Pipeline(CompilationInfo* info) : info_(info) {}
+  explicit Pipeline(CompilationInfo* info);
+  ~Pipeline();
 
   // Run the entire pipeline and generate a handle to a code object.
   Handle<Code> GenerateCode();
 
+  // Run the same pipeline as {GenerateCode} in three separate steps, so that
+  // concurrent recompilation can perform the middle one off the main thread.
+  // {CreateGraph} builds, lowers and schedules the graph and selects
+  // instructions; it accesses the heap and must run on the main thread.
+  // {OptimizeGraph} allocates registers and threads jumps; it does not touch
+  // the heap and may run on any thread. {FinalizeCode} assembles the code
+  // object on the main thread. A step fails if compilation was aborted, in
+  // which case the remaining steps must not be run.
+  bool CreateGraph();
+  bool OptimizeGraph();
+  Handle<Code> FinalizeCode();
+
   // Run the pipeline on an interpreter bytecode handler machine graph and
   // generate code.
   static Handle<Code> GenerateCodeForInterpreter(
@@ -56,6 +71,12 @@ class Pipeline {
   CompilationInfo* info_;
   PipelineData* data_;
 
+  // State owned by the main entry points, which has to survive between the
+  // separate steps of a split pipeline run.
+  base::SmartPointer<ZonePool> zone_pool_;
+  base::SmartPointer<PipelineStatistics> pipeline_statistics_;
+  base::SmartPointer<PipelineData> owned_data_;
+
   // Helpers for executing pipeline phases.
   template <typename Phase>
   void Run();
@@ -68,6 +89,9 @@ class Pipeline {
   void BeginPhaseKind(const char* phase_kind);
   void RunPrintAndVerify(const char* phase, bool untyped = false);
   Handle<Code> ScheduleAndGenerateCode(CallDescriptor* call_descriptor);
+  bool ScheduleAndSelectInstructions(CallDescriptor* call_descriptor);
+  bool AllocateRegistersAndOptimizeJumps();
+  Handle<Code> GenerateFinalCode();
   void AllocateRegisters(const RegisterConfiguration* config,
                          CallDescriptor* descriptor, bool run_verifier);
 };
@@ -123,8 +123,9 @@ class RawMachineAssembler {
   Node* Store(MachineType rep, Node* base, Node* value) {
     return Store(rep, base, IntPtrConstant(0), value);
   }
-  Node* Store(MachineType rep, Node* base, Node* index, Node* value) {
-    return NewNode(machine()->Store(StoreRepresentation(rep, kNoWriteBarrier)),
+  Node* Store(MachineType rep, Node* base, Node* index, Node* value,
+              WriteBarrierKind write_barrier = kNoWriteBarrier) {
+    return NewNode(machine()->Store(StoreRepresentation(rep, write_barrier)),
                    base, index, value, graph()->start(), graph()->start());
   }
 
@@ -499,6 +500,10 @@ class RawMachineAssembler {
   Node* CallCFunction2(MachineType return_type, MachineType arg0_type,
                        MachineType arg1_type, Node* function, Node* arg0,
                        Node* arg1);
+  // Call to a C function with three arguments.
+  Node* CallCFunction3(MachineType return_type, MachineType arg0_type,
+                       MachineType arg1_type, MachineType arg2_type,
+                       Node* function, Node* arg0, Node* arg1, Node* arg2);
   // Call to a C function with eight arguments.
   Node* CallCFunction8(MachineType return_type, MachineType arg0_type,
                        MachineType arg1_type, MachineType arg2_type,
@@ -90,6 +90,8 @@ int GetByteWidth(MachineType machine_type) {
     case kRepWord64:
     case kRepFloat64:
       return 8;
+    case kRepSimd128:
+      return 16;
     default:
       UNREACHABLE();
       return 0;
@@ -294,6 +296,7 @@ RegisterKind LiveRange::kind() const {
   switch (RepresentationOf(machine_type())) {
     case kRepFloat32:
     case kRepFloat64:
+    case kRepSimd128:
       return DOUBLE_REGISTERS;
     default:
       break;
@@ -1128,9 +1131,10 @@ bool SpillRange::IsIntersectingWith(SpillRange* other) const {
 
 
 bool SpillRange::TryMerge(SpillRange* other) {
-  // TODO(dcarney): byte widths should be compared here not kinds.
+  // 128-bit values share the register kind with float64 values, so the slot
+  // widths must match as well.
   if (live_ranges_[0]->kind() != other->live_ranges_[0]->kind() ||
-      IsIntersectingWith(other)) {
+      ByteWidth() != other->ByteWidth() || IsIntersectingWith(other)) {
     return false;
   }
 
@@ -1468,8 +1472,9 @@ InstructionOperand* ConstraintBuilder::AllocateFixed(
   }
   if (operand->HasFixedSlotPolicy()) {
     AllocatedOperand::AllocatedKind kind =
-        IsFloatingPoint(machine_type) ? AllocatedOperand::DOUBLE_STACK_SLOT
-                                      : AllocatedOperand::STACK_SLOT;
+        IsFloatingPoint(machine_type) || IsSimd128(machine_type)
+            ? AllocatedOperand::DOUBLE_STACK_SLOT
+            : AllocatedOperand::STACK_SLOT;
     allocated =
         AllocatedOperand(kind, machine_type, operand->fixed_slot_index());
   } else if (operand->HasFixedRegisterPolicy()) {
@@ -408,7 +408,7 @@ class LiveRange : public ZoneObject {
 
   typedef BitField<bool, 0, 1> SpilledField;
   typedef BitField<int32_t, 6, 6> AssignedRegisterField;
-  typedef BitField<MachineType, 12, 15> MachineTypeField;
+  typedef BitField<MachineType, 12, 16> MachineTypeField;
 
   // Unique among children and splinters of the same virtual register.
   int relative_id_;
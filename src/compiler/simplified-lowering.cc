@@ -60,10 +60,10 @@ class RepresentationSelector {
  public:
   // Information for each node tracked during the fixpoint.
   struct NodeInfo {
-    MachineTypeUnion use : 15;     // Union of all usages for the node.
+    MachineTypeUnion use : 16;     // Union of all usages for the node.
     bool queued : 1;           // Bookkeeping for the traversal.
     bool visited : 1;          // Bookkeeping for the traversal.
-    MachineTypeUnion output : 15;  // Output type of the node.
+    MachineTypeUnion output : 16;  // Output type of the node.
   };
 
   RepresentationSelector(JSGraph* jsgraph, Zone* zone,
@@ -1064,6 +1064,13 @@ class RepresentationSelector {
       case IrOpcode::kFloat64InsertLowWord32:
       case IrOpcode::kFloat64InsertHighWord32:
         return VisitBinop(node, kMachFloat64, kMachInt32, kMachFloat64);
+      case IrOpcode::kFloat32x4Add:
+      case IrOpcode::kFloat32x4Sub:
+      case IrOpcode::kFloat32x4Mul:
+      case IrOpcode::kInt32x4Add:
+      case IrOpcode::kInt32x4Sub:
+      case IrOpcode::kInt32x4Mul:
+        return VisitBinop(node, kMachSimd128, kMachSimd128);
       case IrOpcode::kLoadStackPointer:
       case IrOpcode::kLoadFramePointer:
         return VisitLeaf(node, kMachPtr);
@@ -1480,6 +1480,29 @@ Bounds Typer::Visitor::TypeJSCallRuntime(Node* node) {
       return Bounds(Type::None(), Type::Range(0, String::kMaxLength, zone()));
     case Runtime::kInlineToObject:
       return Bounds(Type::None(), Type::Receiver());
+#define SIMD_RESULT_CASES(Name, lane_type)                                 \
+  case Runtime::kCreate##Name:                                             \
+  case Runtime::k##Name##Check:                                            \
+  case Runtime::kInline##Name##Check:                                      \
+  case Runtime::k##Name##ReplaceLane:                                      \
+  case Runtime::k##Name##Select:                                           \
+  case Runtime::k##Name##Add:                                              \
+  case Runtime::k##Name##Sub:                                              \
+  case Runtime::k##Name##Mul:                                              \
+  case Runtime::k##Name##Min:                                              \
+  case Runtime::k##Name##Max:                                              \
+    return Bounds(Type::None(), Type::Name(isolate(), zone()));            \
+  case Runtime::k##Name##ExtractLane:                                      \
+  case Runtime::kInline##Name##ExtractLane:                                \
+    return Bounds(Type::None(), Type::lane_type());
+      SIMD_RESULT_CASES(Float32x4, Number)
+      SIMD_RESULT_CASES(Int32x4, Signed32)
+      SIMD_RESULT_CASES(Uint32x4, Unsigned32)
+      SIMD_RESULT_CASES(Int16x8, Signed32)
+      SIMD_RESULT_CASES(Uint16x8, Unsigned32)
+      SIMD_RESULT_CASES(Int8x16, Signed32)
+      SIMD_RESULT_CASES(Uint8x16, Unsigned32)
+#undef SIMD_RESULT_CASES
     default:
       break;
   }
@@ -2197,6 +2220,36 @@ Bounds Typer::Visitor::TypeFloat64InsertHighWord32(Node* node) {
 }
 
 
+Bounds Typer::Visitor::TypeFloat32x4Add(Node* node) {
+  return Bounds(Type::Internal());
+}
+
+
+Bounds Typer::Visitor::TypeFloat32x4Sub(Node* node) {
+  return Bounds(Type::Internal());
+}
+
+
+Bounds Typer::Visitor::TypeFloat32x4Mul(Node* node) {
+  return Bounds(Type::Internal());
+}
+
+
+Bounds Typer::Visitor::TypeInt32x4Add(Node* node) {
+  return Bounds(Type::Internal());
+}
+
+
+Bounds Typer::Visitor::TypeInt32x4Sub(Node* node) {
+  return Bounds(Type::Internal());
+}
+
+
+Bounds Typer::Visitor::TypeInt32x4Mul(Node* node) {
+  return Bounds(Type::Internal());
+}
+
+
 Bounds Typer::Visitor::TypeLoadStackPointer(Node* node) {
   return Bounds(Type::Internal());
 }
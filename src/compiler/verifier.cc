@@ -880,6 +880,12 @@ void Verifier::Visitor::Check(Node* node) {
     case IrOpcode::kFloat64ExtractHighWord32:
     case IrOpcode::kFloat64InsertLowWord32:
     case IrOpcode::kFloat64InsertHighWord32:
+    case IrOpcode::kFloat32x4Add:
+    case IrOpcode::kFloat32x4Sub:
+    case IrOpcode::kFloat32x4Mul:
+    case IrOpcode::kInt32x4Add:
+    case IrOpcode::kInt32x4Sub:
+    case IrOpcode::kInt32x4Mul:
     case IrOpcode::kLoadStackPointer:
     case IrOpcode::kLoadFramePointer:
     case IrOpcode::kCheckedLoad:
@@ -149,6 +149,14 @@ bool HasImmediateInput(Instruction* instr, size_t index) {
 }
 
 
+// 128-bit values share the double registers and stack slots with float64
+// values, but need full-width moves.
+bool IsSimd128Operand(InstructionOperand* op) {
+  return op->IsAllocated() &&
+         AllocatedOperand::cast(op)->machine_type() == kRepSimd128;
+}
+
+
 class OutOfLineLoadZero final : public OutOfLineCode {
  public:
   OutOfLineLoadZero(CodeGenerator* gen, Register result)
@@ -963,6 +971,26 @@ void CodeGenerator::AssembleArchInstruction(Instruction* instr) {
         __ movd(i.OutputDoubleRegister(), i.InputOperand(0));
       }
       break;
+    case kSSEFloat32x4Add:
+      __ addps(i.InputDoubleRegister(0), i.InputDoubleRegister(1));
+      break;
+    case kSSEFloat32x4Sub:
+      __ subps(i.InputDoubleRegister(0), i.InputDoubleRegister(1));
+      break;
+    case kSSEFloat32x4Mul:
+      __ mulps(i.InputDoubleRegister(0), i.InputDoubleRegister(1));
+      break;
+    case kSSEInt32x4Add:
+      __ paddd(i.InputDoubleRegister(0), i.InputDoubleRegister(1));
+      break;
+    case kSSEInt32x4Sub:
+      __ psubd(i.InputDoubleRegister(0), i.InputDoubleRegister(1));
+      break;
+    case kSSEInt32x4Mul: {
+      CpuFeatureScope sse_scope(masm(), SSE4_1);
+      __ pmulld(i.InputDoubleRegister(0), i.InputDoubleRegister(1));
+      break;
+    }
     case kAVXFloat32Cmp: {
       CpuFeatureScope avx_scope(masm(), AVX);
       if (instr->InputAt(1)->IsDoubleRegister()) {
@@ -1051,6 +1079,42 @@ void CodeGenerator::AssembleArchInstruction(Instruction* instr) {
       }
       break;
     }
+    case kAVXFloat32x4Add: {
+      CpuFeatureScope avx_scope(masm(), AVX);
+      __ vaddps(i.OutputDoubleRegister(), i.InputDoubleRegister(0),
+                i.InputDoubleRegister(1));
+      break;
+    }
+    case kAVXFloat32x4Sub: {
+      CpuFeatureScope avx_scope(masm(), AVX);
+      __ vsubps(i.OutputDoubleRegister(), i.InputDoubleRegister(0),
+                i.InputDoubleRegister(1));
+      break;
+    }
+    case kAVXFloat32x4Mul: {
+      CpuFeatureScope avx_scope(masm(), AVX);
+      __ vmulps(i.OutputDoubleRegister(), i.InputDoubleRegister(0),
+                i.InputDoubleRegister(1));
+      break;
+    }
+    case kAVXInt32x4Add: {
+      CpuFeatureScope avx_scope(masm(), AVX);
+      __ vpaddd(i.OutputDoubleRegister(), i.InputDoubleRegister(0),
+                i.InputDoubleRegister(1));
+      break;
+    }
+    case kAVXInt32x4Sub: {
+      CpuFeatureScope avx_scope(masm(), AVX);
+      __ vpsubd(i.OutputDoubleRegister(), i.InputDoubleRegister(0),
+                i.InputDoubleRegister(1));
+      break;
+    }
+    case kAVXInt32x4Mul: {
+      CpuFeatureScope avx_scope(masm(), AVX);
+      __ vpmulld(i.OutputDoubleRegister(), i.InputDoubleRegister(0),
+                 i.InputDoubleRegister(1));
+      break;
+    }
     case kAVXFloat64Abs: {
       // TODO(bmeurer): Use RIP relative 128-bit constants.
       __ pcmpeqd(kScratchDoubleReg, kScratchDoubleReg);
@@ -1171,6 +1235,15 @@ void CodeGenerator::AssembleArchInstruction(Instruction* instr) {
         __ movsd(operand, i.InputDoubleRegister(index));
       }
       break;
+    case kX64Movups:
+      if (instr->HasOutput()) {
+        __ movups(i.OutputDoubleRegister(), i.MemoryOperand());
+      } else {
+        size_t index = 0;
+        Operand operand = i.MemoryOperand(&index);
+        __ movups(operand, i.InputDoubleRegister(index));
+      }
+      break;
     case kX64Lea32: {
       AddressingMode mode = AddressingModeField::decode(instr->opcode());
       // Shorten "leal" to "addl", "subl" or "shll" if the register allocation
@@ -1690,12 +1763,25 @@ void CodeGenerator::AssembleMove(InstructionOperand* source,
     } else {
       DCHECK(destination->IsDoubleStackSlot());
       Operand dst = g.ToOperand(destination);
-      __ movsd(dst, src);
+      if (IsSimd128Operand(source)) {
+        __ movups(dst, src);
+      } else {
+        __ movsd(dst, src);
+      }
     }
   } else if (source->IsDoubleStackSlot()) {
     DCHECK(destination->IsDoubleRegister() || destination->IsDoubleStackSlot());
     Operand src = g.ToOperand(source);
-    if (destination->IsDoubleRegister()) {
+    if (IsSimd128Operand(source)) {
+      if (destination->IsDoubleRegister()) {
+        __ movups(g.ToDoubleRegister(destination), src);
+      } else {
+        // We rely on having xmm0 available as a fixed scratch register.
+        Operand dst = g.ToOperand(destination);
+        __ movups(xmm0, src);
+        __ movups(dst, xmm0);
+      }
+    } else if (destination->IsDoubleRegister()) {
       XMMRegister dst = g.ToDoubleRegister(destination);
       __ movsd(dst, src);
     } else {
@@ -1725,13 +1811,16 @@ void CodeGenerator::AssembleSwap(InstructionOperand* source,
   } else if ((source->IsStackSlot() && destination->IsStackSlot()) ||
              (source->IsDoubleStackSlot() &&
               destination->IsDoubleStackSlot())) {
-    // Memory-memory.
+    // Memory-memory, one quadword at a time.
     Register tmp = kScratchRegister;
-    Operand src = g.ToOperand(source);
-    Operand dst = g.ToOperand(destination);
-    __ movq(tmp, dst);
-    __ xchgq(tmp, src);
-    __ movq(dst, tmp);
+    int const size = IsSimd128Operand(source) ? 2 * kPointerSize : kPointerSize;
+    for (int offset = 0; offset < size; offset += kPointerSize) {
+      Operand src(g.ToOperand(source), offset);
+      Operand dst(g.ToOperand(destination), offset);
+      __ movq(tmp, dst);
+      __ xchgq(tmp, src);
+      __ movq(dst, tmp);
+    }
   } else if (source->IsDoubleRegister() && destination->IsDoubleRegister()) {
     // XMM register-register swap. We rely on having xmm0
     // available as a fixed scratch register.
@@ -1745,9 +1834,15 @@ void CodeGenerator::AssembleSwap(InstructionOperand* source,
     // available as a fixed scratch register.
     XMMRegister src = g.ToDoubleRegister(source);
     Operand dst = g.ToOperand(destination);
-    __ movsd(xmm0, src);
-    __ movsd(src, dst);
-    __ movsd(dst, xmm0);
+    if (IsSimd128Operand(source)) {
+      __ movaps(xmm0, src);
+      __ movups(src, dst);
+      __ movups(dst, xmm0);
+    } else {
+      __ movsd(xmm0, src);
+      __ movsd(src, dst);
+      __ movsd(dst, xmm0);
+    }
   } else {
     // No other combinations are possible.
     UNREACHABLE();
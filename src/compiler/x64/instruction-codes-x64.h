@@ -80,6 +80,12 @@ namespace compiler {
   V(SSEFloat64InsertLowWord32)     \
   V(SSEFloat64InsertHighWord32)    \
   V(SSEFloat64LoadLowWord32)       \
+  V(SSEFloat32x4Add)               \
+  V(SSEFloat32x4Sub)               \
+  V(SSEFloat32x4Mul)               \
+  V(SSEInt32x4Add)                 \
+  V(SSEInt32x4Sub)                 \
+  V(SSEInt32x4Mul)                 \
   V(AVXFloat32Cmp)                 \
   V(AVXFloat32Add)                 \
   V(AVXFloat32Sub)                 \
@@ -98,6 +104,12 @@ namespace compiler {
   V(AVXFloat64Neg)                 \
   V(AVXFloat32Abs)                 \
   V(AVXFloat32Neg)                 \
+  V(AVXFloat32x4Add)               \
+  V(AVXFloat32x4Sub)               \
+  V(AVXFloat32x4Mul)               \
+  V(AVXInt32x4Add)                 \
+  V(AVXInt32x4Sub)                 \
+  V(AVXInt32x4Mul)                 \
   V(X64Movsxbl)                    \
   V(X64Movzxbl)                    \
   V(X64Movb)                       \
@@ -109,6 +121,7 @@ namespace compiler {
   V(X64Movq)                       \
   V(X64Movsd)                      \
   V(X64Movss)                      \
+  V(X64Movups)                     \
   V(X64Lea32)                      \
   V(X64Lea)                        \
   V(X64Dec32)                      \
@@ -0,0 +1,269 @@
+// Copyright 2015 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/compiler/instruction-scheduler.h"
+
+namespace v8 {
+namespace internal {
+namespace compiler {
+
+bool InstructionScheduler::SchedulerSupported() { return true; }
+
+
+int InstructionScheduler::GetTargetInstructionFlags(
+    const Instruction* instr) const {
+  switch (instr->arch_opcode()) {
+    case kX64Add:
+    case kX64Add32:
+    case kX64And:
+    case kX64And32:
+    case kX64Cmp:
+    case kX64Cmp32:
+    case kX64Test:
+    case kX64Test32:
+    case kX64Or:
+    case kX64Or32:
+    case kX64Xor:
+    case kX64Xor32:
+    case kX64Sub:
+    case kX64Sub32:
+    case kX64Imul:
+    case kX64Imul32:
+    case kX64ImulHigh32:
+    case kX64UmulHigh32:
+    case kX64Idiv:
+    case kX64Idiv32:
+    case kX64Udiv:
+    case kX64Udiv32:
+    case kX64Not:
+    case kX64Not32:
+    case kX64Neg:
+    case kX64Neg32:
+    case kX64Shl:
+    case kX64Shl32:
+    case kX64Shr:
+    case kX64Shr32:
+    case kX64Sar:
+    case kX64Sar32:
+    case kX64Ror:
+    case kX64Ror32:
+    case kX64Lzcnt32:
+    case kSSEFloat32Cmp:
+    case kSSEFloat32Add:
+    case kSSEFloat32Sub:
+    case kSSEFloat32Mul:
+    case kSSEFloat32Div:
+    case kSSEFloat32Abs:
+    case kSSEFloat32Neg:
+    case kSSEFloat32Sqrt:
+    case kSSEFloat32Max:
+    case kSSEFloat32Min:
+    case kSSEFloat32ToFloat64:
+    case kSSEFloat64Cmp:
+    case kSSEFloat64Add:
+    case kSSEFloat64Sub:
+    case kSSEFloat64Mul:
+    case kSSEFloat64Div:
+    case kSSEFloat64Mod:
+    case kSSEFloat64Abs:
+    case kSSEFloat64Neg:
+    case kSSEFloat64Sqrt:
+    case kSSEFloat64Round:
+    case kSSEFloat64Max:
+    case kSSEFloat64Min:
+    case kSSEFloat64ToFloat32:
+    case kSSEFloat64ToInt32:
+    case kSSEFloat64ToUint32:
+    case kSSEInt32ToFloat64:
+    case kSSEUint32ToFloat64:
+    case kSSEFloat64ExtractLowWord32:
+    case kSSEFloat64ExtractHighWord32:
+    case kSSEFloat64InsertLowWord32:
+    case kSSEFloat64InsertHighWord32:
+    case kSSEFloat64LoadLowWord32:
+    case kSSEFloat32x4Add:
+    case kSSEFloat32x4Sub:
+    case kSSEFloat32x4Mul:
+    case kSSEInt32x4Add:
+    case kSSEInt32x4Sub:
+    case kSSEInt32x4Mul:
+    case kAVXFloat32Cmp:
+    case kAVXFloat32Add:
+    case kAVXFloat32Sub:
+    case kAVXFloat32Mul:
+    case kAVXFloat32Div:
+    case kAVXFloat32Max:
+    case kAVXFloat32Min:
+    case kAVXFloat64Cmp:
+    case kAVXFloat64Add:
+    case kAVXFloat64Sub:
+    case kAVXFloat64Mul:
+    case kAVXFloat64Div:
+    case kAVXFloat64Max:
+    case kAVXFloat64Min:
+    case kAVXFloat64Abs:
+    case kAVXFloat64Neg:
+    case kAVXFloat32Abs:
+    case kAVXFloat32Neg:
+    case kAVXFloat32x4Add:
+    case kAVXFloat32x4Sub:
+    case kAVXFloat32x4Mul:
+    case kAVXInt32x4Add:
+    case kAVXInt32x4Sub:
+    case kAVXInt32x4Mul:
+      // Operands with an addressing mode are read from memory.
+      return instr->addressing_mode() == kMode_None ? kNoOpcodeFlags
+                                                    : kIsLoadOperation;
+
+    case kX64Lea32:
+    case kX64Lea:
+    case kX64Dec32:
+    case kX64Inc32:
+      return kNoOpcodeFlags;
+
+    case kX64Movsxbl:
+    case kX64Movzxbl:
+    case kX64Movb:
+    case kX64Movsxwl:
+    case kX64Movzxwl:
+    case kX64Movw:
+    case kX64Movl:
+    case kX64Movsxlq:
+    case kX64Movq:
+    case kX64Movsd:
+    case kX64Movss:
+    case kX64Movups:
+      // Moves without an output are stores, moves with a memory operand are
+      // loads, everything else is a plain register move or extension.
+      if (!instr->HasOutput()) return kHasSideEffect;
+      return instr->addressing_mode() == kMode_None ? kNoOpcodeFlags
+                                                    : kIsLoadOperation;
+
+    case kX64StackCheck:
+      return kIsLoadOperation;
+
+    case kX64Push:
+    case kX64Poke:
+    case kX64StoreWriteBarrier:
+      return kHasSideEffect;
+
+    default:
+      // Architecture independent opcodes are handled by the caller.
+      break;
+  }
+
+  UNREACHABLE();
+  return kNoOpcodeFlags;
+}
+
+
+int InstructionScheduler::GetInstructionLatency(const Instruction* instr) {
+  // Rough latencies in cycles for recent Intel cores, loads from the L1 cache
+  // are assumed to take four cycles.
+  int const memory_latency = instr->addressing_mode() == kMode_None ? 0 : 4;
+  switch (instr->arch_opcode()) {
+    case kX64Imul:
+    case kX64Imul32:
+    case kX64ImulHigh32:
+    case kX64UmulHigh32:
+      return memory_latency + 3;
+    case kX64Idiv:
+    case kX64Idiv32:
+    case kX64Udiv:
+    case kX64Udiv32:
+      return memory_latency + 30;
+    case kSSEFloat32Add:
+    case kSSEFloat32Sub:
+    case kSSEFloat64Add:
+    case kSSEFloat64Sub:
+    case kAVXFloat32Add:
+    case kAVXFloat32Sub:
+    case kAVXFloat64Add:
+    case kAVXFloat64Sub:
+    case kSSEFloat32Max:
+    case kSSEFloat32Min:
+    case kSSEFloat64Max:
+    case kSSEFloat64Min:
+    case kAVXFloat32Max:
+    case kAVXFloat32Min:
+    case kAVXFloat64Max:
+    case kAVXFloat64Min:
+    case kSSEFloat32Cmp:
+    case kSSEFloat64Cmp:
+    case kAVXFloat32Cmp:
+    case kAVXFloat64Cmp:
+    case kSSEFloat32x4Add:
+    case kSSEFloat32x4Sub:
+    case kAVXFloat32x4Add:
+    case kAVXFloat32x4Sub:
+      return memory_latency + 3;
+    case kSSEInt32x4Add:
+    case kSSEInt32x4Sub:
+    case kAVXInt32x4Add:
+    case kAVXInt32x4Sub:
+      return memory_latency + 1;
+    case kSSEFloat32Mul:
+    case kSSEFloat64Mul:
+    case kAVXFloat32Mul:
+    case kAVXFloat64Mul:
+    case kSSEFloat32x4Mul:
+    case kAVXFloat32x4Mul:
+      return memory_latency + 5;
+    case kSSEInt32x4Mul:
+    case kAVXInt32x4Mul:
+      return memory_latency + 10;
+    case kSSEFloat32Div:
+    case kAVXFloat32Div:
+      return memory_latency + 11;
+    case kSSEFloat64Div:
+    case kAVXFloat64Div:
+      return memory_latency + 14;
+    case kSSEFloat32Sqrt:
+      return memory_latency + 13;
+    case kSSEFloat64Sqrt:
+      return memory_latency + 18;
+    case kSSEFloat64Mod:
+      return 50;
+    case kSSEFloat64Round:
+    case kSSEFloat32ToFloat64:
+    case kSSEFloat64ToFloat32:
+    case kSSEFloat64ToInt32:
+    case kSSEFloat64ToUint32:
+    case kSSEInt32ToFloat64:
+    case kSSEUint32ToFloat64:
+      return memory_latency + 5;
+    case kX64Movsxbl:
+    case kX64Movzxbl:
+    case kX64Movsxwl:
+    case kX64Movzxwl:
+    case kX64Movsxlq:
+    case kX64Movl:
+    case kX64Movq:
+    case kX64Movsd:
+    case kX64Movss:
+    case kX64Movups:
+      return instr->HasOutput() ? memory_latency + 1 : 1;
+    case kCheckedLoadInt8:
+    case kCheckedLoadUint8:
+    case kCheckedLoadInt16:
+    case kCheckedLoadUint16:
+    case kCheckedLoadWord32:
+    case kCheckedLoadWord64:
+    case kCheckedLoadFloat32:
+    case kCheckedLoadFloat64:
+      return 5;
+    case kArchTruncateDoubleToI:
+      return 6;
+    case kArchCallCFunction:
+    case kArchCallCodeObject:
+    case kArchCallJSFunction:
+      return 10;
+    default:
+      return memory_latency + 1;
+  }
+}
+
+}  // namespace compiler
+}  // namespace internal
+}  // namespace v8
@@ -120,6 +120,9 @@ void InstructionSelector::VisitLoad(Node* node) {
     case kRepFloat64:
       opcode = kX64Movsd;
       break;
+    case kRepSimd128:
+      opcode = kX64Movups;
+      break;
     case kRepBit:  // Fall through.
     case kRepWord8:
       opcode = typ == kTypeInt32 ? kX64Movsxbl : kX64Movzxbl;
@@ -185,6 +188,9 @@ void InstructionSelector::VisitStore(Node* node) {
     case kRepFloat64:
       opcode = kX64Movsd;
       break;
+    case kRepSimd128:
+      opcode = kX64Movups;
+      break;
     case kRepBit:  // Fall through.
     case kRepWord8:
       opcode = kX64Movb;
@@ -854,6 +860,21 @@ void VisitFloatBinop(InstructionSelector* selector, Node* node,
 }
 
 
+// Packed SSE instructions require 16-byte aligned memory operands, which spill
+// slots do not guarantee, so both inputs of a 128-bit operation are registers.
+void VisitSimd128Binop(InstructionSelector* selector, Node* node,
+                       ArchOpcode avx_opcode, ArchOpcode sse_opcode) {
+  X64OperandGenerator g(selector);
+  InstructionOperand operand0 = g.UseRegister(node->InputAt(0));
+  InstructionOperand operand1 = g.UseRegister(node->InputAt(1));
+  if (selector->IsSupported(AVX)) {
+    selector->Emit(avx_opcode, g.DefineAsRegister(node), operand0, operand1);
+  } else {
+    selector->Emit(sse_opcode, g.DefineSameAsFirst(node), operand0, operand1);
+  }
+}
+
+
 void VisitFloatUnop(InstructionSelector* selector, Node* node, Node* input,
                     ArchOpcode avx_opcode, ArchOpcode sse_opcode) {
   X64OperandGenerator g(selector);
@@ -1672,6 +1693,37 @@ void InstructionSelector::VisitFloat64InsertHighWord32(Node* node) {
 }
 
 
+void InstructionSelector::VisitFloat32x4Add(Node* node) {
+  VisitSimd128Binop(this, node, kAVXFloat32x4Add, kSSEFloat32x4Add);
+}
+
+
+void InstructionSelector::VisitFloat32x4Sub(Node* node) {
+  VisitSimd128Binop(this, node, kAVXFloat32x4Sub, kSSEFloat32x4Sub);
+}
+
+
+void InstructionSelector::VisitFloat32x4Mul(Node* node) {
+  VisitSimd128Binop(this, node, kAVXFloat32x4Mul, kSSEFloat32x4Mul);
+}
+
+
+void InstructionSelector::VisitInt32x4Add(Node* node) {
+  VisitSimd128Binop(this, node, kAVXInt32x4Add, kSSEInt32x4Add);
+}
+
+
+void InstructionSelector::VisitInt32x4Sub(Node* node) {
+  VisitSimd128Binop(this, node, kAVXInt32x4Sub, kSSEInt32x4Sub);
+}
+
+
+void InstructionSelector::VisitInt32x4Mul(Node* node) {
+  DCHECK(IsSupported(AVX) || IsSupported(SSE4_1));
+  VisitSimd128Binop(this, node, kAVXInt32x4Mul, kSSEInt32x4Mul);
+}
+
+
 // static
 MachineOperatorBuilder::Flags
 InstructionSelector::SupportedMachineOperatorFlags() {
@@ -1680,10 +1732,16 @@ InstructionSelector::SupportedMachineOperatorFlags() {
       MachineOperatorBuilder::kFloat32Min |
       MachineOperatorBuilder::kFloat64Max |
       MachineOperatorBuilder::kFloat64Min |
-      MachineOperatorBuilder::kWord32ShiftIsSafe;
+      MachineOperatorBuilder::kWord32ShiftIsSafe |
+      MachineOperatorBuilder::kFloat32x4Add |
+      MachineOperatorBuilder::kFloat32x4Sub |
+      MachineOperatorBuilder::kFloat32x4Mul |
+      MachineOperatorBuilder::kInt32x4Add |
+      MachineOperatorBuilder::kInt32x4Sub;
   if (CpuFeatures::IsSupported(SSE4_1)) {
     flags |= MachineOperatorBuilder::kFloat64RoundDown |
-             MachineOperatorBuilder::kFloat64RoundTruncate;
+             MachineOperatorBuilder::kFloat64RoundTruncate |
+             MachineOperatorBuilder::kInt32x4Mul;
   }
   return flags;
 }
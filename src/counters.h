@@ -483,7 +483,8 @@ double AggregatedMemoryHistogram<Histogram>::Aggregate(double current_ms,
   HR(gc_idle_time_limit_overshot, V8.GCIdleTimeLimit.Overshot, 0, 10000, 101) \
   HR(gc_idle_time_limit_undershot, V8.GCIdleTimeLimit.Undershot, 0, 10000,    \
      101)                                                                     \
-  HR(code_cache_reject_reason, V8.CodeCacheRejectReason, 1, 6, 6)
+  HR(code_cache_reject_reason, V8.CodeCacheRejectReason, 1, 7, 7)            \
+  HR(bytecode_flushed_kb_per_gc, V8.BytecodeFlushedKBPerGC, 0, 10000, 101)
 
 #define HISTOGRAM_TIMER_LIST(HT)                                              \
   /* Garbage collection timers. */                                            \
@@ -560,6 +561,7 @@ double AggregatedMemoryHistogram<Histogram>::Aggregate(double current_ms,
   SC(alive_after_last_gc, V8.AliveAfterLastGC)                        \
   SC(objs_since_last_young, V8.ObjsSinceLastYoung)                    \
   SC(objs_since_last_full, V8.ObjsSinceLastFull)                      \
+  SC(bytecode_bytes_flushed, V8.BytecodeBytesFlushed)                 \
   SC(string_table_capacity, V8.StringTableCapacity)                   \
   SC(number_of_symbols, V8.NumberOfSymbols)                           \
   SC(script_wrappers, V8.ScriptWrappers)                              \
@@ -571,6 +573,20 @@ double AggregatedMemoryHistogram<Histogram>::Aggregate(double current_ms,
   SC(arguments_adaptors, V8.ArgumentsAdaptors)                        \
   SC(compilation_cache_hits, V8.CompilationCacheHits)                 \
   SC(compilation_cache_misses, V8.CompilationCacheMisses)             \
+  SC(compilation_cache_script_hits, V8.CompilationCacheScriptHits)    \
+  SC(compilation_cache_script_misses,                                 \
+     V8.CompilationCacheScriptMisses)                                 \
+  SC(compilation_cache_script_evictions,                              \
+     V8.CompilationCacheScriptEvictions)                              \
+  SC(compilation_cache_eval_hits, V8.CompilationCacheEvalHits)        \
+  SC(compilation_cache_eval_misses, V8.CompilationCacheEvalMisses)    \
+  SC(compilation_cache_eval_evictions,                                \
+     V8.CompilationCacheEvalEvictions)                                \
+  SC(compilation_cache_regexp_hits, V8.CompilationCacheRegExpHits)    \
+  SC(compilation_cache_regexp_misses,                                 \
+     V8.CompilationCacheRegExpMisses)                                 \
+  SC(compilation_cache_regexp_evictions,                              \
+     V8.CompilationCacheRegExpEvictions)                              \
   SC(string_ctor_calls, V8.StringConstructorCalls)                    \
   SC(string_ctor_conversions, V8.StringConstructorConversions)        \
   SC(string_ctor_cached_number, V8.StringConstructorCachedNumber)     \
@@ -584,6 +600,8 @@ double AggregatedMemoryHistogram<Histogram>::Aggregate(double current_ms,
   SC(total_parse_size, V8.TotalParseSize)                             \
   /* Amount of source code skipped over using preparsing. */          \
   SC(total_preparse_skipped, V8.TotalPreparseSkipped)                 \
+  /* Amount of it skipped using functions preparsed in parallel. */    \
+  SC(parallel_preparse_skipped, V8.ParallelPreparseSkipped)           \
   /* Number of symbol lookups skipped using preparsing */             \
   SC(total_preparse_symbols_skipped, V8.TotalPreparseSymbolSkipped)   \
   /* Amount of compiled source code. */                               \
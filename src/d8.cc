@@ -217,6 +217,127 @@ const char* Shell::ToCString(const v8::String::Utf8Value& value) {
 }
 
 
+static FILE* FOpen(const char* path, const char* mode);
+
+
+static uint32_t HashStringForCachedData(uint32_t hash, Local<String> string) {
+  int length = string->Length();
+  uint16_t* buffer = new uint16_t[length];
+  string->Write(buffer, 0, length);
+  // FNV-1a, which is stable across runs unlike the V8 string hash.
+  for (int i = 0; i < length; i++) {
+    hash ^= buffer[i];
+    hash *= 16777619u;
+  }
+  delete[] buffer;
+  return hash;
+}
+
+
+// Files in --cache-dir start with a header that identifies the source they
+// were produced for: a magic number, the source length and a 64-bit FNV-1a
+// hash of the source. File names only carry a 32-bit hash, so this keeps a
+// collision from applying the cached data of another script.
+static const uint32_t kCachedDataFileMagic = 0xD8CAC8E0;
+static const int kCachedDataFileHeaderSize = 4;
+
+
+static void CachedDataFileHeader(Local<String> source,
+                                 uint32_t header[kCachedDataFileHeaderSize]) {
+  int length = source->Length();
+  uint16_t* buffer = new uint16_t[length];
+  source->Write(buffer, 0, length);
+  uint64_t hash = V8_UINT64_C(14695981039346656037);
+  for (int i = 0; i < length; i++) {
+    hash ^= buffer[i];
+    hash *= V8_UINT64_C(1099511628211);
+  }
+  delete[] buffer;
+  header[0] = kCachedDataFileMagic;
+  header[1] = static_cast<uint32_t>(length);
+  header[2] = static_cast<uint32_t>(hash);
+  header[3] = static_cast<uint32_t>(hash >> 32);
+}
+
+
+// Returns the file in --cache-dir that persists the cached data of a script.
+// Files are keyed by a hash of the script source and name, so editing the
+// script simply picks a different file.
+static char* CachedDataFileName(
+    Local<String> source, Local<Value> name,
+    ScriptCompiler::CompileOptions compile_options) {
+  uint32_t hash = HashStringForCachedData(2166136261u, source);
+  if (name->IsString()) {
+    hash = HashStringForCachedData(hash, Local<String>::Cast(name));
+  }
+  const char* extension =
+      compile_options == ScriptCompiler::kProduceParserCache ? ".parse"
+                                                             : ".code";
+  const char* dir = Shell::options.cache_dir;
+  size_t dir_length = strlen(dir);
+  char* file_name = new char[dir_length + 1 + 8 + strlen(extension) + 1];
+  memcpy(file_name, dir, dir_length);
+  char* cursor = file_name + dir_length;
+  *cursor++ = '/';
+  for (int shift = 28; shift >= 0; shift -= 4) {
+    *cursor++ = "0123456789abcdef"[(hash >> shift) & 0xf];
+  }
+  strcpy(cursor, extension);  // NOLINT
+  return file_name;
+}
+
+
+// Returns the cached data in the file, or NULL if there is none or the file
+// was written for a different source.
+static ScriptCompiler::CachedData* ReadCachedData(const char* file_name,
+                                                  Local<String> source) {
+  FILE* file = FOpen(file_name, "rb");
+  if (file == NULL) return NULL;
+  fseek(file, 0, SEEK_END);
+  long size = ftell(file);  // NOLINT(runtime/int)
+  rewind(file);
+  long header_size = sizeof(uint32_t) * kCachedDataFileHeaderSize;  // NOLINT
+  if (size <= header_size) {
+    fclose(file);
+    return NULL;
+  }
+  uint32_t expected_header[kCachedDataFileHeaderSize];
+  uint32_t header[kCachedDataFileHeaderSize];
+  CachedDataFileHeader(source, expected_header);
+  if (fread(header, 1, header_size, file) !=
+          static_cast<size_t>(header_size) ||
+      memcmp(header, expected_header, header_size) != 0) {
+    fclose(file);
+    return NULL;
+  }
+  size -= header_size;
+  uint8_t* data = new uint8_t[size];
+  bool ok = fread(data, 1, size, file) == static_cast<size_t>(size);
+  fclose(file);
+  if (!ok) {
+    delete[] data;
+    return NULL;
+  }
+  return new ScriptCompiler::CachedData(
+      data, static_cast<int>(size), ScriptCompiler::CachedData::BufferOwned);
+}
+
+
+static void WriteCachedData(const char* file_name, Local<String> source,
+                            const ScriptCompiler::CachedData* data) {
+  FILE* file = FOpen(file_name, "wb");
+  if (file == NULL) return;
+  uint32_t header[kCachedDataFileHeaderSize];
+  CachedDataFileHeader(source, header);
+  bool ok = fwrite(header, sizeof(header), 1, file) == 1 &&
+            fwrite(data->data, 1, data->length, file) ==
+                static_cast<size_t>(data->length);
+  fclose(file);
+  // Never leave a truncated file behind.
+  if (!ok) remove(file_name);
+}
+
+
 ScriptCompiler::CachedData* CompileForCachedData(
     Local<String> source, Local<Value> name,
     ScriptCompiler::CompileOptions compile_options) {
@@ -284,8 +405,21 @@ MaybeLocal<Script> Shell::CompileString(
                                                compile_options);
   }
 
-  ScriptCompiler::CachedData* data =
-      CompileForCachedData(source, name, compile_options);
+  // With --cache-dir, cached data is read from and written to disk so that it
+  // survives across runs. Otherwise it is produced in a separate isolate.
+  char* cache_file = NULL;
+  ScriptCompiler::CachedData* data = NULL;
+  if (options.cache_dir != NULL) {
+    cache_file = CachedDataFileName(source, name, compile_options);
+    data = ReadCachedData(cache_file, source);
+  }
+  bool from_file = data != NULL;
+  if (data == NULL) {
+    data = CompileForCachedData(source, name, compile_options);
+    if (data != NULL && cache_file != NULL) {
+      WriteCachedData(cache_file, source, data);
+    }
+  }
   ScriptCompiler::Source cached_source(source, origin, data);
   if (compile_options == ScriptCompiler::kProduceCodeCache) {
     compile_options = ScriptCompiler::kConsumeCodeCache;
@@ -300,7 +434,13 @@ MaybeLocal<Script> Shell::CompileString(
           ? ScriptCompiler::Compile(context, &cached_source, compile_options)
           : ScriptCompiler::CompileModule(context, &cached_source,
                                           compile_options);
-  CHECK(data == NULL || !data->rejected);
+  if (data != NULL && data->rejected && from_file) {
+    // The file was produced by a different V8 version or with different
+    // flags. Drop it so the next run writes fresh data.
+    remove(cache_file);
+  }
+  CHECK(data == NULL || !data->rejected || from_file);
+  delete[] cache_file;
   return result;
 }
 
@@ -326,6 +466,20 @@ bool Shell::ExecuteString(Isolate* isolate, Local<String> source,
       return false;
     }
     maybe_result = script->Run(realm);
+    if (options.cache_dir != NULL &&
+        options.compile_options == ScriptCompiler::kProduceCodeCache) {
+      // Also store the functions that were compiled while the script ran,
+      // so that the next run starts with them.
+      ScriptCompiler::CachedData* cache =
+          ScriptCompiler::CreateCodeCache(script->GetUnboundScript(), source);
+      if (cache != NULL) {
+        char* cache_file =
+            CachedDataFileName(source, name, options.compile_options);
+        WriteCachedData(cache_file, source, cache);
+        delete[] cache_file;
+        delete cache;
+      }
+    }
     EmptyMessageQueues(isolate);
     data->realm_current_ = data->realm_switch_;
   }
@@ -1922,6 +2076,9 @@ bool Shell::SetOptions(int argc, char* argv[]) {
         return false;
       }
       argv[i] = NULL;
+    } else if (strncmp(argv[i], "--cache-dir=", 12) == 0) {
+      options.cache_dir = argv[i] + 12;
+      argv[i] = NULL;
     }
   }
 
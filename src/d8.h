@@ -287,6 +287,7 @@ class ShellOptions {
         mock_arraybuffer_allocator(false),
         num_isolates(1),
         compile_options(v8::ScriptCompiler::kNoCompileOptions),
+        cache_dir(NULL),
         isolate_sources(NULL),
         icu_data_file(NULL),
         natives_blob(NULL),
@@ -314,6 +315,7 @@ class ShellOptions {
   bool mock_arraybuffer_allocator;
   int num_isolates;
   v8::ScriptCompiler::CompileOptions compile_options;
+  const char* cache_dir;
   SourceGroup* isolate_sources;
   const char* icu_data_file;
   const char* natives_blob;
@@ -8,6 +8,7 @@
 #include "src/codegen.h"
 #include "src/deoptimizer.h"
 #include "src/isolate-inl.h"
+#include "src/lazy-compile-queue.h"
 #include "src/messages.h"
 #include "src/parser.h"
 #include "src/prettyprinter.h"
@@ -639,6 +640,11 @@ Object* StackGuard::HandleInterrupts() {
     isolate_->optimizing_compile_dispatcher()->InstallOptimizedFunctions();
   }
 
+  if (CheckAndClearInterrupt(INSTALL_LAZY_CODE)) {
+    DCHECK(isolate_->lazy_compile_queue() != NULL);
+    isolate_->lazy_compile_queue()->InstallParsedFunctions();
+  }
+
   if (CheckAndClearInterrupt(API_INTERRUPT)) {
     // Callbacks must be invoked outside of ExecusionAccess lock.
     isolate_->InvokeApiInterruptCallbacks();
@@ -289,8 +289,18 @@ DEFINE_BOOL(string_slices, true, "use string slices")
 DEFINE_BOOL(ignition, false, "use ignition interpreter")
 DEFINE_IMPLICATION(ignition, vector_stores)
 DEFINE_STRING(ignition_filter, "~~", "filter for ignition interpreter")
+DEFINE_BOOL(ignition_peephole, true, "apply peephole optimizations to bytecode")
+DEFINE_BOOL(ignition_tier_up, false,
+            "optimize hot interpreted functions with TurboFan")
 DEFINE_BOOL(print_bytecode, false,
             "print bytecode generated by ignition interpreter")
+DEFINE_BOOL(ignition_sequence_stats, false,
+            "count the bytecode pairs and triples executed by ignition and "
+            "print the most frequent ones as candidates for superinstructions")
+DEFINE_BOOL(ignition_profile, false,
+            "instrument ignition bytecode handlers to count executed "
+            "bytecodes and bytecode dispatches and to time each handler")
+DEFINE_IMPLICATION(ignition_sequence_stats, ignition_profile)
 DEFINE_BOOL(trace_ignition_codegen, false,
             "trace the codegen of ignition interpreter bytecode handlers")
 
@@ -397,6 +407,8 @@ DEFINE_BOOL(block_concurrent_recompilation, false,
             "block queued jobs until released")
 DEFINE_BOOL(concurrent_osr, true, "concurrent on-stack replacement")
 DEFINE_IMPLICATION(concurrent_osr, concurrent_recompilation)
+DEFINE_INT(zone_segment_pool_size, 8 * 1024,
+           "maximum size (in KB) of the process-wide pool of zone segments")
 
 DEFINE_BOOL(omit_map_checks_for_leaf_maps, true,
             "do not emit check maps for constant values that have a leaf map, "
@@ -444,6 +456,8 @@ DEFINE_BOOL(turbo_verify_allocation, DEBUG_BOOL,
             "verify register allocation in TurboFan")
 DEFINE_BOOL(turbo_move_optimization, true, "optimize gap moves in TurboFan")
 DEFINE_BOOL(turbo_jt, true, "enable jump threading in TurboFan")
+DEFINE_BOOL(turbo_instruction_scheduling, false,
+            "enable instruction scheduling in TurboFan")
 DEFINE_BOOL(turbo_osr, true, "enable OSR in TurboFan")
 DEFINE_BOOL(turbo_try_finally, false, "enable try-finally support in TurboFan")
 DEFINE_BOOL(turbo_stress_loop_peeling, false,
@@ -559,15 +573,35 @@ DEFINE_BOOL(trace_stub_failures, false,
 DEFINE_BOOL(serialize_toplevel, true, "enable caching of toplevel scripts")
 DEFINE_BOOL(serialize_inner, true, "enable caching of inner functions")
 DEFINE_BOOL(trace_serializer, false, "print code serializer trace")
+DEFINE_BOOL(compress_code_cache, false, "compress the payload of code caches")
+DEFINE_BOOL(compress_snapshot, false,
+            "compress the payload of startup snapshots")
 
 // compiler.cc
 DEFINE_INT(min_preparse_length, 1024,
            "minimum length for automatic enable preparsing")
+DEFINE_BOOL(parallel_preparse, false,
+            "preparse top-level functions of large scripts on background "
+            "threads")
+DEFINE_INT(parallel_preparse_min_length, 256 * KB,
+           "minimum length for preparsing a script on background threads")
+DEFINE_INT(lazy_compile_profile_window, 0,
+           "record the functions of a script that are compiled lazily within "
+           "this many ms after the script (0 disables recording)")
+DEFINE_BOOL(background_lazy_compile, false,
+            "parse the functions of a compile profile on background threads "
+            "instead of along with the top-level code")
+// Generating bytecode needs the closure to check --ignition-filter.
+DEFINE_NEG_IMPLICATION(ignition, background_lazy_compile)
 DEFINE_INT(max_opt_count, 10,
            "maximum number of optimization attempts before giving up.")
 
 // compilation-cache.cc
 DEFINE_BOOL(compilation_cache, true, "enable compilation cache")
+DEFINE_BOOL(shared_code_cache, false,
+            "share the code of compiled scripts between isolates")
+DEFINE_INT(shared_code_cache_size, 64,
+           "memory budget of the shared code cache (in Mbytes)")
 
 DEFINE_BOOL(cache_prototype_transitions, true, "cache prototype transitions")
 
@@ -739,6 +773,11 @@ DEFINE_BOOL(trace_maps, false, "trace map creation")
 DEFINE_BOOL(allow_natives_syntax, false, "allow natives syntax")
 DEFINE_BOOL(trace_parse, false, "trace parsing and preparsing")
 
+// scanner.cc
+DEFINE_BOOL(simd_scanner, false,
+            "skip runs of whitespace, comment, identifier and string literal "
+            "characters in bulk, using SSE2 or AVX2 where available")
+
 // simulator-arm.cc, simulator-arm64.cc and simulator-mips.cc
 DEFINE_BOOL(trace_sim, false, "Trace simulator execution")
 DEFINE_BOOL(debug_sim, false, "Enable debugging the simulator")
@@ -814,6 +853,7 @@ DEFINE_BOOL(profile_hydrogen_code_stub_compilation, false,
 DEFINE_BOOL(predictable, false, "enable predictable mode")
 DEFINE_NEG_IMPLICATION(predictable, concurrent_recompilation)
 DEFINE_NEG_IMPLICATION(predictable, concurrent_osr)
+DEFINE_NEG_IMPLICATION(predictable, background_lazy_compile)
 DEFINE_NEG_IMPLICATION(predictable, concurrent_sweeping)
 DEFINE_NEG_IMPLICATION(predictable, parallel_compaction)
 
@@ -51,8 +51,9 @@ SIMD_ALL_TYPES(DECLARE_GLOBALS)
 
 macro DECLARE_COMMON_FUNCTIONS(NAME, TYPE, LANES)
 function NAMECheckJS(a) {
-  return %NAMECheck(a);
+  return %_NAMECheck(a);
 }
+%SetForceInlineFlag(NAMECheckJS);
 
 function NAMEToString() {
   if (typeof(this) !== 'TYPE' && %_ClassOf(this) !== 'NAME') {
@@ -91,8 +92,9 @@ function NAMEValueOf() {
 }
 
 function NAMEExtractLaneJS(instance, lane) {
-  return %NAMEExtractLane(instance, lane);
+  return %_NAMEExtractLane(instance, lane);
 }
+%SetForceInlineFlag(NAMEExtractLaneJS);
 endmacro
 
 SIMD_ALL_TYPES(DECLARE_COMMON_FUNCTIONS)
@@ -196,30 +198,37 @@ macro DECLARE_NUMERIC_FUNCTIONS(NAME, TYPE, LANES)
 function NAMEReplaceLaneJS(instance, lane, value) {
   return %NAMEReplaceLane(instance, lane, TO_NUMBER_INLINE(value));
 }
+%SetForceInlineFlag(NAMEReplaceLaneJS);
 
 function NAMESelectJS(selector, a, b) {
   return %NAMESelect(selector, a, b);
 }
+%SetForceInlineFlag(NAMESelectJS);
 
 function NAMEAddJS(a, b) {
-  return %NAMEAdd(a, b);
+  return %_NAMEAdd(a, b);
 }
+%SetForceInlineFlag(NAMEAddJS);
 
 function NAMESubJS(a, b) {
-  return %NAMESub(a, b);
+  return %_NAMESub(a, b);
 }
+%SetForceInlineFlag(NAMESubJS);
 
 function NAMEMulJS(a, b) {
-  return %NAMEMul(a, b);
+  return %_NAMEMul(a, b);
 }
+%SetForceInlineFlag(NAMEMulJS);
 
 function NAMEMinJS(a, b) {
   return %NAMEMin(a, b);
 }
+%SetForceInlineFlag(NAMEMinJS);
 
 function NAMEMaxJS(a, b) {
   return %NAMEMax(a, b);
 }
+%SetForceInlineFlag(NAMEMaxJS);
 
 function NAMEEqualJS(a, b) {
   return %NAMEEqual(a, b);
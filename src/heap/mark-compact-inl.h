@@ -94,6 +94,12 @@ void CodeFlusher::AddOptimizedCodeMap(SharedFunctionInfo* code_map_holder) {
 }
 
 
+void CodeFlusher::AddBytecodeCandidate(SharedFunctionInfo* shared_info) {
+  DCHECK(shared_info->HasBytecodeArray());
+  bytecode_candidates_.Add(shared_info);
+}
+
+
 JSFunction** CodeFlusher::GetNextCandidateSlot(JSFunction* candidate) {
   return reinterpret_cast<JSFunction**>(
       HeapObject::RawField(candidate, JSFunction::kNextFunctionLinkOffset));
@@ -981,6 +981,59 @@ void CodeFlusher::ProcessSharedFunctionInfoCandidates() {
 }
 
 
+void CodeFlusher::ProcessBytecodeCandidates() {
+  Heap* heap = isolate_->heap();
+  Code* lazy_compile = isolate_->builtins()->builtin(Builtins::kCompileLazy);
+  Code* trampoline =
+      isolate_->builtins()->builtin(Builtins::kInterpreterEntryTrampoline);
+  int flushed_bytes = 0;
+
+  for (int i = 0; i < bytecode_candidates_.length(); i++) {
+    SharedFunctionInfo* candidate = bytecode_candidates_[i];
+    // The candidate might have been added more than once, in which case it
+    // was already processed.
+    if (!candidate->HasBytecodeArray()) continue;
+
+    BytecodeArray* bytecode = candidate->bytecode_array();
+    MarkBit bytecode_mark = Marking::MarkBitFrom(bytecode);
+    if (Marking::IsWhite(bytecode_mark)) {
+      if (FLAG_trace_code_flushing) {
+        PrintF("[code-flushing clears bytecode: ");
+        candidate->ShortPrint();
+        PrintF(" - age: %d]\n", bytecode->bytecode_age());
+      }
+      flushed_bytes += bytecode->Size();
+      candidate->set_function_data(heap->undefined_value());
+      if (candidate->code() == trampoline) {
+        // Always flush the optimized code map if there is one.
+        if (!candidate->optimized_code_map()->IsSmi()) {
+          candidate->ClearOptimizedCodeMap();
+        }
+        candidate->set_code(lazy_compile);
+      }
+    } else {
+      DCHECK(Marking::IsBlack(bytecode_mark));
+    }
+
+    // The code and function data setters did not record the slots as we are
+    // in the middle of a GC cycle, so we have to do that manually.
+    Object** data_slot =
+        HeapObject::RawField(candidate, SharedFunctionInfo::kFunctionDataOffset);
+    heap->mark_compact_collector()->RecordSlot(candidate, data_slot,
+                                               *data_slot);
+    Object** code_slot =
+        HeapObject::RawField(candidate, SharedFunctionInfo::kCodeOffset);
+    heap->mark_compact_collector()->RecordSlot(candidate, code_slot,
+                                               *code_slot);
+  }
+
+  bytecode_candidates_.Clear();
+  isolate_->counters()->bytecode_flushed_kb_per_gc()->AddSample(
+      flushed_bytes / KB);
+  isolate_->counters()->bytecode_bytes_flushed()->Increment(flushed_bytes);
+}
+
+
 void CodeFlusher::ProcessOptimizedCodeMaps() {
   STATIC_ASSERT(SharedFunctionInfo::kEntryLength == 4);
 
@@ -1192,6 +1245,22 @@ void CodeFlusher::EvictSharedFunctionInfoCandidates() {
 }
 
 
+void CodeFlusher::EvictBytecodeCandidates() {
+  for (int i = 0; i < bytecode_candidates_.length(); i++) {
+    SharedFunctionInfo* candidate = bytecode_candidates_[i];
+    // Make sure previous flushing decisions are revisited.
+    isolate_->heap()->incremental_marking()->RecordWrites(candidate);
+
+    if (FLAG_trace_code_flushing) {
+      PrintF("[code-flushing abandons bytecode: ");
+      candidate->ShortPrint();
+      PrintF("]\n");
+    }
+  }
+  bytecode_candidates_.Clear();
+}
+
+
 void CodeFlusher::EvictOptimizedCodeMaps() {
   SharedFunctionInfo* holder = optimized_code_map_holder_head_;
   SharedFunctionInfo* next_holder;
@@ -1437,6 +1506,10 @@ class SharedFunctionInfoMarkingVisitor : public ObjectVisitor {
       MarkBit code_mark = Marking::MarkBitFrom(shared->code());
       collector_->MarkObject(shared->code(), code_mark);
       collector_->MarkObject(shared, shared_mark);
+      if (shared->HasBytecodeArray()) {
+        BytecodeArray* bytecode = shared->bytecode_array();
+        collector_->MarkObject(bytecode, Marking::MarkBitFrom(bytecode));
+      }
     }
   }
 
@@ -1460,6 +1533,15 @@ void MarkCompactCollector::PrepareThreadForCodeFlushing(Isolate* isolate,
       MarkCompactMarkingVisitor::MarkInlinedFunctionsCode(heap(),
                                                           frame->LookupCode());
     }
+    if (frame->is_java_script()) {
+      // Interpreted frames use the bytecode of the function.
+      SharedFunctionInfo* shared =
+          JavaScriptFrame::cast(frame)->function()->shared();
+      if (shared->HasBytecodeArray()) {
+        BytecodeArray* bytecode = shared->bytecode_array();
+        MarkObject(bytecode, Marking::MarkBitFrom(bytecode));
+      }
+    }
   }
 }
 
@@ -455,6 +455,7 @@ class CodeFlusher {
   inline void AddCandidate(SharedFunctionInfo* shared_info);
   inline void AddCandidate(JSFunction* function);
   inline void AddOptimizedCodeMap(SharedFunctionInfo* code_map_holder);
+  inline void AddBytecodeCandidate(SharedFunctionInfo* shared_info);
 
   void EvictOptimizedCodeMap(SharedFunctionInfo* code_map_holder);
   void EvictCandidate(SharedFunctionInfo* shared_info);
@@ -463,6 +464,7 @@ class CodeFlusher {
   void ProcessCandidates() {
     ProcessOptimizedCodeMaps();
     ProcessSharedFunctionInfoCandidates();
+    ProcessBytecodeCandidates();
     ProcessJSFunctionCandidates();
   }
 
@@ -470,6 +472,7 @@ class CodeFlusher {
     EvictOptimizedCodeMaps();
     EvictJSFunctionCandidates();
     EvictSharedFunctionInfoCandidates();
+    EvictBytecodeCandidates();
   }
 
   void IteratePointersToFromSpace(ObjectVisitor* v);
@@ -478,9 +481,11 @@ class CodeFlusher {
   void ProcessOptimizedCodeMaps();
   void ProcessJSFunctionCandidates();
   void ProcessSharedFunctionInfoCandidates();
+  void ProcessBytecodeCandidates();
   void EvictOptimizedCodeMaps();
   void EvictJSFunctionCandidates();
   void EvictSharedFunctionInfoCandidates();
+  void EvictBytecodeCandidates();
 
   static inline JSFunction** GetNextCandidateSlot(JSFunction* candidate);
   static inline JSFunction* GetNextCandidate(JSFunction* candidate);
@@ -505,6 +510,11 @@ class CodeFlusher {
   SharedFunctionInfo* shared_function_info_candidates_head_;
   SharedFunctionInfo* optimized_code_map_holder_head_;
 
+  // Shared function infos whose bytecode is treated weakly. There is no spare
+  // field to thread them through, as their code is the interpreter entry
+  // trampoline shared by all interpreted functions.
+  List<SharedFunctionInfo*> bytecode_candidates_;
+
   DISALLOW_COPY_AND_ASSIGN(CodeFlusher);
 };
 
@@ -462,6 +462,12 @@ void StaticMarkingVisitor<StaticVisitor>::VisitSharedFunctionInfo(
       VisitSharedFunctionInfoWeakCode(heap, object);
       return;
     }
+    if (IsFlushableBytecode(heap, shared)) {
+      collector->code_flusher()->AddBytecodeCandidate(shared);
+      // Treat the reference to the bytecode array weakly.
+      VisitSharedFunctionInfoWeakBytecode(heap, object);
+      return;
+    }
   } else {
     if (!shared->optimized_code_map()->IsSmi()) {
       // Flush optimized code map on major GCs without code flushing,
@@ -499,9 +505,18 @@ void StaticMarkingVisitor<StaticVisitor>::VisitJSFunction(Map* map,
       // Treat the reference to the code object weakly.
       VisitJSFunctionWeakCode(heap, object);
       return;
+    } else if (IsFlushableBytecode(heap, function)) {
+      // The closure points to the interpreter entry trampoline, which has to
+      // be replaced by the lazy compilation stub if the bytecode referenced
+      // from its shared function info ends up being flushed.
+      collector->code_flusher()->AddCandidate(function);
     } else {
       // Visit all unoptimized code objects to prevent flushing them.
-      StaticVisitor::MarkObject(heap, function->shared()->code());
+      SharedFunctionInfo* shared = function->shared();
+      StaticVisitor::MarkObject(heap, shared->code());
+      if (shared->HasBytecodeArray()) {
+        StaticVisitor::MarkObject(heap, shared->bytecode_array());
+      }
       if (function->code()->kind() == Code::OPTIMIZED_FUNCTION) {
         MarkInlinedFunctionsCode(heap, function->code());
       }
@@ -562,8 +577,12 @@ void StaticMarkingVisitor<StaticVisitor>::VisitJSDataView(Map* map,
 template <typename StaticVisitor>
 void StaticMarkingVisitor<StaticVisitor>::VisitBytecodeArray(
     Map* map, HeapObject* object) {
+  Heap* heap = map->GetHeap();
+  if (FLAG_age_code && !heap->isolate()->serializer_enabled()) {
+    BytecodeArray::cast(object)->MakeOlder();
+  }
   StaticVisitor::VisitPointers(
-      map->GetHeap(), object,
+      heap, object,
       HeapObject::RawField(object, BytecodeArray::kConstantPoolOffset),
       HeapObject::RawField(object, BytecodeArray::kHeaderSize));
 }
@@ -762,6 +781,87 @@ bool StaticMarkingVisitor<StaticVisitor>::IsFlushable(
 }
 
 
+template <typename StaticVisitor>
+bool StaticMarkingVisitor<StaticVisitor>::IsFlushableBytecode(
+    Heap* heap, JSFunction* function) {
+  SharedFunctionInfo* shared_info = function->shared();
+
+  // The function must have a valid context and not be a builtin.
+  if (!IsValidNonBuiltinContext(function->context())) {
+    return false;
+  }
+
+  // Closures that are optimized still refer to the bytecode through the
+  // shared function info, but do not enter the interpreter.
+  if (function->code() != shared_info->code()) {
+    return false;
+  }
+
+  return IsFlushableBytecode(heap, shared_info);
+}
+
+
+template <typename StaticVisitor>
+bool StaticMarkingVisitor<StaticVisitor>::IsFlushableBytecode(
+    Heap* heap, SharedFunctionInfo* shared_info) {
+  // Only flush bytecode for functions that are run by the interpreter.
+  if (!shared_info->HasBytecodeArray()) {
+    return false;
+  }
+
+  // Bytecode is either on stack, in compilation cache or referenced by a
+  // closure that cannot be flushed.
+  BytecodeArray* bytecode = shared_info->bytecode_array();
+  MarkBit bytecode_mark = Marking::MarkBitFrom(bytecode);
+  if (Marking::IsBlackOrGrey(bytecode_mark)) {
+    return false;
+  }
+
+  // The source code must be available, to be able to recompile the function
+  // in case we need it again.
+  if (!HasSourceCode(heap, shared_info)) {
+    return false;
+  }
+
+  // The code must still be the interpreter entry trampoline.
+  Code* trampoline = heap->isolate()->builtins()->builtin(
+      Builtins::kInterpreterEntryTrampoline);
+  if (shared_info->code() != trampoline) {
+    return false;
+  }
+
+  // Function must be lazy compilable.
+  if (!shared_info->allows_lazy_compilation()) {
+    return false;
+  }
+
+  // We do not flush bytecode for generator functions, because we don't know
+  // if there are still live activations (generator objects) on the heap.
+  if (shared_info->is_generator()) {
+    return false;
+  }
+
+  // If this is a full script wrapped in a function we do not flush the
+  // bytecode.
+  if (shared_info->is_toplevel()) {
+    return false;
+  }
+
+  // If this is a function initialized with %SetCode then the one-to-one
+  // relation between SharedFunctionInfo and its code is broken.
+  if (shared_info->dont_flush()) {
+    return false;
+  }
+
+  // Check age of bytecode. If code aging is disabled we never flush.
+  if (!FLAG_age_code || !bytecode->IsOld()) {
+    return false;
+  }
+
+  return true;
+}
+
+
 template <typename StaticVisitor>
 void StaticMarkingVisitor<StaticVisitor>::VisitSharedFunctionInfoStrongCode(
     Heap* heap, HeapObject* object) {
@@ -794,6 +894,24 @@ void StaticMarkingVisitor<StaticVisitor>::VisitSharedFunctionInfoWeakCode(
 }
 
 
+template <typename StaticVisitor>
+void StaticMarkingVisitor<StaticVisitor>::VisitSharedFunctionInfoWeakBytecode(
+    Heap* heap, HeapObject* object) {
+  Object** start_slot = HeapObject::RawField(
+      object, SharedFunctionInfo::BodyDescriptor::kStartOffset);
+  Object** end_slot =
+      HeapObject::RawField(object, SharedFunctionInfo::kFunctionDataOffset);
+  StaticVisitor::VisitPointers(heap, object, start_slot, end_slot);
+
+  // Skip visiting kFunctionDataOffset as it is treated weakly here.
+  start_slot = HeapObject::RawField(
+      object, SharedFunctionInfo::kFunctionDataOffset + kPointerSize);
+  end_slot = HeapObject::RawField(
+      object, SharedFunctionInfo::BodyDescriptor::kEndOffset);
+  StaticVisitor::VisitPointers(heap, object, start_slot, end_slot);
+}
+
+
 template <typename StaticVisitor>
 void StaticMarkingVisitor<StaticVisitor>::VisitJSFunctionStrongCode(
     Heap* heap, HeapObject* object) {
@@ -446,11 +446,16 @@ class StaticMarkingVisitor : public StaticVisitorBase {
   // Code flushing support.
   INLINE(static bool IsFlushable(Heap* heap, JSFunction* function));
   INLINE(static bool IsFlushable(Heap* heap, SharedFunctionInfo* shared_info));
+  INLINE(static bool IsFlushableBytecode(Heap* heap, JSFunction* function));
+  INLINE(static bool IsFlushableBytecode(Heap* heap,
+                                         SharedFunctionInfo* shared_info));
 
   // Helpers used by code flushing support that visit pointer fields and treat
   // references to code objects either strongly or weakly.
   static void VisitSharedFunctionInfoStrongCode(Heap* heap, HeapObject* object);
   static void VisitSharedFunctionInfoWeakCode(Heap* heap, HeapObject* object);
+  static void VisitSharedFunctionInfoWeakBytecode(Heap* heap,
+                                                  HeapObject* object);
   static void VisitJSFunctionStrongCode(Heap* heap, HeapObject* object);
   static void VisitJSFunctionWeakCode(Heap* heap, HeapObject* object);
 
@@ -4,6 +4,8 @@
 
 #include "src/interpreter/bytecode-array-builder.h"
 
+#include <algorithm>
+
 namespace v8 {
 namespace internal {
 namespace interpreter {
@@ -12,6 +14,10 @@ BytecodeArrayBuilder::BytecodeArrayBuilder(Isolate* isolate, Zone* zone)
     : isolate_(isolate),
       bytecodes_(zone),
       bytecode_generated_(false),
+      last_bytecode_start_(0),
+      last_bound_label_offset_(0),
+      source_positions_(zone),
+      pending_source_position_(RelocInfo::kNoPosition),
       constants_map_(isolate->heap(), zone),
       constants_(zone),
       parameter_count_(-1),
@@ -77,14 +83,26 @@ Handle<BytecodeArray> BytecodeArrayBuilder::ToBytecodeArray() {
 
 
 BytecodeArrayBuilder& BytecodeArrayBuilder::BinaryOperation(Token::Value binop,
-                                                            Register reg) {
-  Output(BytecodeForBinaryOperation(binop), reg.ToOperand());
+                                                            Register reg,
+                                                            int feedback_slot) {
+  if (binop == Token::Value::ADD && CanRewriteLastBytecode() &&
+      LastBytecode() == Bytecode::kLdaSmi8) {
+    // Fold the small integer literal into the addition.
+    uint32_t raw_smi = LastBytecodeOperand(0);
+    DropLastBytecode();
+    Output(Bytecode::kAddSmi8, reg.ToOperand(), raw_smi,
+           static_cast<uint32_t>(feedback_slot));
+    return *this;
+  }
+  Output(BytecodeForBinaryOperation(binop), reg.ToOperand(),
+         static_cast<uint32_t>(feedback_slot));
   return *this;
 }
 
 
 BytecodeArrayBuilder& BytecodeArrayBuilder::LoadLiteral(
     v8::internal::Smi* smi) {
+  PrepareForAccumulatorLoad();
   int32_t raw_smi = smi->value();
   if (raw_smi == 0) {
     Output(Bytecode::kLdaZero);
@@ -98,41 +116,43 @@ BytecodeArrayBuilder& BytecodeArrayBuilder::LoadLiteral(
 
 
 BytecodeArrayBuilder& BytecodeArrayBuilder::LoadLiteral(Handle<Object> object) {
+  PrepareForAccumulatorLoad();
   size_t entry = GetConstantPoolEntry(object);
-  if (FitsInByteOperand(entry)) {
-    Output(Bytecode::kLdaConstant, static_cast<uint8_t>(entry));
-  } else {
-    UNIMPLEMENTED();
-  }
+  Output(Bytecode::kLdaConstant, static_cast<uint32_t>(entry));
   return *this;
 }
 
 
 BytecodeArrayBuilder& BytecodeArrayBuilder::LoadUndefined() {
+  PrepareForAccumulatorLoad();
   Output(Bytecode::kLdaUndefined);
   return *this;
 }
 
 
 BytecodeArrayBuilder& BytecodeArrayBuilder::LoadNull() {
+  PrepareForAccumulatorLoad();
   Output(Bytecode::kLdaNull);
   return *this;
 }
 
 
 BytecodeArrayBuilder& BytecodeArrayBuilder::LoadTheHole() {
+  PrepareForAccumulatorLoad();
   Output(Bytecode::kLdaTheHole);
   return *this;
 }
 
 
 BytecodeArrayBuilder& BytecodeArrayBuilder::LoadTrue() {
+  PrepareForAccumulatorLoad();
   Output(Bytecode::kLdaTrue);
   return *this;
 }
 
 
 BytecodeArrayBuilder& BytecodeArrayBuilder::LoadFalse() {
+  PrepareForAccumulatorLoad();
   Output(Bytecode::kLdaFalse);
   return *this;
 }
@@ -140,6 +160,11 @@ BytecodeArrayBuilder& BytecodeArrayBuilder::LoadFalse() {
 
 BytecodeArrayBuilder& BytecodeArrayBuilder::LoadAccumulatorWithRegister(
     Register reg) {
+  if (CanRewriteLastBytecode() && LastBytecodeSynchronizesRegister(reg)) {
+    // The accumulator already holds the value of |reg|.
+    return *this;
+  }
+  PrepareForAccumulatorLoad();
   Output(Bytecode::kLdar, reg.ToOperand());
   return *this;
 }
@@ -147,23 +172,45 @@ BytecodeArrayBuilder& BytecodeArrayBuilder::LoadAccumulatorWithRegister(
 
 BytecodeArrayBuilder& BytecodeArrayBuilder::StoreAccumulatorInRegister(
     Register reg) {
+  if (CanRewriteLastBytecode()) {
+    if (LastBytecodeSynchronizesRegister(reg)) {
+      // |reg| already holds the value of the accumulator.
+      return *this;
+    }
+    if (LastBytecode() == Bytecode::kLdar) {
+      // Fuse the register to register copy into a superinstruction.
+      uint32_t src = LastBytecodeOperand(0);
+      DropLastBytecode();
+      Output(Bytecode::kLdarStar, src, reg.ToOperand());
+      return *this;
+    }
+  }
   Output(Bytecode::kStar, reg.ToOperand());
   return *this;
 }
 
 
+BytecodeArrayBuilder& BytecodeArrayBuilder::LoadContextSlot(int slot_index) {
+  PrepareForAccumulatorLoad();
+  Output(Bytecode::kLdaContextSlot, static_cast<uint32_t>(slot_index));
+  return *this;
+}
+
+
+BytecodeArrayBuilder& BytecodeArrayBuilder::StoreContextSlot(int slot_index) {
+  Output(Bytecode::kStaContextSlot, static_cast<uint32_t>(slot_index));
+  return *this;
+}
+
+
 BytecodeArrayBuilder& BytecodeArrayBuilder::LoadNamedProperty(
     Register object, int feedback_slot, LanguageMode language_mode) {
   if (!is_sloppy(language_mode)) {
     UNIMPLEMENTED();
   }
 
-  if (FitsInByteOperand(feedback_slot)) {
-    Output(Bytecode::kLoadIC, object.ToOperand(),
-           static_cast<uint8_t>(feedback_slot));
-  } else {
-    UNIMPLEMENTED();
-  }
+  Output(Bytecode::kLoadIC, object.ToOperand(),
+         static_cast<uint32_t>(feedback_slot));
   return *this;
 }
 
@@ -174,12 +221,8 @@ BytecodeArrayBuilder& BytecodeArrayBuilder::LoadKeyedProperty(
     UNIMPLEMENTED();
   }
 
-  if (FitsInByteOperand(feedback_slot)) {
-    Output(Bytecode::kKeyedLoadIC, object.ToOperand(),
-           static_cast<uint8_t>(feedback_slot));
-  } else {
-    UNIMPLEMENTED();
-  }
+  Output(Bytecode::kKeyedLoadIC, object.ToOperand(),
+         static_cast<uint32_t>(feedback_slot));
   return *this;
 }
 
@@ -191,12 +234,8 @@ BytecodeArrayBuilder& BytecodeArrayBuilder::StoreNamedProperty(
     UNIMPLEMENTED();
   }
 
-  if (FitsInByteOperand(feedback_slot)) {
-    Output(Bytecode::kStoreIC, object.ToOperand(), name.ToOperand(),
-           static_cast<uint8_t>(feedback_slot));
-  } else {
-    UNIMPLEMENTED();
-  }
+  Output(Bytecode::kStoreIC, object.ToOperand(), name.ToOperand(),
+         static_cast<uint32_t>(feedback_slot));
   return *this;
 }
 
@@ -208,12 +247,15 @@ BytecodeArrayBuilder& BytecodeArrayBuilder::StoreKeyedProperty(
     UNIMPLEMENTED();
   }
 
-  if (FitsInByteOperand(feedback_slot)) {
-    Output(Bytecode::kKeyedStoreIC, object.ToOperand(), key.ToOperand(),
-           static_cast<uint8_t>(feedback_slot));
-  } else {
-    UNIMPLEMENTED();
-  }
+  Output(Bytecode::kKeyedStoreIC, object.ToOperand(), key.ToOperand(),
+         static_cast<uint32_t>(feedback_slot));
+  return *this;
+}
+
+
+BytecodeArrayBuilder& BytecodeArrayBuilder::Bind(BytecodeLabel* label) {
+  label->bind_to(bytecodes_.size());
+  last_bound_label_offset_ = bytecodes_.size();
   return *this;
 }
 
@@ -224,6 +266,14 @@ BytecodeArrayBuilder& BytecodeArrayBuilder::Return() {
 }
 
 
+BytecodeArrayBuilder& BytecodeArrayBuilder::SetSourcePosition(
+    int source_position) {
+  DCHECK_NE(source_position, RelocInfo::kNoPosition);
+  pending_source_position_ = source_position;
+  return *this;
+}
+
+
 size_t BytecodeArrayBuilder::GetConstantPoolEntry(Handle<Object> object) {
   // These constants shouldn't be added to the constant pool, the should use
   // specialzed bytecodes instead.
@@ -262,7 +312,7 @@ void BytecodeArrayBuilder::ReturnTemporaryRegister(int reg_index) {
 
 
 bool BytecodeArrayBuilder::OperandIsValid(Bytecode bytecode, int operand_index,
-                                          uint8_t operand_value) const {
+                                          uint32_t operand_value) const {
   OperandType operand_type = Bytecodes::GetOperandType(bytecode, operand_index);
   switch (operand_type) {
     case OperandType::kNone:
@@ -271,7 +321,7 @@ bool BytecodeArrayBuilder::OperandIsValid(Bytecode bytecode, int operand_index,
     case OperandType::kIdx:
       return true;
     case OperandType::kReg: {
-      Register reg = Register::FromOperand(operand_value);
+      Register reg = Register::FromOperand(static_cast<int32_t>(operand_value));
       if (reg.is_parameter()) {
         int parameter_index = reg.ToParameterIndex(parameter_count_);
         return parameter_index >= 0 && parameter_index < parameter_count_;
@@ -285,41 +335,173 @@ bool BytecodeArrayBuilder::OperandIsValid(Bytecode bytecode, int operand_index,
 }
 
 
-void BytecodeArrayBuilder::Output(Bytecode bytecode, uint8_t operand0,
-                                  uint8_t operand1, uint8_t operand2) {
+bool BytecodeArrayBuilder::CanRewriteLastBytecode() const {
+  // A bound label at the current offset makes the next bytecode a jump
+  // target, which must not be merged with the bytecode before it.
+  if (!FLAG_ignition_peephole || last_bytecode_start_ >= bytecodes_.size() ||
+      last_bound_label_offset_ == bytecodes_.size()) {
+    return false;
+  }
+  if (pending_source_position_ != RelocInfo::kNoPosition) return false;
+  return source_positions_.empty() ||
+         source_positions_.back().bytecode_offset != last_bytecode_start_;
+}
+
+
+Bytecode BytecodeArrayBuilder::LastBytecode() const {
+  DCHECK(CanRewriteLastBytecode());
+  Bytecode bytecode = Bytecodes::FromByte(bytecodes_[last_bytecode_start_]);
+  if (Bytecodes::IsPrefixScalingBytecode(bytecode)) {
+    bytecode = Bytecodes::FromByte(bytecodes_[last_bytecode_start_ + 1]);
+  }
+  return bytecode;
+}
+
+
+OperandScale BytecodeArrayBuilder::LastBytecodeOperandScale() const {
+  DCHECK(CanRewriteLastBytecode());
+  Bytecode bytecode = Bytecodes::FromByte(bytecodes_[last_bytecode_start_]);
+  return Bytecodes::IsPrefixScalingBytecode(bytecode)
+             ? Bytecodes::PrefixBytecodeToOperandScale(bytecode)
+             : OperandScale::kSingle;
+}
+
+
+uint32_t BytecodeArrayBuilder::LastBytecodeOperand(int operand_index) const {
+  Bytecode bytecode = LastBytecode();
+  DCHECK_LT(operand_index, Bytecodes::NumberOfOperands(bytecode));
+  OperandScale operand_scale = LastBytecodeOperandScale();
+  size_t operand_offset = last_bytecode_start_ + 1 +
+                          operand_index * static_cast<int>(operand_scale);
+  if (operand_scale != OperandScale::kSingle) operand_offset++;
+  const uint8_t* operand_start = &bytecodes_[operand_offset];
+  if (Bytecodes::IsSignedOperandType(
+          Bytecodes::GetOperandType(bytecode, operand_index))) {
+    return static_cast<uint32_t>(
+        Bytecodes::DecodeSignedOperand(operand_start, operand_scale));
+  }
+  return Bytecodes::DecodeUnsignedOperand(operand_start, operand_scale);
+}
+
+
+bool BytecodeArrayBuilder::LastBytecodeSynchronizesRegister(
+    Register reg) const {
+  uint32_t operand = reg.ToOperand();
+  switch (LastBytecode()) {
+    case Bytecode::kLdar:
+    case Bytecode::kStar:
+      return LastBytecodeOperand(0) == operand;
+    case Bytecode::kLdarStar:
+      return LastBytecodeOperand(0) == operand ||
+             LastBytecodeOperand(1) == operand;
+    default:
+      return false;
+  }
+}
+
+
+void BytecodeArrayBuilder::DropLastBytecode() {
+  DCHECK(CanRewriteLastBytecode());
+  bytecodes_.resize(last_bytecode_start_);
+}
+
+
+void BytecodeArrayBuilder::PrepareForAccumulatorLoad() {
+  // A load without side effects whose result is overwritten by the next
+  // load is dead.
+  if (CanRewriteLastBytecode() &&
+      IsAccumulatorLoadWithoutEffects(LastBytecode())) {
+    DropLastBytecode();
+  }
+}
+
+
+// static
+bool BytecodeArrayBuilder::IsAccumulatorLoadWithoutEffects(Bytecode bytecode) {
+  switch (bytecode) {
+    case Bytecode::kLdaZero:
+    case Bytecode::kLdaSmi8:
+    case Bytecode::kLdaConstant:
+    case Bytecode::kLdaUndefined:
+    case Bytecode::kLdaNull:
+    case Bytecode::kLdaTheHole:
+    case Bytecode::kLdaTrue:
+    case Bytecode::kLdaFalse:
+    case Bytecode::kLdar:
+    case Bytecode::kLdaContextSlot:
+      return true;
+    default:
+      return false;
+  }
+}
+
+
+void BytecodeArrayBuilder::Output(Bytecode bytecode, uint32_t operand0,
+                                  uint32_t operand1, uint32_t operand2) {
   DCHECK_EQ(Bytecodes::NumberOfOperands(bytecode), 3);
   DCHECK(OperandIsValid(bytecode, 0, operand0) &&
          OperandIsValid(bytecode, 1, operand1) &&
          OperandIsValid(bytecode, 2, operand2));
-  bytecodes_.push_back(Bytecodes::ToByte(bytecode));
-  bytecodes_.push_back(operand0);
-  bytecodes_.push_back(operand1);
-  bytecodes_.push_back(operand2);
+  uint32_t operands[] = {operand0, operand1, operand2};
+  OutputScaled(bytecode, operands, 3);
 }
 
 
-void BytecodeArrayBuilder::Output(Bytecode bytecode, uint8_t operand0,
-                                  uint8_t operand1) {
+void BytecodeArrayBuilder::Output(Bytecode bytecode, uint32_t operand0,
+                                  uint32_t operand1) {
   DCHECK_EQ(Bytecodes::NumberOfOperands(bytecode), 2);
   DCHECK(OperandIsValid(bytecode, 0, operand0) &&
          OperandIsValid(bytecode, 1, operand1));
-  bytecodes_.push_back(Bytecodes::ToByte(bytecode));
-  bytecodes_.push_back(operand0);
-  bytecodes_.push_back(operand1);
+  uint32_t operands[] = {operand0, operand1};
+  OutputScaled(bytecode, operands, 2);
 }
 
 
-void BytecodeArrayBuilder::Output(Bytecode bytecode, uint8_t operand0) {
+void BytecodeArrayBuilder::Output(Bytecode bytecode, uint32_t operand0) {
   DCHECK_EQ(Bytecodes::NumberOfOperands(bytecode), 1);
   DCHECK(OperandIsValid(bytecode, 0, operand0));
-  bytecodes_.push_back(Bytecodes::ToByte(bytecode));
-  bytecodes_.push_back(operand0);
+  OutputScaled(bytecode, &operand0, 1);
 }
 
 
 void BytecodeArrayBuilder::Output(Bytecode bytecode) {
   DCHECK_EQ(Bytecodes::NumberOfOperands(bytecode), 0);
+  OutputScaled(bytecode, nullptr, 0);
+}
+
+
+void BytecodeArrayBuilder::OutputScaled(Bytecode bytecode,
+                                        const uint32_t* operands,
+                                        int operand_count) {
+  // All operands of a bytecode share the scale of the widest one.
+  OperandScale operand_scale = OperandScale::kSingle;
+  for (int i = 0; i < operand_count; i++) {
+    OperandScale scale =
+        Bytecodes::IsSignedOperandType(Bytecodes::GetOperandType(bytecode, i))
+            ? Bytecodes::ScaleForSignedOperand(
+                  static_cast<int32_t>(operands[i]))
+            : Bytecodes::ScaleForUnsignedOperand(operands[i]);
+    operand_scale = std::max(operand_scale, scale);
+  }
+
+  last_bytecode_start_ = bytecodes_.size();
+  if (pending_source_position_ != RelocInfo::kNoPosition) {
+    SourcePositionEntry entry = {last_bytecode_start_,
+                                 pending_source_position_};
+    source_positions_.push_back(entry);
+    pending_source_position_ = RelocInfo::kNoPosition;
+  }
+  if (operand_scale != OperandScale::kSingle) {
+    bytecodes_.push_back(Bytecodes::ToByte(
+        Bytecodes::OperandScaleToPrefixBytecode(operand_scale)));
+  }
   bytecodes_.push_back(Bytecodes::ToByte(bytecode));
+  for (int i = 0; i < operand_count; i++) {
+    // Operands are stored in little-endian byte order.
+    for (int j = 0; j < static_cast<int>(operand_scale); j++) {
+      bytecodes_.push_back(static_cast<uint8_t>(operands[i] >> (8 * j)));
+    }
+  }
 }
 
 
@@ -343,18 +525,6 @@ Bytecode BytecodeArrayBuilder::BytecodeForBinaryOperation(Token::Value op) {
 }
 
 
-// static
-bool BytecodeArrayBuilder::FitsInByteOperand(int value) {
-  return 0 <= value && value <= 255;
-}
-
-
-// static
-bool BytecodeArrayBuilder::FitsInByteOperand(size_t value) {
-  return value <= 255;
-}
-
-
 TemporaryRegisterScope::TemporaryRegisterScope(BytecodeArrayBuilder* builder)
     : builder_(builder), count_(0), last_register_index_(-1) {}
 
@@ -20,6 +20,7 @@ class Isolate;
 
 namespace interpreter {
 
+class BytecodeLabel;
 class Register;
 
 class BytecodeArrayBuilder {
@@ -53,6 +54,10 @@ class BytecodeArrayBuilder {
   BytecodeArrayBuilder& LoadAccumulatorWithRegister(Register reg);
   BytecodeArrayBuilder& StoreAccumulatorInRegister(Register reg);
 
+  // Context slot loads and stores. The slots are in the current context.
+  BytecodeArrayBuilder& LoadContextSlot(int slot_index);
+  BytecodeArrayBuilder& StoreContextSlot(int slot_index);
+
   // Load properties. The property name should be in the accumulator.
   BytecodeArrayBuilder& LoadNamedProperty(Register object, int feedback_slot,
                                           LanguageMode language_mode);
@@ -67,24 +72,56 @@ class BytecodeArrayBuilder {
                                            int feedback_slot,
                                            LanguageMode language_mode);
 
-  // Operators.
-  BytecodeArrayBuilder& BinaryOperation(Token::Value binop, Register reg);
+  // Operators. The feedback slot is where the handler records the operand
+  // types it has seen.
+  BytecodeArrayBuilder& BinaryOperation(Token::Value binop, Register reg,
+                                        int feedback_slot);
 
   // Flow Control.
+  BytecodeArrayBuilder& Bind(BytecodeLabel* label);
   BytecodeArrayBuilder& Return();
 
+  // Attaches |source_position| to the next bytecode. The peephole optimizer
+  // neither removes nor fuses bytecodes which carry a source position.
+  BytecodeArrayBuilder& SetSourcePosition(int source_position);
+
+  // A source position and the offset of the bytecode carrying it.
+  struct SourcePositionEntry {
+    size_t bytecode_offset;
+    int source_position;
+  };
+  const ZoneVector<SourcePositionEntry>& source_positions() const {
+    return source_positions_;
+  }
+
  private:
   static Bytecode BytecodeForBinaryOperation(Token::Value op);
-  static bool FitsInByteOperand(int value);
-  static bool FitsInByteOperand(size_t value);
 
-  void Output(Bytecode bytecode, uint8_t r0, uint8_t r1, uint8_t r2);
-  void Output(Bytecode bytecode, uint8_t r0, uint8_t r1);
-  void Output(Bytecode bytecode, uint8_t r0);
+  // Operands are passed as 32-bit values, with signed operands sign extended.
+  // Operands that don't fit in a byte are emitted with a scaling prefix.
+  void Output(Bytecode bytecode, uint32_t r0, uint32_t r1, uint32_t r2);
+  void Output(Bytecode bytecode, uint32_t r0, uint32_t r1);
+  void Output(Bytecode bytecode, uint32_t r0);
   void Output(Bytecode bytecode);
+  void OutputScaled(Bytecode bytecode, const uint32_t* operands,
+                    int operand_count);
 
   bool OperandIsValid(Bytecode bytecode, int operand_index,
-                      uint8_t operand_value) const;
+                      uint32_t operand_value) const;
+
+  // Peephole helpers. The last bytecode may only be inspected or rewritten
+  // if peephole optimization is enabled, no label is bound behind it and
+  // neither it nor the next bytecode carries a source position.
+  bool CanRewriteLastBytecode() const;
+  Bytecode LastBytecode() const;
+  OperandScale LastBytecodeOperandScale() const;
+  uint32_t LastBytecodeOperand(int operand_index) const;
+  // Returns true if the last bytecode left the accumulator and |reg| holding
+  // the same value.
+  bool LastBytecodeSynchronizesRegister(Register reg) const;
+  void DropLastBytecode();
+  void PrepareForAccumulatorLoad();
+  static bool IsAccumulatorLoadWithoutEffects(Bytecode bytecode);
 
   size_t GetConstantPoolEntry(Handle<Object> object);
 
@@ -94,6 +131,13 @@ class BytecodeArrayBuilder {
   Isolate* isolate_;
   ZoneVector<uint8_t> bytecodes_;
   bool bytecode_generated_;
+  size_t last_bytecode_start_;
+  // The offset the last label was bound to. The start of the bytecode counts
+  // as a bound label.
+  size_t last_bound_label_offset_;
+
+  ZoneVector<SourcePositionEntry> source_positions_;
+  int pending_source_position_;
 
   IdentityMap<size_t> constants_map_;
   ZoneVector<Handle<Object>> constants_;
@@ -107,6 +151,32 @@ class BytecodeArrayBuilder {
   DISALLOW_IMPLICIT_CONSTRUCTORS(BytecodeArrayBuilder);
 };
 
+// A label representing a jump target in a bytecode array. Binding it fixes
+// its position at the offset of the next bytecode.
+class BytecodeLabel final {
+ public:
+  BytecodeLabel() : offset_(kUnboundOffset) {}
+
+  bool is_bound() const { return offset_ != kUnboundOffset; }
+  size_t offset() const {
+    DCHECK(is_bound());
+    return offset_;
+  }
+
+ private:
+  static const size_t kUnboundOffset = static_cast<size_t>(-1);
+
+  void bind_to(size_t offset) {
+    DCHECK(!is_bound());
+    offset_ = offset;
+  }
+
+  size_t offset_;
+
+  friend class BytecodeArrayBuilder;
+};
+
+
 // A stack-allocated class than allows the instantiator to allocate
 // temporary registers that are cleaned up when scope is closed.
 class TemporaryRegisterScope {
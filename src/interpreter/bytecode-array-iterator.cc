@@ -12,11 +12,31 @@ namespace interpreter {
 
 BytecodeArrayIterator::BytecodeArrayIterator(
     Handle<BytecodeArray> bytecode_array)
-    : bytecode_array_(bytecode_array), bytecode_offset_(0) {}
+    : bytecode_array_(bytecode_array),
+      bytecode_offset_(0),
+      prefix_size_(0),
+      operand_scale_(OperandScale::kSingle) {
+  UpdateOperandScale();
+}
 
 
 void BytecodeArrayIterator::Advance() {
-  bytecode_offset_ += Bytecodes::Size(current_bytecode());
+  bytecode_offset_ +=
+      prefix_size_ + Bytecodes::Size(current_bytecode(), operand_scale_);
+  UpdateOperandScale();
+}
+
+
+void BytecodeArrayIterator::UpdateOperandScale() {
+  prefix_size_ = 0;
+  operand_scale_ = OperandScale::kSingle;
+  if (done()) return;
+  Bytecode bytecode =
+      Bytecodes::FromByte(bytecode_array()->get(bytecode_offset_));
+  if (Bytecodes::IsPrefixScalingBytecode(bytecode)) {
+    prefix_size_ = 1;
+    operand_scale_ = Bytecodes::PrefixBytecodeToOperandScale(bytecode);
+  }
 }
 
 
@@ -27,36 +47,42 @@ bool BytecodeArrayIterator::done() const {
 
 Bytecode BytecodeArrayIterator::current_bytecode() const {
   DCHECK(!done());
-  uint8_t current_byte = bytecode_array()->get(bytecode_offset_);
+  uint8_t current_byte = bytecode_array()->get(bytecode_offset_ + prefix_size_);
   return interpreter::Bytecodes::FromByte(current_byte);
 }
 
 
-uint8_t BytecodeArrayIterator::GetOperand(int operand_index,
-                                          OperandType operand_type) const {
+const uint8_t* BytecodeArrayIterator::GetOperandStart(
+    int operand_index, OperandType operand_type) const {
   DCHECK_GE(operand_index, 0);
   DCHECK_LT(operand_index, Bytecodes::NumberOfOperands(current_bytecode()));
   DCHECK_EQ(operand_type,
             Bytecodes::GetOperandType(current_bytecode(), operand_index));
-  int operands_start = bytecode_offset_ + 1;
-  return bytecode_array()->get(operands_start + operand_index);
+  int operands_start = bytecode_offset_ + prefix_size_ + 1;
+  int operand_offset = operand_index * static_cast<int>(operand_scale_);
+  return bytecode_array()->GetFirstBytecodeAddress() + operands_start +
+         operand_offset;
 }
 
 
 int8_t BytecodeArrayIterator::GetSmi8Operand(int operand_index) const {
-  uint8_t operand = GetOperand(operand_index, OperandType::kImm8);
+  int32_t operand = Bytecodes::DecodeSignedOperand(
+      GetOperandStart(operand_index, OperandType::kImm8), operand_scale_);
+  DCHECK(operand >= kMinInt8 && operand <= kMaxInt8);
   return static_cast<int8_t>(operand);
 }
 
 
 int BytecodeArrayIterator::GetIndexOperand(int operand_index) const {
-  uint8_t operand = GetOperand(operand_index, OperandType::kIdx);
+  uint32_t operand = Bytecodes::DecodeUnsignedOperand(
+      GetOperandStart(operand_index, OperandType::kIdx), operand_scale_);
   return static_cast<int>(operand);
 }
 
 
 Register BytecodeArrayIterator::GetRegisterOperand(int operand_index) const {
-  uint8_t operand = GetOperand(operand_index, OperandType::kReg);
+  int32_t operand = Bytecodes::DecodeSignedOperand(
+      GetOperandStart(operand_index, OperandType::kReg), operand_scale_);
   return Register::FromOperand(operand);
 }
 
@@ -13,6 +13,9 @@ namespace v8 {
 namespace internal {
 namespace interpreter {
 
+// Iterates over the bytecodes in a BytecodeArray. Scaling prefixes are not
+// visited on their own, instead they determine the operand scale of the
+// bytecode they precede.
 class BytecodeArrayIterator {
  public:
   explicit BytecodeArrayIterator(Handle<BytecodeArray> bytecode_array);
@@ -20,6 +23,7 @@ class BytecodeArrayIterator {
   void Advance();
   bool done() const;
   Bytecode current_bytecode() const;
+  OperandScale current_operand_scale() const { return operand_scale_; }
   const Handle<BytecodeArray>& bytecode_array() const {
     return bytecode_array_;
   }
@@ -30,10 +34,15 @@ class BytecodeArrayIterator {
   Handle<Object> GetConstantForIndexOperand(int operand_index) const;
 
  private:
-  uint8_t GetOperand(int operand_index, OperandType operand_type) const;
+  const uint8_t* GetOperandStart(int operand_index,
+                                 OperandType operand_type) const;
+  void UpdateOperandScale();
 
   Handle<BytecodeArray> bytecode_array_;
+  // Offset of the current bytecode, or of its prefix if it has one.
   int bytecode_offset_;
+  int prefix_size_;
+  OperandScale operand_scale_;
 
   DISALLOW_COPY_AND_ASSIGN(BytecodeArrayIterator);
 };
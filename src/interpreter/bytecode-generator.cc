@@ -259,9 +259,15 @@ void BytecodeGenerator::VisitVariableProxy(VariableProxy* proxy) {
       builder().LoadAccumulatorWithRegister(source);
       break;
     }
+    case VariableLocation::CONTEXT: {
+      if (!IsClosureContextSlot(variable) || variable->binding_needs_init()) {
+        UNIMPLEMENTED();
+      }
+      builder().LoadContextSlot(variable->index());
+      break;
+    }
     case VariableLocation::GLOBAL:
     case VariableLocation::UNALLOCATED:
-    case VariableLocation::CONTEXT:
     case VariableLocation::LOOKUP:
       UNIMPLEMENTED();
   }
@@ -316,6 +322,13 @@ void BytecodeGenerator::VisitAssignment(Assignment* expr) {
   switch (assign_type) {
     case VARIABLE: {
       Variable* variable = expr->target()->AsVariableProxy()->var();
+      if (variable->location() == VariableLocation::CONTEXT) {
+        if (!IsClosureContextSlot(variable) || variable->mode() != VAR) {
+          UNIMPLEMENTED();
+        }
+        builder().StoreContextSlot(variable->index());
+        break;
+      }
       DCHECK(variable->location() == VariableLocation::LOCAL);
       Register destination(variable->index());
       builder().StoreAccumulatorInRegister(destination);
@@ -447,7 +460,16 @@ void BytecodeGenerator::VisitArithmeticExpression(BinaryOperation* binop) {
   Visit(left);
   builder().StoreAccumulatorInRegister(temporary);
   Visit(right);
-  builder().BinaryOperation(op, temporary);
+  FeedbackVectorSlot slot = binop->BinaryOperationFeedbackSlot();
+  builder().BinaryOperation(op, temporary, feedback_index(slot));
+}
+
+
+bool BytecodeGenerator::IsClosureContextSlot(Variable* variable) const {
+  // Creating a function context and walking the context chain are not
+  // implemented yet, so only the closure's own context can be accessed.
+  return !scope()->NeedsContext() &&
+         scope()->ContextChainLength(variable->scope()) == 0;
 }
 
 
@@ -456,6 +478,11 @@ LanguageMode BytecodeGenerator::language_mode() const {
 }
 
 
+int BytecodeGenerator::feedback_index(FeedbackVectorSlot slot) const {
+  return info()->feedback_vector()->GetIndex(slot);
+}
+
+
 int BytecodeGenerator::feedback_index(FeedbackVectorICSlot slot) const {
   return info()->feedback_vector()->GetIndex(slot);
 }
@@ -29,6 +29,10 @@ class BytecodeGenerator : public AstVisitor {
 
   void VisitArithmeticExpression(BinaryOperation* binop);
 
+  // Returns true if the context slot of |variable| is in the context the
+  // function was called with.
+  bool IsClosureContextSlot(Variable* variable) const;
+
   inline BytecodeArrayBuilder& builder() { return builder_; }
   inline Scope* scope() const { return scope_; }
   inline void set_scope(Scope* scope) { scope_ = scope; }
@@ -36,6 +40,7 @@ class BytecodeGenerator : public AstVisitor {
   inline void set_info(CompilationInfo* info) { info_ = info; }
 
   LanguageMode language_mode() const;
+  int feedback_index(FeedbackVectorSlot slot) const;
   int feedback_index(FeedbackVectorICSlot slot) const;
 
   BytecodeArrayBuilder builder_;
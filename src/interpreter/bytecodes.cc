@@ -94,12 +94,122 @@ int Bytecodes::Size(Bytecode bytecode) {
 }
 
 
+// static
+int Bytecodes::Size(Bytecode bytecode, OperandScale operand_scale) {
+  return 1 + NumberOfOperands(bytecode) * static_cast<int>(operand_scale);
+}
+
+
 // static
 int Bytecodes::MaximumNumberOfOperands() { return kMaxOperands; }
 
 
 // static
-int Bytecodes::MaximumSize() { return 1 + kMaxOperands; }
+int Bytecodes::MaximumSize() {
+  return 2 + kMaxOperands * static_cast<int>(OperandScale::kQuadruple);
+}
+
+
+// static
+bool Bytecodes::IsPrefixScalingBytecode(Bytecode bytecode) {
+  return bytecode == Bytecode::kWide || bytecode == Bytecode::kExtraWide;
+}
+
+
+// static
+OperandScale Bytecodes::PrefixBytecodeToOperandScale(Bytecode bytecode) {
+  DCHECK(IsPrefixScalingBytecode(bytecode));
+  return bytecode == Bytecode::kWide ? OperandScale::kDouble
+                                     : OperandScale::kQuadruple;
+}
+
+
+// static
+Bytecode Bytecodes::OperandScaleToPrefixBytecode(OperandScale operand_scale) {
+  DCHECK(operand_scale != OperandScale::kSingle);
+  return operand_scale == OperandScale::kDouble ? Bytecode::kWide
+                                                : Bytecode::kExtraWide;
+}
+
+
+// static
+bool Bytecodes::IsSignedOperandType(OperandType operand_type) {
+  return operand_type == OperandType::kImm8 ||
+         operand_type == OperandType::kReg;
+}
+
+
+// static
+OperandScale Bytecodes::ScaleForSignedOperand(int32_t value) {
+  if (value >= kMinInt8 && value <= kMaxInt8) return OperandScale::kSingle;
+  if (value >= kMinInt16 && value <= kMaxInt16) return OperandScale::kDouble;
+  return OperandScale::kQuadruple;
+}
+
+
+// static
+OperandScale Bytecodes::ScaleForUnsignedOperand(uint32_t value) {
+  if (value <= static_cast<uint32_t>(kMaxUInt8)) return OperandScale::kSingle;
+  if (value <= static_cast<uint32_t>(kMaxUInt16)) return OperandScale::kDouble;
+  return OperandScale::kQuadruple;
+}
+
+
+// static
+uint32_t Bytecodes::DecodeUnsignedOperand(const uint8_t* operand_start,
+                                          OperandScale operand_scale) {
+  uint32_t value = 0;
+  for (int i = static_cast<int>(operand_scale) - 1; i >= 0; i--) {
+    value = (value << 8) | operand_start[i];
+  }
+  return value;
+}
+
+
+// static
+int32_t Bytecodes::DecodeSignedOperand(const uint8_t* operand_start,
+                                       OperandScale operand_scale) {
+  uint32_t value = DecodeUnsignedOperand(operand_start, operand_scale);
+  switch (operand_scale) {
+    case OperandScale::kSingle:
+      return static_cast<int8_t>(value);
+    case OperandScale::kDouble:
+      return static_cast<int16_t>(value);
+    case OperandScale::kQuadruple:
+      return static_cast<int32_t>(value);
+  }
+  UNREACHABLE();
+  return 0;
+}
+
+
+// static
+int Bytecodes::DispatchTableOffset(OperandScale operand_scale) {
+  static const int kBytecodeCount = static_cast<int>(Bytecode::kLast) + 1;
+  switch (operand_scale) {
+    case OperandScale::kSingle:
+      return 0;
+    case OperandScale::kDouble:
+      return kBytecodeCount;
+    case OperandScale::kQuadruple:
+      return 2 * kBytecodeCount;
+  }
+  UNREACHABLE();
+  return 0;
+}
+
+
+// static
+int Bytecodes::DispatchTableIndex(Bytecode bytecode,
+                                  OperandScale operand_scale) {
+  return DispatchTableOffset(operand_scale) + ToByte(bytecode);
+}
+
+
+// static
+int Bytecodes::DispatchTableSize() {
+  return 3 * (static_cast<int>(Bytecode::kLast) + 1);
+}
 
 
 // static
@@ -108,7 +218,14 @@ std::ostream& Bytecodes::Decode(std::ostream& os, const uint8_t* bytecode_start,
   Vector<char> buf = Vector<char>::New(50);
 
   Bytecode bytecode = Bytecodes::FromByte(bytecode_start[0]);
-  int bytecode_size = Bytecodes::Size(bytecode);
+  OperandScale operand_scale = OperandScale::kSingle;
+  int prefix_size = 0;
+  if (IsPrefixScalingBytecode(bytecode)) {
+    operand_scale = PrefixBytecodeToOperandScale(bytecode);
+    prefix_size = 1;
+    bytecode = Bytecodes::FromByte(bytecode_start[prefix_size]);
+  }
+  int bytecode_size = prefix_size + Bytecodes::Size(bytecode, operand_scale);
 
   for (int i = 0; i < bytecode_size; i++) {
     SNPrintF(buf, "%02x ", bytecode_start[i]);
@@ -118,22 +235,29 @@ std::ostream& Bytecodes::Decode(std::ostream& os, const uint8_t* bytecode_start,
     os << "   ";
   }
 
-  os << bytecode << " ";
+  os << bytecode;
+  if (operand_scale != OperandScale::kSingle) {
+    os << "." << OperandScaleToPrefixBytecode(operand_scale);
+  }
+  os << " ";
 
-  const uint8_t* operands_start = bytecode_start + 1;
-  int operands_size = bytecode_size - 1;
-  for (int i = 0; i < operands_size; i++) {
+  const uint8_t* operands_start = bytecode_start + prefix_size + 1;
+  int number_of_operands = NumberOfOperands(bytecode);
+  for (int i = 0; i < number_of_operands; i++) {
     OperandType op_type = GetOperandType(bytecode, i);
-    uint8_t operand = operands_start[i];
+    const uint8_t* operand_start =
+        operands_start + i * static_cast<int>(operand_scale);
     switch (op_type) {
       case interpreter::OperandType::kIdx:
-        os << "[" << static_cast<unsigned int>(operand) << "]";
+        os << "[" << DecodeUnsignedOperand(operand_start, operand_scale)
+           << "]";
         break;
       case interpreter::OperandType::kImm8:
-        os << "#" << static_cast<int>(operand);
+        os << "#" << DecodeSignedOperand(operand_start, operand_scale);
         break;
       case interpreter::OperandType::kReg: {
-        Register reg = Register::FromOperand(operand);
+        Register reg = Register::FromOperand(
+            DecodeSignedOperand(operand_start, operand_scale));
         if (reg.is_parameter()) {
           int parameter_index = reg.ToParameterIndex(parameter_count);
           if (parameter_index == 0) {
@@ -150,7 +274,7 @@ std::ostream& Bytecodes::Decode(std::ostream& os, const uint8_t* bytecode_start,
         UNREACHABLE();
         break;
     }
-    if (i != operands_size - 1) {
+    if (i != number_of_operands - 1) {
       os << ", ";
     }
   }
@@ -168,14 +292,20 @@ std::ostream& operator<<(std::ostream& os, const OperandType& operand_type) {
 }
 
 
+std::ostream& operator<<(std::ostream& os, const OperandScale& operand_scale) {
+  return os << static_cast<int>(operand_scale);
+}
+
+
 static const int kLastParamRegisterIndex =
     -InterpreterFrameConstants::kLastParamFromRegisterPointer / kPointerSize;
 
 
-// Registers occupy range 0-127 in 8-bit value leaving 128 unused values.
-// Parameter indices are biased with the negative value kLastParamRegisterIndex
-// for ease of access in the interpreter.
-static const int kMaxParameterIndex = 128 + kLastParamRegisterIndex;
+// Registers occupy the non-positive operand values and parameters the positive
+// ones. Parameter indices are biased with the negative value
+// kLastParamRegisterIndex for ease of access in the interpreter.
+static const int kMaxParameterIndex =
+    -Register::kMinRegisterIndex + kLastParamRegisterIndex;
 
 
 Register Register::FromParameterIndex(int index, int parameter_count) {
@@ -198,12 +328,10 @@ int Register::ToParameterIndex(int parameter_count) const {
 int Register::MaxParameterIndex() { return kMaxParameterIndex; }
 
 
-uint8_t Register::ToOperand() const { return static_cast<uint8_t>(-index_); }
+int32_t Register::ToOperand() const { return -index_; }
 
 
-Register Register::FromOperand(uint8_t operand) {
-  return Register(-static_cast<int8_t>(operand));
-}
+Register Register::FromOperand(int32_t operand) { return Register(-operand); }
 
 }  // namespace interpreter
 }  // namespace internal
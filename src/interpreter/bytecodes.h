@@ -25,6 +25,10 @@ namespace interpreter {
 // The list of bytecodes which are interpreted by the interpreter.
 #define BYTECODE_LIST(V)                                                   \
                                                                            \
+  /* Operand scaling prefixes */                                           \
+  V(Wide, OperandType::kNone)                                              \
+  V(ExtraWide, OperandType::kNone)                                         \
+                                                                           \
   /* Loading the accumulator */                                            \
   V(LdaZero, OperandType::kNone)                                           \
   V(LdaSmi8, OperandType::kImm8)                                           \
@@ -39,6 +43,13 @@ namespace interpreter {
   V(Ldar, OperandType::kReg)                                               \
   V(Star, OperandType::kReg)                                               \
                                                                            \
+  /* Superinstructions */                                                  \
+  V(LdarStar, OperandType::kReg, OperandType::kReg)                        \
+                                                                           \
+  /* Context operations */                                                 \
+  V(LdaContextSlot, OperandType::kIdx)                                     \
+  V(StaContextSlot, OperandType::kIdx)                                     \
+                                                                           \
   /* LoadIC operations */                                                  \
   V(LoadIC, OperandType::kReg, OperandType::kIdx)                          \
   V(KeyedLoadIC, OperandType::kReg, OperandType::kIdx)                     \
@@ -48,11 +59,12 @@ namespace interpreter {
   V(KeyedStoreIC, OperandType::kReg, OperandType::kReg, OperandType::kIdx) \
                                                                            \
   /* Binary Operators */                                                   \
-  V(Add, OperandType::kReg)                                                \
-  V(Sub, OperandType::kReg)                                                \
-  V(Mul, OperandType::kReg)                                                \
-  V(Div, OperandType::kReg)                                                \
-  V(Mod, OperandType::kReg)                                                \
+  V(Add, OperandType::kReg, OperandType::kIdx)                             \
+  V(AddSmi8, OperandType::kReg, OperandType::kImm8, OperandType::kIdx)     \
+  V(Sub, OperandType::kReg, OperandType::kIdx)                             \
+  V(Mul, OperandType::kReg, OperandType::kIdx)                             \
+  V(Div, OperandType::kReg, OperandType::kIdx)                             \
+  V(Mod, OperandType::kReg, OperandType::kIdx)                             \
                                                                            \
   /* Control Flow */                                                       \
   V(Return, OperandType::kNone)
@@ -71,6 +83,15 @@ enum class OperandType : uint8_t {
 };
 
 
+// The width of the operands of a bytecode, in bytes per operand. Operands are
+// a single byte unless the bytecode is preceded by a Wide or ExtraWide prefix.
+enum class OperandScale : uint8_t {
+  kSingle = 1,
+  kDouble = 2,
+  kQuadruple = 4,
+};
+
+
 // Enumeration of interpreter bytecodes.
 enum class Bytecode : uint8_t {
 #define DECLARE_BYTECODE(Name, ...) k##Name,
@@ -86,10 +107,13 @@ enum class Bytecode : uint8_t {
 
 // An interpreter register which is located in the function's register file
 // in its stack-frame. Register hold parameters, this, and expression values.
+// Registers are encoded as signed operands, so registers 0-127 and the first
+// parameters fit in a single byte and the remaining ones need a scaled operand.
 class Register {
  public:
-  static const int kMaxRegisterIndex = 127;
-  static const int kMinRegisterIndex = -128;
+  // The frame size in bytes must fit in an int.
+  static const int kMaxRegisterIndex = kMaxInt / kPointerSize - 1;
+  static const int kMinRegisterIndex = -kMaxRegisterIndex - 1;
 
   Register() : index_(kIllegalIndex) {}
 
@@ -108,8 +132,8 @@ class Register {
   int ToParameterIndex(int parameter_count) const;
   static int MaxParameterIndex();
 
-  static Register FromOperand(uint8_t operand);
-  uint8_t ToOperand() const;
+  static Register FromOperand(int32_t operand);
+  int32_t ToOperand() const;
 
  private:
   static const int kIllegalIndex = kMaxInt;
@@ -144,13 +168,52 @@ class Bytecodes {
   // Returns the size of the bytecode including its operands.
   static int Size(Bytecode bytecode);
 
+  // Returns the size of the bytecode including its operands when the operands
+  // are scaled by |operand_scale|. Does not include the size of the prefix.
+  static int Size(Bytecode bytecode, OperandScale operand_scale);
+
   // The maximum number of operands across all bytecodes.
   static int MaximumNumberOfOperands();
 
-  // Maximum size of a bytecode and its operands.
+  // Maximum size of a bytecode and its operands, including a scaling prefix.
   static int MaximumSize();
 
-  // Decode a single bytecode and operands to |os|.
+  // Returns true if |bytecode| scales the operands of the next bytecode.
+  static bool IsPrefixScalingBytecode(Bytecode bytecode);
+
+  // Returns the operand scale applied by the prefix |bytecode|.
+  static OperandScale PrefixBytecodeToOperandScale(Bytecode bytecode);
+
+  // Returns the prefix bytecode for |operand_scale|, which must not be kSingle.
+  static Bytecode OperandScaleToPrefixBytecode(OperandScale operand_scale);
+
+  // Returns true if operands of |operand_type| are sign extended.
+  static bool IsSignedOperandType(OperandType operand_type);
+
+  // Returns the smallest operand scale that can hold |value|.
+  static OperandScale ScaleForSignedOperand(int32_t value);
+  static OperandScale ScaleForUnsignedOperand(uint32_t value);
+
+  // Decodes an operand of width |operand_scale| starting at |operand_start|.
+  // Operands are stored in little-endian byte order.
+  static int32_t DecodeSignedOperand(const uint8_t* operand_start,
+                                     OperandScale operand_scale);
+  static uint32_t DecodeUnsignedOperand(const uint8_t* operand_start,
+                                        OperandScale operand_scale);
+
+  // The interpreter dispatch table holds a handler for every bytecode at each
+  // operand scale. Returns the index of the handler for |bytecode| with
+  // operands scaled by |operand_scale|.
+  static int DispatchTableIndex(Bytecode bytecode, OperandScale operand_scale);
+
+  // Returns the index of the first handler for |operand_scale|.
+  static int DispatchTableOffset(OperandScale operand_scale);
+
+  // Returns the number of entries in the interpreter dispatch table.
+  static int DispatchTableSize();
+
+  // Decode a single bytecode and operands to |os|. |bytecode_start| may point
+  // to a scaling prefix, in which case the prefixed bytecode is decoded.
   static std::ostream& Decode(std::ostream& os, const uint8_t* bytecode_start,
                               int number_of_parameters);
 
@@ -160,6 +223,7 @@ class Bytecodes {
 
 std::ostream& operator<<(std::ostream& os, const Bytecode& bytecode);
 std::ostream& operator<<(std::ostream& os, const OperandType& operand_type);
+std::ostream& operator<<(std::ostream& os, const OperandScale& operand_scale);
 
 }  // namespace interpreter
 }  // namespace internal
@@ -4,6 +4,10 @@
 
 #include "src/interpreter/interpreter.h"
 
+#include <algorithm>
+#include <vector>
+
+#include "src/base/platform/time.h"
 #include "src/code-factory.h"
 #include "src/compiler.h"
 #include "src/compiler/interpreter-assembler.h"
@@ -28,7 +32,7 @@ Interpreter::Interpreter(Isolate* isolate)
 Handle<FixedArray> Interpreter::CreateUninitializedInterpreterTable(
     Isolate* isolate) {
   Handle<FixedArray> handler_table = isolate->factory()->NewFixedArray(
-      static_cast<int>(Bytecode::kLast) + 1, TENURED);
+      Bytecodes::DispatchTableSize(), TENURED);
   // We rely on the interpreter handler table being immovable, so check that
   // it was allocated on the first page (which is always immovable).
   DCHECK(isolate->heap()->old_space()->FirstPage()->Contains(
@@ -44,17 +48,42 @@ void Interpreter::Initialize() {
     Zone zone;
     HandleScope scope(isolate_);
 
-#define GENERATE_CODE(Name, ...)                                      \
-    {                                                                 \
-      compiler::InterpreterAssembler assembler(isolate_, &zone,       \
-                                               Bytecode::k##Name);    \
-      Do##Name(&assembler);                                           \
-      Handle<Code> code = assembler.GenerateCode();                   \
-      handler_table->set(static_cast<int>(Bytecode::k##Name), *code); \
-    }
+#define GENERATE_CODE(Name, ...)                            \
+    GenerateHandlers(&zone, handler_table, Bytecode::k##Name, \
+                     &Interpreter::Do##Name);
     BYTECODE_LIST(GENERATE_CODE)
 #undef GENERATE_CODE
   }
+  if (FLAG_ignition_profile) {
+    dispatch_counts_.resize(kNumberOfBytecodes * (kNumberOfBytecodes + 1));
+    handler_ticks_.resize(kNumberOfBytecodes);
+  }
+}
+
+
+void Interpreter::GenerateHandlers(Zone* zone, Handle<FixedArray> handler_table,
+                                   Bytecode bytecode,
+                                   HandlerGenerator generator) {
+  static const OperandScale kOperandScales[] = {
+      OperandScale::kSingle, OperandScale::kDouble, OperandScale::kQuadruple};
+  Handle<Code> single_scale_code;
+  for (OperandScale operand_scale : kOperandScales) {
+    Handle<Code> code;
+    if (operand_scale == OperandScale::kSingle ||
+        Bytecodes::NumberOfOperands(bytecode) > 0) {
+      compiler::InterpreterAssembler assembler(isolate_, zone, bytecode,
+                                               operand_scale);
+      (this->*generator)(&assembler);
+      code = assembler.GenerateCode();
+    } else {
+      // Bytecodes without operands, including the prefixes themselves, are
+      // not affected by a prefix and share their handler.
+      code = single_scale_code;
+    }
+    if (operand_scale == OperandScale::kSingle) single_scale_code = code;
+    handler_table->set(Bytecodes::DispatchTableIndex(bytecode, operand_scale),
+                       *code);
+  }
 }
 
 
@@ -79,13 +108,291 @@ bool Interpreter::MakeBytecode(CompilationInfo* info) {
 }
 
 
+// Returns a timestamp for timing bytecode handlers: the CPU timestamp counter
+// on x86 hosts, the high resolution clock elsewhere.
+static uint64_t ReadProfileTicks() {
+#if (V8_HOST_ARCH_IA32 || V8_HOST_ARCH_X64) && V8_CC_GNU
+  uint32_t low, high;
+  __asm__ __volatile__("rdtsc" : "=a"(low), "=d"(high));
+  return (static_cast<uint64_t>(high) << 32) | low;
+#else
+  return static_cast<uint64_t>(
+      base::TimeTicks::HighResolutionNow().ToInternalValue());
+#endif
+}
+
+
+// static
+void Interpreter::ProfileHandlerEntry(Isolate* isolate,
+                                      Address register_file) {
+  uint64_t entry_ticks = ReadProfileTicks();
+  Interpreter* interpreter = isolate->interpreter();
+  // Only one handler at a time runs in an interpreted frame, so a frame left
+  // for it is stale.
+  interpreter->UnwindProfileStack(register_file, true, entry_ticks);
+  ProfileFrame frame = {register_file, entry_ticks, 0};
+  interpreter->profile_stack_.push_back(frame);
+}
+
+
+// static
+void Interpreter::ProfileHandlerExit(Isolate* isolate, intptr_t dispatch,
+                                     Address register_file) {
+  uint64_t exit_ticks = ReadProfileTicks();
+  Interpreter* interpreter = isolate->interpreter();
+  DCHECK_LT(static_cast<size_t>(dispatch),
+            interpreter->dispatch_counts_.size());
+  interpreter->dispatch_counts_[dispatch]++;
+  if (FLAG_ignition_sequence_stats) {
+    interpreter->RecordSequence(static_cast<int>(dispatch), register_file);
+  }
+
+  interpreter->UnwindProfileStack(register_file, false, exit_ticks);
+  // The frame is missing if the profile was reset while the handler ran.
+  if (interpreter->profile_stack_.empty() ||
+      interpreter->profile_stack_.back().register_file != register_file) {
+    return;
+  }
+  ProfileFrame frame = interpreter->profile_stack_.back();
+  interpreter->profile_stack_.pop_back();
+  uint64_t ticks = exit_ticks - frame.entry_ticks;
+  int bytecode = static_cast<int>(dispatch) / (kNumberOfBytecodes + 1);
+  interpreter->handler_ticks_[bytecode] += ticks - frame.callee_ticks;
+  if (!interpreter->profile_stack_.empty()) {
+    interpreter->profile_stack_.back().callee_ticks += ticks;
+  }
+}
+
+
+void Interpreter::UnwindProfileStack(Address register_file, bool include_frame,
+                                     uint64_t ticks) {
+  // The stack grows downwards, so deeper frames have lower addresses.
+  bool unwound = false;
+  uint64_t outermost_entry_ticks = 0;
+  while (!profile_stack_.empty()) {
+    Address top = profile_stack_.back().register_file;
+    if (top > register_file || (top == register_file && !include_frame)) break;
+    outermost_entry_ticks = profile_stack_.back().entry_ticks;
+    profile_stack_.pop_back();
+    unwound = true;
+  }
+  if (unwound && !profile_stack_.empty()) {
+    profile_stack_.back().callee_ticks += ticks - outermost_entry_ticks;
+  }
+}
+
+
+void Interpreter::RecordSequence(int dispatch, Address register_file) {
+  // Frames deeper on the stack than |register_file| have returned or thrown.
+  while (!sequence_stack_.empty() &&
+         sequence_stack_.back().register_file < register_file) {
+    sequence_stack_.pop_back();
+  }
+  int bytecode = dispatch / (kNumberOfBytecodes + 1);
+  int to = dispatch % (kNumberOfBytecodes + 1);
+  if (!sequence_stack_.empty() &&
+      sequence_stack_.back().register_file == register_file) {
+    SequenceFrame& frame = sequence_stack_.back();
+    // A frame left behind by a handler that threw may not have dispatched to
+    // this bytecode.
+    if (frame.previous_dispatch % (kNumberOfBytecodes + 1) == bytecode) {
+      triple_counts_[frame.previous_dispatch * (kNumberOfBytecodes + 1) +
+                     to]++;
+    }
+    frame.previous_dispatch = dispatch;
+  } else {
+    SequenceFrame frame = {register_file, dispatch};
+    sequence_stack_.push_back(frame);
+  }
+  if (to == kNumberOfBytecodes) sequence_stack_.pop_back();
+}
+
+
+uint64_t Interpreter::execution_count(Bytecode bytecode) const {
+  if (dispatch_counts_.empty()) return 0;
+  uint64_t count = 0;
+  for (int to = 0; to <= kNumberOfBytecodes; to++) {
+    count += dispatch_counts_[ProfileDispatchIndex(bytecode, to)];
+  }
+  return count;
+}
+
+
+uint64_t Interpreter::dispatch_count(Bytecode from, Bytecode to) const {
+  if (dispatch_counts_.empty()) return 0;
+  return dispatch_counts_[ProfileDispatchIndex(from, Bytecodes::ToByte(to))];
+}
+
+
+uint64_t Interpreter::handler_ticks(Bytecode bytecode) const {
+  if (handler_ticks_.empty()) return 0;
+  return handler_ticks_[Bytecodes::ToByte(bytecode)];
+}
+
+
+uint64_t Interpreter::sequence_count(Bytecode first, Bytecode second) const {
+  return dispatch_count(first, second);
+}
+
+
+uint64_t Interpreter::sequence_count(Bytecode first, Bytecode second,
+                                     Bytecode third) const {
+  int pair = ProfileDispatchIndex(first, Bytecodes::ToByte(second));
+  auto it = triple_counts_.find(pair * (kNumberOfBytecodes + 1) +
+                                Bytecodes::ToByte(third));
+  return it == triple_counts_.end() ? 0 : it->second;
+}
+
+
+void Interpreter::ResetProfile() {
+  std::fill(dispatch_counts_.begin(), dispatch_counts_.end(), 0);
+  std::fill(handler_ticks_.begin(), handler_ticks_.end(), 0);
+  profile_stack_.clear();
+  triple_counts_.clear();
+  sequence_stack_.clear();
+}
+
+
+// Returns whether |index| identifies a bytecode, rather than a return, which
+// can be part of a superinstruction.
+static bool IsFusibleBytecode(int index) {
+  return index < Interpreter::kNumberOfBytecodes &&
+         !Bytecodes::IsPrefixScalingBytecode(
+             Bytecodes::FromByte(static_cast<uint8_t>(index)));
+}
+
+
+std::vector<Interpreter::SuperinstructionCandidate>
+Interpreter::SuperinstructionCandidates() const {
+  std::vector<SuperinstructionCandidate> candidates;
+  for (size_t i = 0; i < dispatch_counts_.size(); i++) {
+    int from = static_cast<int>(i) / (kNumberOfBytecodes + 1);
+    int to = static_cast<int>(i) % (kNumberOfBytecodes + 1);
+    if (dispatch_counts_[i] == 0 || !IsFusibleBytecode(from) ||
+        !IsFusibleBytecode(to)) {
+      continue;
+    }
+    SuperinstructionCandidate candidate = {
+        {Bytecodes::FromByte(static_cast<uint8_t>(from)),
+         Bytecodes::FromByte(static_cast<uint8_t>(to)), Bytecode::kLast},
+        2,
+        dispatch_counts_[i]};
+    candidates.push_back(candidate);
+  }
+  for (auto& entry : triple_counts_) {
+    int pair = entry.first / (kNumberOfBytecodes + 1);
+    int first = pair / (kNumberOfBytecodes + 1);
+    int second = pair % (kNumberOfBytecodes + 1);
+    int third = entry.first % (kNumberOfBytecodes + 1);
+    if (!IsFusibleBytecode(first) || !IsFusibleBytecode(second) ||
+        !IsFusibleBytecode(third)) {
+      continue;
+    }
+    SuperinstructionCandidate candidate = {
+        {Bytecodes::FromByte(static_cast<uint8_t>(first)),
+         Bytecodes::FromByte(static_cast<uint8_t>(second)),
+         Bytecodes::FromByte(static_cast<uint8_t>(third))},
+        3,
+        entry.second};
+    candidates.push_back(candidate);
+  }
+  std::stable_sort(candidates.begin(), candidates.end(),
+                   [](const SuperinstructionCandidate& a,
+                      const SuperinstructionCandidate& b) {
+                     return a.saved_dispatches() > b.saved_dispatches();
+                   });
+  return candidates;
+}
+
+
+void Interpreter::PrintSuperinstructionCandidates(std::ostream& os) const {
+  static const size_t kMaxCandidates = 20;
+  std::vector<SuperinstructionCandidate> candidates =
+      SuperinstructionCandidates();
+  os << "Superinstruction candidates:" << std::endl;
+  os << "  saved dispatches	executions	bytecodes" << std::endl;
+  for (size_t i = 0; i < candidates.size() && i < kMaxCandidates; i++) {
+    os << "  " << candidates[i].saved_dispatches() << "	"
+       << candidates[i].count << "	";
+    for (int j = 0; j < candidates[i].length; j++) {
+      os << " " << Bytecodes::ToString(candidates[i].bytecodes[j]);
+    }
+    os << std::endl;
+  }
+}
+
+
+void Interpreter::PrintAndResetProfile(std::ostream& os) {
+  static const size_t kMaxDispatches = 20;
+  typedef std::pair<uint64_t, Bytecode> HandlerEntry;
+  typedef std::pair<uint64_t, int> DispatchEntry;
+  std::vector<HandlerEntry> handlers;
+  std::vector<DispatchEntry> dispatches;
+  for (int i = 0; i < kNumberOfBytecodes; i++) {
+    Bytecode bytecode = Bytecodes::FromByte(static_cast<uint8_t>(i));
+    if (execution_count(bytecode) == 0) continue;
+    handlers.push_back(HandlerEntry(handler_ticks(bytecode), bytecode));
+    for (int to = 0; to <= kNumberOfBytecodes; to++) {
+      int index = ProfileDispatchIndex(bytecode, to);
+      if (dispatch_counts_[index] == 0) continue;
+      dispatches.push_back(DispatchEntry(dispatch_counts_[index], index));
+    }
+  }
+  std::sort(handlers.begin(), handlers.end(), std::greater<HandlerEntry>());
+  std::sort(dispatches.begin(), dispatches.end(),
+            std::greater<DispatchEntry>());
+
+  os << "Bytecode handlers by time:" << std::endl;
+  os << "  executions\tticks\tticks/execution\tbytecode" << std::endl;
+  for (const HandlerEntry& entry : handlers) {
+    uint64_t count = execution_count(entry.second);
+    os << "  " << count << "\t" << entry.first << "\t"
+       << entry.first / count << "\t" << Bytecodes::ToString(entry.second)
+       << std::endl;
+  }
+
+  os << "Most frequent bytecode dispatches:" << std::endl;
+  for (size_t i = 0; i < dispatches.size() && i < kMaxDispatches; i++) {
+    int from = dispatches[i].second / (kNumberOfBytecodes + 1);
+    int to = dispatches[i].second % (kNumberOfBytecodes + 1);
+    os << "  " << dispatches[i].first << "\t"
+       << Bytecodes::ToString(Bytecodes::FromByte(static_cast<uint8_t>(from)))
+       << " -> "
+       << (to == kNumberOfBytecodes
+               ? "(return)"
+               : Bytecodes::ToString(
+                     Bytecodes::FromByte(static_cast<uint8_t>(to))))
+       << std::endl;
+  }
+  ResetProfile();
+}
+
+
 bool Interpreter::IsInterpreterTableInitialized(
     Handle<FixedArray> handler_table) {
-  DCHECK(handler_table->length() == static_cast<int>(Bytecode::kLast) + 1);
+  DCHECK(handler_table->length() == Bytecodes::DispatchTableSize());
   return handler_table->get(0) != isolate_->heap()->undefined_value();
 }
 
 
+// Wide
+//
+// Prefix bytecode indicating that the operands of the next bytecode are
+// 16-bit wide.
+void Interpreter::DoWide(compiler::InterpreterAssembler* assembler) {
+  __ DispatchWide(OperandScale::kDouble);
+}
+
+
+// ExtraWide
+//
+// Prefix bytecode indicating that the operands of the next bytecode are
+// 32-bit wide.
+void Interpreter::DoExtraWide(compiler::InterpreterAssembler* assembler) {
+  __ DispatchWide(OperandScale::kQuadruple);
+}
+
+
 // LdaZero
 //
 // Load literal '0' into the accumulator.
@@ -191,6 +498,44 @@ void Interpreter::DoStar(compiler::InterpreterAssembler* assembler) {
 }
 
 
+// LdarStar <src> <dst>
+//
+// Load accumulator with value from register <src> and store it to register
+// <dst>. Superinstruction for Ldar <src>; Star <dst>.
+void Interpreter::DoLdarStar(compiler::InterpreterAssembler* assembler) {
+  Node* src_index = __ BytecodeOperandReg(0);
+  Node* value = __ LoadRegister(src_index);
+  Node* dst_index = __ BytecodeOperandReg(1);
+  __ StoreRegister(value, dst_index);
+  __ SetAccumulator(value);
+  __ Dispatch();
+}
+
+
+// LdaContextSlot <slot_index>
+//
+// Load the object in <slot_index> of the current context into the
+// accumulator.
+void Interpreter::DoLdaContextSlot(compiler::InterpreterAssembler* assembler) {
+  Node* slot_index = __ BytecodeOperandIdx(0);
+  Node* result = __ LoadContextSlot(__ GetContext(), slot_index);
+  __ SetAccumulator(result);
+  __ Dispatch();
+}
+
+
+// StaContextSlot <slot_index>
+//
+// Store the object in the accumulator into <slot_index> of the current
+// context.
+void Interpreter::DoStaContextSlot(compiler::InterpreterAssembler* assembler) {
+  Node* value = __ GetAccumulator();
+  Node* slot_index = __ BytecodeOperandIdx(0);
+  __ StoreContextSlot(__ GetContext(), slot_index, value);
+  __ Dispatch();
+}
+
+
 void Interpreter::DoPropertyLoadIC(Callable ic,
                                    compiler::InterpreterAssembler* assembler) {
   Node* code_target = __ HeapConstant(ic.code());
@@ -269,56 +614,79 @@ void Interpreter::DoKeyedStoreIC(compiler::InterpreterAssembler* assembler) {
 }
 
 
-void Interpreter::DoBinaryOp(Runtime::FunctionId function_id,
+void Interpreter::DoBinaryOp(Token::Value op, Runtime::FunctionId function_id,
                              compiler::InterpreterAssembler* assembler) {
-  // TODO(rmcilroy): Call ICs which back-patch bytecode with type specialized
-  // operations, instead of calling builtins directly.
   Node* reg_index = __ BytecodeOperandReg(0);
   Node* lhs = __ LoadRegister(reg_index);
   Node* rhs = __ GetAccumulator();
-  Node* result = __ CallRuntime(function_id, lhs, rhs);
+  Node* feedback_slot = __ BytecodeOperandIdx(1);
+  Node* result =
+      __ BinaryOpWithFeedback(op, function_id, lhs, rhs, feedback_slot);
   __ SetAccumulator(result);
   __ Dispatch();
 }
 
 
-// Add <src>
+// Add <src> <slot>
 //
-// Add register <src> to accumulator.
+// Add register <src> to accumulator, recording the operand types in
+// FeedbackVector slot <slot>.
 void Interpreter::DoAdd(compiler::InterpreterAssembler* assembler) {
-  DoBinaryOp(Runtime::kAdd, assembler);
+  DoBinaryOp(Token::ADD, Runtime::kAdd, assembler);
+}
+
+
+// AddSmi8 <src> <imm8> <slot>
+//
+// Add the 8-bit integer literal <imm8> to register <src> and put the result
+// in the accumulator, recording the operand types in FeedbackVector slot
+// <slot>.
+void Interpreter::DoAddSmi8(compiler::InterpreterAssembler* assembler) {
+  Node* reg_index = __ BytecodeOperandReg(0);
+  Node* lhs = __ LoadRegister(reg_index);
+  Node* raw_int = __ BytecodeOperandImm8(1);
+  Node* rhs = __ SmiTag(raw_int);
+  Node* feedback_slot = __ BytecodeOperandIdx(2);
+  Node* result = __ BinaryOpWithFeedback(Token::ADD, Runtime::kAdd, lhs, rhs,
+                                         feedback_slot);
+  __ SetAccumulator(result);
+  __ Dispatch();
 }
 
 
-// Sub <src>
+// Sub <src> <slot>
 //
-// Subtract register <src> from accumulator.
+// Subtract register <src> from accumulator, recording the operand types in
+// FeedbackVector slot <slot>.
 void Interpreter::DoSub(compiler::InterpreterAssembler* assembler) {
-  DoBinaryOp(Runtime::kSubtract, assembler);
+  DoBinaryOp(Token::SUB, Runtime::kSubtract, assembler);
 }
 
 
-// Mul <src>
+// Mul <src> <slot>
 //
-// Multiply accumulator by register <src>.
+// Multiply accumulator by register <src>, recording the operand types in
+// FeedbackVector slot <slot>.
 void Interpreter::DoMul(compiler::InterpreterAssembler* assembler) {
-  DoBinaryOp(Runtime::kMultiply, assembler);
+  DoBinaryOp(Token::MUL, Runtime::kMultiply, assembler);
 }
 
 
-// Div <src>
+// Div <src> <slot>
 //
-// Divide register <src> by accumulator.
+// Divide register <src> by accumulator, recording the operand types in
+// FeedbackVector slot <slot>.
 void Interpreter::DoDiv(compiler::InterpreterAssembler* assembler) {
-  DoBinaryOp(Runtime::kDivide, assembler);
+  DoBinaryOp(Token::DIV, Runtime::kDivide, assembler);
 }
 
 
-// Mod <src>
+// Mod <src> <slot>
 //
-// Modulo register <src> by accumulator.
+// Modulo register <src> by accumulator, recording the operand types in
+// FeedbackVector slot <slot>.
 void Interpreter::DoMod(compiler::InterpreterAssembler* assembler) {
-  DoBinaryOp(Runtime::kModulus, assembler);
+  DoBinaryOp(Token::MOD, Runtime::kModulus, assembler);
 }
 
 
@@ -326,6 +694,8 @@ void Interpreter::DoMod(compiler::InterpreterAssembler* assembler) {
 //
 // Return the value in register 0.
 void Interpreter::DoReturn(compiler::InterpreterAssembler* assembler) {
+  __ UpdateInterruptBudgetOnReturn();
+  __ ResetBytecodeAge();
   __ Return();
 }
 
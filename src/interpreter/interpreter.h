@@ -8,16 +8,22 @@
 // Clients of this interface shouldn't depend on lots of interpreter internals.
 // Do not include anything from src/interpreter other than
 // src/interpreter/bytecodes.h here!
+#include <iosfwd>
+#include <map>
+#include <vector>
+
 #include "src/base/macros.h"
 #include "src/builtins.h"
 #include "src/interpreter/bytecodes.h"
 #include "src/runtime/runtime.h"
+#include "src/token.h"
 
 namespace v8 {
 namespace internal {
 
 class Isolate;
 class Callable;
+class Zone;
 class CompilationInfo;
 
 namespace compiler {
@@ -26,6 +32,17 @@ class InterpreterAssembler;
 
 namespace interpreter {
 
+// Operand feedback which the binary operation handlers record in the feedback
+// vector slot of the operation. The values form a lattice in which feedback is
+// combined by bitwise or.
+enum class BinaryOperationFeedback {
+  kNone = 0x0,
+  kSignedSmall = 0x1,
+  kNumber = 0x3,
+  kAny = 0x7
+};
+
+
 class Interpreter {
  public:
   explicit Interpreter(Isolate* isolate);
@@ -42,15 +59,78 @@ class Interpreter {
   // Generate bytecode for |info|.
   static bool MakeBytecode(CompilationInfo* info);
 
+  static const int kNumberOfBytecodes = static_cast<int>(Bytecode::kLast) + 1;
+
+  // Called on entry to and exit from every bytecode handler when the handlers
+  // are instrumented for --ignition-profile. |dispatch| identifies the
+  // handler's bytecode and the bytecode it dispatches to, see
+  // ProfileDispatchIndex. |register_file| identifies the interpreted frame the
+  // handler runs in.
+  static void ProfileHandlerEntry(Isolate* isolate, Address register_file);
+  static void ProfileHandlerExit(Isolate* isolate, intptr_t dispatch,
+                                 Address register_file);
+
+  // Returns the |dispatch| index passed to ProfileHandlerExit for a handler of
+  // |from| which dispatches to the bytecode |to|, or returns from the function
+  // if |to| is kNumberOfBytecodes.
+  static int ProfileDispatchIndex(Bytecode from, int to) {
+    return Bytecodes::ToByte(from) * (kNumberOfBytecodes + 1) + to;
+  }
+
+  // Accessors for the profile recorded for --ignition-profile. Handler times
+  // are in ticks of the CPU timestamp counter on x86 hosts and microseconds
+  // elsewhere, and exclude the time spent in functions called by the handler.
+  uint64_t execution_count(Bytecode bytecode) const;
+  uint64_t dispatch_count(Bytecode from, Bytecode to) const;
+  uint64_t handler_ticks(Bytecode bytecode) const;
+  void ResetProfile();
+  size_t profile_stack_depth() const { return profile_stack_.size(); }
+
+  // Prints and resets the profile recorded for --ignition-profile.
+  void PrintAndResetProfile(std::ostream& os);
+
+  // A bytecode sequence which was executed |count| times.
+  struct SuperinstructionCandidate {
+    Bytecode bytecodes[3];
+    int length;
+    uint64_t count;
+
+    // The number of dispatches a superinstruction for the sequence would
+    // have saved.
+    uint64_t saved_dispatches() const { return count * (length - 1); }
+  };
+
+  // Accessors for the executed bytecode pairs and triples. Pairs are counted
+  // for --ignition-profile, triples also need --ignition-sequence-stats. The
+  // counts are reset with the rest of the profile.
+  uint64_t sequence_count(Bytecode first, Bytecode second) const;
+  uint64_t sequence_count(Bytecode first, Bytecode second,
+                          Bytecode third) const;
+
+  // Returns the executed bytecode pairs and triples which don't involve a
+  // prefix bytecode, ordered by the dispatches a superinstruction would have
+  // saved, most first.
+  std::vector<SuperinstructionCandidate> SuperinstructionCandidates() const;
+
+  // Prints the most promising superinstruction candidates for
+  // --ignition-sequence-stats.
+  void PrintSuperinstructionCandidates(std::ostream& os) const;
+
  private:
+  // Counts the bytecode triple which ends with the dispatch identified by
+  // |dispatch| in the interpreted frame of |register_file|.
+  void RecordSequence(int dispatch, Address register_file);
+
 // Bytecode handler generator functions.
 #define DECLARE_BYTECODE_HANDLER_GENERATOR(Name, ...) \
   void Do##Name(compiler::InterpreterAssembler* assembler);
   BYTECODE_LIST(DECLARE_BYTECODE_HANDLER_GENERATOR)
 #undef DECLARE_BYTECODE_HANDLER_GENERATOR
 
-  // Generates code to perform the binary operations via |function_id|.
-  void DoBinaryOp(Runtime::FunctionId function_id,
+  // Generates code to perform the binary operation |op| inline for numbers
+  // and via |function_id| otherwise, recording the operand feedback in the
+  // slot given by operand 1.
+  void DoBinaryOp(Token::Value op, Runtime::FunctionId function_id,
                   compiler::InterpreterAssembler* assembler);
 
   // Generates code to perform a property load via |ic|.
@@ -60,10 +140,51 @@ class Interpreter {
   void DoPropertyStoreIC(Callable ic,
                          compiler::InterpreterAssembler* assembler);
 
+  typedef void (Interpreter::*HandlerGenerator)(
+      compiler::InterpreterAssembler* assembler);
+
+  // Generates the handlers for |bytecode| at every operand scale and installs
+  // them in |handler_table|.
+  void GenerateHandlers(Zone* zone, Handle<FixedArray> handler_table,
+                        Bytecode bytecode, HandlerGenerator generator);
+
   bool IsInterpreterTableInitialized(Handle<FixedArray> handler_table);
 
   Isolate* isolate_;
 
+  // A bytecode handler that has been entered but not yet exited.
+  struct ProfileFrame {
+    Address register_file;
+    uint64_t entry_ticks;
+    uint64_t callee_ticks;
+  };
+
+  // Pops the frames of handlers that threw and so were never exited: those
+  // of interpreted frames deeper on the stack than |register_file|, and with
+  // |include_frame| also those of |register_file|'s frame. Their time up to
+  // |ticks| is charged as callee time to the handler below them.
+  void UnwindProfileStack(Address register_file, bool include_frame,
+                          uint64_t ticks);
+
+  // The last dispatch of an interpreted frame, for counting triples.
+  struct SequenceFrame {
+    Address register_file;
+    int previous_dispatch;
+  };
+
+  // Profile recorded for --ignition-profile, allocated by Initialize() when
+  // the handlers are instrumented. Dispatch counts are indexed by
+  // ProfileDispatchIndex, handler ticks by bytecode.
+  std::vector<uint64_t> dispatch_counts_;
+  std::vector<uint64_t> handler_ticks_;
+  std::vector<ProfileFrame> profile_stack_;
+
+  // Triple counts recorded for --ignition-sequence-stats, keyed by the
+  // ProfileDispatchIndex of the first two bytecodes times
+  // kNumberOfBytecodes + 1 plus the third bytecode.
+  std::map<int, uint64_t> triple_counts_;
+  std::vector<SequenceFrame> sequence_stack_;
+
   DISALLOW_COPY_AND_ASSIGN(Interpreter);
 };
 
@@ -27,6 +27,8 @@
 #include "src/ic/stub-cache.h"
 #include "src/interpreter/interpreter.h"
 #include "src/isolate-inl.h"
+#include "src/lazy-compile-profiler.h"
+#include "src/lazy-compile-queue.h"
 #include "src/lithium-allocator.h"
 #include "src/log.h"
 #include "src/messages.h"
@@ -1728,6 +1730,7 @@ Isolate::Isolate(bool enable_serializer)
       bootstrapper_(NULL),
       runtime_profiler_(NULL),
       compilation_cache_(NULL),
+      lazy_compile_profiler_(NULL),
       counters_(NULL),
       code_range_(NULL),
       logger_(NULL),
@@ -1764,6 +1767,7 @@ Isolate::Isolate(bool enable_serializer)
       function_entry_hook_(NULL),
       deferred_handles_head_(NULL),
       optimizing_compile_dispatcher_(NULL),
+      lazy_compile_queue_(NULL),
       stress_deopt_count_(0),
       next_optimization_id_(0),
 #if TRACE_MAPS
@@ -1865,6 +1869,12 @@ void Isolate::Deinit() {
     optimizing_compile_dispatcher_ = NULL;
   }
 
+  if (lazy_compile_queue_ != NULL) {
+    lazy_compile_queue_->Stop();
+    delete lazy_compile_queue_;
+    lazy_compile_queue_ = NULL;
+  }
+
   if (heap_.mark_compact_collector()->sweeping_in_progress()) {
     heap_.mark_compact_collector()->EnsureSweepingCompleted();
   }
@@ -1974,6 +1984,8 @@ Isolate::~Isolate() {
 
   delete compilation_cache_;
   compilation_cache_ = NULL;
+  delete lazy_compile_profiler_;
+  lazy_compile_profiler_ = NULL;
   delete bootstrapper_;
   bootstrapper_ = NULL;
   delete inner_pointer_to_code_cache_;
@@ -2089,6 +2101,7 @@ bool Isolate::Init(Deserializer* des) {
 #undef ASSIGN_ELEMENT
 
   compilation_cache_ = new CompilationCache(this);
+  lazy_compile_profiler_ = new LazyCompileProfiler();
   keyed_lookup_cache_ = new KeyedLookupCache();
   context_slot_cache_ = new ContextSlotCache();
   descriptor_lookup_cache_ = new DescriptorLookupCache();
@@ -2165,6 +2178,10 @@ bool Isolate::Init(Deserializer* des) {
     optimizing_compile_dispatcher_ = new OptimizingCompileDispatcher(this);
   }
 
+  if (LazyCompileQueue::Enabled()) {
+    lazy_compile_queue_ = new LazyCompileQueue(this);
+  }
+
   // Initialize runtime profiler before deserialization, because collections may
   // occur, clearing/updating ICs.
   runtime_profiler_ = new RuntimeProfiler(this);
@@ -2351,6 +2368,14 @@ void Isolate::DumpAndResetCompilationStats() {
     os << *turbo_statistics() << std::endl;
   }
   if (hstatistics() != nullptr) hstatistics()->Print();
+  if (FLAG_ignition_sequence_stats && interpreter_ != nullptr) {
+    OFStream os(stdout);
+    interpreter_->PrintSuperinstructionCandidates(os);
+  }
+  if (FLAG_ignition_profile && interpreter_ != nullptr) {
+    OFStream os(stdout);
+    interpreter_->PrintAndResetProfile(os);
+  }
   delete turbo_statistics_;
   turbo_statistics_ = nullptr;
   delete hstatistics_;
@@ -64,6 +64,8 @@ class HStatistics;
 class HTracer;
 class InlineRuntimeFunctionsTable;
 class InnerPointerToCodeCache;
+class LazyCompileProfiler;
+class LazyCompileQueue;
 class Logger;
 class MaterializedObjectStore;
 class CodeAgingHelper;
@@ -387,6 +389,7 @@ typedef List<HeapObject*> DebugObjectCache;
   V(uint32_t, per_isolate_assert_data, 0xFFFFFFFFu)                            \
   V(PromiseRejectCallback, promise_reject_callback, NULL)                      \
   V(const v8::StartupData*, snapshot_blob, NULL)                               \
+  V(intptr_t*, api_external_references, NULL)                                  \
   ISOLATE_INIT_SIMULATOR_LIST(V)
 
 #define THREAD_LOCAL_TOP_ACCESSOR(type, name)                        \
@@ -807,6 +810,9 @@ class Isolate {
   CodeRange* code_range() { return code_range_; }
   RuntimeProfiler* runtime_profiler() { return runtime_profiler_; }
   CompilationCache* compilation_cache() { return compilation_cache_; }
+  LazyCompileProfiler* lazy_compile_profiler() {
+    return lazy_compile_profiler_;
+  }
   Logger* logger() {
     // Call InitializeLoggingAndCounters() if logging is needed before
     // the isolate is fully initialized.
@@ -1008,6 +1014,9 @@ class Isolate {
     return optimizing_compile_dispatcher_;
   }
 
+  // Only available with --background-lazy-compile.
+  LazyCompileQueue* lazy_compile_queue() { return lazy_compile_queue_; }
+
   int id() const { return static_cast<int>(id_); }
 
   HStatistics* GetHStatistics();
@@ -1203,6 +1212,7 @@ class Isolate {
   Bootstrapper* bootstrapper_;
   RuntimeProfiler* runtime_profiler_;
   CompilationCache* compilation_cache_;
+  LazyCompileProfiler* lazy_compile_profiler_;
   Counters* counters_;
   CodeRange* code_range_;
   base::RecursiveMutex break_access_;
@@ -1295,6 +1305,7 @@ class Isolate {
 
   DeferredHandles* deferred_handles_head_;
   OptimizingCompileDispatcher* optimizing_compile_dispatcher_;
+  LazyCompileQueue* lazy_compile_queue_;
 
   // Counts deopt points if deopt_every_n_times is enabled.
   unsigned int stress_deopt_count_;
@@ -1333,6 +1344,7 @@ class Isolate {
   friend class v8::Locker;
   friend class v8::Unlocker;
   friend v8::StartupData v8::V8::CreateSnapshotDataBlob(const char*);
+  friend class v8::SnapshotCreator;
 
   DISALLOW_COPY_AND_ASSIGN(Isolate);
 };
@@ -0,0 +1,210 @@
+// Copyright 2015 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/lazy-compile-profiler.h"
+
+#include <algorithm>
+
+#include "src/isolate.h"
+#include "src/list-inl.h"
+#include "src/objects-inl.h"
+#include "src/preparse-data.h"
+
+namespace v8 {
+namespace internal {
+
+LazyCompileProfiler::LazyCompileProfiler()
+    : entries_(HashMap::PointersMatch), purged_ms_count_(-1) {}
+
+
+LazyCompileProfiler::~LazyCompileProfiler() {
+  for (HashMap::Entry* p = entries_.Start(); p != NULL; p = entries_.Next(p)) {
+    delete reinterpret_cast<Entry*>(p->value);
+  }
+}
+
+
+namespace {
+
+void* ScriptIdToKey(int script_id) {
+  return reinterpret_cast<void*>(static_cast<intptr_t>(script_id));
+}
+
+
+uint32_t ScriptIdHash(int script_id) {
+  return ComputeIntegerHash(static_cast<uint32_t>(script_id), 0);
+}
+
+}  // namespace
+
+
+HashMap::Entry* LazyCompileProfiler::Lookup(int script_id) {
+  return entries_.Lookup(ScriptIdToKey(script_id), ScriptIdHash(script_id));
+}
+
+
+bool LazyCompileProfiler::InWindow(Entry* entry) {
+  return (base::TimeTicks::Now() - entry->start).InMilliseconds() <
+         FLAG_lazy_compile_profile_window;
+}
+
+
+void LazyCompileProfiler::RemoveExpiredEntries(Isolate* isolate) {
+  // Entries are keyed by script id, so the ids of the scripts that are still
+  // on the heap's script list tell which ones are alive. Dead scripts only
+  // leave the list in a full GC, so the list is only scanned after one.
+  bool check_alive = purged_ms_count_ != isolate->heap()->ms_count();
+  purged_ms_count_ = isolate->heap()->ms_count();
+  HashMap live_scripts(HashMap::PointersMatch);
+  if (check_alive) {
+    DisallowHeapAllocation no_gc;
+    Script::Iterator iterator(isolate);
+    Script* script;
+    while ((script = iterator.Next()) != NULL) {
+      int script_id = script->id()->value();
+      live_scripts.LookupOrInsert(ScriptIdToKey(script_id),
+                                  ScriptIdHash(script_id));
+    }
+  }
+  // Removing entries moves others in the map, so only collect keys first.
+  List<void*> expired;
+  for (HashMap::Entry* p = entries_.Start(); p != NULL; p = entries_.Next(p)) {
+    Entry* entry = reinterpret_cast<Entry*>(p->value);
+    bool alive = !check_alive || live_scripts.Lookup(p->key, p->hash) != NULL;
+    if (!alive || (entry->positions.is_empty() && !InWindow(entry))) {
+      expired.Add(p->key);
+      delete entry;
+    }
+  }
+  for (int i = 0; i < expired.length(); i++) {
+    int script_id = static_cast<int>(reinterpret_cast<intptr_t>(expired[i]));
+    entries_.Remove(expired[i], ScriptIdHash(script_id));
+  }
+}
+
+
+void LazyCompileProfiler::ScriptCompiled(Handle<Script> script,
+                                         ScriptData* consumed_profile) {
+  if (FLAG_lazy_compile_profile_window <= 0) return;
+  if (entries_.occupancy() >= static_cast<uint32_t>(kMaxScripts)) {
+    RemoveExpiredEntries(script->GetIsolate());
+    if (entries_.occupancy() >= static_cast<uint32_t>(kMaxScripts)) return;
+  }
+  int script_id = script->id()->value();
+  HashMap::Entry* p = entries_.LookupOrInsert(ScriptIdToKey(script_id),
+                                              ScriptIdHash(script_id));
+  if (p->value == NULL) p->value = new Entry();
+  Entry* entry = reinterpret_cast<Entry*>(p->value);
+  entry->start = base::TimeTicks::Now();
+  entry->positions.Clear();
+  if (consumed_profile != NULL) {
+    Vector<const uint32_t> positions = FunctionPositions(consumed_profile);
+    for (int i = 0; i < positions.length(); i++) {
+      entry->positions.Add(static_cast<int>(positions[i]));
+    }
+  }
+}
+
+
+void LazyCompileProfiler::FunctionCompiled(Handle<SharedFunctionInfo> shared) {
+  if (FLAG_lazy_compile_profile_window <= 0 || entries_.occupancy() == 0) {
+    return;
+  }
+  if (!shared->script()->IsScript() || shared->is_toplevel()) return;
+  HashMap::Entry* p = Lookup(Script::cast(shared->script())->id()->value());
+  if (p == NULL) return;
+  Entry* entry = reinterpret_cast<Entry*>(p->value);
+  if (InWindow(entry)) entry->positions.Add(shared->start_position());
+}
+
+
+ScriptData* LazyCompileProfiler::Export(Handle<Script> script) {
+  HashMap::Entry* p = Lookup(script->id()->value());
+  if (p == NULL || !script->source()->IsString()) return NULL;
+  Entry* entry = reinterpret_cast<Entry*>(p->value);
+  if (entry->positions.is_empty()) return NULL;
+
+  List<int> positions(entry->positions.length());
+  positions.AddAll(entry->positions);
+  positions.Sort();
+  int count = 0;
+  for (int i = 0; i < positions.length(); i++) {
+    if (count == 0 || positions[count - 1] != positions[i]) {
+      positions[count++] = positions[i];
+    }
+  }
+
+  String* source = String::cast(script->source());
+  int length = kHeaderSize + count;
+  uint32_t* data = NewArray<uint32_t>(length);
+  data[kMagicNumberOffset] = kMagicNumber;
+  data[kSourceHashOffset] = SourceHash(source);
+  data[kSourceLengthOffset] = static_cast<uint32_t>(source->length());
+  data[kFunctionCountOffset] = static_cast<uint32_t>(count);
+  for (int i = 0; i < count; i++) {
+    data[kHeaderSize + i] = static_cast<uint32_t>(positions[i]);
+  }
+  ScriptData* result = new ScriptData(reinterpret_cast<byte*>(data),
+                                      length * sizeof(uint32_t));
+  result->AcquireDataOwnership();
+  return result;
+}
+
+
+// static
+uint32_t LazyCompileProfiler::SourceHash(String* source) {
+  DisallowHeapAllocation no_gc;
+  // FNV-1a over the UTF-16 code units, so that one-byte and two-byte
+  // representations of the same source hash alike.
+  uint32_t hash = 2166136261u;
+  String::FlatContent content = source->GetFlatContent();
+  int length = source->length();
+  for (int i = 0; i < length; i++) {
+    hash = (hash ^ content.Get(i)) * 16777619u;
+  }
+  return hash;
+}
+
+
+// static
+bool LazyCompileProfiler::Validate(ScriptData* data, Handle<String> source) {
+  source = String::Flatten(source);
+  const uint32_t* words = reinterpret_cast<const uint32_t*>(data->data());
+  int length = data->length() / static_cast<int>(sizeof(uint32_t));
+  bool valid = data->length() % sizeof(uint32_t) == 0 && length >= kHeaderSize;
+  if (valid) {
+    valid = words[kMagicNumberOffset] == kMagicNumber &&
+            words[kFunctionCountOffset] ==
+                static_cast<uint32_t>(length - kHeaderSize) &&
+            words[kSourceLengthOffset] ==
+                static_cast<uint32_t>(source->length()) &&
+            words[kSourceHashOffset] == SourceHash(*source);
+    for (int i = kHeaderSize; valid && i < length; i++) {
+      valid = words[i] < static_cast<uint32_t>(source->length()) &&
+              (i == kHeaderSize || words[i - 1] < words[i]);
+    }
+  }
+  if (!valid) data->Reject();
+  return valid;
+}
+
+
+// static
+Vector<const uint32_t> LazyCompileProfiler::FunctionPositions(
+    ScriptData* data) {
+  const uint32_t* words = reinterpret_cast<const uint32_t*>(data->data());
+  return Vector<const uint32_t>(words + kHeaderSize,
+                                words[kFunctionCountOffset]);
+}
+
+
+// static
+bool LazyCompileProfiler::Contains(Vector<const uint32_t> positions,
+                                   int position) {
+  return std::binary_search(positions.start(), positions.end(),
+                            static_cast<uint32_t>(position));
+}
+
+}  // namespace internal
+}  // namespace v8
@@ -0,0 +1,98 @@
+// Copyright 2015 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8_LAZY_COMPILE_PROFILER_H_
+#define V8_LAZY_COMPILE_PROFILER_H_
+
+#include "src/base/platform/time.h"
+#include "src/handles.h"
+#include "src/hashmap.h"
+#include "src/list.h"
+#include "src/vector.h"
+
+namespace v8 {
+namespace internal {
+
+class Isolate;
+class Script;
+class ScriptData;
+class SharedFunctionInfo;
+class String;
+
+// Records which lazily compiled functions of a script are compiled within
+// the first FLAG_lazy_compile_profile_window milliseconds after the script.
+// Such functions were preparsed and later parsed again for nothing.
+//
+// The profile of a script can be exported and passed back with
+// ScriptCompiler::kConsumeCompileProfile on a later load of the same source.
+// The parser then parses the functions in the profile eagerly and the
+// compiler compiles them along with the top-level code.
+//
+// A profile only consists of the source positions of the functions and a
+// hash of the source, so unlike the code cache it stays valid across V8
+// versions and flags.
+class LazyCompileProfiler {
+ public:
+  LazyCompileProfiler();
+  ~LazyCompileProfiler();
+
+  // Starts the recording window of a newly compiled script. The functions of
+  // a profile it was compiled with are carried over, since they are not
+  // compiled lazily anymore.
+  void ScriptCompiled(Handle<Script> script, ScriptData* consumed_profile);
+
+  // Records a lazily compiled function if its script is still in its
+  // recording window.
+  void FunctionCompiled(Handle<SharedFunctionInfo> shared);
+
+  // Returns the profile recorded for the script, or NULL if no function was
+  // recorded. The caller owns the result.
+  ScriptData* Export(Handle<Script> script);
+
+  // Checks that the data is a well-formed profile for the source. Rejects
+  // the data otherwise.
+  static bool Validate(ScriptData* data, Handle<String> source);
+
+  // Returns the sorted start positions of the functions in valid data.
+  static Vector<const uint32_t> FunctionPositions(ScriptData* data);
+
+  // Returns whether a function starting at the position is in the profile.
+  static bool Contains(Vector<const uint32_t> positions, int position);
+
+ private:
+  struct Entry {
+    base::TimeTicks start;
+    List<int> positions;
+  };
+
+  static const uint32_t kMagicNumber = 0x4C435046;  // "LCPF"
+  static const int kMagicNumberOffset = 0;
+  static const int kSourceHashOffset = 1;
+  static const int kSourceLengthOffset = 2;
+  static const int kFunctionCountOffset = 3;
+  static const int kHeaderSize = 4;
+
+  // Scripts compiled while this many live scripts are recorded are not
+  // recorded.
+  static const int kMaxScripts = 1024;
+
+  static uint32_t SourceHash(String* source);
+
+  HashMap::Entry* Lookup(int script_id);
+  bool InWindow(Entry* entry);
+  // Drops the entries of scripts whose window is over with nothing recorded,
+  // and of scripts that have died since the last full GC it looked at.
+  void RemoveExpiredEntries(Isolate* isolate);
+
+  HashMap entries_;
+  // The mark-sweep count at which dead scripts were last dropped.
+  int purged_ms_count_;
+
+  DISALLOW_COPY_AND_ASSIGN(LazyCompileProfiler);
+};
+
+}  // namespace internal
+}  // namespace v8
+
+#endif  // V8_LAZY_COMPILE_PROFILER_H_
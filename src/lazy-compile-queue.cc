@@ -0,0 +1,273 @@
+// Copyright 2015 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/lazy-compile-queue.h"
+
+#include "src/compiler.h"
+#include "src/debug/debug.h"
+#include "src/isolate.h"
+#include "src/list-inl.h"
+#include "src/parser.h"
+#include "src/scanner-character-streams.h"
+#include "src/v8.h"
+
+namespace v8 {
+namespace internal {
+
+class LazyCompileQueue::Job {
+ public:
+  enum State { kQueued, kParsing, kParsed };
+
+  explicit Job(Handle<SharedFunctionInfo> shared);
+  ~Job();
+
+  // Runs on a background thread.
+  void Parse(uintptr_t stack_limit);
+
+  // Compiles the parsed function on the main thread. Returns false if it was
+  // not parsed or does not need to be compiled anymore.
+  bool Compile(Isolate* isolate);
+
+  SharedFunctionInfo* shared() const { return *parse_info_->shared_info(); }
+
+  State state() const { return state_; }
+  void set_state(State state) { state_ = state; }
+
+ private:
+  Zone zone_;
+  UnicodeCache unicode_cache_;
+  ParseInfo* parse_info_;
+  DeferredHandles* handles_;
+  LazyFunctionInfo* function_;
+  // A copy of the source of the function, since the source string may move.
+  Vector<uc16> source_;
+  // Stays alive after parsing for internalizing on the main thread.
+  Parser* parser_;
+  State state_;
+
+  DISALLOW_COPY_AND_ASSIGN(Job);
+};
+
+
+LazyCompileQueue::Job::Job(Handle<SharedFunctionInfo> shared)
+    : parser_(NULL), state_(kQueued) {
+  Isolate* isolate = shared->GetIsolate();
+  {
+    // The handles of the parse info have to live as long as the job.
+    DeferredHandleScope deferred(isolate);
+    parse_info_ = new ParseInfo(&zone_, handle(*shared, isolate));
+    handles_ = deferred.Detach();
+  }
+  parse_info_->set_unicode_cache(&unicode_cache_);
+  parse_info_->set_ast_value_factory(
+      new AstValueFactory(&zone_, parse_info_->hash_seed()));
+  parse_info_->set_ast_value_factory_owned();
+  function_ = new LazyFunctionInfo(shared, parse_info_->ast_value_factory());
+
+  String* source = String::cast(parse_info_->script()->source());
+  source_ = Vector<uc16>::New(function_->end_position -
+                              function_->start_position);
+  String::WriteToFlat(source, source_.start(), function_->start_position,
+                      function_->end_position);
+}
+
+
+LazyCompileQueue::Job::~Job() {
+  delete parser_;
+  delete function_;
+  delete parse_info_;
+  delete handles_;
+  source_.Dispose();
+}
+
+
+void LazyCompileQueue::Job::Parse(uintptr_t stack_limit) {
+  DisallowHeapAllocation no_allocation;
+  DisallowHandleAllocation no_handles;
+  DisallowHandleDereference no_deref;
+
+  parse_info_->set_stack_limit(stack_limit);
+  FlatStringUtf16CharacterStream stream(
+      Vector<const uc16>(source_.start(), source_.length()),
+      function_->start_position);
+  parser_ = new Parser(parse_info_);
+  parser_->ParseLazyOnBackground(parse_info_, *function_, &stream);
+}
+
+
+bool LazyCompileQueue::Job::Compile(Isolate* isolate) {
+  DCHECK_EQ(kParsed, state_);
+  Handle<SharedFunctionInfo> shared = parse_info_->shared_info();
+  // Errors are reported when the function is parsed again at its call. The
+  // function may also have been compiled in the meantime, and the debugger
+  // may have changed the source of its script.
+  if (parse_info_->literal() == NULL || shared->is_compiled() ||
+      isolate->debug()->is_active()) {
+    return false;
+  }
+  parser_->Internalize(isolate, parse_info_->script(), false);
+  parse_info_->literal()->set_inferred_name(
+      handle(shared->inferred_name(), isolate));
+  return Compiler::CompileParsedFunction(parse_info_);
+}
+
+
+class LazyCompileQueue::ParseTask : public v8::Task {
+ public:
+  explicit ParseTask(LazyCompileQueue* queue) : queue_(queue) {}
+
+  virtual ~ParseTask() {}
+
+ private:
+  // v8::Task overrides.
+  void Run() override { queue_->ParseNextJob(); }
+
+  LazyCompileQueue* queue_;
+
+  DISALLOW_COPY_AND_ASSIGN(ParseTask);
+};
+
+
+LazyCompileQueue::LazyCompileQueue(Isolate* isolate)
+    : isolate_(isolate), pending_tasks_(0), stopped_(false) {}
+
+
+LazyCompileQueue::~LazyCompileQueue() {
+  DCHECK_EQ(0, pending_tasks_);
+  DCHECK(jobs_.is_empty());
+}
+
+
+// static
+bool LazyCompileQueue::CanParse(SharedFunctionInfo* shared) {
+  return !shared->is_compiled() && !shared->is_toplevel() &&
+         shared->allows_lazy_compilation() && shared->script()->IsScript() &&
+         Script::cast(shared->script())->source()->IsString();
+}
+
+
+bool LazyCompileQueue::Enqueue(Handle<SharedFunctionInfo> shared) {
+  if (!CanParse(*shared)) return false;
+  {
+    base::LockGuard<base::Mutex> lock_guard(&mutex_);
+    if (stopped_) return false;
+    for (int i = 0; i < jobs_.length(); i++) {
+      if (jobs_[i]->shared() == *shared) return true;
+    }
+  }
+  Job* job = new Job(shared);
+  {
+    base::LockGuard<base::Mutex> lock_guard(&mutex_);
+    jobs_.Add(job);
+    pending_tasks_++;
+  }
+  V8::GetCurrentPlatform()->CallOnBackgroundThread(
+      new ParseTask(this), v8::Platform::kShortRunningTask);
+  return true;
+}
+
+
+void LazyCompileQueue::EnqueueOrCompile(Handle<SharedFunctionInfo> shared) {
+  if (Enqueue(shared) || !CanParse(*shared)) return;
+  // Parse on the main thread the way a background thread would.
+  Job job(shared);
+  job.Parse(isolate_->stack_guard()->real_climit());
+  job.set_state(Job::kParsed);
+  HandleScope scope(isolate_);
+  job.Compile(isolate_);
+}
+
+
+void LazyCompileQueue::ParseNextJob() {
+  // Tasks are not tied to jobs, so that jobs taken out of the queue before a
+  // task picked them up are simply skipped.
+  Job* job = NULL;
+  {
+    base::LockGuard<base::Mutex> lock_guard(&mutex_);
+    for (int i = 0; !stopped_ && i < jobs_.length(); i++) {
+      if (jobs_[i]->state() == Job::kQueued) {
+        job = jobs_[i];
+        job->set_state(Job::kParsing);
+        break;
+      }
+    }
+  }
+
+  if (job != NULL) {
+    uintptr_t stack_limit =
+        reinterpret_cast<uintptr_t>(&stack_limit) - FLAG_stack_size * KB;
+    job->Parse(stack_limit);
+  }
+
+  base::LockGuard<base::Mutex> lock_guard(&mutex_);
+  if (job != NULL) {
+    job->set_state(Job::kParsed);
+    // The isolate outlives the task as long as pending_tasks_ is not zero.
+    if (!stopped_) isolate_->stack_guard()->RequestInstallLazyCode();
+  }
+  pending_tasks_--;
+  job_parsed_.NotifyAll();
+}
+
+
+void LazyCompileQueue::InstallParsedFunctions() {
+  List<Job*> parsed;
+  {
+    base::LockGuard<base::Mutex> lock_guard(&mutex_);
+    for (int i = 0; i < jobs_.length();) {
+      if (jobs_[i]->state() == Job::kParsed) {
+        parsed.Add(jobs_.Remove(i));
+      } else {
+        i++;
+      }
+    }
+  }
+  for (int i = 0; i < parsed.length(); i++) Finalize(parsed[i]);
+}
+
+
+void LazyCompileQueue::FinishFunction(Handle<SharedFunctionInfo> shared) {
+  Job* job = NULL;
+  {
+    base::LockGuard<base::Mutex> lock_guard(&mutex_);
+    for (int i = 0; i < jobs_.length(); i++) {
+      if (jobs_[i]->shared() == *shared) {
+        job = jobs_[i];
+        break;
+      }
+    }
+    if (job == NULL) return;
+    while (job->state() == Job::kParsing) job_parsed_.Wait(&mutex_);
+    // Only the main thread removes jobs, so the job is still queued.
+    jobs_.RemoveElement(job);
+  }
+  if (job->state() == Job::kParsed) {
+    Finalize(job);
+  } else {
+    delete job;
+  }
+}
+
+
+void LazyCompileQueue::Finalize(Job* job) {
+  HandleScope scope(isolate_);
+  job->Compile(isolate_);
+  delete job;
+}
+
+
+void LazyCompileQueue::Stop() {
+  List<Job*> jobs;
+  {
+    base::LockGuard<base::Mutex> lock_guard(&mutex_);
+    stopped_ = true;
+    while (pending_tasks_ > 0) job_parsed_.Wait(&mutex_);
+    jobs.AddAll(jobs_);
+    jobs_.Clear();
+  }
+  for (int i = 0; i < jobs.length(); i++) delete jobs[i];
+}
+
+}  // namespace internal
+}  // namespace v8
@@ -0,0 +1,88 @@
+// Copyright 2015 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8_LAZY_COMPILE_QUEUE_H_
+#define V8_LAZY_COMPILE_QUEUE_H_
+
+#include "src/base/platform/condition-variable.h"
+#include "src/base/platform/mutex.h"
+#include "src/flags.h"
+#include "src/handles.h"
+#include "src/list.h"
+
+namespace v8 {
+namespace internal {
+
+class SharedFunctionInfo;
+
+// Parses lazily compiled functions that are expected to be called soon on
+// background threads, so that their first call does not stall on parsing.
+//
+// Generating code allocates on the heap, so that is left to the main thread:
+// a background thread that has parsed a function requests an interrupt, and
+// the function is compiled at the next interrupt check. A function that is
+// called before that waits for its parse to finish, or is parsed on the main
+// thread as usual if no background thread picked it up yet.
+//
+// Only functions declared directly in a script are queued, as marked by the
+// parser. They are parsed without the scope of the script, which would have
+// to be read from the heap, so their free variables are accessed through
+// global ICs. Those also find the lexical declarations of script contexts.
+class LazyCompileQueue {
+ public:
+  explicit LazyCompileQueue(Isolate* isolate);
+  ~LazyCompileQueue();
+
+  static bool Enabled() { return FLAG_background_lazy_compile; }
+
+  // Queues a function directly in its script if it is not compiled yet.
+  // Returns whether it is queued.
+  bool Enqueue(Handle<SharedFunctionInfo> shared);
+
+  // Queues the function, or compiles it right away if it cannot be queued,
+  // so that the function is not left to be parsed at its first call.
+  void EnqueueOrCompile(Handle<SharedFunctionInfo> shared);
+
+  // Compiles the functions that have been parsed. Called at interrupt checks.
+  void InstallParsedFunctions();
+
+  // Takes the function out of the queue before it is compiled on the main
+  // thread. If it is being parsed, waits for that and compiles it.
+  void FinishFunction(Handle<SharedFunctionInfo> shared);
+
+  // Waits for the background threads and drops all queued functions.
+  void Stop();
+
+ private:
+  class Job;
+  class ParseTask;
+
+  static bool CanParse(SharedFunctionInfo* shared);
+
+  // Called by ParseTask on a background thread.
+  void ParseNextJob();
+
+  // Compiles a parsed job on the main thread and deletes it.
+  void Finalize(Job* job);
+
+  Isolate* isolate_;
+
+  base::Mutex mutex_;
+  // Signaled when a job has been parsed and when a task has finished.
+  base::ConditionVariable job_parsed_;
+
+  // Jobs in the order they were queued. Guarded by mutex_.
+  List<Job*> jobs_;
+  // Number of posted tasks that did not finish yet. Guarded by mutex_.
+  int pending_tasks_;
+  // Set once the isolate is torn down. Guarded by mutex_.
+  bool stopped_;
+
+  DISALLOW_COPY_AND_ASSIGN(LazyCompileQueue);
+};
+
+}  // namespace internal
+}  // namespace v8
+
+#endif  // V8_LAZY_COMPILE_QUEUE_H_
@@ -4112,6 +4112,38 @@ int BytecodeArray::parameter_count() const {
 }
 
 
+int BytecodeArray::interrupt_budget() const {
+  return READ_INT_FIELD(this, kInterruptBudgetOffset);
+}
+
+
+void BytecodeArray::set_interrupt_budget(int interrupt_budget) {
+  WRITE_INT_FIELD(this, kInterruptBudgetOffset, interrupt_budget);
+}
+
+
+int BytecodeArray::bytecode_age() const {
+  return READ_BYTE_FIELD(this, kBytecodeAgeOffset);
+}
+
+
+void BytecodeArray::set_bytecode_age(int age) {
+  DCHECK(age >= kNoAgeBytecodeAge && age <= kIsOldBytecodeAge);
+  WRITE_BYTE_FIELD(this, kBytecodeAgeOffset, static_cast<byte>(age));
+}
+
+
+void BytecodeArray::MakeOlder() {
+  int age = bytecode_age();
+  if (age < kIsOldBytecodeAge) set_bytecode_age(age + 1);
+}
+
+
+bool BytecodeArray::IsOld() const {
+  return bytecode_age() >= kIsOldBytecodeAge;
+}
+
+
 ACCESSORS(BytecodeArray, constant_pool, FixedArray, kConstantPoolOffset)
 
 
@@ -5622,6 +5654,12 @@ bool Script::hide_source() { return BooleanBit::get(flags(), kHideSourceBit); }
 void Script::set_hide_source(bool value) {
   set_flags(BooleanBit::set(flags(), kHideSourceBit, value));
 }
+bool Script::will_serialize() {
+  return BooleanBit::get(flags(), kWillSerializeBit);
+}
+void Script::set_will_serialize(bool value) {
+  set_flags(BooleanBit::set(flags(), kWillSerializeBit, value));
+}
 Script::CompilationState Script::compilation_state() {
   return BooleanBit::get(flags(), kCompilationStateBit) ?
       COMPILATION_STATE_COMPILED : COMPILATION_STATE_INITIAL;
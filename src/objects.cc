@@ -12110,6 +12110,12 @@ void BytecodeArray::Disassemble(std::ostream& os) {
     interpreter::Bytecode bytecode =
         interpreter::Bytecodes::FromByte(bytecode_start[0]);
     bytecode_size = interpreter::Bytecodes::Size(bytecode);
+    if (interpreter::Bytecodes::IsPrefixScalingBytecode(bytecode)) {
+      interpreter::OperandScale operand_scale =
+          interpreter::Bytecodes::PrefixBytecodeToOperandScale(bytecode);
+      bytecode = interpreter::Bytecodes::FromByte(bytecode_start[1]);
+      bytecode_size += interpreter::Bytecodes::Size(bytecode, operand_scale);
+    }
 
     SNPrintF(buf, "%p", bytecode_start);
     os << buf.start() << " : ";
@@ -14665,6 +14671,16 @@ String* StringTable::LookupKeyIfExists(Isolate* isolate, HashTableKey* key) {
 }
 
 
+// The hit score of a compilation cache entry is stored after its value.
+static void IncrementHitScore(CompilationCacheTable* table, int entry_index) {
+  int score_index = entry_index + 2;
+  int score = Smi::cast(table->get(score_index))->value();
+  if (score < CompilationCacheTable::kMaxHitScore) {
+    table->set(score_index, Smi::FromInt(score + 1));
+  }
+}
+
+
 Handle<Object> CompilationCacheTable::Lookup(Handle<String> src,
                                              Handle<Context> context,
                                              LanguageMode language_mode) {
@@ -14690,6 +14706,7 @@ Handle<Object> CompilationCacheTable::LookupEval(
   if (entry == kNotFound) return isolate->factory()->undefined_value();
   int index = EntryToIndex(entry);
   if (!get(index)->IsFixedArray()) return isolate->factory()->undefined_value();
+  IncrementHitScore(this, index);
   return Handle<Object>(get(EntryToIndex(entry) + 1), isolate);
 }
 
@@ -14701,6 +14718,7 @@ Handle<Object> CompilationCacheTable::LookupRegExp(Handle<String> src,
   RegExpKey key(src, flags);
   int entry = FindEntry(&key);
   if (entry == kNotFound) return isolate->factory()->undefined_value();
+  IncrementHitScore(this, EntryToIndex(entry));
   return Handle<Object>(get(EntryToIndex(entry) + 1), isolate);
 }
 
@@ -14718,6 +14736,8 @@ Handle<CompilationCacheTable> CompilationCacheTable::Put(
     if (entry != kNotFound) {
       cache->set(EntryToIndex(entry), *k);
       cache->set(EntryToIndex(entry) + 1, *value);
+      // Script entries are aged by the age of their code, not by hits.
+      cache->set(EntryToIndex(entry) + 2, isolate->heap()->undefined_value());
       return cache;
     }
   }
@@ -14728,6 +14748,7 @@ Handle<CompilationCacheTable> CompilationCacheTable::Put(
       isolate->factory()->NewNumber(static_cast<double>(key.Hash()));
   cache->set(EntryToIndex(entry), *k);
   cache->set(EntryToIndex(entry) + 1, Smi::FromInt(kHashGenerations));
+  cache->set(EntryToIndex(entry) + 2, Smi::FromInt(0));
   cache->ElementAdded();
   return cache;
 }
@@ -14744,8 +14765,11 @@ Handle<CompilationCacheTable> CompilationCacheTable::PutEval(
     DisallowHeapAllocation no_allocation_scope;
     int entry = cache->FindEntry(&key);
     if (entry != kNotFound) {
+      int score = Smi::cast(cache->get(EntryToIndex(entry) + 2))->value();
       cache->set(EntryToIndex(entry), *k);
       cache->set(EntryToIndex(entry) + 1, *value);
+      cache->set(EntryToIndex(entry) + 2,
+                 Smi::FromInt(Max(score, kInitialHitScore)));
       return cache;
     }
   }
@@ -14756,6 +14780,7 @@ Handle<CompilationCacheTable> CompilationCacheTable::PutEval(
       isolate->factory()->NewNumber(static_cast<double>(key.Hash()));
   cache->set(EntryToIndex(entry), *k);
   cache->set(EntryToIndex(entry) + 1, Smi::FromInt(kHashGenerations));
+  cache->set(EntryToIndex(entry) + 2, Smi::FromInt(0));
   cache->ElementAdded();
   return cache;
 }
@@ -14771,17 +14796,20 @@ Handle<CompilationCacheTable> CompilationCacheTable::PutRegExp(
   // to the stored value with a custon IsMatch function during lookups.
   cache->set(EntryToIndex(entry), *value);
   cache->set(EntryToIndex(entry) + 1, *value);
+  cache->set(EntryToIndex(entry) + 2, Smi::FromInt(kInitialHitScore));
   cache->ElementAdded();
   return cache;
 }
 
 
-void CompilationCacheTable::Age() {
+int CompilationCacheTable::Age() {
   DisallowHeapAllocation no_allocation;
   Object* the_hole_value = GetHeap()->the_hole_value();
+  int evicted = 0;
   for (int entry = 0, size = Capacity(); entry < size; entry++) {
     int entry_index = EntryToIndex(entry);
     int value_index = entry_index + 1;
+    int score_index = entry_index + 2;
 
     if (get(entry_index)->IsNumber()) {
       Smi* count = Smi::cast(get(value_index));
@@ -14789,19 +14817,40 @@ void CompilationCacheTable::Age() {
       if (count->value() == 0) {
         NoWriteBarrierSet(this, entry_index, the_hole_value);
         NoWriteBarrierSet(this, value_index, the_hole_value);
+        NoWriteBarrierSet(this, score_index, the_hole_value);
         ElementRemoved();
       } else {
         NoWriteBarrierSet(this, value_index, count);
       }
     } else if (get(entry_index)->IsFixedArray()) {
-      SharedFunctionInfo* info = SharedFunctionInfo::cast(get(value_index));
-      if (info->code()->kind() != Code::FUNCTION || info->code()->IsOld()) {
+      Object* score = get(score_index);
+      bool evict;
+      if (score->IsUndefined()) {
+        // Script entries.
+        SharedFunctionInfo* info = SharedFunctionInfo::cast(get(value_index));
+        evict = info->code()->kind() != Code::FUNCTION ||
+                info->code()->IsOld();
+      } else {
+        // Eval entries and regexp data.
+        evict = score == Smi::FromInt(0);
+        if (get(value_index)->IsSharedFunctionInfo()) {
+          SharedFunctionInfo* info = SharedFunctionInfo::cast(get(value_index));
+          evict |= info->code()->kind() != Code::FUNCTION;
+        }
+      }
+      if (evict) {
         NoWriteBarrierSet(this, entry_index, the_hole_value);
         NoWriteBarrierSet(this, value_index, the_hole_value);
+        NoWriteBarrierSet(this, score_index, the_hole_value);
         ElementRemoved();
+        evicted++;
+      } else if (score->IsSmi()) {
+        NoWriteBarrierSet(this, score_index,
+                          Smi::FromInt(Smi::cast(score)->value() >> 1));
       }
     }
   }
+  return evicted;
 }
 
 
@@ -14814,6 +14863,7 @@ void CompilationCacheTable::Remove(Object* value) {
     if (get(value_index) == value) {
       NoWriteBarrierSet(this, entry_index, the_hole_value);
       NoWriteBarrierSet(this, value_index, the_hole_value);
+      NoWriteBarrierSet(this, entry_index + 2, the_hole_value);
       ElementRemoved();
     }
   }
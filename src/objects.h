@@ -4218,6 +4218,22 @@ class BytecodeArray : public FixedArrayBase {
   inline int parameter_count() const;
   inline void set_parameter_count(int number_of_parameters);
 
+  // Accessors for the interrupt budget, which is decremented as the function
+  // is interpreted and used to decide when to optimize it.
+  inline int interrupt_budget() const;
+  inline void set_interrupt_budget(int interrupt_budget);
+
+  // Bytecode aging. Counts how many full GCs this bytecode has survived
+  // without the function returning. Used to determine when it is relatively
+  // safe to flush the bytecode and replace it with the lazy compilation stub.
+  static const int kNoAgeBytecodeAge = 0;
+  static const int kIsOldBytecodeAge = 3;
+
+  inline int bytecode_age() const;
+  inline void set_bytecode_age(int age);
+  inline void MakeOlder();
+  inline bool IsOld() const;
+
   // Accessors for the constant pool.
   DECL_ACCESSORS(constant_pool, FixedArray)
 
@@ -4235,7 +4251,10 @@ class BytecodeArray : public FixedArrayBase {
   // Layout description.
   static const int kFrameSizeOffset = FixedArrayBase::kHeaderSize;
   static const int kParameterSizeOffset = kFrameSizeOffset + kIntSize;
-  static const int kConstantPoolOffset = kParameterSizeOffset + kIntSize;
+  static const int kInterruptBudgetOffset = kParameterSizeOffset + kIntSize;
+  static const int kBytecodeAgeOffset = kInterruptBudgetOffset + kIntSize;
+  static const int kConstantPoolOffset =
+      POINTER_SIZE_ALIGN(kBytecodeAgeOffset + kCharSize);
   static const int kHeaderSize = kConstantPoolOffset + kPointerSize;
 
   static const int kAlignedSize = OBJECT_POINTER_ALIGN(kHeaderSize);
@@ -6079,6 +6098,12 @@ class Script: public Struct {
   inline bool hide_source();
   inline void set_hide_source(bool value);
 
+  // [will_serialize]: determines whether functions of the script are compiled
+  // with reloc info for serialization, so that a code cache can be created
+  // after they ran. Encoded in the 'flags' field.
+  inline bool will_serialize();
+  inline void set_will_serialize(bool value);
+
   // [origin_options]: optional attributes set by the embedder via ScriptOrigin,
   // and used by the embedder to make decisions about the script. V8 just passes
   // this through. Encoded in the 'flags' field.
@@ -6156,6 +6181,7 @@ class Script: public Struct {
   static const int kOriginOptionsSize = 3;
   static const int kOriginOptionsMask = ((1 << kOriginOptionsSize) - 1)
                                         << kOriginOptionsShift;
+  static const int kWillSerializeBit = kOriginOptionsShift + kOriginOptionsSize;
 
   DISALLOW_IMPLICIT_CONSTRUCTORS(Script);
 };
@@ -7597,7 +7623,7 @@ class CompilationCacheShape : public BaseShape<HashTableKey*> {
   static inline Handle<Object> AsHandle(Isolate* isolate, HashTableKey* key);
 
   static const int kPrefixSize = 0;
-  static const int kEntrySize = 2;
+  static const int kEntrySize = 3;
 };
 
 
@@ -7612,6 +7638,11 @@ class CompilationCacheShape : public BaseShape<HashTableKey*> {
 // Such entries are identified by SharedFunctionInfos pointing to either the
 // recompilation stub, or to "old" code. This avoids memory leaks due to
 // premature caching of scripts and eval strings that are never needed later.
+//
+// Eval and regexp entries also have a hit score, which their lookups increase
+// and Age halves. These entries stay in the cache until Age finds their score
+// at zero, so frequently used ones survive more GCs. Script entries have no
+// hit score (undefined) and are evicted once their code is old.
 class CompilationCacheTable: public HashTable<CompilationCacheTable,
                                               CompilationCacheShape,
                                               HashTableKey*> {
@@ -7635,8 +7666,14 @@ class CompilationCacheTable: public HashTable<CompilationCacheTable,
       Handle<CompilationCacheTable> cache, Handle<String> src,
       JSRegExp::Flags flags, Handle<FixedArray> value);
   void Remove(Object* value);
-  void Age();
+  // Ages all entries and returns the number of evicted cache entries, not
+  // counting hashes.
+  int Age();
   static const int kHashGenerations = 10;
+  // Hit score of new eval and regexp entries, which keeps them for one call
+  // to Age.
+  static const int kInitialHitScore = 1;
+  static const int kMaxHitScore = 255;
 
   DECLARE_CAST(CompilationCacheTable)
 
@@ -17,7 +17,6 @@ namespace {
 
 void DisposeOptimizedCompileJob(OptimizedCompileJob* job,
                                 bool restore_function_code) {
-  // The recompile job is allocated in the CompilationInfo's zone.
   CompilationInfo* info = job->info();
   if (restore_function_code) {
     if (info->is_osr()) {
@@ -32,6 +31,7 @@ void DisposeOptimizedCompileJob(OptimizedCompileJob* job,
       function->ReplaceCode(function->shared()->code());
     }
   }
+  delete job;
   delete info;
 }
 
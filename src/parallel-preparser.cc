@@ -0,0 +1,394 @@
+// Copyright 2015 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/parallel-preparser.h"
+
+#include "src/base/platform/semaphore.h"
+#include "src/base/platform/time.h"
+#include "src/base/sys-info.h"
+#include "src/parser.h"
+#include "src/scanner-character-streams.h"
+#include "src/v8.h"
+
+namespace v8 {
+namespace internal {
+
+// Shared by the main thread and the tasks it posts. The main thread only
+// waits for the tasks that started before it finished preparsing; tasks that
+// start later must not touch the preparser, which may be gone by then. The
+// state is deleted by whichever of them releases it last.
+class ParallelPreparser::TaskState {
+ public:
+  TaskState(ParallelPreparser* preparser, int task_count)
+      : preparser_(preparser),
+        ref_count_(task_count + 1),
+        started_tasks_(0),
+        finished_tasks_(0) {}
+
+  ParallelPreparser* preparser() const { return preparser_; }
+
+  // Called by a task before it uses the preparser. Returns false if the main
+  // thread does not wait for tasks anymore.
+  bool StartTask() {
+    while (true) {
+      base::Atomic32 started = base::Acquire_Load(&started_tasks_);
+      if (started == kClosed) return false;
+      if (base::Acquire_CompareAndSwap(&started_tasks_, started,
+                                       started + 1) == started) {
+        return true;
+      }
+    }
+  }
+
+  void FinishTask() { finished_tasks_.Signal(); }
+
+  // Called by the main thread once all functions have been handed out. Waits
+  // for the tasks that started, and keeps any others from starting. Returns
+  // the number of tasks that started.
+  int WaitForStartedTasks() {
+    base::Atomic32 started;
+    do {
+      started = base::Acquire_Load(&started_tasks_);
+    } while (base::Acquire_CompareAndSwap(&started_tasks_, started,
+                                          kClosed) != started);
+    for (int i = 0; i < started; i++) finished_tasks_.Wait();
+    return started;
+  }
+
+  void Release() {
+    if (base::Barrier_AtomicIncrement(&ref_count_, -1) == 0) delete this;
+  }
+
+ private:
+  static const base::Atomic32 kClosed = -1;
+
+  ParallelPreparser* preparser_;
+  base::Atomic32 ref_count_;
+  base::Atomic32 started_tasks_;
+  base::Semaphore finished_tasks_;
+
+  DISALLOW_COPY_AND_ASSIGN(TaskState);
+};
+
+
+class ParallelPreparser::Task : public v8::Task {
+ public:
+  explicit Task(TaskState* state) : state_(state) {}
+
+  virtual ~Task() {}
+
+ private:
+  // v8::Task overrides.
+  void Run() override {
+    if (state_->StartTask()) {
+      uintptr_t stack_limit =
+          reinterpret_cast<uintptr_t>(&stack_limit) - FLAG_stack_size * KB;
+      state_->preparser()->PreparseFunctions(stack_limit);
+      state_->FinishTask();
+    }
+    state_->Release();
+  }
+
+  TaskState* state_;
+
+  DISALLOW_COPY_AND_ASSIGN(Task);
+};
+
+
+ParallelPreparser::ParallelPreparser(Parser* parser,
+                                     String::FlatContent source,
+                                     uint32_t hash_seed,
+                                     uintptr_t stack_limit)
+    : parser_(parser),
+      source_(source),
+      hash_seed_(hash_seed),
+      stack_limit_(stack_limit),
+      results_(NULL),
+      next_function_(0) {
+  DCHECK(source.IsFlat());
+}
+
+
+ParallelPreparser::~ParallelPreparser() { delete[] results_; }
+
+
+namespace {
+
+template <typename Char>
+bool IsWord(const Char* chars, int length, const char* word) {
+  for (int i = 0; i < length; i++) {
+    if (word[i] == '\0' || chars[i] != static_cast<Char>(word[i])) {
+      return false;
+    }
+  }
+  return word[length] == '\0';
+}
+
+
+inline bool IsWhiteSpaceChar(int c) {
+  return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\v' ||
+         c == '\f' || c == 0xA0 || c == 0xFEFF || c == 0x2028 || c == 0x2029;
+}
+
+
+inline bool IsIdentifierChar(int c) {
+  return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') ||
+         (c >= '0' && c <= '9') || c == '$' || c == '_' || c == '\\' ||
+         c >= 0x80;
+}
+
+
+// Stand-ins for the previous token; punctuators are represented by
+// themselves.
+const int kNoToken = 0;
+const int kOperand = 'a';           // Identifiers, literals.
+const int kExpressionKeyword = '=';  // An expression may follow, e.g. return.
+const int kBlockKeyword = ';';       // A block may follow, e.g. else.
+
+}  // namespace
+
+
+template <typename Char>
+void ParallelPreparser::FindTopLevelFunctions(const Char* chars, int length) {
+  // Whether each open brace starts a function body or block, inside which
+  // functions are not top-level, or an object literal or class body.
+  List<bool> braces;
+  int nested_braces = 0;
+  int prev = kNoToken;
+  bool prev_is_arrow = false;
+  bool last_paren_is_call = false;
+  int i = 0;
+  while (i < length) {
+    int c = chars[i];
+    if (IsWhiteSpaceChar(c)) {
+      i++;
+      continue;
+    }
+    int next = i + 1 < length ? chars[i + 1] : 0;
+    if (c == '/' && next == '/') {
+      while (i < length && chars[i] != '\n' && chars[i] != '\r') i++;
+      continue;
+    }
+    if (c == '/' && next == '*') {
+      i += 2;
+      while (i + 1 < length && !(chars[i] == '*' && chars[i + 1] == '/')) i++;
+      i += 2;
+      continue;
+    }
+    bool was_arrow = prev_is_arrow;
+    prev_is_arrow = false;
+    if (c == '/' && prev != kOperand && prev != ')' && prev != ']') {
+      // Regular expression literal.
+      bool in_class = false;
+      for (i++; i < length; i++) {
+        int r = chars[i];
+        if (r == '\\') {
+          i++;
+        } else if (r == '[') {
+          in_class = true;
+        } else if (r == ']') {
+          in_class = false;
+        } else if ((r == '/' && !in_class) || r == '\n' || r == '\r') {
+          break;
+        }
+      }
+      i++;
+      while (i < length && IsIdentifierChar(chars[i])) i++;
+      prev = kOperand;
+      continue;
+    }
+    if (c == '"' || c == '\'' || c == '`') {
+      for (i++; i < length && chars[i] != c; i++) {
+        if (chars[i] == '\\') {
+          i++;
+          continue;
+        }
+        if (c != '`' && (chars[i] == '\n' || chars[i] == '\r')) break;
+      }
+      i++;
+      prev = kOperand;
+      continue;
+    }
+    if (c >= '0' && c <= '9') {
+      while (i < length && (IsIdentifierChar(chars[i]) || chars[i] == '.')) {
+        i++;
+      }
+      prev = kOperand;
+      continue;
+    }
+    if (IsIdentifierChar(c)) {
+      int start = i;
+      while (i < length && IsIdentifierChar(chars[i])) i++;
+      const Char* word = chars + start;
+      int word_length = i - start;
+      if (IsWord(word, word_length, "function")) {
+        // Only function literals the parser preparses qualify: not nested,
+        // not directly parenthesized, no generators, simple parameters.
+        bool candidate =
+            nested_braces == 0 && !(prev == '(' && !last_paren_is_call);
+        int j = i;
+        while (candidate && j < length && IsWhiteSpaceChar(chars[j])) j++;
+        while (candidate && j < length && IsIdentifierChar(chars[j])) j++;
+        while (candidate && j < length && IsWhiteSpaceChar(chars[j])) j++;
+        candidate = candidate && j < length && chars[j] == '(';
+        for (j++; candidate && j < length && chars[j] != ')'; j++) {
+          candidate = IsWhiteSpaceChar(chars[j]) ||
+                      IsIdentifierChar(chars[j]) || chars[j] == ',';
+        }
+        j++;
+        while (candidate && j < length && IsWhiteSpaceChar(chars[j])) j++;
+        if (candidate && j < length && chars[j] == '{') {
+          function_positions_.Add(j);
+        }
+        prev = kExpressionKeyword;
+      } else if (IsWord(word, word_length, "return") ||
+                 IsWord(word, word_length, "typeof") ||
+                 IsWord(word, word_length, "instanceof") ||
+                 IsWord(word, word_length, "in") ||
+                 IsWord(word, word_length, "new") ||
+                 IsWord(word, word_length, "delete") ||
+                 IsWord(word, word_length, "void") ||
+                 IsWord(word, word_length, "throw") ||
+                 IsWord(word, word_length, "case") ||
+                 IsWord(word, word_length, "yield")) {
+        prev = kExpressionKeyword;
+      } else if (IsWord(word, word_length, "else") ||
+                 IsWord(word, word_length, "try") ||
+                 IsWord(word, word_length, "do") ||
+                 IsWord(word, word_length, "finally")) {
+        prev = kBlockKeyword;
+      } else {
+        prev = kOperand;
+      }
+      continue;
+    }
+    switch (c) {
+      case '(':
+        last_paren_is_call = prev == kOperand || prev == ')' || prev == ']';
+        break;
+      case '{': {
+        bool nested = prev == ')' || prev == kBlockKeyword || prev == '{' ||
+                      prev == '}' || prev == kNoToken || was_arrow;
+        braces.Add(nested);
+        if (nested) nested_braces++;
+        break;
+      }
+      case '}':
+        // Give up on unbalanced braces; the parser will report the error.
+        if (braces.is_empty()) return;
+        if (braces.RemoveLast()) nested_braces--;
+        break;
+      case '>':
+        prev_is_arrow = i > 0 && chars[i - 1] == '=';
+        break;
+    }
+    prev = c;
+    i++;
+  }
+}
+
+
+ScriptData* ParallelPreparser::Run() {
+  base::ElapsedTimer timer;
+  if (FLAG_trace_parse) timer.Start();
+
+  if (source_.IsOneByte()) {
+    Vector<const uint8_t> chars = source_.ToOneByteVector();
+    FindTopLevelFunctions(chars.start(), chars.length());
+  } else {
+    Vector<const uc16> chars = source_.ToUC16Vector();
+    FindTopLevelFunctions(chars.start(), chars.length());
+  }
+  int function_count = function_positions_.length();
+  if (function_count == 0) return NULL;
+
+  results_ = new Result[function_count];
+  for (int i = 0; i < function_count; i++) {
+    results_[i].start_position = function_positions_[i];
+  }
+
+  int task_count = Min(base::SysInfo::NumberOfProcessors() - 1,
+                       Min(kMaxBackgroundTasks,
+                           function_count / kMinFunctionsPerTask));
+  TaskState* state = new TaskState(this, task_count);
+  for (int i = 0; i < task_count; i++) {
+    V8::GetCurrentPlatform()->CallOnBackgroundThread(
+        new Task(state), v8::Platform::kShortRunningTask);
+  }
+  PreparseFunctions(stack_limit_);
+  // Functions still being preparsed by a task have to be waited for, but the
+  // main thread does not wait for busy platform threads to start a task.
+  int started_tasks = state->WaitForStartedTasks();
+  state->Release();
+
+  CompleteParserRecorder recorder;
+  int preparsed_count = 0;
+  for (int i = 0; i < function_count; i++) {
+    Result* result = &results_[i];
+    if (!result->preparsed) continue;
+    recorder.LogFunction(result->start_position, result->log.end(),
+                         result->log.literals(), result->log.properties(),
+                         result->log.language_mode(),
+                         result->log.uses_super_property(),
+                         result->log.calls_eval());
+    preparsed_count++;
+  }
+
+  if (FLAG_trace_parse) {
+    PrintF("[parallel preparse: %d of %d functions on %d threads - took %0.3f "
+           "ms]\n",
+           preparsed_count, function_count, started_tasks + 1,
+           timer.Elapsed().InMillisecondsF());
+  }
+  if (preparsed_count == 0) return NULL;
+  return recorder.GetScriptData();
+}
+
+
+void ParallelPreparser::PreparseFunctions(uintptr_t stack_limit) {
+  UnicodeCache unicode_cache;
+  Zone zone;
+  AstValueFactory ast_value_factory(&zone, hash_seed_);
+  Scanner scanner(&unicode_cache);
+  PreParser preparser(&zone, &scanner, &ast_value_factory, NULL, stack_limit);
+  parser_->SetUpPreParser(&preparser);
+
+  int length = source_.IsOneByte() ? source_.ToOneByteVector().length()
+                                   : source_.ToUC16Vector().length();
+  int function_count = function_positions_.length();
+  while (true) {
+    int index = base::NoBarrier_AtomicIncrement(&next_function_, 1) - 1;
+    if (index >= function_count) break;
+    Result* result = &results_[index];
+    if (source_.IsOneByte()) {
+      FlatStringUtf16CharacterStream stream(
+          source_.ToOneByteVector().start(), result->start_position, length);
+      PreparseFunction(&scanner, &preparser, &stream, result);
+    } else {
+      FlatStringUtf16CharacterStream stream(
+          source_.ToUC16Vector().start(), result->start_position, length);
+      PreparseFunction(&scanner, &preparser, &stream, result);
+    }
+  }
+}
+
+
+void ParallelPreparser::PreparseFunction(Scanner* scanner,
+                                         PreParser* preparser,
+                                         Utf16CharacterStream* stream,
+                                         Result* result) {
+  scanner->Initialize(stream);
+  if (scanner->peek() != Token::LBRACE) return;
+  scanner->Next();
+  // The parser only uses the result for sloppy mode functions with simple
+  // parameters, matching what is assumed here.
+  PreParser::PreParseResult outcome = preparser->PreParseLazyFunction(
+      SLOPPY, kNormalFunction, true, &result->log);
+  result->preparsed =
+      outcome == PreParser::kPreParseSuccess && !result->log.has_error();
+}
+
+
+}  // namespace internal
+}  // namespace v8
@@ -0,0 +1,94 @@
+// Copyright 2015 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8_PARALLEL_PREPARSER_H_
+#define V8_PARALLEL_PREPARSER_H_
+
+#include "src/base/atomicops.h"
+#include "src/objects.h"
+#include "src/preparse-data.h"
+
+namespace v8 {
+namespace internal {
+
+class Parser;
+class PreParser;
+class Scanner;
+class Utf16CharacterStream;
+
+// Preparses the top-level functions of a script on background threads before
+// the script is parsed. A quick character-level scan of the source finds the
+// bodies of top-level functions. These are preparsed concurrently, each
+// thread with its own scanner, zone and AstValueFactory. The results are
+// function entries in the parser cache format, which the parser uses to skip
+// the bodies instead of preparsing them one after another.
+//
+// The scan may find bodies that the parser never skips, or miss some, but it
+// cannot produce wrong entries: an entry is only used for a body that starts
+// at the same position and is preparsed under the same assumptions.
+//
+// Only preparsing is moved off the main thread. With lazy parsing, the bodies
+// of top-level functions are just preparsed while the script is parsed; they
+// are fully parsed later, one at a time, when the functions are first
+// compiled. Fully parsing them in parallel would also mean merging ASTs
+// built in other zones, with strings interned in other AstValueFactories and
+// scopes that must be linked into the script scope.
+//
+// The source is read directly from the heap, so no heap allocation may happen
+// while Run() is active. tools/parser-shell reports the parse time without a
+// parser cache as UncachedParseRunTime; run it with and without
+// --parallel-preparse to compare.
+class ParallelPreparser {
+ public:
+  ParallelPreparser(Parser* parser, String::FlatContent source,
+                    uint32_t hash_seed, uintptr_t stack_limit);
+  ~ParallelPreparser();
+
+  // Returns function entries for the top-level functions that were preparsed
+  // successfully, or NULL if there are none. The caller owns the result.
+  ScriptData* Run();
+
+ private:
+  class Task;
+  class TaskState;
+
+  struct Result {
+    Result() : start_position(-1), preparsed(false) {}
+
+    int start_position;
+    bool preparsed;
+    SingletonLogger log;
+  };
+
+  static const int kMaxBackgroundTasks = 7;
+  // Background tasks are only worth starting for this many functions each.
+  static const int kMinFunctionsPerTask = 16;
+
+  // Finds the positions of the '{' of top-level function bodies that the
+  // parser would preparse.
+  template <typename Char>
+  void FindTopLevelFunctions(const Char* chars, int length);
+
+  // Preparses functions until all have been handed out. Called on the main
+  // thread and from background tasks.
+  void PreparseFunctions(uintptr_t stack_limit);
+  void PreparseFunction(Scanner* scanner, PreParser* preparser,
+                        Utf16CharacterStream* stream, Result* result);
+
+  Parser* parser_;
+  String::FlatContent source_;
+  uint32_t hash_seed_;
+  uintptr_t stack_limit_;
+
+  List<int> function_positions_;
+  Result* results_;
+  base::Atomic32 next_function_;
+
+  DISALLOW_COPY_AND_ASSIGN(ParallelPreparser);
+};
+
+}  // namespace internal
+}  // namespace v8
+
+#endif  // V8_PARALLEL_PREPARSER_H_
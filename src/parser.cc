@@ -13,7 +13,9 @@
 #include "src/char-predicates-inl.h"
 #include "src/codegen.h"
 #include "src/compiler.h"
+#include "src/lazy-compile-profiler.h"
 #include "src/messages.h"
+#include "src/parallel-preparser.h"
 #include "src/preparser.h"
 #include "src/runtime/runtime.h"
 #include "src/scanner-character-streams.h"
@@ -92,6 +94,23 @@ ParseInfo::ParseInfo(Zone* zone, Handle<Script> script) : ParseInfo(zone) {
 }
 
 
+LazyFunctionInfo::LazyFunctionInfo(Handle<SharedFunctionInfo> shared,
+                                   AstValueFactory* ast_value_factory)
+    : name(ast_value_factory->GetString(
+          Handle<String>(String::cast(shared->name())))),
+      kind(shared->kind()),
+      language_mode(shared->language_mode()),
+      function_type(shared->is_expression()
+                        ? (shared->is_anonymous()
+                               ? FunctionLiteral::ANONYMOUS_EXPRESSION
+                               : FunctionLiteral::NAMED_EXPRESSION)
+                        : FunctionLiteral::DECLARATION),
+      is_arrow(shared->is_arrow()),
+      is_default_constructor(shared->is_default_constructor()),
+      start_position(shared->start_position()),
+      end_position(shared->end_position()) {}
+
+
 RegExpBuilder::RegExpBuilder(Zone* zone)
     : zone_(zone),
       pending_empty_(false),
@@ -249,9 +268,17 @@ void RegExpBuilder::AddQuantifierToAtom(
 
 
 FunctionEntry ParseData::GetFunctionEntry(int start) {
+  // Entries are sorted by start position and requested in increasing order.
+  // Entries for functions nested in skipped functions are never requested,
+  // so move past any entry that starts before the given position.
+  int functions_end = PreparseDataConstants::kHeaderSize + FunctionsSize();
+  while ((function_index_ + FunctionEntry::kSize <= functions_end) &&
+         (static_cast<int>(Data()[function_index_]) < start)) {
+    function_index_ += FunctionEntry::kSize;
+  }
   // The current pre-data entry must be a FunctionEntry with the given
   // start position.
-  if ((function_index_ + FunctionEntry::kSize <= Length()) &&
+  if ((function_index_ + FunctionEntry::kSize <= functions_end) &&
       (static_cast<int>(Data()[function_index_]) == start)) {
     int index = function_index_;
     function_index_ += FunctionEntry::kSize;
@@ -262,6 +289,42 @@ FunctionEntry ParseData::GetFunctionEntry(int start) {
 }
 
 
+bool ParseData::GetFreeVariables(FunctionEntry entry, AstValueFactory* factory,
+                                 ZoneList<const AstRawString*>* names,
+                                 Zone* zone) {
+  int names_size = NamesSize();
+  const unsigned* store =
+      Data() + PreparseDataConstants::kHeaderSize + FunctionsSize();
+  int index = entry.free_variables_index();
+  if (index < 0 || index >= names_size) return false;
+  int count = store[index++];
+  for (int i = 0; i < count; i++) {
+    if (index >= names_size) return false;
+    unsigned header = store[index++];
+    int length = static_cast<int>(header >> 1);
+    if (length > names_size - index) return false;
+    const unsigned* chars = store + index;
+    index += length;
+    if (header & 1) {
+      ScopedVector<uint8_t> name(length);
+      for (int j = 0; j < length; j++) {
+        name[j] = static_cast<uint8_t>(chars[j]);
+      }
+      names->Add(factory->GetOneByteString(
+          Vector<const uint8_t>(name.start(), length)), zone);
+    } else {
+      ScopedVector<uint16_t> name(length);
+      for (int j = 0; j < length; j++) {
+        name[j] = static_cast<uint16_t>(chars[j]);
+      }
+      names->Add(factory->GetTwoByteString(
+          Vector<const uint16_t>(name.start(), length)), zone);
+    }
+  }
+  return true;
+}
+
+
 int ParseData::FunctionCount() {
   int functions_size = FunctionsSize();
   if (functions_size < 0) return 0;
@@ -283,9 +346,12 @@ bool ParseData::IsSane() {
   int functions_size = FunctionsSize();
   if (functions_size < 0) return false;
   if (functions_size % FunctionEntry::kSize != 0) return false;
-  // Check that the total size has room for header and function entries.
+  int names_size = NamesSize();
+  if (names_size < 0) return false;
+  // Check that the total size has room for header, function entries and
+  // names.
   int minimum_size =
-      PreparseDataConstants::kHeaderSize + functions_size;
+      PreparseDataConstants::kHeaderSize + functions_size + names_size;
   if (data_length < minimum_size) return false;
   return true;
 }
@@ -320,6 +386,11 @@ int ParseData::FunctionsSize() {
 }
 
 
+int ParseData::NamesSize() {
+  return static_cast<int>(Data()[PreparseDataConstants::kNamesSizeOffset]);
+}
+
+
 void Parser::SetCachedData(ParseInfo* info) {
   if (compile_options_ == ScriptCompiler::kNoCompileOptions) {
     cached_parse_data_ = NULL;
@@ -327,6 +398,10 @@ void Parser::SetCachedData(ParseInfo* info) {
     DCHECK(info->cached_data() != NULL);
     if (compile_options_ == ScriptCompiler::kConsumeParserCache) {
       cached_parse_data_ = ParseData::FromCachedData(*info->cached_data());
+    } else if (compile_options_ == ScriptCompiler::kConsumeCompileProfile) {
+      compile_profile_positions_ =
+          LazyCompileProfiler::FunctionPositions(*info->cached_data());
+      parse_profile_in_background_ = info->parse_profile_in_background();
     }
   }
 }
@@ -904,7 +979,10 @@ Parser::Parser(ParseInfo* info)
       target_stack_(NULL),
       compile_options_(info->compile_options()),
       cached_parse_data_(NULL),
+      preparsed_data_(NULL),
+      parse_profile_in_background_(false),
       total_preparse_skipped_(0),
+      total_parallel_preparse_skipped_(0),
       pre_parse_timer_(NULL),
       parsing_on_main_thread_(true) {
   // Even though we were passed ParseInfo, we should not store it in
@@ -967,6 +1045,24 @@ FunctionLiteral* Parser::ParseProgram(Isolate* isolate, ParseInfo* info) {
   source = String::Flatten(source);
   FunctionLiteral* result;
 
+  // Preparse the top-level functions of large scripts on background threads
+  // first, so that parsing them lazily below only needs to skip their bodies.
+  ScriptData* preparsed_functions = NULL;
+  if (FLAG_parallel_preparse &&
+      compile_options_ == ScriptCompiler::kNoCompileOptions && FLAG_lazy &&
+      allow_lazy() && !allow_natives() && extension_ == NULL &&
+      !info->is_eval() && !info->is_module() &&
+      source->length() >= FLAG_parallel_preparse_min_length) {
+    DisallowHeapAllocation no_allocation;
+    ParallelPreparser preparser(this, source->GetFlatContent(),
+                                isolate->heap()->HashSeed(), stack_limit_);
+    preparsed_functions = preparser.Run();
+    if (preparsed_functions != NULL) {
+      preparsed_data_ = ParseData::FromCachedData(preparsed_functions);
+      if (preparsed_data_ != NULL) preparsed_data_->Initialize();
+    }
+  }
+
   if (source->IsExternalTwoByteString()) {
     // Notice that the stream is destroyed at the end of the branch block.
     // The last line of the blocks can't be moved outside, even though they're
@@ -975,6 +1071,16 @@ FunctionLiteral* Parser::ParseProgram(Isolate* isolate, ParseInfo* info) {
         Handle<ExternalTwoByteString>::cast(source), 0, source->length());
     scanner_.Initialize(&stream);
     result = DoParseProgram(info);
+  } else if (source->IsExternalOneByteString()) {
+    ExternalOneByteStringUtf16CharacterStream stream(
+        Handle<ExternalOneByteString>::cast(source), 0, source->length());
+    scanner_.Initialize(&stream);
+    result = DoParseProgram(info);
+  } else if (source->IsSeqOneByteString()) {
+    SeqOneByteStringUtf16CharacterStream stream(
+        Handle<SeqOneByteString>::cast(source), 0, source->length());
+    scanner_.Initialize(&stream);
+    result = DoParseProgram(info);
   } else {
     GenericStringUtf16CharacterStream stream(source, 0, source->length());
     scanner_.Initialize(&stream);
@@ -1002,6 +1108,9 @@ FunctionLiteral* Parser::ParseProgram(Isolate* isolate, ParseInfo* info) {
     if (result != NULL) *info->cached_data() = recorder.GetScriptData();
     log_ = NULL;
   }
+  delete preparsed_data_;
+  preparsed_data_ = NULL;
+  delete preparsed_functions;
   return result;
 }
 
@@ -1122,6 +1231,17 @@ FunctionLiteral* Parser::ParseLazy(Isolate* isolate, ParseInfo* info) {
         shared_info->start_position(),
         shared_info->end_position());
     result = ParseLazy(isolate, info, &stream);
+  } else if (source->IsExternalOneByteString()) {
+    ExternalOneByteStringUtf16CharacterStream stream(
+        Handle<ExternalOneByteString>::cast(source),
+        shared_info->start_position(),
+        shared_info->end_position());
+    result = ParseLazy(isolate, info, &stream);
+  } else if (source->IsSeqOneByteString()) {
+    SeqOneByteStringUtf16CharacterStream stream(
+        Handle<SeqOneByteString>::cast(source), shared_info->start_position(),
+        shared_info->end_position());
+    result = ParseLazy(isolate, info, &stream);
   } else {
     GenericStringUtf16CharacterStream stream(source,
                                              shared_info->start_position(),
@@ -1142,15 +1262,40 @@ FunctionLiteral* Parser::ParseLazy(Isolate* isolate, ParseInfo* info) {
 FunctionLiteral* Parser::ParseLazy(Isolate* isolate, ParseInfo* info,
                                    Utf16CharacterStream* source) {
   Handle<SharedFunctionInfo> shared_info = info->shared_info();
-  scanner_.Initialize(source);
   DCHECK(scope_ == NULL);
+  DCHECK(ast_value_factory());
+  LazyFunctionInfo function(shared_info, ast_value_factory());
+
+  Scope* scope = NewScope(scope_, SCRIPT_SCOPE);
+  info->set_script_scope(scope);
+  if (!info->closure().is_null()) {
+    // Ok to use Isolate here, since lazy function parsing is only done in the
+    // main thread.
+    DCHECK(parsing_on_main_thread_);
+    scope = Scope::DeserializeScopeChain(isolate, zone(),
+                                         info->closure()->context(), scope);
+  }
+  DCHECK(is_sloppy(scope->language_mode()) ||
+         is_strict(info->language_mode()));
+  DCHECK(info->language_mode() == shared_info->language_mode());
+  FunctionLiteral* result = DoParseLazy(function, scope, source);
+
+  if (result != NULL) {
+    Handle<String> inferred_name(shared_info->inferred_name());
+    result->set_inferred_name(inferred_name);
+  }
+  return result;
+}
+
+
+FunctionLiteral* Parser::DoParseLazy(const LazyFunctionInfo& function,
+                                     Scope* scope,
+                                     Utf16CharacterStream* source) {
+  scanner_.Initialize(source);
   DCHECK(target_stack_ == NULL);
 
-  Handle<String> name(String::cast(shared_info->name()));
-  DCHECK(ast_value_factory());
   fni_ = new (zone()) FuncNameInferrer(ast_value_factory(), zone());
-  const AstRawString* raw_name = ast_value_factory()->GetString(name);
-  fni_->PushEnclosingName(raw_name);
+  fni_->PushEnclosingName(function.name);
 
   ParsingModeScope parsing_mode(this, PARSE_EAGERLY);
 
@@ -1159,34 +1304,17 @@ FunctionLiteral* Parser::ParseLazy(Isolate* isolate, ParseInfo* info,
 
   {
     // Parse the function literal.
-    Scope* scope = NewScope(scope_, SCRIPT_SCOPE);
-    info->set_script_scope(scope);
-    if (!info->closure().is_null()) {
-      // Ok to use Isolate here, since lazy function parsing is only done in the
-      // main thread.
-      DCHECK(parsing_on_main_thread_);
-      scope = Scope::DeserializeScopeChain(isolate, zone(),
-                                           info->closure()->context(), scope);
-    }
     original_scope_ = scope;
     AstNodeFactory function_factory(ast_value_factory());
     FunctionState function_state(&function_state_, &scope_, scope,
-                                 shared_info->kind(), &function_factory);
-    DCHECK(is_sloppy(scope->language_mode()) ||
-           is_strict(info->language_mode()));
-    DCHECK(info->language_mode() == shared_info->language_mode());
-    FunctionLiteral::FunctionType function_type = shared_info->is_expression()
-        ? (shared_info->is_anonymous()
-              ? FunctionLiteral::ANONYMOUS_EXPRESSION
-              : FunctionLiteral::NAMED_EXPRESSION)
-        : FunctionLiteral::DECLARATION;
+                                 function.kind, &function_factory);
     bool ok = true;
 
-    if (shared_info->is_arrow()) {
+    if (function.is_arrow) {
       Scope* scope =
           NewScope(scope_, ARROW_SCOPE, FunctionKind::kArrowFunction);
-      scope->SetLanguageMode(shared_info->language_mode());
-      scope->set_start_position(shared_info->start_position());
+      scope->SetLanguageMode(function.language_mode);
+      scope->set_start_position(function.start_position);
       ExpressionClassifier formals_classifier;
       ParserFormalParameters formals(scope);
       Checkpoint checkpoint(this);
@@ -1220,7 +1348,7 @@ FunctionLiteral* Parser::ParseLazy(Isolate* isolate, ParseInfo* info,
           // concise body happens to be a valid expression. This is a problem
           // only for arrow functions with single expression bodies, since there
           // is no end token such as "}" for normal functions.
-          if (scanner()->location().end_pos == shared_info->end_position()) {
+          if (scanner()->location().end_pos == function.end_position) {
             // The pre-parser saw an arrow function here, so the full parser
             // must produce a FunctionLiteral.
             DCHECK(expression->IsFunctionLiteral());
@@ -1230,16 +1358,15 @@ FunctionLiteral* Parser::ParseLazy(Isolate* isolate, ParseInfo* info,
           }
         }
       }
-    } else if (shared_info->is_default_constructor()) {
-      result = DefaultConstructor(IsSubclassConstructor(shared_info->kind()),
-                                  scope, shared_info->start_position(),
-                                  shared_info->end_position(),
-                                  shared_info->language_mode());
+    } else if (function.is_default_constructor) {
+      result = DefaultConstructor(
+          IsSubclassConstructor(function.kind), scope, function.start_position,
+          function.end_position, function.language_mode);
     } else {
       result = ParseFunctionLiteral(
-          raw_name, Scanner::Location::invalid(), kSkipFunctionNameCheck,
-          shared_info->kind(), RelocInfo::kNoPosition, function_type,
-          FunctionLiteral::NORMAL_ARITY, shared_info->language_mode(), &ok);
+          function.name, Scanner::Location::invalid(), kSkipFunctionNameCheck,
+          function.kind, RelocInfo::kNoPosition, function.function_type,
+          FunctionLiteral::NORMAL_ARITY, function.language_mode, &ok);
     }
     // Make sure the results agree.
     DCHECK(ok == (result != NULL));
@@ -1247,11 +1374,6 @@ FunctionLiteral* Parser::ParseLazy(Isolate* isolate, ParseInfo* info,
 
   // Make sure the target stack is empty.
   DCHECK(target_stack_ == NULL);
-
-  if (result != NULL) {
-    Handle<String> inferred_name(shared_info->inferred_name());
-    result->set_inferred_name(inferred_name);
-  }
   return result;
 }
 
@@ -4109,6 +4231,7 @@ FunctionLiteral* Parser::ParseFunctionLiteral(
       parenthesized_function_ ? FunctionLiteral::kShouldEagerCompile
                               : FunctionLiteral::kShouldLazyCompile;
   bool should_be_used_once_hint = false;
+  bool parse_in_background = false;
   // Parse function.
   {
     AstNodeFactory function_factory(ast_value_factory());
@@ -4177,9 +4300,22 @@ FunctionLiteral* Parser::ParseFunctionLiteral(
 
     // To make this additional case work, both Parser and PreParser implement a
     // logic where only top-level functions will be parsed lazily.
+    // Functions that a compile profile lists as called soon after the script
+    // ran are compiled eagerly, like parenthesized ones. With a
+    // LazyCompileQueue, those directly in the script that would be parsed
+    // lazily anyway are left to it instead.
+    bool in_compile_profile = LazyCompileProfiler::Contains(
+        compile_profile_positions_, start_position);
     bool is_lazily_parsed = mode() == PARSE_LAZILY &&
                             scope_->AllowsLazyParsing() &&
                             !parenthesized_function_;
+    parse_in_background = in_compile_profile && is_lazily_parsed &&
+                          parse_profile_in_background_ &&
+                          scope->outer_scope()->is_script_scope();
+    if (in_compile_profile && !parse_in_background) {
+      eager_compile_hint = FunctionLiteral::kShouldEagerCompile;
+      is_lazily_parsed = false;
+    }
     parenthesized_function_ = false;  // The bit was set for this function only.
 
     // Eager or lazy parse?
@@ -4209,8 +4345,13 @@ FunctionLiteral* Parser::ParseFunctionLiteral(
         eager_compile_hint = FunctionLiteral::kShouldEagerCompile;
         should_be_used_once_hint = true;
       }
+    } else if (consume_cached_parse_data() &&
+               CanSkipWithFreeVariables(kind, eager_compile_hint)) {
+      is_lazily_parsed = SkipFunctionBodyWithFreeVariables(
+          &materialized_literal_count, &expected_property_count, CHECK_OK);
     }
     if (!is_lazily_parsed) {
+      int function_block_pos = position();
       // Determine whether the function body can be discarded after parsing.
       // The preconditions are:
       // - Lazy compilation has to be enabled.
@@ -4244,6 +4385,12 @@ FunctionLiteral* Parser::ParseFunctionLiteral(
       }
       materialized_literal_count = function_state.materialized_literal_count();
       expected_property_count = function_state.expected_property_count();
+      if (produce_cached_parse_data() &&
+          CanSkipWithFreeVariables(kind, eager_compile_hint)) {
+        LogFunctionWithFreeVariables(scope, function_block_pos,
+                                     materialized_literal_count,
+                                     expected_property_count);
+      }
       if (can_use_temp_zone) {
         // If the preconditions are correct the function body should never be
         // accessed, but do this anyway for better behaviour if they're wrong.
@@ -4296,6 +4443,7 @@ FunctionLiteral* Parser::ParseFunctionLiteral(
   function_literal->set_function_token_position(function_token_pos);
   if (should_be_used_once_hint)
     function_literal->set_should_be_used_once_hint();
+  if (parse_in_background) function_literal->set_should_parse_in_background();
 
   if (fni_ != NULL && should_infer_name) fni_->AddFunction(function_literal);
   return function_literal;
@@ -4318,23 +4466,32 @@ void Parser::SkipLazyFunctionBody(int* materialized_literal_count,
     // handles it). Note that end position greater than end of stream is safe,
     // and hard to check.
     if (entry.is_valid() && entry.end_pos() > function_block_pos) {
-      scanner()->SeekForward(entry.end_pos() - 1);
-
-      scope_->set_end_position(entry.end_pos());
-      Expect(Token::RBRACE, ok);
-      if (!*ok) {
-        return;
-      }
-      total_preparse_skipped_ += scope_->end_position() - function_block_pos;
-      *materialized_literal_count = entry.literal_count();
-      *expected_property_count = entry.property_count();
-      scope_->SetLanguageMode(entry.language_mode());
-      if (entry.uses_super_property()) scope_->RecordSuperPropertyUsage();
-      if (entry.calls_eval()) scope_->RecordEvalCall();
+      SkipFunctionBodyUsingEntry(entry, function_block_pos,
+                                 materialized_literal_count,
+                                 expected_property_count, ok);
       return;
     }
     cached_parse_data_->Reject();
   }
+  if (preparsed_data_ != NULL && language_mode() == SLOPPY &&
+      function_state_->kind() == kNormalFunction &&
+      scope_->has_simple_parameters()) {
+    // The function may have been preparsed on a background thread, which
+    // assumes exactly these properties of the function. A missing entry is
+    // not an error; only some functions are found before parsing.
+    DCHECK(!produce_cached_parse_data());
+    FunctionEntry entry = preparsed_data_->GetFunctionEntry(function_block_pos);
+    if (entry.is_valid() && entry.end_pos() > function_block_pos) {
+      SkipFunctionBodyUsingEntry(entry, function_block_pos,
+                                 materialized_literal_count,
+                                 expected_property_count, ok);
+      if (*ok) {
+        total_parallel_preparse_skipped_ +=
+            scope_->end_position() - function_block_pos;
+      }
+      return;
+    }
+  }
   // With no cached data, we partially parse the function, without building an
   // AST. This gathers the data needed to build a lazy function.
   SingletonLogger logger;
@@ -4382,6 +4539,85 @@ void Parser::SkipLazyFunctionBody(int* materialized_literal_count,
 }
 
 
+void Parser::SkipFunctionBodyUsingEntry(FunctionEntry entry,
+                                        int function_block_pos,
+                                        int* materialized_literal_count,
+                                        int* expected_property_count,
+                                        bool* ok) {
+  scanner()->SeekForward(entry.end_pos() - 1);
+
+  scope_->set_end_position(entry.end_pos());
+  Expect(Token::RBRACE, ok);
+  if (!*ok) {
+    return;
+  }
+  total_preparse_skipped_ += scope_->end_position() - function_block_pos;
+  *materialized_literal_count = entry.literal_count();
+  *expected_property_count = entry.property_count();
+  scope_->SetLanguageMode(entry.language_mode());
+  if (entry.uses_super_property()) scope_->RecordSuperPropertyUsage();
+  if (entry.calls_eval()) scope_->RecordEvalCall();
+}
+
+
+bool Parser::CanSkipWithFreeVariables(
+    FunctionKind kind, FunctionLiteral::EagerCompileHint hint) {
+  // Only plain functions are skipped; they cannot refer to the receiver,
+  // arguments or home object of their enclosing functions. Like lazily
+  // parsed functions, they must also be compiled lazily.
+  return FLAG_lazy && allow_lazy() && !allow_natives() && extension_ == NULL &&
+         kind == kNormalFunction &&
+         hint == FunctionLiteral::kShouldLazyCompile &&
+         scope_->AllowsLazyParsing();
+}
+
+
+bool Parser::SkipFunctionBodyWithFreeVariables(int* materialized_literal_count,
+                                               int* expected_property_count,
+                                               bool* ok) {
+  if (cached_parse_data_->rejected()) return false;
+  int function_block_pos = position();
+  FunctionEntry entry =
+      cached_parse_data_->GetFunctionEntry(function_block_pos);
+  // A missing entry is not an error here; the function may not have been
+  // parsed eagerly when the data was produced.
+  if (!entry.is_valid() || !entry.has_free_variables()) return false;
+  ZoneList<const AstRawString*> free_variables(4, zone());
+  if (entry.end_pos() <= function_block_pos ||
+      !cached_parse_data_->GetFreeVariables(entry, ast_value_factory(),
+                                            &free_variables, zone())) {
+    cached_parse_data_->Reject();
+    return false;
+  }
+  SkipFunctionBodyUsingEntry(entry, function_block_pos,
+                             materialized_literal_count,
+                             expected_property_count, ok);
+  if (!*ok) return false;
+  // Reference the free variables from the skipped function, so that scope
+  // analysis allocates the variables they resolve to in a context. They may
+  // be assigned by the skipped function.
+  for (int i = 0; i < free_variables.length(); i++) {
+    scope_->NewUnresolved(factory(), free_variables[i])->set_is_assigned();
+  }
+  return true;
+}
+
+
+void Parser::LogFunctionWithFreeVariables(Scope* scope, int function_block_pos,
+                                          int materialized_literal_count,
+                                          int expected_property_count) {
+  DCHECK(log_);
+  ZoneList<const AstRawString*> free_variables(4, zone());
+  bool calls_eval = scope->CollectFreeVariableNames(&free_variables);
+  // Position right after terminal '}'.
+  int body_end = scanner()->location().end_pos;
+  log_->LogFunctionWithFreeVariables(
+      function_block_pos, body_end, materialized_literal_count,
+      expected_property_count, scope->language_mode(), calls_eval,
+      free_variables.ToConstVector());
+}
+
+
 void Parser::AddAssertIsConstruct(ZoneList<Statement*>* body, int pos) {
   ZoneList<Expression*>* arguments =
       new (zone()) ZoneList<Expression*>(0, zone());
@@ -4706,6 +4942,24 @@ ZoneList<Statement*>* Parser::ParseEagerFunctionBody(
 }
 
 
+void Parser::SetUpPreParser(PreParser* preparser) {
+  preparser->set_allow_lazy(true);
+#define SET_ALLOW(name) preparser->set_allow_##name(allow_##name());
+  SET_ALLOW(natives);
+  SET_ALLOW(harmony_arrow_functions);
+  SET_ALLOW(harmony_sloppy);
+  SET_ALLOW(harmony_sloppy_let);
+  SET_ALLOW(harmony_rest_parameters);
+  SET_ALLOW(harmony_default_parameters);
+  SET_ALLOW(harmony_spreadcalls);
+  SET_ALLOW(harmony_destructuring);
+  SET_ALLOW(harmony_spread_arrays);
+  SET_ALLOW(harmony_new_target);
+  SET_ALLOW(strong_mode);
+#undef SET_ALLOW
+}
+
+
 PreParser::PreParseResult Parser::ParseLazyFunctionBodyWithPreParser(
     SingletonLogger* logger, Scanner::BookmarkScope* bookmark) {
   // This function may be called on a background thread too; record only the
@@ -4718,20 +4972,7 @@ PreParser::PreParseResult Parser::ParseLazyFunctionBodyWithPreParser(
   if (reusable_preparser_ == NULL) {
     reusable_preparser_ = new PreParser(zone(), &scanner_, ast_value_factory(),
                                         NULL, stack_limit_);
-    reusable_preparser_->set_allow_lazy(true);
-#define SET_ALLOW(name) reusable_preparser_->set_allow_##name(allow_##name());
-    SET_ALLOW(natives);
-    SET_ALLOW(harmony_arrow_functions);
-    SET_ALLOW(harmony_sloppy);
-    SET_ALLOW(harmony_sloppy_let);
-    SET_ALLOW(harmony_rest_parameters);
-    SET_ALLOW(harmony_default_parameters);
-    SET_ALLOW(harmony_spreadcalls);
-    SET_ALLOW(harmony_destructuring);
-    SET_ALLOW(harmony_spread_arrays);
-    SET_ALLOW(harmony_new_target);
-    SET_ALLOW(strong_mode);
-#undef SET_ALLOW
+    SetUpPreParser(reusable_preparser_);
   }
   PreParser::PreParseResult result = reusable_preparser_->PreParseLazyFunction(
       language_mode(), function_state_->kind(), scope_->has_simple_parameters(),
@@ -5016,6 +5257,8 @@ void Parser::Internalize(Isolate* isolate, Handle<Script> script, bool error) {
   }
   isolate->counters()->total_preparse_skipped()->Increment(
       total_preparse_skipped_);
+  isolate->counters()->parallel_preparse_skipped()->Increment(
+      total_parallel_preparse_skipped_);
 }
 
 
@@ -6011,6 +6254,26 @@ void Parser::ParseOnBackground(ParseInfo* info) {
 }
 
 
+void Parser::ParseLazyOnBackground(ParseInfo* info,
+                                   const LazyFunctionInfo& function,
+                                   Utf16CharacterStream* source) {
+  parsing_on_main_thread_ = false;
+
+  DCHECK(info->literal() == NULL);
+  DCHECK(scope_ == NULL);
+  // Only functions declared directly in the script scope are parsed here.
+  // Their free variables stay unresolved and are accessed through global ICs,
+  // which also find the lexical declarations of script contexts, so there is
+  // no scope chain to deserialize.
+  Scope* scope = NewScope(scope_, SCRIPT_SCOPE);
+  info->set_script_scope(scope);
+  info->set_literal(DoParseLazy(function, scope, source));
+
+  // As with ParseOnBackground, internalizing is left to the main thread, and
+  // so is setting the inferred name.
+}
+
+
 ParserTraits::TemplateLiteralState Parser::OpenTemplateLiteral(int pos) {
   return new (zone()) ParserTraits::TemplateLiteral(zone(), pos);
 }
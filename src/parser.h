@@ -56,6 +56,8 @@ class ParseInfo {
   FLAG_ACCESSOR(kNative, is_native, set_native)
   FLAG_ACCESSOR(kModule, is_module, set_module)
   FLAG_ACCESSOR(kAllowLazyParsing, allow_lazy_parsing, set_allow_lazy_parsing)
+  FLAG_ACCESSOR(kParseProfileInBackground, parse_profile_in_background,
+                set_parse_profile_in_background)
   FLAG_ACCESSOR(kAstValueFactoryOwned, ast_value_factory_owned,
                 set_ast_value_factory_owned)
 
@@ -165,8 +167,9 @@ class ParseInfo {
     kParseRestriction = 1 << 7,
     kModule = 1 << 8,
     kAllowLazyParsing = 1 << 9,
+    kParseProfileInBackground = 1 << 10,
     // ---------- Output flags --------------------------
-    kAstValueFactoryOwned = 1 << 10
+    kAstValueFactoryOwned = 1 << 11
   };
 
   //------------- Inputs to parsing and scope analysis -----------------------
@@ -204,6 +207,25 @@ class ParseInfo {
   void set_closure(Handle<JSFunction> closure) { closure_ = closure; }
 };
 
+
+// The properties of a lazily compiled function that the parser needs to parse
+// it again. They are copied out of its SharedFunctionInfo on the main thread,
+// so that the function can also be parsed on a background thread.
+struct LazyFunctionInfo {
+  LazyFunctionInfo(Handle<SharedFunctionInfo> shared,
+                   AstValueFactory* ast_value_factory);
+
+  const AstRawString* name;
+  FunctionKind kind;
+  LanguageMode language_mode;
+  FunctionLiteral::FunctionType function_type;
+  bool is_arrow;
+  bool is_default_constructor;
+  int start_position;
+  int end_position;
+};
+
+
 class FunctionEntry BASE_EMBEDDED {
  public:
   enum {
@@ -214,6 +236,7 @@ class FunctionEntry BASE_EMBEDDED {
     kLanguageModeIndex,
     kUsesSuperPropertyIndex,
     kCallsEvalIndex,
+    kFreeVariablesIndex,
     kSize
   };
 
@@ -232,6 +255,14 @@ class FunctionEntry BASE_EMBEDDED {
   }
   bool uses_super_property() { return backing_[kUsesSuperPropertyIndex]; }
   bool calls_eval() { return backing_[kCallsEvalIndex]; }
+  bool has_free_variables() {
+    return backing_[kFreeVariablesIndex] !=
+           PreparseDataConstants::kNoFreeVariables;
+  }
+  int free_variables_index() {
+    DCHECK(has_free_variables());
+    return backing_[kFreeVariablesIndex];
+  }
 
   bool is_valid() { return !backing_.is_empty(); }
 
@@ -255,6 +286,11 @@ class ParseData {
   FunctionEntry GetFunctionEntry(int start);
   int FunctionCount();
 
+  // Reads the names a fully parsed function references from enclosing
+  // scopes. Returns false if the data is malformed.
+  bool GetFreeVariables(FunctionEntry entry, AstValueFactory* factory,
+                        ZoneList<const AstRawString*>* names, Zone* zone);
+
   bool HasError();
 
   unsigned* Data() {  // Writable data as unsigned int array.
@@ -272,6 +308,7 @@ class ParseData {
   unsigned Magic();
   unsigned Version();
   int FunctionsSize();
+  int NamesSize();
   int Length() const {
     // Script data length is already checked to be a multiple of unsigned size.
     return script_data_->length() / sizeof(unsigned);
@@ -887,6 +924,8 @@ class Parser : public ParserBase<ParserTraits> {
     reusable_preparser_ = NULL;
     delete cached_parse_data_;
     cached_parse_data_ = NULL;
+    delete preparsed_data_;
+    preparsed_data_ = NULL;
   }
 
   // Parses the source code represented by the compilation info and sets its
@@ -896,11 +935,20 @@ class Parser : public ParserBase<ParserTraits> {
   bool Parse(ParseInfo* info);
   void ParseOnBackground(ParseInfo* info);
 
+  // Parses a lazily compiled function whose outer scope is the script scope
+  // without accessing the heap. Like ParseOnBackground, the literal is left in
+  // the info and the main thread has to call Internalize.
+  void ParseLazyOnBackground(ParseInfo* info, const LazyFunctionInfo& function,
+                             Utf16CharacterStream* source);
+
   // Handle errors detected during parsing, move statistics to Isolate,
   // internalize strings (move them to the heap).
   void Internalize(Isolate* isolate, Handle<Script> script, bool error);
   void HandleSourceURLComments(Isolate* isolate, Handle<Script> script);
 
+  // Configures a preparser to accept the same syntax as this parser.
+  void SetUpPreParser(PreParser* preparser);
+
  private:
   friend class ParserTraits;
 
@@ -920,6 +968,11 @@ class Parser : public ParserBase<ParserTraits> {
   FunctionLiteral* ParseLazy(Isolate* isolate, ParseInfo* info,
                              Utf16CharacterStream* source);
 
+  // Called by ParseLazy and ParseLazyOnBackground after setting up the scope
+  // the function is parsed in.
+  FunctionLiteral* DoParseLazy(const LazyFunctionInfo& function, Scope* scope,
+                               Utf16CharacterStream* source);
+
   // Called by ParseProgram after setting up the scanner.
   FunctionLiteral* DoParseProgram(ParseInfo* info);
 
@@ -1161,9 +1214,30 @@ class Parser : public ParserBase<ParserTraits> {
                             int* expected_property_count, bool* ok,
                             Scanner::BookmarkScope* bookmark = nullptr);
 
+  // Skips a function body described by an entry of cached or preparsed data.
+  void SkipFunctionBodyUsingEntry(FunctionEntry entry, int function_block_pos,
+                                  int* materialized_literal_count,
+                                  int* expected_property_count, bool* ok);
+
   PreParser::PreParseResult ParseLazyFunctionBodyWithPreParser(
       SingletonLogger* logger, Scanner::BookmarkScope* bookmark = nullptr);
 
+  // Functions inside eagerly parsed functions can only be skipped if the
+  // cached data records the names they reference from enclosing scopes.
+  // Returns true if the function body at the current position can be skipped
+  // (or logged, when producing cached data) this way.
+  bool CanSkipWithFreeVariables(FunctionKind kind,
+                                FunctionLiteral::EagerCompileHint hint);
+
+  // Skips the body of an eagerly parsed function using cached data. Returns
+  // false if there is no suitable entry and the body has to be parsed.
+  bool SkipFunctionBodyWithFreeVariables(int* materialized_literal_count,
+                                         int* expected_property_count,
+                                         bool* ok);
+  void LogFunctionWithFreeVariables(Scope* scope, int function_block_pos,
+                                    int materialized_literal_count,
+                                    int expected_property_count);
+
   Block* BuildParameterInitializationBlock(
       const ParserFormalParameters& parameters, bool* ok);
 
@@ -1196,6 +1270,14 @@ class Parser : public ParserBase<ParserTraits> {
   Target* target_stack_;  // for break, continue statements
   ScriptCompiler::CompileOptions compile_options_;
   ParseData* cached_parse_data_;
+  // Function entries produced by ParallelPreparser before parsing.
+  ParseData* preparsed_data_;
+  // Start positions of the functions to compile eagerly, from the compile
+  // profile consumed with ScriptCompiler::kConsumeCompileProfile.
+  Vector<const uint32_t> compile_profile_positions_;
+  // Whether the functions of the profile that are directly in the script are
+  // left to the LazyCompileQueue.
+  bool parse_profile_in_background_;
 
   PendingCompilationErrorHandler pending_error_handler_;
 
@@ -1203,6 +1285,8 @@ class Parser : public ParserBase<ParserTraits> {
   // parsing.
   int use_counts_[v8::Isolate::kUseCounterFeatureCount];
   int total_preparse_skipped_;
+  // The part of it skipped using functions preparsed by ParallelPreparser.
+  int total_parallel_preparse_skipped_;
   HistogramTimer* pre_parse_timer_;
 
   bool parsing_on_main_thread_;
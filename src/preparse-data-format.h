@@ -14,14 +14,20 @@ struct PreparseDataConstants {
  public:
   // Layout and constants of the preparse data exchange format.
   static const unsigned kMagicNumber = 0xBadDead;
-  static const unsigned kCurrentVersion = 11;
+  static const unsigned kCurrentVersion = 12;
 
   static const int kMagicOffset = 0;
   static const int kVersionOffset = 1;
   static const int kHasErrorOffset = 2;
   static const int kFunctionsSizeOffset = 3;
   static const int kSizeOffset = 4;
-  static const int kHeaderSize = 5;
+  static const int kNamesSizeOffset = 5;
+  static const int kHeaderSize = 6;
+
+  // Function entries of functions that were fully parsed refer to the list of
+  // names they reference from enclosing scopes, which follows the function
+  // entries. Other entries use the following marker instead.
+  static const unsigned kNoFreeVariables = 0xFFFFFFFFu;
 
   // If encoding a message, the following positions are fixed.
   static const int kMessageStartPos = 0;
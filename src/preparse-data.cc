@@ -2,6 +2,8 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <algorithm>
+
 #include "src/base/logging.h"
 #include "src/globals.h"
 #include "src/hashmap.h"
@@ -21,7 +23,8 @@ CompleteParserRecorder::CompleteParserRecorder() {
   preamble_[PreparseDataConstants::kHasErrorOffset] = false;
   preamble_[PreparseDataConstants::kFunctionsSizeOffset] = 0;
   preamble_[PreparseDataConstants::kSizeOffset] = 0;
-  DCHECK_EQ(5, PreparseDataConstants::kHeaderSize);
+  preamble_[PreparseDataConstants::kNamesSizeOffset] = 0;
+  DCHECK_EQ(6, PreparseDataConstants::kHeaderSize);
 #ifdef DEBUG
   prev_start_ = -1;
 #endif
@@ -35,6 +38,7 @@ void CompleteParserRecorder::LogMessage(int start_pos, int end_pos,
   if (HasError()) return;
   preamble_[PreparseDataConstants::kHasErrorOffset] = true;
   function_store_.Reset();
+  names_store_.Reset();
   STATIC_ASSERT(PreparseDataConstants::kMessageStartPos == 0);
   function_store_.Add(start_pos);
   STATIC_ASSERT(PreparseDataConstants::kMessageEndPos == 1);
@@ -50,6 +54,38 @@ void CompleteParserRecorder::LogMessage(int start_pos, int end_pos,
 }
 
 
+void CompleteParserRecorder::LogFunctionWithFreeVariables(
+    int start, int end, int literals, int properties,
+    LanguageMode language_mode, bool calls_eval,
+    Vector<const AstRawString* const> free_variables) {
+  if (HasError()) return;
+  function_store_.Add(start);
+  function_store_.Add(end);
+  function_store_.Add(literals);
+  function_store_.Add(properties);
+  function_store_.Add(language_mode);
+  function_store_.Add(false);
+  function_store_.Add(calls_eval);
+  function_store_.Add(names_store_.size());
+  // Each name is stored as its length and encoding followed by one character
+  // per unsigned, like the strings in error messages.
+  names_store_.Add(free_variables.length());
+  for (int i = 0; i < free_variables.length(); i++) {
+    const AstRawString* name = free_variables[i];
+    int length = name->length();
+    names_store_.Add((length << 1) | (name->is_one_byte() ? 1 : 0));
+    if (name->is_one_byte()) {
+      const uint8_t* chars = name->raw_data();
+      for (int j = 0; j < length; j++) names_store_.Add(chars[j]);
+    } else {
+      const uint16_t* chars = reinterpret_cast<const uint16_t*>(
+          name->raw_data());
+      for (int j = 0; j < length; j++) names_store_.Add(chars[j]);
+    }
+  }
+}
+
+
 void CompleteParserRecorder::WriteString(Vector<const char> str) {
   function_store_.Add(str.length());
   for (int i = 0; i < str.length(); i++) {
@@ -58,15 +94,51 @@ void CompleteParserRecorder::WriteString(Vector<const char> str) {
 }
 
 
+namespace {
+
+struct FunctionEntryRecord {
+  unsigned data[FunctionEntry::kSize];
+};
+
+
+bool CompareFunctionEntryRecords(const FunctionEntryRecord& a,
+                                 const FunctionEntryRecord& b) {
+  return a.data[FunctionEntry::kStartPositionIndex] <
+         b.data[FunctionEntry::kStartPositionIndex];
+}
+
+}  // namespace
+
+
 ScriptData* CompleteParserRecorder::GetScriptData() {
   int function_size = function_store_.size();
-  int total_size = PreparseDataConstants::kHeaderSize + function_size;
+  int names_size = names_store_.size();
+  int total_size =
+      PreparseDataConstants::kHeaderSize + function_size + names_size;
   unsigned* data = NewArray<unsigned>(total_size);
   preamble_[PreparseDataConstants::kFunctionsSizeOffset] = function_size;
+  preamble_[PreparseDataConstants::kNamesSizeOffset] = names_size;
   MemCopy(data, preamble_, sizeof(preamble_));
   if (function_size > 0) {
-    function_store_.WriteTo(Vector<unsigned>(
-        data + PreparseDataConstants::kHeaderSize, function_size));
+    Vector<unsigned> functions(data + PreparseDataConstants::kHeaderSize,
+                               function_size);
+    function_store_.WriteTo(functions);
+    if (!HasError()) {
+      // Eagerly parsed functions are logged after their inner functions, but
+      // consumers look up entries by increasing start position.
+      STATIC_ASSERT(sizeof(FunctionEntryRecord) ==
+                    FunctionEntry::kSize * sizeof(unsigned));
+      DCHECK_EQ(0, function_size % FunctionEntry::kSize);
+      FunctionEntryRecord* records =
+          reinterpret_cast<FunctionEntryRecord*>(functions.start());
+      std::stable_sort(records, records + function_size / FunctionEntry::kSize,
+                       CompareFunctionEntryRecords);
+    }
+  }
+  if (names_size > 0) {
+    names_store_.WriteTo(Vector<unsigned>(
+        data + PreparseDataConstants::kHeaderSize + function_size,
+        names_size));
   }
   DCHECK(IsAligned(reinterpret_cast<intptr_t>(data), kPointerAlignment));
   ScriptData* result = new ScriptData(reinterpret_cast<byte*>(data),
@@ -13,6 +13,8 @@
 namespace v8 {
 namespace internal {
 
+class AstRawString;
+
 class ScriptData {
  public:
   ScriptData(const byte* data, int length);
@@ -56,6 +58,14 @@ class ParserRecorder {
                            LanguageMode language_mode, bool uses_super_property,
                            bool calls_eval) = 0;
 
+  // Logs a function literal that was parsed eagerly, together with the names
+  // it may reference from enclosing scopes. With these a later parse can skip
+  // the function even when its outer function is parsed eagerly.
+  virtual void LogFunctionWithFreeVariables(
+      int start, int end, int literals, int properties,
+      LanguageMode language_mode, bool calls_eval,
+      Vector<const AstRawString* const> free_variables) {}
+
   // Logs an error message and marks the log as containing an error.
   // Further logging will be ignored, and ExtractData will return a vector
   // representing the error only.
@@ -177,8 +187,14 @@ class CompleteParserRecorder : public ParserRecorder {
     function_store_.Add(language_mode);
     function_store_.Add(uses_super_property);
     function_store_.Add(calls_eval);
+    function_store_.Add(PreparseDataConstants::kNoFreeVariables);
   }
 
+  virtual void LogFunctionWithFreeVariables(
+      int start, int end, int literals, int properties,
+      LanguageMode language_mode, bool calls_eval,
+      Vector<const AstRawString* const> free_variables);
+
   // Logs an error message and marks the log as containing an error.
   // Further logging will be ignored, and ExtractData will return a vector
   // representing the error only.
@@ -198,6 +214,7 @@ class CompleteParserRecorder : public ParserRecorder {
   void WriteString(Vector<const char> str);
 
   Collector<unsigned> function_store_;
+  Collector<unsigned> names_store_;
   unsigned preamble_[PreparseDataConstants::kHeaderSize];
 
 #ifdef DEBUG
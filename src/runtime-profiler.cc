@@ -9,6 +9,7 @@
 #include "src/bootstrapper.h"
 #include "src/code-stubs.h"
 #include "src/compilation-cache.h"
+#include "src/compiler/bytecode-graph-builder.h"
 #include "src/execution.h"
 #include "src/frames-inl.h"
 #include "src/full-codegen/full-codegen.h"
@@ -62,9 +63,11 @@ static void GetICCounts(SharedFunctionInfo* shared,
   *ic_total_count = 0;
   *ic_generic_count = 0;
   *ic_with_type_info_count = 0;
-  Object* raw_info = shared_code->type_feedback_info();
-  if (raw_info->IsTypeFeedbackInfo()) {
-    TypeFeedbackInfo* info = TypeFeedbackInfo::cast(raw_info);
+  // Interpreted functions only have feedback in their vector.
+  if (shared_code->kind() == Code::FUNCTION &&
+      shared_code->type_feedback_info()->IsTypeFeedbackInfo()) {
+    TypeFeedbackInfo* info =
+        TypeFeedbackInfo::cast(shared_code->type_feedback_info());
     *ic_with_type_info_count = info->ic_with_type_info_count();
     *ic_generic_count = info->ic_generic_count();
     *ic_total_count = info->ic_total_count();
@@ -135,6 +138,37 @@ void RuntimeProfiler::AttemptOnStackReplacement(JSFunction* function,
 }
 
 
+void RuntimeProfiler::TickInterpretedFunction(JSFunction* function) {
+  SharedFunctionInfo* shared = function->shared();
+  DCHECK(shared->HasBytecodeArray());
+  int ticks = shared->profiler_ticks();
+  if (ticks < Smi::kMaxValue) shared->set_profiler_ticks(++ticks);
+
+  if (!FLAG_ignition_tier_up) return;
+  if (function->IsOptimized() || function->IsMarkedForOptimization() ||
+      function->IsMarkedForConcurrentOptimization() ||
+      function->IsInOptimizationQueue()) {
+    return;
+  }
+  if (shared->optimization_disabled()) return;
+
+  // Interpreted frames can't be replaced on the stack, so the optimized code
+  // is only used from the next call on.
+  if (ticks >= kProfilerTicksBeforeOptimization) {
+    // Keep functions the bytecode graph builder can't handle yet running in
+    // the interpreter.
+    HandleScope scope(isolate_);
+    BailoutReason reason = compiler::BytecodeGraphBuilder::CheckSupported(
+        handle(shared, isolate_));
+    if (reason != kNoReason) {
+      shared->DisableOptimization(reason);
+      return;
+    }
+    Optimize(function, "hot interpreted function");
+  }
+}
+
+
 void RuntimeProfiler::OptimizeNow() {
   HandleScope scope(isolate_);
 
@@ -29,6 +29,10 @@ class RuntimeProfiler {
 
   void AttemptOnStackReplacement(JSFunction* function, int nesting_levels = 1);
 
+  // Called by the interpreter each time |function| has used up its interrupt
+  // budget.
+  void TickInterpretedFunction(JSFunction* function);
+
  private:
   void Optimize(JSFunction* function, const char* reason);
 
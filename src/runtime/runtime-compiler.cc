@@ -67,7 +67,8 @@ RUNTIME_FUNCTION(Runtime_CompileOptimized) {
     }
     code = Handle<Code>(function->shared()->code(), isolate);
     if (code->kind() != Code::FUNCTION &&
-        code->kind() != Code::OPTIMIZED_FUNCTION) {
+        code->kind() != Code::OPTIMIZED_FUNCTION &&
+        !function->shared()->HasBytecodeArray()) {
       ASSIGN_RETURN_FAILURE_ON_EXCEPTION(
           isolate, code, Compiler::GetUnoptimizedCode(function));
     }
@@ -76,6 +77,7 @@ RUNTIME_FUNCTION(Runtime_CompileOptimized) {
 
   DCHECK(function->code()->kind() == Code::FUNCTION ||
          function->code()->kind() == Code::OPTIMIZED_FUNCTION ||
+         function->shared()->HasBytecodeArray() ||
          function->IsInOptimizationQueue());
   return function->code();
 }
@@ -220,6 +220,17 @@ RUNTIME_FUNCTION(Runtime_Interrupt) {
 }
 
 
+RUNTIME_FUNCTION(Runtime_BytecodeBudgetInterrupt) {
+  SealHandleScope shs(isolate);
+  DCHECK(args.length() == 1);
+  CONVERT_ARG_CHECKED(JSFunction, function, 0);
+  function->shared()->bytecode_array()->set_interrupt_budget(
+      FLAG_interrupt_budget);
+  isolate->runtime_profiler()->TickInterpretedFunction(function);
+  return isolate->heap()->undefined_value();
+}
+
+
 RUNTIME_FUNCTION(Runtime_AllocateInNewSpace) {
   HandleScope scope(isolate);
   DCHECK(args.length() == 1);
@@ -317,6 +317,7 @@ namespace internal {
   F(PromiseRevokeReject, 1, 1)                \
   F(StackGuard, 0, 1)                         \
   F(Interrupt, 0, 1)                          \
+  F(BytecodeBudgetInterrupt, 1, 1)            \
   F(AllocateInNewSpace, 1, 1)                 \
   F(AllocateInTargetSpace, 2, 1)              \
   F(CollectStackTrace, 2, 1)                  \
@@ -8,7 +8,7 @@
 #include "src/globals.h"
 #include "src/handles.h"
 #include "src/list-inl.h"  // TODO(mstarzinger): Temporary cycle breaker!
-#include "src/objects.h"
+#include "src/objects-inl.h"
 #include "src/unicode-inl.h"
 
 namespace v8 {
@@ -174,6 +174,57 @@ size_t GenericStringUtf16CharacterStream::FillBuffer(size_t from_pos) {
 }
 
 
+// ----------------------------------------------------------------------------
+// FlatStringUtf16CharacterStream
+
+FlatStringUtf16CharacterStream::FlatStringUtf16CharacterStream(
+    const uint8_t* data, size_t start_position, size_t end_position)
+    : Utf16CharacterStream() {
+  DCHECK(end_position >= start_position);
+  buffer_cursor_ = NULL;
+  buffer_end_ = NULL;
+  one_byte_cursor_ = data + start_position;
+  one_byte_end_ = data + end_position;
+  pos_ = start_position;
+}
+
+
+FlatStringUtf16CharacterStream::FlatStringUtf16CharacterStream(
+    const uc16* data, size_t start_position, size_t end_position)
+    : Utf16CharacterStream() {
+  DCHECK(end_position >= start_position);
+  buffer_cursor_ = data + start_position;
+  buffer_end_ = data + end_position;
+  pos_ = start_position;
+}
+
+
+FlatStringUtf16CharacterStream::FlatStringUtf16CharacterStream(
+    Vector<const uc16> chars, size_t start_position)
+    : Utf16CharacterStream() {
+  buffer_cursor_ = chars.start();
+  buffer_end_ = chars.end();
+  pos_ = start_position;
+}
+
+
+FlatStringUtf16CharacterStream::~FlatStringUtf16CharacterStream() {}
+
+
+void FlatStringUtf16CharacterStream::PushBack(uc32 character) {
+  if (character == kEndOfInput) {
+    pos_--;
+    return;
+  }
+  if (one_byte_end_ != NULL) {
+    one_byte_cursor_--;
+  } else {
+    buffer_cursor_--;
+  }
+  pos_--;
+}
+
+
 // ----------------------------------------------------------------------------
 // Utf8ToUtf16CharacterStream
 Utf8ToUtf16CharacterStream::Utf8ToUtf16CharacterStream(const byte* data,
@@ -528,6 +579,88 @@ void ExternalStreamingStream::HandleUtf8SplitCharacters(
 }
 
 
+// ----------------------------------------------------------------------------
+// ExternalOneByteStringUtf16CharacterStream
+
+ExternalOneByteStringUtf16CharacterStream::
+    ~ExternalOneByteStringUtf16CharacterStream() {}
+
+
+ExternalOneByteStringUtf16CharacterStream::
+    ExternalOneByteStringUtf16CharacterStream(
+        Handle<ExternalOneByteString> data, int start_position,
+        int end_position)
+    : Utf16CharacterStream(),
+      source_(data),
+      raw_data_(data->GetChars()),
+      bookmark_(kNoBookmark) {
+  DCHECK(end_position >= start_position);
+  buffer_cursor_ = NULL;
+  buffer_end_ = NULL;
+  one_byte_cursor_ = raw_data_ + start_position;
+  one_byte_end_ = raw_data_ + end_position;
+  pos_ = start_position;
+}
+
+
+bool ExternalOneByteStringUtf16CharacterStream::SetBookmark() {
+  bookmark_ = pos_;
+  return true;
+}
+
+
+void ExternalOneByteStringUtf16CharacterStream::ResetToBookmark() {
+  DCHECK(bookmark_ != kNoBookmark);
+  pos_ = bookmark_;
+  one_byte_cursor_ = raw_data_ + bookmark_;
+}
+
+
+// ----------------------------------------------------------------------------
+// SeqOneByteStringUtf16CharacterStream
+
+SeqOneByteStringUtf16CharacterStream::SeqOneByteStringUtf16CharacterStream(
+    Handle<SeqOneByteString> data, int start_position, int end_position)
+    : Utf16CharacterStream(),
+      Relocatable(data->GetIsolate()),
+      source_(data),
+      raw_data_(data->GetChars()),
+      bookmark_(kNoBookmark) {
+  DCHECK(end_position >= start_position);
+  buffer_cursor_ = NULL;
+  buffer_end_ = NULL;
+  one_byte_cursor_ = raw_data_ + start_position;
+  one_byte_end_ = raw_data_ + end_position;
+  pos_ = start_position;
+}
+
+
+SeqOneByteStringUtf16CharacterStream::~SeqOneByteStringUtf16CharacterStream() {
+}
+
+
+bool SeqOneByteStringUtf16CharacterStream::SetBookmark() {
+  bookmark_ = pos_;
+  return true;
+}
+
+
+void SeqOneByteStringUtf16CharacterStream::ResetToBookmark() {
+  DCHECK(bookmark_ != kNoBookmark);
+  pos_ = bookmark_;
+  one_byte_cursor_ = raw_data_ + bookmark_;
+}
+
+
+void SeqOneByteStringUtf16CharacterStream::PostGarbageCollection() {
+  const uint8_t* raw_data = source_->GetChars();
+  if (raw_data == raw_data_) return;
+  one_byte_cursor_ = raw_data + (one_byte_cursor_ - raw_data_);
+  one_byte_end_ = raw_data + (one_byte_end_ - raw_data_);
+  raw_data_ = raw_data;
+}
+
+
 // ----------------------------------------------------------------------------
 // ExternalTwoByteStringUtf16CharacterStream
 
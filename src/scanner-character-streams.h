@@ -6,6 +6,7 @@
 #define V8_SCANNER_CHARACTER_STREAMS_H_
 
 #include "src/handles.h"
+#include "src/objects.h"
 #include "src/scanner.h"
 #include "src/vector.h"
 
@@ -13,6 +14,7 @@ namespace v8 {
 namespace internal {
 
 // Forward declarations.
+class ExternalOneByteString;
 class ExternalTwoByteString;
 
 // A buffered character stream based on a random access character
@@ -63,6 +65,35 @@ class GenericStringUtf16CharacterStream: public BufferedUtf16CharacterStream {
 };
 
 
+// Utf16 stream over the characters of a flat string, read directly from its
+// backing store without copying. It does not use handles, so it can be used
+// on background threads as long as the string does not move.
+class FlatStringUtf16CharacterStream : public Utf16CharacterStream {
+ public:
+  FlatStringUtf16CharacterStream(const uint8_t* data, size_t start_position,
+                                 size_t end_position);
+  FlatStringUtf16CharacterStream(const uc16* data, size_t start_position,
+                                 size_t end_position);
+  // Reads characters that were copied out of a string starting at
+  // start_position, e.g. the source of a single function.
+  FlatStringUtf16CharacterStream(Vector<const uc16> chars,
+                                 size_t start_position);
+  virtual ~FlatStringUtf16CharacterStream();
+
+  virtual void PushBack(uc32 character);
+
+ protected:
+  virtual size_t SlowSeekForward(size_t delta) {
+    // Fast case always handles seeking.
+    return 0;
+  }
+  virtual bool ReadBlock() {
+    // Entire string is read at start.
+    return false;
+  }
+};
+
+
 // Utf16 stream based on a literal UTF-8 string.
 class Utf8ToUtf16CharacterStream: public BufferedUtf16CharacterStream {
  public:
@@ -144,6 +175,92 @@ class ExternalStreamingStream : public BufferedUtf16CharacterStream {
 };
 
 
+// Stream over the characters of an external one-byte string. The characters
+// are read directly from the external resource, without widening them into a
+// UTF-16 buffer first.
+class ExternalOneByteStringUtf16CharacterStream : public Utf16CharacterStream {
+ public:
+  ExternalOneByteStringUtf16CharacterStream(Handle<ExternalOneByteString> data,
+                                            int start_position,
+                                            int end_position);
+  virtual ~ExternalOneByteStringUtf16CharacterStream();
+
+  virtual void PushBack(uc32 character) {
+    if (character == kEndOfInput) {
+      pos_--;
+      return;
+    }
+    DCHECK(one_byte_cursor_ > raw_data_);
+    one_byte_cursor_--;
+    pos_--;
+  }
+
+  virtual bool SetBookmark();
+  virtual void ResetToBookmark();
+
+ protected:
+  virtual size_t SlowSeekForward(size_t delta) {
+    // Fast case always handles seeking.
+    return 0;
+  }
+  virtual bool ReadBlock() {
+    // Entire string is read at start.
+    return false;
+  }
+  Handle<ExternalOneByteString> source_;
+  const uint8_t* raw_data_;  // Pointer to the start of the string.
+
+ private:
+  static const size_t kNoBookmark = -1;
+
+  size_t bookmark_;
+};
+
+
+// Stream over the characters of a sequential one-byte string. Like the stream
+// above it reads the characters directly from the string, and it follows the
+// string when the garbage collector moves it.
+class SeqOneByteStringUtf16CharacterStream : public Utf16CharacterStream,
+                                             public Relocatable {
+ public:
+  SeqOneByteStringUtf16CharacterStream(Handle<SeqOneByteString> data,
+                                       int start_position, int end_position);
+  virtual ~SeqOneByteStringUtf16CharacterStream();
+
+  virtual void PushBack(uc32 character) {
+    if (character == kEndOfInput) {
+      pos_--;
+      return;
+    }
+    DCHECK(one_byte_cursor_ > raw_data_);
+    one_byte_cursor_--;
+    pos_--;
+  }
+
+  virtual bool SetBookmark();
+  virtual void ResetToBookmark();
+
+  virtual void PostGarbageCollection();
+
+ protected:
+  virtual size_t SlowSeekForward(size_t delta) {
+    // Fast case always handles seeking.
+    return 0;
+  }
+  virtual bool ReadBlock() {
+    // Entire string is read at start.
+    return false;
+  }
+  Handle<SeqOneByteString> source_;
+  const uint8_t* raw_data_;  // Pointer to the start of the string.
+
+ private:
+  static const size_t kNoBookmark = -1;
+
+  size_t bookmark_;
+};
+
+
 // UTF16 buffer to read characters from an external string.
 class ExternalTwoByteStringUtf16CharacterStream: public Utf16CharacterStream {
  public:
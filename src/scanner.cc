@@ -11,11 +11,21 @@
 #include <cmath>
 
 #include "src/ast-value-factory.h"
+#include "src/base/bits.h"
 #include "src/char-predicates-inl.h"
 #include "src/conversions-inl.h"
 #include "src/list-inl.h"
 #include "src/parser.h"
 
+#if V8_HOST_ARCH_X64 || (V8_HOST_ARCH_IA32 && defined(__SSE2__))
+#include <emmintrin.h>
+#define V8_SCANNER_USE_SSE2 1
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define V8_SCANNER_USE_AVX2 1
+#endif
+#endif
+
 namespace v8 {
 namespace internal {
 
@@ -39,7 +49,8 @@ void Utf16CharacterStream::ResetToBookmark() { UNREACHABLE(); }
 Scanner::Scanner(UnicodeCache* unicode_cache)
     : unicode_cache_(unicode_cache),
       bookmark_c0_(kNoBookmark),
-      octal_pos_(Location::invalid()) {
+      octal_pos_(Location::invalid()),
+      skip_buffered_runs_(FLAG_simd_scanner) {
   bookmark_current_.literal_chars = &bookmark_current_literal_;
   bookmark_current_.raw_literal_chars = &bookmark_current_raw_literal_;
   bookmark_next_.literal_chars = &bookmark_next_literal_;
@@ -287,6 +298,268 @@ static inline bool IsLittleEndianByteOrderMark(uc32 c) {
 }
 
 
+const int kMaxAscii = 127;
+
+
+namespace {
+
+// Matchers for Scanner::SkipBufferedRun(). Each one has a scalar variant and,
+// where SSE2 is available, a variant that checks a vector of code units at
+// once and returns all ones in the lanes of accepted code units. The vector
+// variant is written against the helpers below, which exist for the eight
+// lane SSE2 vectors and, in builds targeting AVX2, the sixteen lane AVX2
+// ones. Code units are compared as signed 16-bit values, so ranges must not
+// go above 0x7FFF.
+
+#ifdef V8_SCANNER_USE_SSE2
+inline __m128i Or(__m128i a, __m128i b) { return _mm_or_si128(a, b); }
+inline __m128i AndNot(__m128i a, __m128i b) { return _mm_andnot_si128(a, b); }
+inline __m128i Not(__m128i v) {
+  return _mm_xor_si128(v, _mm_set1_epi16(-1));
+}
+inline __m128i SetBits(__m128i v, uint16_t bits) {
+  return _mm_or_si128(v, _mm_set1_epi16(static_cast<int16_t>(bits)));
+}
+
+
+inline __m128i Equals(__m128i v, uint16_t c) {
+  return _mm_cmpeq_epi16(v, _mm_set1_epi16(static_cast<int16_t>(c)));
+}
+
+
+inline __m128i InRange(__m128i v, uint16_t lower, uint16_t upper) {
+  return _mm_and_si128(
+      _mm_cmpgt_epi16(v, _mm_set1_epi16(static_cast<int16_t>(lower - 1))),
+      _mm_cmplt_epi16(v, _mm_set1_epi16(static_cast<int16_t>(upper + 1))));
+}
+#endif
+
+
+#ifdef V8_SCANNER_USE_AVX2
+inline __m256i Or(__m256i a, __m256i b) { return _mm256_or_si256(a, b); }
+inline __m256i AndNot(__m256i a, __m256i b) {
+  return _mm256_andnot_si256(a, b);
+}
+inline __m256i Not(__m256i v) {
+  return _mm256_xor_si256(v, _mm256_set1_epi16(-1));
+}
+inline __m256i SetBits(__m256i v, uint16_t bits) {
+  return _mm256_or_si256(v, _mm256_set1_epi16(static_cast<int16_t>(bits)));
+}
+
+
+inline __m256i Equals(__m256i v, uint16_t c) {
+  return _mm256_cmpeq_epi16(v, _mm256_set1_epi16(static_cast<int16_t>(c)));
+}
+
+
+inline __m256i InRange(__m256i v, uint16_t lower, uint16_t upper) {
+  // AVX2 has no less-than comparison, so swap the operands of greater-than.
+  return _mm256_and_si256(
+      _mm256_cmpgt_epi16(v,
+                         _mm256_set1_epi16(static_cast<int16_t>(lower - 1))),
+      _mm256_cmpgt_epi16(_mm256_set1_epi16(static_cast<int16_t>(upper + 1)),
+                         v));
+}
+#endif
+
+
+#ifdef V8_SCANNER_USE_SSE2
+template <typename Vector>
+inline Vector IsLineTerminator(Vector v) {
+  return Or(Or(Equals(v, '\n'), Equals(v, '\r')), InRange(v, 0x2028, 0x2029));
+}
+#endif
+
+
+struct AsciiWhiteSpace {
+  static bool Match(uc32 c) {
+    return c == ' ' || IsInRange(c, '\t', '\r');
+  }
+#ifdef V8_SCANNER_USE_SSE2
+  template <typename Vector>
+  static Vector MatchVector(Vector v) {
+    return Or(Equals(v, ' '), InRange(v, '\t', '\r'));
+  }
+#endif
+};
+
+
+struct NonLineTerminator {
+  static bool Match(uc32 c) {
+    return c != '\n' && c != '\r' && !IsInRange(c, 0x2028, 0x2029);
+  }
+#ifdef V8_SCANNER_USE_SSE2
+  template <typename Vector>
+  static Vector MatchVector(Vector v) {
+    return Not(IsLineTerminator(v));
+  }
+#endif
+};
+
+
+struct MultiLineCommentChar {
+  static bool Match(uc32 c) { return c != '*' && NonLineTerminator::Match(c); }
+#ifdef V8_SCANNER_USE_SSE2
+  template <typename Vector>
+  static Vector MatchVector(Vector v) {
+    return Not(Or(Equals(v, '*'), IsLineTerminator(v)));
+  }
+#endif
+};
+
+
+struct AsciiLowerCaseLetter {
+  static bool Match(uc32 c) { return IsInRange(c, 'a', 'z'); }
+#ifdef V8_SCANNER_USE_SSE2
+  template <typename Vector>
+  static Vector MatchVector(Vector v) {
+    return InRange(v, 'a', 'z');
+  }
+#endif
+};
+
+
+struct AsciiIdentifierPart {
+  static bool Match(uc32 c) { return IsAsciiIdentifier(c); }
+#ifdef V8_SCANNER_USE_SSE2
+  template <typename Vector>
+  static Vector MatchVector(Vector v) {
+    // Setting the 0x20 bit maps upper case letters to lower case ones, and
+    // no other character to a lower case letter.
+    Vector letter = InRange(SetBits(v, 0x20), 'a', 'z');
+    Vector digit = InRange(v, '0', '9');
+    Vector other = Or(Equals(v, '_'), Equals(v, '$'));
+    return Or(Or(letter, digit), other);
+  }
+#endif
+};
+
+
+// Characters of string literals the first loop of ScanString() adds to the
+// literal as they are.
+struct AsciiStringLiteralChar {
+  static bool Match(uc32 c) {
+    return c <= kMaxAscii && c != '"' && c != '\'' && c != '\\' &&
+           c != '\n' && c != '\r';
+  }
+#ifdef V8_SCANNER_USE_SSE2
+  template <typename Vector>
+  static Vector MatchVector(Vector v) {
+    Vector special = Or(Or(Equals(v, '"'), Equals(v, '\'')),
+                        Or(Equals(v, '\\'),
+                           Or(Equals(v, '\n'), Equals(v, '\r'))));
+    return AndNot(special, InRange(v, 0, kMaxAscii));
+  }
+#endif
+};
+
+
+#ifdef V8_SCANNER_USE_SSE2
+// Loads eight code units, widening one-byte characters to 16 bits.
+inline __m128i LoadCodeUnits(const uint16_t* chars) {
+  return _mm_loadu_si128(reinterpret_cast<const __m128i*>(chars));
+}
+
+
+inline __m128i LoadCodeUnits(const uint8_t* chars) {
+  return _mm_unpacklo_epi8(
+      _mm_loadl_epi64(reinterpret_cast<const __m128i*>(chars)),
+      _mm_setzero_si128());
+}
+#endif
+
+
+#ifdef V8_SCANNER_USE_AVX2
+// Loads sixteen code units, widening one-byte characters to 16 bits.
+inline __m256i LoadWideCodeUnits(const uint16_t* chars) {
+  return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(chars));
+}
+
+
+inline __m256i LoadWideCodeUnits(const uint8_t* chars) {
+  return _mm256_cvtepu8_epi16(
+      _mm_loadu_si128(reinterpret_cast<const __m128i*>(chars)));
+}
+#endif
+
+
+// Returns the number of leading characters accepted by Matcher.
+template <typename Matcher, typename Char>
+int MatchingPrefixLength(Vector<const Char> code_units) {
+  const Char* chars = code_units.start();
+  int length = code_units.length();
+  int i = 0;
+#ifdef V8_SCANNER_USE_AVX2
+  const int kWideLanes = sizeof(__m256i) / sizeof(uint16_t);
+  for (; i + kWideLanes <= length; i += kWideLanes) {
+    uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(
+        Matcher::MatchVector(LoadWideCodeUnits(chars + i))));
+    if (mask != 0xFFFFFFFFu) {
+      // Two mask bits per code unit.
+      return i + base::bits::CountTrailingZeros32(~mask) / 2;
+    }
+  }
+#endif
+#ifdef V8_SCANNER_USE_SSE2
+  const int kLanes = sizeof(__m128i) / sizeof(uint16_t);
+  for (; i + kLanes <= length; i += kLanes) {
+    uint32_t mask =
+        _mm_movemask_epi8(Matcher::MatchVector(LoadCodeUnits(chars + i)));
+    if (mask != 0xFFFF) {
+      // Two mask bits per code unit.
+      return i + base::bits::CountTrailingZeros32(~mask) / 2;
+    }
+  }
+#endif
+  while (i < length && Matcher::Match(chars[i])) i++;
+  return i;
+}
+
+
+// Returns the length of the run of characters accepted by Matcher at the
+// start of chars, after adding them to literal unless it is NULL.
+template <typename Matcher, typename Char>
+int MatchRun(Vector<const Char> chars, LiteralBuffer* literal,
+             bool* has_line_terminator) {
+  Vector<const Char> run =
+      chars.SubVector(0, MatchingPrefixLength<Matcher>(chars));
+  if (literal != NULL) literal->AddOneByteChars(run);
+  if (has_line_terminator != NULL &&
+      MatchingPrefixLength<NonLineTerminator>(run) < run.length()) {
+    *has_line_terminator = true;
+  }
+  return run.length();
+}
+
+}  // namespace
+
+
+template <typename Matcher, bool add_literal_chars>
+V8_INLINE void Scanner::SkipBufferedRun(bool* has_line_terminator) {
+  // Single characters, such as most identifiers in minified code, are left
+  // to the caller's loop.
+  if (!skip_buffered_runs_) return;
+  uc32 next = source_->PeekBuffered();
+  if (next < 0 || !Matcher::Match(next)) return;
+  ConsumeBufferedRun<Matcher, add_literal_chars>(has_line_terminator);
+}
+
+
+template <typename Matcher, bool add_literal_chars>
+void Scanner::ConsumeBufferedRun(bool* has_line_terminator) {
+  LiteralBuffer* literal = add_literal_chars ? next_.literal_chars : NULL;
+  // The UTF-16 buffer comes first, as in Utf16CharacterStream::Advance().
+  Vector<const uint16_t> code_units = source_->buffered_code_units();
+  int length =
+      code_units.is_empty()
+          ? MatchRun<Matcher>(source_->buffered_one_byte_chars(), literal,
+                              has_line_terminator)
+          : MatchRun<Matcher>(code_units, literal, has_line_terminator);
+  if (length > 0) source_->SeekForward(length);
+}
+
+
 bool Scanner::SkipWhiteSpace() {
   int start_position = source_pos();
 
@@ -302,6 +575,8 @@ bool Scanner::SkipWhiteSpace() {
                  !IsLittleEndianByteOrderMark(c0_)) {
         break;
       }
+      SkipBufferedRun<AsciiWhiteSpace, false>(
+          &has_line_terminator_before_next_);
       Advance();
     }
 
@@ -338,6 +613,7 @@ Token::Value Scanner::SkipSingleLineComment() {
   // stream of input elements for the syntactic grammar (see
   // ECMA-262, section 7.4).
   while (c0_ >= 0 && !unicode_cache_->IsLineTerminator(c0_)) {
+    SkipBufferedRun<NonLineTerminator, false>();
     Advance();
   }
 
@@ -412,6 +688,10 @@ Token::Value Scanner::SkipMultiLineComment() {
 
   while (c0_ >= 0) {
     uc32 ch = c0_;
+    if (ch != '*' && !unicode_cache_->IsLineTerminator(ch)) {
+      // Neither ends the comment nor makes it count as a line terminator.
+      SkipBufferedRun<MultiLineCommentChar, false>();
+    }
     Advance();
     if (c0_ >= 0 && unicode_cache_->IsLineTerminator(ch)) {
       // Following ECMA-262, section 7.4, a comment containing
@@ -813,9 +1093,6 @@ uc32 Scanner::ScanOctalEscape(uc32 c, int length) {
 }
 
 
-const int kMaxAscii = 127;
-
-
 Token::Value Scanner::ScanString() {
   uc32 quote = c0_;
   Advance<false, false>();  // consume quote
@@ -834,8 +1111,9 @@ Token::Value Scanner::ScanString() {
     }
     uc32 c = c0_;
     if (c == '\\') break;
-    Advance<false, false>();
     AddLiteralChar(c);
+    SkipBufferedRun<AsciiStringLiteralChar, true>();
+    Advance<false, false>();
   }
 
   while (c0_ != quote && c0_ >= 0
@@ -1233,9 +1511,9 @@ Token::Value Scanner::ScanIdentifierOrKeyword() {
   LiteralScope literal(this);
   if (IsInRange(c0_, 'a', 'z')) {
     do {
-      uc32 first_char = c0_;
+      AddLiteralChar(c0_);
+      SkipBufferedRun<AsciiLowerCaseLetter, true>();
       Advance<false, false>();
-      AddLiteralChar(first_char);
     } while (IsInRange(c0_, 'a', 'z'));
 
     if (IsDecimalDigit(c0_) || IsInRange(c0_, 'A', 'Z') || c0_ == '_' ||
@@ -1245,9 +1523,9 @@ Token::Value Scanner::ScanIdentifierOrKeyword() {
       Advance<false, false>();
       AddLiteralChar(first_char);
       while (IsAsciiIdentifier(c0_)) {
-        uc32 first_char = c0_;
+        AddLiteralChar(c0_);
+        SkipBufferedRun<AsciiIdentifierPart, true>();
         Advance<false, false>();
-        AddLiteralChar(first_char);
       }
       if (c0_ <= kMaxAscii && c0_ != '\\') {
         literal.Complete();
@@ -1263,9 +1541,9 @@ Token::Value Scanner::ScanIdentifierOrKeyword() {
     HandleLeadSurrogate();
   } else if (IsInRange(c0_, 'A', 'Z') || c0_ == '_' || c0_ == '$') {
     do {
-      uc32 first_char = c0_;
+      AddLiteralChar(c0_);
+      SkipBufferedRun<AsciiIdentifierPart, true>();
       Advance<false, false>();
-      AddLiteralChar(first_char);
     } while (IsAsciiIdentifier(c0_));
 
     if (c0_ <= kMaxAscii && c0_ != '\\') {
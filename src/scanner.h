@@ -46,14 +46,26 @@ inline int HexValue(uc32 c) {
 
 class Utf16CharacterStream {
  public:
-  Utf16CharacterStream() : pos_(0) { }
+  Utf16CharacterStream()
+      : one_byte_cursor_(NULL), one_byte_end_(NULL), pos_(0) {}
   virtual ~Utf16CharacterStream() { }
 
   // Returns and advances past the next UTF-16 code unit in the input
   // stream. If there are no more code units, it returns a negative
   // value.
   inline uc32 Advance() {
-    if (buffer_cursor_ < buffer_end_ || ReadBlock()) {
+    // The UTF-16 buffer is checked first, so that streams which do not read
+    // one-byte characters directly only see the one-byte cursors when their
+    // buffer runs out.
+    if (buffer_cursor_ < buffer_end_) {
+      pos_++;
+      return static_cast<uc32>(*(buffer_cursor_++));
+    }
+    if (one_byte_cursor_ < one_byte_end_) {
+      pos_++;
+      return static_cast<uc32>(*(one_byte_cursor_++));
+    }
+    if (ReadBlock()) {
       pos_++;
       return static_cast<uc32>(*(buffer_cursor_++));
     }
@@ -81,9 +93,39 @@ class Utf16CharacterStream {
       pos_ += code_unit_count;
       return code_unit_count;
     }
+    size_t one_byte_chars = one_byte_end_ - one_byte_cursor_;
+    if (code_unit_count <= one_byte_chars) {
+      one_byte_cursor_ += code_unit_count;
+      pos_ += code_unit_count;
+      return code_unit_count;
+    }
     return SlowSeekForward(code_unit_count);
   }
 
+  // Returns the code units that have already been read into the buffer but
+  // not yet returned by Advance(). The scanner examines these directly to
+  // skip over runs of characters, and then consumes them with SeekForward().
+  inline Vector<const uint16_t> buffered_code_units() const {
+    return Vector<const uint16_t>(
+        buffer_cursor_, static_cast<int>(buffer_end_ - buffer_cursor_));
+  }
+
+  // As above, for streams that read one-byte characters directly from their
+  // source.
+  inline Vector<const uint8_t> buffered_one_byte_chars() const {
+    return Vector<const uint8_t>(
+        one_byte_cursor_, static_cast<int>(one_byte_end_ - one_byte_cursor_));
+  }
+
+  // Returns the code unit the next call to Advance() will return if it has
+  // already been read into the buffer, and a negative value otherwise. Like
+  // Advance() and SeekForward(), it checks the UTF-16 buffer first.
+  inline uc32 PeekBuffered() const {
+    if (buffer_cursor_ < buffer_end_) return *buffer_cursor_;
+    if (one_byte_cursor_ < one_byte_end_) return *one_byte_cursor_;
+    return kEndOfInput;
+  }
+
   // Pushes back the most recently read UTF-16 code unit (or negative
   // value if at end of input), i.e., the value returned by the most recent
   // call to Advance.
@@ -105,6 +147,11 @@ class Utf16CharacterStream {
 
   const uint16_t* buffer_cursor_;
   const uint16_t* buffer_end_;
+  // Streams over one-byte sources may use these instead of the above, and
+  // leave the UTF-16 buffer empty, so that characters are not widened and
+  // copied before being scanned.
+  const uint8_t* one_byte_cursor_;
+  const uint8_t* one_byte_end_;
   size_t pos_;
 };
 
@@ -196,6 +243,21 @@ class LiteralBuffer {
     }
   }
 
+  // Adds code units that are all at most unibrow::Latin1::kMaxChar.
+  template <typename Char>
+  void AddOneByteChars(Vector<const Char> code_units) {
+    int size = code_units.length() * (is_one_byte_ ? kOneByteSize : kUC16Size);
+    while (position_ + size > backing_store_.length()) ExpandBuffer();
+    if (is_one_byte_) {
+      CopyChars(&backing_store_[position_], code_units.start(),
+                code_units.length());
+    } else {
+      CopyChars(reinterpret_cast<uint16_t*>(&backing_store_[position_]),
+                code_units.start(), code_units.length());
+    }
+    position_ += size;
+  }
+
   bool is_one_byte() const { return is_one_byte_; }
 
   bool is_contextual_keyword(Vector<const char> keyword) const {
@@ -658,6 +720,16 @@ class Scanner {
   // Scans a single JavaScript token.
   void Scan();
 
+  // Consumes the longest run of buffered code units following c0_ that are
+  // accepted by Matcher, adding them to the current literal if requested.
+  // Sets *has_line_terminator if it is given and the run contains a line
+  // terminator. c0_ itself is left in place, so the caller still has to
+  // Advance(). Only does work if the run continues past the next code unit.
+  template <typename Matcher, bool add_literal_chars>
+  void SkipBufferedRun(bool* has_line_terminator = NULL);
+  template <typename Matcher, bool add_literal_chars>
+  void ConsumeBufferedRun(bool* has_line_terminator);
+
   bool SkipWhiteSpace();
   Token::Value SkipSingleLineComment();
   Token::Value SkipSourceURLComment();
@@ -761,6 +833,8 @@ class Scanner {
   // Whether there is a multi-line comment that contains a
   // line-terminator after the current token, and before the next.
   bool has_multiline_comment_before_next_;
+  // Whether runs of characters are skipped in bulk (--simd-scanner).
+  bool skip_buffered_runs_;
 };
 
 } }  // namespace v8::internal
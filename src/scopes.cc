@@ -671,6 +671,43 @@ void Scope::CollectStackAndContextLocals(
 }
 
 
+bool Scope::CollectFreeVariableNames(ZoneList<const AstRawString*>* names) {
+  DCHECK(!already_resolved());
+  ZoneHashMap seen(ZoneHashMap::PointersMatch, 8, ZoneAllocationPolicy(zone()));
+  return CollectFreeVariableNames(this, &seen, names);
+}
+
+
+bool Scope::CollectFreeVariableNames(Scope* outermost, ZoneHashMap* seen,
+                                     ZoneList<const AstRawString*>* names) {
+  bool calls_eval = scope_calls_eval_;
+  for (int i = 0; i < unresolved_.length(); i++) {
+    const AstRawString* name = unresolved_[i]->raw_name();
+    // References to variables declared between this scope and the outermost
+    // scope (inclusive) never leave it. The parse is complete at this point,
+    // so all of these declarations are known.
+    bool is_local = false;
+    for (Scope* scope = this; !is_local; scope = scope->outer_scope_) {
+      is_local = scope->LookupLocal(name) != NULL;
+      if (scope == outermost) break;
+    }
+    if (is_local) continue;
+    ZoneHashMap::Entry* entry =
+        seen->LookupOrInsert(const_cast<AstRawString*>(name), name->hash(),
+                             ZoneAllocationPolicy(zone()));
+    if (entry->value != NULL) continue;
+    entry->value = const_cast<AstRawString*>(name);
+    names->Add(name, zone());
+  }
+  for (int i = 0; i < inner_scopes_.length(); i++) {
+    if (inner_scopes_[i]->CollectFreeVariableNames(outermost, seen, names)) {
+      calls_eval = true;
+    }
+  }
+  return calls_eval;
+}
+
+
 bool Scope::AllocateVariables(ParseInfo* info, AstNodeFactory* factory) {
   // 1) Propagate scope information.
   bool outer_scope_calls_sloppy_eval = false;
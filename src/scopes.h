@@ -466,6 +466,12 @@ class Scope: public ZoneObject {
       ZoneList<Variable*>* context_globals,
       ZoneList<Variable*>* strong_mode_free_variables = nullptr);
 
+  // Collect the names referenced from this scope or its inner scopes that are
+  // not declared in between, i.e. the variables this scope may refer to in
+  // enclosing scopes. Only valid before variables are resolved. Returns true
+  // if this scope or any inner scope calls eval.
+  bool CollectFreeVariableNames(ZoneList<const AstRawString*>* names);
+
   // Current number of var or const locals.
   int num_var_or_const() { return num_var_or_const_; }
 
@@ -672,6 +678,9 @@ class Scope: public ZoneObject {
   // These variables are looked up dynamically at runtime.
   Variable* NonLocal(const AstRawString* name, VariableMode mode);
 
+  bool CollectFreeVariableNames(Scope* outermost, ZoneHashMap* seen,
+                                ZoneList<const AstRawString*>* names);
+
   // Variable resolution.
   // Possible results of a recursive variable lookup telling if and how a
   // variable is bound. These are returned in the output parameter *binding_kind
@@ -6,6 +6,8 @@
 
 #include "src/accessors.h"
 #include "src/api.h"
+#include "src/base/lazy-instance.h"
+#include "src/base/platform/mutex.h"
 #include "src/base/platform/platform.h"
 #include "src/bootstrapper.h"
 #include "src/code-stubs.h"
@@ -20,6 +22,7 @@
 #include "src/runtime/runtime.h"
 #include "src/snapshot/natives.h"
 #include "src/snapshot/snapshot.h"
+#include "src/snapshot/snapshot-compression.h"
 #include "src/snapshot/snapshot-source-sink.h"
 #include "src/v8.h"
 #include "src/v8threads.h"
@@ -125,6 +128,12 @@ ExternalReferenceTable::ExternalReferenceTable(Isolate* isolate) {
       "Logger::EnterExternal");
   Add(ExternalReference::log_leave_external_function(isolate).address(),
       "Logger::LeaveExternal");
+  Add(ExternalReference::interpreter_profile_handler_entry_function(isolate)
+          .address(),
+      "Interpreter::ProfileHandlerEntry");
+  Add(ExternalReference::interpreter_profile_handler_exit_function(isolate)
+          .address(),
+      "Interpreter::ProfileHandlerExit");
   Add(ExternalReference::address_of_minus_one_half().address(),
       "double_constants.minus_one_half");
   Add(ExternalReference::stress_deopt_count(isolate).address(),
@@ -310,6 +319,15 @@ ExternalReferenceTable::ExternalReferenceTable(Isolate* isolate) {
         Deoptimizer::CALCULATE_ENTRY_ADDRESS);
     Add(address, "lazy_deopt");
   }
+
+  // Add external references provided by the embedder, e.g. API callbacks.
+  intptr_t* api_external_references = isolate->api_external_references();
+  if (api_external_references != NULL) {
+    while (*api_external_references != 0) {
+      Add(reinterpret_cast<Address>(*api_external_references), "<embedder>");
+      api_external_references++;
+    }
+  }
 }
 
 
@@ -338,6 +356,11 @@ uint32_t ExternalReferenceEncoder::Encode(Address address) const {
 }
 
 
+bool ExternalReferenceEncoder::Contains(Address key) const {
+  return const_cast<HashMap*>(map_)->Lookup(key, Hash(key)) != NULL;
+}
+
+
 const char* ExternalReferenceEncoder::NameOfAddress(Isolate* isolate,
                                                     Address address) const {
   HashMap::Entry* entry =
@@ -2469,13 +2492,17 @@ void CodeSerializer::SerializeObject(HeapObject* obj, HowToCode how_to_code,
         SerializeIC(code_object, how_to_code, where_to_point);
         return;
       case Code::FUNCTION:
-        DCHECK(code_object->has_reloc_info_for_serialization());
         // Only serialize the code for the toplevel function unless specified
         // by flag. Replace code of inner functions by the lazy compile builtin.
-        // This is safe, as checked in Compiler::GetSharedFunctionInfo.
-        if (code_object != main_code_ && !FLAG_serialize_inner) {
+        // This is safe, as checked in Compiler::GetSharedFunctionInfo. The
+        // same goes for inner functions that were compiled lazily before
+        // their script was compiled for serialization.
+        if (code_object != main_code_ &&
+            (!FLAG_serialize_inner ||
+             !code_object->has_reloc_info_for_serialization())) {
           SerializeBuiltin(Builtins::kCompileLazy, how_to_code, where_to_point);
         } else {
+          DCHECK(code_object->has_reloc_info_for_serialization());
           SerializeGeneric(code_object, how_to_code, where_to_point);
         }
         return;
@@ -2662,11 +2689,53 @@ void SerializedData::AllocateData(int size) {
 }
 
 
+// static
+SerializedData::PayloadFormat SerializedData::CompressPayload(
+    Vector<const byte> payload, List<byte>* compressed) {
+  SnapshotCompression::Compress(payload, compressed);
+  while (!IsAligned(compressed->length(), kPointerSize)) compressed->Add(0);
+  if (compressed->length() >= payload.length()) return kUncompressedPayload;
+  return kCompressedPayload;
+}
+
+
+bool SerializedData::DecompressPayload(int payload_offset,
+                                       int uncompressed_length) {
+  Vector<const byte> compressed(data_ + payload_offset, size_ - payload_offset);
+  // Every byte of compressed data produces at most 255 bytes.
+  if (uncompressed_length < 0 ||
+      uncompressed_length / 255 > compressed.length()) {
+    return false;
+  }
+  int size = payload_offset + uncompressed_length;
+  byte* data = NewArray<byte>(size);
+  DCHECK(IsAligned(reinterpret_cast<intptr_t>(data), kPointerAlignment));
+  CopyBytes(data, data_, payload_offset);
+  Vector<byte> uncompressed(data + payload_offset, uncompressed_length);
+  if (!SnapshotCompression::Decompress(compressed, uncompressed)) {
+    DeleteArray(data);
+    return false;
+  }
+  if (owns_data_) DeleteArray(data_);
+  data_ = data;
+  size_ = size;
+  owns_data_ = true;
+  return true;
+}
+
+
 SnapshotData::SnapshotData(const Serializer& ser) {
   DisallowHeapAllocation no_gc;
   List<Reservation> reservations;
   ser.EncodeReservations(&reservations);
-  const List<byte>& payload = ser.sink()->data();
+  const List<byte>& serialized = ser.sink()->data();
+  List<byte> compressed;
+  PayloadFormat format =
+      FLAG_compress_snapshot
+          ? CompressPayload(serialized.ToConstVector(), &compressed)
+          : kUncompressedPayload;
+  const List<byte>& payload =
+      format == kCompressedPayload ? compressed : serialized;
 
   // Calculate sizes.
   int reservation_size = reservations.length() * kInt32Size;
@@ -2680,6 +2749,8 @@ SnapshotData::SnapshotData(const Serializer& ser) {
   SetHeaderValue(kCheckSumOffset, Version::Hash());
   SetHeaderValue(kNumReservationsOffset, reservations.length());
   SetHeaderValue(kPayloadLengthOffset, payload.length());
+  SetHeaderValue(kPayloadFormatOffset, format);
+  SetHeaderValue(kUncompressedPayloadLengthOffset, serialized.length());
 
   // Copy reservation chunk sizes.
   CopyBytes(data_ + kHeaderSize, reinterpret_cast<byte*>(reservations.begin()),
@@ -2692,7 +2763,68 @@ SnapshotData::SnapshotData(const Serializer& ser) {
 
 
 bool SnapshotData::IsSane() {
-  return GetHeaderValue(kCheckSumOffset) == Version::Hash();
+  return GetHeaderValue(kCheckSumOffset) == Version::Hash() &&
+         GetHeaderValue(kPayloadFormatOffset) <= kCompressedPayload;
+}
+
+
+bool SnapshotData::IsCompressed() const {
+  return GetHeaderValue(kPayloadFormatOffset) == kCompressedPayload;
+}
+
+
+namespace {
+
+// Compressed snapshot data is only decompressed once per process. Isolates
+// and contexts created from the same blob share the decompressed copy, which
+// is never freed. The compressed data is kept for comparison, since the
+// embedder may reuse the memory of a blob for another one.
+struct DecompressedSnapshotData {
+  Vector<const byte> compressed;
+  Vector<const byte> decompressed;
+};
+
+struct DecompressedSnapshotCache {
+  base::Mutex mutex;
+  List<DecompressedSnapshotData> entries;
+};
+
+base::LazyInstance<DecompressedSnapshotCache>::type decompressed_snapshots =
+    LAZY_INSTANCE_INITIALIZER;
+
+}  // namespace
+
+
+bool SnapshotData::Decompress() {
+  DecompressedSnapshotCache* cache = decompressed_snapshots.Pointer();
+  base::LockGuard<base::Mutex> lock_guard(&cache->mutex);
+  for (const DecompressedSnapshotData& entry : cache->entries) {
+    if (entry.compressed.length() == size_ &&
+        memcmp(entry.compressed.start(), data_, size_) == 0) {
+      DCHECK(!owns_data_);
+      data_ = const_cast<byte*>(entry.decompressed.start());
+      size_ = entry.decompressed.length();
+      return true;
+    }
+  }
+
+  Vector<byte> compressed = Vector<byte>::New(size_);
+  CopyBytes(compressed.start(), data_, size_);
+  int reservations_size = GetHeaderValue(kNumReservationsOffset) * kInt32Size;
+  int length = GetHeaderValue(kUncompressedPayloadLengthOffset);
+  if (!DecompressPayload(kHeaderSize + reservations_size, length)) {
+    compressed.Dispose();
+    return false;
+  }
+  SetHeaderValue(kPayloadFormatOffset, kUncompressedPayload);
+  SetHeaderValue(kPayloadLengthOffset, length);
+
+  // Hand the decompressed data over to the cache.
+  DecompressedSnapshotData entry = {
+      Vector<const byte>(compressed.start(), compressed.length()), RawData()};
+  cache->entries.Add(entry);
+  owns_data_ = false;
+  return true;
 }
 
 
@@ -2752,10 +2884,17 @@ class Checksum {
 };
 
 
-SerializedCodeData::SerializedCodeData(const List<byte>& payload,
+SerializedCodeData::SerializedCodeData(const List<byte>& serialized,
                                        const CodeSerializer& cs) {
   DisallowHeapAllocation no_gc;
   const List<uint32_t>* stub_keys = cs.stub_keys();
+  List<byte> compressed;
+  PayloadFormat format =
+      FLAG_compress_code_cache
+          ? CompressPayload(serialized.ToConstVector(), &compressed)
+          : kUncompressedPayload;
+  const List<byte>& payload =
+      format == kCompressedPayload ? compressed : serialized;
 
   List<Reservation> reservations;
   cs.EncodeReservations(&reservations);
@@ -2781,6 +2920,8 @@ SerializedCodeData::SerializedCodeData(const List<byte>& payload,
   SetHeaderValue(kNumReservationsOffset, reservations.length());
   SetHeaderValue(kNumCodeStubKeysOffset, num_stub_keys);
   SetHeaderValue(kPayloadLengthOffset, payload.length());
+  SetHeaderValue(kPayloadFormatOffset, format);
+  SetHeaderValue(kUncompressedPayloadLengthOffset, serialized.length());
 
   Checksum checksum(payload.ToConstVector());
   SetHeaderValue(kChecksum1Offset, checksum.a());
@@ -2819,10 +2960,22 @@ SerializedCodeData::SanityCheckResult SerializedCodeData::SanityCheck(
   }
   if (flags_hash != FlagList::Hash()) return FLAGS_MISMATCH;
   if (!Checksum(Payload()).Check(c1, c2)) return CHECKSUM_MISMATCH;
+  if (GetHeaderValue(kPayloadFormatOffset) > kCompressedPayload) {
+    return PAYLOAD_FORMAT_MISMATCH;
+  }
   return CHECK_SUCCESS;
 }
 
 
+bool SerializedCodeData::Decompress() {
+  int length = GetHeaderValue(kUncompressedPayloadLengthOffset);
+  if (!DecompressPayload(PayloadOffset(), length)) return false;
+  SetHeaderValue(kPayloadFormatOffset, kUncompressedPayload);
+  SetHeaderValue(kPayloadLengthOffset, length);
+  return true;
+}
+
+
 uint32_t SerializedCodeData::SourceHash(String* source) const {
   return source->length();
 }
@@ -2847,12 +3000,16 @@ Vector<const SerializedData::Reservation> SerializedCodeData::Reservations()
 }
 
 
-Vector<const byte> SerializedCodeData::Payload() const {
+int SerializedCodeData::PayloadOffset() const {
   int reservations_size = GetHeaderValue(kNumReservationsOffset) * kInt32Size;
   int code_stubs_size = GetHeaderValue(kNumCodeStubKeysOffset) * kInt32Size;
   int payload_offset = kHeaderSize + reservations_size + code_stubs_size;
-  int padded_payload_offset = POINTER_SIZE_ALIGN(payload_offset);
-  const byte* payload = data_ + padded_payload_offset;
+  return POINTER_SIZE_ALIGN(payload_offset);
+}
+
+
+Vector<const byte> SerializedCodeData::Payload() const {
+  const byte* payload = data_ + PayloadOffset();
   DCHECK(IsAligned(reinterpret_cast<intptr_t>(payload), kPointerAlignment));
   int length = GetHeaderValue(kPayloadLengthOffset);
   DCHECK_EQ(data_ + size_, payload + length);
@@ -2878,6 +3035,11 @@ SerializedCodeData* SerializedCodeData::FromCachedData(Isolate* isolate,
   DisallowHeapAllocation no_gc;
   SerializedCodeData* scd = new SerializedCodeData(cached_data);
   SanityCheckResult r = scd->SanityCheck(isolate, source);
+  if (r == CHECK_SUCCESS &&
+      scd->GetHeaderValue(kPayloadFormatOffset) == kCompressedPayload &&
+      !scd->Decompress()) {
+    r = PAYLOAD_FORMAT_MISMATCH;
+  }
   if (r == CHECK_SUCCESS) return scd;
   cached_data->Reject();
   source->GetIsolate()->counters()->code_cache_reject_reason()->AddSample(r);
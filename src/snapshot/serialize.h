@@ -56,6 +56,9 @@ class ExternalReferenceEncoder {
 
   uint32_t Encode(Address key) const;
 
+  // Returns true if {key} is in the external reference table.
+  bool Contains(Address key) const;
+
   const char* NameOfAddress(Isolate* isolate, Address address) const;
 
  private:
@@ -502,6 +505,21 @@ class SerializedData {
 
   void AllocateData(int size);
 
+  // Formats of the serialized payload.
+  enum PayloadFormat { kUncompressedPayload = 0, kCompressedPayload = 1 };
+
+  // Compresses the payload into |compressed|, padded to a multiple of the
+  // pointer size. Returns the format to store, which is kUncompressedPayload
+  // if compressing does not make the payload smaller.
+  static PayloadFormat CompressPayload(Vector<const byte> payload,
+                                       List<byte>* compressed);
+
+  // Replaces the data with a copy in which the compressed payload, starting
+  // at |payload_offset| and ending with the data, is decompressed to
+  // |uncompressed_length| bytes. The header values have to be updated by the
+  // caller. Returns false if the payload is malformed.
+  bool DecompressPayload(int payload_offset, int uncompressed_length);
+
   static uint32_t ComputeMagicNumber(Isolate* isolate) {
     return ComputeMagicNumber(ExternalReferenceTable::instance(isolate));
   }
@@ -894,6 +912,7 @@ class SnapshotData : public SerializedData {
   explicit SnapshotData(const Vector<const byte> snapshot)
       : SerializedData(const_cast<byte*>(snapshot.begin()), snapshot.length()) {
     CHECK(IsSane());
+    if (IsCompressed()) CHECK(Decompress());
   }
 
   Vector<const Reservation> Reservations() const;
@@ -905,18 +924,27 @@ class SnapshotData : public SerializedData {
 
  private:
   bool IsSane();
+  bool IsCompressed() const;
+  // Replaces the data with the decompressed data, which is shared by all
+  // SnapshotData instances of the same compressed data in the process.
+  bool Decompress();
 
   // The data header consists of uint32_t-sized entries:
   // [0] magic number and external reference count
   // [1] version hash
   // [2] number of reservation size entries
   // [3] payload length
+  // [4] payload format
+  // [5] uncompressed payload length
   // ... reservations
   // ... serialized payload
   static const int kCheckSumOffset = kMagicNumberOffset + kInt32Size;
   static const int kNumReservationsOffset = kCheckSumOffset + kInt32Size;
   static const int kPayloadLengthOffset = kNumReservationsOffset + kInt32Size;
-  static const int kHeaderSize = kPayloadLengthOffset + kInt32Size;
+  static const int kPayloadFormatOffset = kPayloadLengthOffset + kInt32Size;
+  static const int kUncompressedPayloadLengthOffset =
+      kPayloadFormatOffset + kInt32Size;
+  static const int kHeaderSize = kUncompressedPayloadLengthOffset + kInt32Size;
 };
 
 
@@ -949,10 +977,14 @@ class SerializedCodeData : public SerializedData {
     SOURCE_MISMATCH = 3,
     CPU_FEATURES_MISMATCH = 4,
     FLAGS_MISMATCH = 5,
-    CHECKSUM_MISMATCH = 6
+    CHECKSUM_MISMATCH = 6,
+    PAYLOAD_FORMAT_MISMATCH = 7
   };
 
   SanityCheckResult SanityCheck(Isolate* isolate, String* source) const;
+  bool Decompress();
+
+  int PayloadOffset() const;
 
   uint32_t SourceHash(String* source) const;
 
@@ -965,11 +997,13 @@ class SerializedCodeData : public SerializedData {
   // [5] number of code stub keys
   // [6] number of reservation size entries
   // [7] payload length
-  // [8] payload checksum part 1
-  // [9] payload checksum part 2
+  // [8] payload format
+  // [9] uncompressed payload length
+  // [10] payload checksum part 1
+  // [11] payload checksum part 2
   // ...  reservations
   // ...  code stub keys
-  // ...  serialized payload
+  // ...  serialized payload, checksummed as stored
   static const int kVersionHashOffset = kMagicNumberOffset + kInt32Size;
   static const int kSourceHashOffset = kVersionHashOffset + kInt32Size;
   static const int kCpuFeaturesOffset = kSourceHashOffset + kInt32Size;
@@ -977,7 +1011,11 @@ class SerializedCodeData : public SerializedData {
   static const int kNumReservationsOffset = kFlagHashOffset + kInt32Size;
   static const int kNumCodeStubKeysOffset = kNumReservationsOffset + kInt32Size;
   static const int kPayloadLengthOffset = kNumCodeStubKeysOffset + kInt32Size;
-  static const int kChecksum1Offset = kPayloadLengthOffset + kInt32Size;
+  static const int kPayloadFormatOffset = kPayloadLengthOffset + kInt32Size;
+  static const int kUncompressedPayloadLengthOffset =
+      kPayloadFormatOffset + kInt32Size;
+  static const int kChecksum1Offset =
+      kUncompressedPayloadLengthOffset + kInt32Size;
   static const int kChecksum2Offset = kChecksum1Offset + kInt32Size;
   static const int kHeaderSize = kChecksum2Offset + kInt32Size;
 };
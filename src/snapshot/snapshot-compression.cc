@@ -0,0 +1,155 @@
+// Copyright 2015 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/snapshot/snapshot-compression.h"
+
+#include "src/list-inl.h"
+#include "src/utils.h"
+
+namespace v8 {
+namespace internal {
+
+namespace {
+
+const int kHashBits = 14;
+const int kHashSize = 1 << kHashBits;
+const int kMaxTokenLength = 15;
+// Positions without a match are skipped faster the longer there has been no
+// match, so that incompressible data is not searched byte by byte.
+const int kSkipShift = 6;
+
+
+inline uint32_t Read32(const byte* p) {
+  uint32_t value;
+  memcpy(&value, p, sizeof(value));
+  return value;
+}
+
+
+inline int Hash(uint32_t sequence) {
+  return static_cast<int>((sequence * 2654435761u) >> (32 - kHashBits));
+}
+
+
+void EmitLength(int length, List<byte>* output) {
+  while (length >= 255) {
+    output->Add(255);
+    length -= 255;
+  }
+  output->Add(static_cast<byte>(length));
+}
+
+
+void EmitLiterals(const byte* literals, int count, int match_length,
+                  List<byte>* output) {
+  int literal_token = Min(count, kMaxTokenLength);
+  int match_token = Min(match_length, kMaxTokenLength);
+  output->Add(static_cast<byte>((literal_token << 4) | match_token));
+  if (literal_token == kMaxTokenLength) {
+    EmitLength(count - kMaxTokenLength, output);
+  }
+  output->AddAll(Vector<byte>(const_cast<byte*>(literals), count));
+}
+
+
+bool ReadLength(const byte** input, const byte* end, int* length) {
+  const byte* cur = *input;
+  int value;
+  do {
+    if (cur == end || *length > kMaxInt / 2) return false;
+    value = *cur++;
+    *length += value;
+  } while (value == 255);
+  *input = cur;
+  return true;
+}
+
+}  // namespace
+
+
+void SnapshotCompression::Compress(Vector<const byte> input,
+                                   List<byte>* output) {
+  const byte* data = input.start();
+  int length = input.length();
+  // Positions of the most recent sequence of kMinMatch bytes with each hash.
+  ScopedVector<int> table(kHashSize);
+  for (int i = 0; i < kHashSize; i++) table[i] = -1;
+
+  int anchor = 0;
+  int position = 0;
+  while (position + kMinMatch <= length) {
+    uint32_t sequence = Read32(data + position);
+    int hash = Hash(sequence);
+    int candidate = table[hash];
+    table[hash] = position;
+    if (candidate < 0 || position - candidate > kMaxOffset ||
+        Read32(data + candidate) != sequence) {
+      position += 1 + ((position - anchor) >> kSkipShift);
+      continue;
+    }
+    int match_length = kMinMatch;
+    while (position + match_length < length &&
+           data[candidate + match_length] == data[position + match_length]) {
+      match_length++;
+    }
+    int offset = position - candidate;
+    EmitLiterals(data + anchor, position - anchor, match_length - kMinMatch,
+                 output);
+    output->Add(static_cast<byte>(offset & 0xff));
+    output->Add(static_cast<byte>(offset >> 8));
+    if (match_length - kMinMatch >= kMaxTokenLength) {
+      EmitLength(match_length - kMinMatch - kMaxTokenLength, output);
+    }
+    position += match_length;
+    anchor = position;
+  }
+  EmitLiterals(data + anchor, length - anchor, 0, output);
+}
+
+
+bool SnapshotCompression::Decompress(Vector<const byte> input,
+                                     Vector<byte> output) {
+  const byte* in = input.start();
+  const byte* in_end = input.end();
+  byte* out = output.start();
+  byte* out_end = output.end();
+  while (in < in_end) {
+    int token = *in++;
+    int literals = token >> 4;
+    if (literals == kMaxTokenLength && !ReadLength(&in, in_end, &literals)) {
+      return false;
+    }
+    if (literals > in_end - in || literals > out_end - out) return false;
+    MemCopy(out, in, literals);
+    in += literals;
+    out += literals;
+    if (out == out_end) return true;
+
+    if (in_end - in < 2) return false;
+    int offset = in[0] | (in[1] << 8);
+    in += 2;
+    int match_length = token & 0xf;
+    if (match_length == kMaxTokenLength &&
+        !ReadLength(&in, in_end, &match_length)) {
+      return false;
+    }
+    match_length += kMinMatch;
+    if (offset == 0 || offset > out - output.start() ||
+        match_length > out_end - out) {
+      return false;
+    }
+    const byte* match = out - offset;
+    if (offset >= match_length) {
+      MemCopy(out, match, match_length);
+      out += match_length;
+    } else {
+      // The match overlaps the bytes it produces, e.g. for runs.
+      for (int i = 0; i < match_length; i++) *out++ = *match++;
+    }
+  }
+  return out == out_end;
+}
+
+}  // namespace internal
+}  // namespace v8
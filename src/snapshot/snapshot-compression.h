@@ -0,0 +1,44 @@
+// Copyright 2015 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8_SNAPSHOT_SNAPSHOT_COMPRESSION_H_
+#define V8_SNAPSHOT_SNAPSHOT_COMPRESSION_H_
+
+#include "src/allocation.h"
+#include "src/list.h"
+#include "src/vector.h"
+
+namespace v8 {
+namespace internal {
+
+// A byte-oriented LZ77 codec in the style of LZ4, used for the payloads of
+// snapshots and code caches. It favors decompression speed over ratio.
+//
+// The compressed data is a sequence of blocks, each consisting of
+//   - a token byte, with the number of literals in the upper four bits and the
+//     match length minus kMinMatch in the lower four bits,
+//   - more bytes of the number of literals if it is 15 or more,
+//   - the literals,
+//   - the offset of the match to copy, as 16-bit little endian,
+//   - more bytes of the match length if it is 15 or more.
+// Lengths are continued with bytes that are added to them, up to and including
+// the first byte that is not 255. The last block ends after its literals.
+class SnapshotCompression : public AllStatic {
+ public:
+  // Appends the compressed input to the output.
+  static void Compress(Vector<const byte> input, List<byte>* output);
+
+  // Decompresses the input into the output, which must have exactly the
+  // length of the uncompressed data. Bytes after the last block are ignored.
+  // Returns false if the input is malformed.
+  static bool Decompress(Vector<const byte> input, Vector<byte> output);
+
+  static const int kMinMatch = 4;
+  static const int kMaxOffset = 0xffff;
+};
+
+}  // namespace internal
+}  // namespace v8
+
+#endif  // V8_SNAPSHOT_SNAPSHOT_COMPRESSION_H_
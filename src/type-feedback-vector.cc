@@ -223,6 +223,28 @@ void TypeFeedbackVector::ClearICSlotsImpl(SharedFunctionInfo* shared,
 }
 
 
+void TypeFeedbackVector::ClearAllocationSites() {
+  Object* uninitialized_sentinel =
+      TypeFeedbackVector::RawUninitializedSentinel(GetIsolate()->heap());
+  int slots = Slots();
+  for (int i = 0; i < slots; i++) {
+    FeedbackVectorSlot slot(i);
+    if (Get(slot)->IsAllocationSite()) {
+      Set(slot, uninitialized_sentinel, SKIP_WRITE_BARRIER);
+    }
+  }
+  int ic_slots = ICSlots();
+  for (int i = 0; i < ic_slots; i++) {
+    FeedbackVectorICSlot slot(i);
+    if (Get(slot)->IsAllocationSite()) {
+      DCHECK_EQ(Code::CALL_IC, GetKind(slot));
+      CallICNexus nexus(this, slot);
+      nexus.ConfigureUninitialized();
+    }
+  }
+}
+
+
 // static
 void TypeFeedbackVector::ClearAllKeyedStoreICs(Isolate* isolate) {
   DCHECK(FLAG_vector_stores);
@@ -154,6 +154,10 @@ class TypeFeedbackVector : public FixedArray {
     ClearICSlotsImpl(shared, false);
   }
 
+  // Also clears the allocation sites that ClearSlots and ClearICSlots keep.
+  // Only for copies that no function runs with.
+  void ClearAllocationSites();
+
   static void ClearAllKeyedStoreICs(Isolate* isolate);
   void ClearKeyedStoreICs(SharedFunctionInfo* shared);
 
@@ -6,6 +6,9 @@
 
 #include <cstring>
 
+#include "src/base/lazy-instance.h"
+#include "src/base/platform/mutex.h"
+#include "src/flags.h"
 #include "src/v8.h"
 
 #ifdef V8_USE_ADDRESS_SANITIZER
@@ -73,6 +76,95 @@ class Segment {
 };
 
 
+namespace {
+
+struct SegmentPoolState {
+  SegmentPoolState() : pooled_bytes(0) {
+    for (Segment*& free_list : free_lists) free_list = nullptr;
+  }
+
+  base::Mutex mutex;
+  Segment* free_lists[ZoneSegmentPool::kNumberOfSizeClasses];
+  size_t pooled_bytes;
+};
+
+base::LazyInstance<SegmentPoolState>::type segment_pool =
+    LAZY_INSTANCE_INITIALIZER;
+
+}  // namespace
+
+
+// static
+size_t ZoneSegmentPool::pooled_bytes() {
+  SegmentPoolState* state = segment_pool.Pointer();
+  base::LockGuard<base::Mutex> lock_guard(&state->mutex);
+  return state->pooled_bytes;
+}
+
+
+// static
+void ZoneSegmentPool::Trim() {
+  SegmentPoolState* state = segment_pool.Pointer();
+  base::LockGuard<base::Mutex> lock_guard(&state->mutex);
+  for (Segment*& free_list : state->free_lists) {
+    while (free_list != nullptr) {
+      Segment* segment = free_list;
+      free_list = segment->next();
+      state->pooled_bytes -= segment->size();
+      Malloced::Delete(segment);
+    }
+  }
+  DCHECK_EQ(0u, state->pooled_bytes);
+}
+
+
+// static
+int ZoneSegmentPool::SizeClassFor(size_t size) {
+  STATIC_ASSERT(Zone::kMaximumSegmentSize ==
+                Zone::kMinimumSegmentSize << (kNumberOfSizeClasses - 1));
+  if (size < Zone::kMinimumSegmentSize || size > Zone::kMaximumSegmentSize ||
+      !base::bits::IsPowerOfTwo64(size)) {
+    return -1;
+  }
+  int size_class = WhichPowerOf2(static_cast<uint32_t>(size)) -
+                   WhichPowerOf2(Zone::kMinimumSegmentSize);
+  DCHECK_LT(size_class, kNumberOfSizeClasses);
+  return size_class;
+}
+
+
+// static
+Segment* ZoneSegmentPool::Acquire(size_t size) {
+  int size_class = SizeClassFor(size);
+  if (size_class < 0) return nullptr;
+  SegmentPoolState* state = segment_pool.Pointer();
+  base::LockGuard<base::Mutex> lock_guard(&state->mutex);
+  Segment* segment = state->free_lists[size_class];
+  if (segment != nullptr) {
+    DCHECK_EQ(size, segment->size());
+    state->free_lists[size_class] = segment->next();
+    state->pooled_bytes -= size;
+  }
+  return segment;
+}
+
+
+// static
+bool ZoneSegmentPool::Release(Segment* segment, size_t size) {
+  int size_class = SizeClassFor(size);
+  if (size_class < 0) return false;
+  SegmentPoolState* state = segment_pool.Pointer();
+  base::LockGuard<base::Mutex> lock_guard(&state->mutex);
+  // Keep the pool below its high-water mark.
+  size_t const limit = static_cast<size_t>(FLAG_zone_segment_pool_size) * KB;
+  if (state->pooled_bytes + size > limit) return false;
+  segment->Initialize(state->free_lists[size_class], size);
+  state->free_lists[size_class] = segment;
+  state->pooled_bytes += size;
+  return true;
+}
+
+
 Zone::Zone()
     : allocation_size_(0),
       segment_bytes_allocated_(0),
@@ -201,7 +293,10 @@ void Zone::DeleteKeptSegment() {
 // Creates a new segment, sets it size, and pushes it to the front
 // of the segment chain. Returns the new segment.
 Segment* Zone::NewSegment(size_t size) {
-  Segment* result = reinterpret_cast<Segment*>(Malloced::New(size));
+  Segment* result = ZoneSegmentPool::Acquire(size);
+  if (result == nullptr) {
+    result = reinterpret_cast<Segment*>(Malloced::New(size));
+  }
   segment_bytes_allocated_ += size;
   if (result != nullptr) {
     result->Initialize(segment_head_, size);
@@ -214,7 +309,11 @@ Segment* Zone::NewSegment(size_t size) {
 // Deletes the given segment. Does not touch the segment chain.
 void Zone::DeleteSegment(Segment* segment, size_t size) {
   segment_bytes_allocated_ -= size;
-  Malloced::Delete(segment);
+  // Un-poison so the segment can be handed out to another zone.
+  ASAN_UNPOISON_MEMORY_REGION(segment, size);
+  if (!ZoneSegmentPool::Release(segment, size)) {
+    Malloced::Delete(segment);
+  }
 }
 
 
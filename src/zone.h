@@ -65,6 +65,8 @@ class Zone final {
   size_t allocation_size() const { return allocation_size_; }
 
  private:
+  friend class ZoneSegmentPool;
+
   // All pointers returned from New() have this alignment.  In addition, if the
   // object being allocated has a size that is divisible by 8 then its alignment
   // will be 8. ASan requires 8-byte alignment.
@@ -118,6 +120,39 @@ class Zone final {
 };
 
 
+// A process-wide, thread-safe pool of zone segments. Zones do not round their
+// segment sizes, but the common sizes (the minimum segment size for the first
+// segment of a zone, the maximum segment size for large zones) are powers of
+// two. Segments of such a size are kept in per-size free lists when a zone
+// releases them, so that later compilations (possibly on other threads) can
+// reuse them instead of going to malloc(). All other segments, and segments
+// released while the pool is above --zone-segment-pool-size, are freed right
+// away.
+class ZoneSegmentPool final : public AllStatic {
+ public:
+  // Number of pooled segment sizes, from 8 KB up to 1 MB.
+  static const int kNumberOfSizeClasses = 8;
+
+  // Returns the number of bytes currently held in the pool.
+  static size_t pooled_bytes();
+
+  // Frees all pooled segments, i.e. on memory pressure.
+  static void Trim();
+
+ private:
+  friend class Zone;
+
+  // Returns a pooled segment of exactly {size} bytes, or nullptr.
+  static Segment* Acquire(size_t size);
+
+  // Takes {segment} into the pool if possible. Returns false if the caller
+  // has to free it.
+  static bool Release(Segment* segment, size_t size);
+
+  static int SizeClassFor(size_t size);
+};
+
+
 // ZoneObject is an abstraction that helps define classes of objects
 // allocated in the Zone. Use it as a base class; see ast.h.
 class ZoneObject {
@@ -645,4 +645,22 @@ class HandleAndZoneScope : public InitializedHandleScope {
   i::Zone main_zone_;
 };
 
+
+// Sets a flag for the lifetime of the scope and restores its previous value
+// afterwards, also when a CHECK fails in between.
+template <typename T>
+class FlagScope {
+ public:
+  FlagScope(T* flag, T new_value) : flag_(flag), previous_value_(*flag) {
+    *flag = new_value;
+  }
+  ~FlagScope() { *flag_ = previous_value_; }
+
+ private:
+  T* flag_;
+  T previous_value_;
+
+  DISALLOW_COPY_AND_ASSIGN(FlagScope);
+};
+
 #endif  // ifndef CCTEST_H_
@@ -39,3 +39,30 @@ TEST(PipelineGeneric) {
   FLAG_turbo_types = false;
   RunPipeline(handles.main_zone(), "(function(a,b) { return a + b; })");
 }
+
+
+TEST(PipelineSplitSteps) {
+  HandleAndZoneScope handles;
+  FLAG_turbo_types = true;
+  Handle<JSFunction> function = v8::Utils::OpenHandle(
+      *v8::Handle<v8::Function>::Cast(
+          CompileRun("(function(a,b) { return a * b + 1; })")));
+  ParseInfo parse_info(handles.main_zone(), function);
+  CHECK(Compiler::ParseAndAnalyze(&parse_info));
+  CompilationInfo info(&parse_info);
+  info.SetOptimizing(BailoutId::None(), Handle<Code>(function->code()));
+
+  Pipeline pipeline(&info);
+  CHECK(pipeline.CreateGraph());
+  {
+    // The middle step must not touch the heap, just like on the concurrent
+    // recompilation thread.
+    DisallowHeapAllocation no_allocation;
+    DisallowHandleAllocation no_handles;
+    DisallowHandleDereference no_deref;
+    CHECK(pipeline.OptimizeGraph());
+  }
+  Handle<Code> code = pipeline.FinalizeCode();
+  CHECK(!code.is_null());
+  CHECK_EQ(*code, *info.code());
+}
@@ -257,3 +257,123 @@ TEST(BytecodeGraphBuilderTwoParameterTests) {
     CHECK(return_value->SameValue(*snippets[i].return_value()));
   }
 }
+
+
+// Defines f by running {script} in a fresh isolate with --ignition-tier-up,
+// then makes f hot by evaluating {call} in a loop and checks that the last
+// call returns {expected}. If {donor} names a function, f takes over its
+// scope info first. With {reason} == kNoReason f must end up optimized by
+// TurboFan, otherwise it must keep running in the interpreter with its
+// optimization disabled for {reason}.
+static void CheckTierUp(const char* script, const char* call, int expected,
+                        BailoutReason reason, const char* donor = nullptr) {
+  bool old_tier_up = i::FLAG_ignition_tier_up;
+  bool old_concurrent = i::FLAG_concurrent_recompilation;
+  int old_interrupt_budget = i::FLAG_interrupt_budget;
+  i::FLAG_ignition = true;
+  i::FLAG_ignition_tier_up = true;
+  i::FLAG_always_opt = false;
+  i::FLAG_concurrent_recompilation = false;
+  i::FLAG_interrupt_budget = 100;
+  ScopedVector<char> ignition_filter(64);
+  SNPrintF(ignition_filter, "--ignition-filter=%s", kFunctionName);
+  FlagList::SetFlagsFromString(ignition_filter.start(),
+                               ignition_filter.length());
+
+  v8::Isolate::CreateParams create_params;
+  create_params.array_buffer_allocator = CcTest::array_buffer_allocator();
+  v8::Isolate* isolate = v8::Isolate::New(create_params);
+  {
+    v8::Isolate::Scope isolate_scope(isolate);
+    v8::HandleScope handle_scope(isolate);
+    v8::Local<v8::Context> context = v8::Context::New(isolate);
+    v8::Context::Scope context_scope(context);
+    Isolate* i_isolate = reinterpret_cast<Isolate*>(isolate);
+    i_isolate->interpreter()->Initialize();
+
+    CompileRun(script);
+    Handle<JSFunction> function = v8::Utils::OpenHandle(
+        *v8::Local<v8::Function>::Cast(CompileRun(kFunctionName)));
+    CHECK(function->shared()->HasBytecodeArray());
+    CHECK(!function->IsOptimized());
+    if (donor != nullptr) {
+      Handle<JSFunction> donor_function = v8::Utils::OpenHandle(
+          *v8::Local<v8::Function>::Cast(CompileRun(donor)));
+      function->shared()->set_scope_info(
+          donor_function->shared()->scope_info());
+    }
+
+    ScopedVector<char> loop(256);
+    SNPrintF(loop, "var r; for (var i = 0; i < 1000; i++) r = %s; r", call);
+    CHECK_EQ(expected, CompileRun(loop.start())->Int32Value());
+    if (reason == kNoReason) {
+      CHECK(function->IsOptimized());
+      CHECK(function->code()->is_turbofanned());
+    } else {
+      CHECK(!function->IsOptimized());
+      CHECK(function->shared()->optimization_disabled());
+      CHECK_EQ(reason, function->shared()->disable_optimization_reason());
+      CHECK(function->shared()->HasBytecodeArray());
+      CHECK_EQ(*i_isolate->builtins()->InterpreterEntryTrampoline(),
+               function->code());
+    }
+    CHECK_EQ(expected, CompileRun(call)->Int32Value());
+  }
+  isolate->Dispose();
+
+  i::FLAG_ignition_tier_up = old_tier_up;
+  i::FLAG_concurrent_recompilation = old_concurrent;
+  i::FLAG_interrupt_budget = old_interrupt_budget;
+}
+
+
+TEST(BytecodeGraphBuilderTierUp) {
+  // A hot interpreted function is marked by the runtime profiler when its
+  // interrupt budget runs out, and its next call optimizes it with TurboFan
+  // from its bytecode.
+  CheckTierUp("function f(p1) { return p1 + 1; }", "f(999)", 1000, kNoReason);
+}
+
+
+TEST(BytecodeGraphBuilderTierUpNamedLoad) {
+  CheckTierUp("function f(p1) { return p1.x; }", "f({x: 999})", 999,
+              kNoReason);
+}
+
+
+TEST(BytecodeGraphBuilderTierUpKeyedStore) {
+  CheckTierUp("var o = [];\nfunction f(p1, p2) { p1[p2] = 1; return p2; }",
+              "f(o, 999)", 999, kNoReason);
+}
+
+
+TEST(BytecodeGraphBuilderTierUpPropertyAccess) {
+  // Named and keyed loads and stores on the same object.
+  CheckTierUp(
+      "var o = {};\n"
+      "function f(p1, p2) { p1.x = p2; p1[p2] = p1.x; return p1[p2]; }",
+      "f(o, 999)", 999, kNoReason);
+}
+
+
+TEST(BytecodeGraphBuilderTierUpContextSlot) {
+  // f has no context of its own, so its variable a lives in the context of
+  // g, which f runs in.
+  CheckTierUp(
+      "function g() { var a = 0; function f(p1) { a = p1; return a + 1; }\n"
+      "  return f; }\n"
+      "var f = g();",
+      "f(999)", 1000, kNoReason);
+}
+
+
+TEST(BytecodeGraphBuilderTierUpClosureCapture) {
+  // The bytecode generator can't compile closures yet, so f takes over the
+  // scope info of g, whose parameter is captured by the closure it returns
+  // and lives in g's function context. The graph builder can't build
+  // function contexts yet.
+  CheckTierUp(
+      "function g(a) { return function() { return a; }; }\ng(1);\n"
+      "function f(p1) { return p1 + 1; }",
+      "f(999)", 1000, kUnsupportedFunctionContext, "g");
+}
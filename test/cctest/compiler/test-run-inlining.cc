@@ -559,3 +559,89 @@ TEST(InlineMutuallyRecursive) {
   InstallAssertInlineCountHelper(CcTest::isolate());
   T.CheckCall(T.Val(42), T.Val(1));
 }
+
+
+TEST(InlinePolymorphicTarget) {
+  FunctionTester T(
+      "(function () {"
+      "  function foo(x) { AssertInlineCount(2); return x; }"
+      "  function baz(x) { AssertInlineCount(2); return x + 1; }"
+      "  function bar(x, y) { var f = y ? foo : baz; return f(x); }"
+      "  return bar;"
+      "})();",
+      kInlineFlags);
+
+  InstallAssertInlineCountHelper(CcTest::isolate());
+  T.CheckCall(T.Val(1), T.Val(1), T.true_value());
+  T.CheckCall(T.Val(2), T.Val(1), T.false_value());
+}
+
+
+TEST(InlineCumulativeBudgetOnlyLimitsPolymorphicTargets) {
+  FlagScope<int> max_inlined_nodes_cumulative(
+      &FLAG_max_inlined_nodes_cumulative, 0);
+
+  // Calls to constant targets are inlined regardless of the budget.
+  FunctionTester T1(
+      "(function(){"
+      "  function foo(s) { AssertInlineCount(2); return s; };"
+      "  function bar(s, t) { return foo(s); };"
+      "  return bar;"
+      "})();",
+      kInlineFlags);
+  InstallAssertInlineCountHelper(CcTest::isolate());
+  T1.CheckCall(T1.Val(1), T1.Val(1), T1.Val(2));
+
+  // Polymorphic call sites are not specialized once it is exhausted.
+  FunctionTester T2(
+      "(function () {"
+      "  function foo(x) { AssertInlineCount(1); return x; }"
+      "  function baz(x) { AssertInlineCount(1); return x + 1; }"
+      "  function bar(x, y) { var f = y ? foo : baz; return f(x); }"
+      "  return bar;"
+      "})();",
+      kInlineFlags);
+  T2.CheckCall(T2.Val(1), T2.Val(1), T2.true_value());
+  T2.CheckCall(T2.Val(2), T2.Val(1), T2.false_value());
+}
+
+
+TEST(InlinePolymorphicTargetNotInlineable) {
+  // {baz} uses its arguments object, so the call site is not specialized and
+  // {foo} is not inlined either.
+  FunctionTester T(
+      "(function () {"
+      "  function foo(x) { AssertInlineCount(1); return x; }"
+      "  function baz(x) { return arguments.length; }"
+      "  function bar(x, y) { var f = y ? foo : baz; return f(x); }"
+      "  return bar;"
+      "})();",
+      kInlineFlags);
+
+  InstallAssertInlineCountHelper(CcTest::isolate());
+  T.CheckCall(T.Val(1), T.Val(1), T.true_value());
+  T.CheckCall(T.Val(1), T.Val(2), T.false_value());
+}
+
+
+TEST(InlineCallICFeedbackTarget) {
+  // The CallIC in {bar} recorded {foo}, so the call is specialized for {foo}
+  // with a generic fallback that calls {baz} without inlining it.
+  FunctionTester T(
+      "var warm = true;"
+      "function foo(x) { if (!warm) AssertInlineCount(2); return x; }"
+      "function baz(x) { if (!warm) AssertInlineCount(1); return x + 1; }"
+      "function bar(f, x) { return f(x); }"
+      "bar(foo, 1);"
+      "bar(foo, 2);"
+      "warm = false;"
+      "bar;",
+      kInlineFlags);
+
+  InstallAssertInlineCountHelper(CcTest::isolate());
+  Handle<JSFunction> foo = T.NewFunction("foo");
+  Handle<JSFunction> baz = T.NewFunction("baz");
+  T.CheckCall(T.Val(1), foo, T.Val(1));
+  T.CheckCall(T.Val(2), baz, T.Val(1));
+  T.CheckCall(T.Val(3), foo, T.Val(3));
+}
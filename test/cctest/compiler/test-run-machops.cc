@@ -5202,6 +5202,60 @@ TEST(RunFloat64RoundTiesAway) {
 }
 
 
+
+TEST(RunFloat32x4Arithmetic) {
+  float lhs[4] = {1.5f, -2.0f, 0.25f, 3e38f};
+  float rhs[4] = {2.0f, 4.0f, -0.5f, 3e38f};
+  float result[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+  RawMachineAssemblerTester<int32_t> m;
+  if (!m.machine()->Float32x4Add().IsSupported() ||
+      !m.machine()->Float32x4Sub().IsSupported() ||
+      !m.machine()->Float32x4Mul().IsSupported()) {
+    return;
+  }
+  Node* const a = m.LoadFromPointer(lhs, kMachSimd128);
+  Node* const b = m.LoadFromPointer(rhs, kMachSimd128);
+  Node* const sum = m.NewNode(m.machine()->Float32x4Add().op(), a, b);
+  Node* const diff = m.NewNode(m.machine()->Float32x4Sub().op(), a, b);
+  m.StoreToPointer(result, kMachSimd128,
+                   m.NewNode(m.machine()->Float32x4Mul().op(), sum, diff));
+  m.Return(m.Int32Constant(0));
+  CHECK_EQ(0, m.Call());
+  for (int i = 0; i < 4; ++i) {
+    float sum_lane = lhs[i] + rhs[i];
+    float diff_lane = lhs[i] - rhs[i];
+    CheckFloatEq(sum_lane * diff_lane, result[i]);
+  }
+}
+
+
+TEST(RunInt32x4Arithmetic) {
+  int32_t lhs[4] = {-3, 0x10000, 0x7fffffff, 5};
+  int32_t rhs[4] = {7, 0x10000, 1, -5};
+  int32_t result[4] = {0, 0, 0, 0};
+  RawMachineAssemblerTester<int32_t> m;
+  if (!m.machine()->Int32x4Add().IsSupported() ||
+      !m.machine()->Int32x4Sub().IsSupported() ||
+      !m.machine()->Int32x4Mul().IsSupported()) {
+    return;
+  }
+  Node* const a = m.LoadFromPointer(lhs, kMachSimd128);
+  Node* const b = m.LoadFromPointer(rhs, kMachSimd128);
+  Node* const product = m.NewNode(m.machine()->Int32x4Mul().op(), a, b);
+  Node* const sum = m.NewNode(m.machine()->Int32x4Add().op(), a, b);
+  m.StoreToPointer(result, kMachSimd128,
+                   m.NewNode(m.machine()->Int32x4Sub().op(), product, sum));
+  m.Return(m.Int32Constant(0));
+  CHECK_EQ(0, m.Call());
+  for (int i = 0; i < 4; ++i) {
+    uint32_t product_lane =
+        static_cast<uint32_t>(lhs[i]) * static_cast<uint32_t>(rhs[i]);
+    uint32_t sum_lane =
+        static_cast<uint32_t>(lhs[i]) + static_cast<uint32_t>(rhs[i]);
+    CHECK_EQ(static_cast<int32_t>(product_lane - sum_lane), result[i]);
+  }
+}
+
 #if !USE_SIMULATOR
 
 namespace {
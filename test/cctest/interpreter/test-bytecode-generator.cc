@@ -111,15 +111,20 @@ TEST(PrimitiveExpressions) {
   InitializedHandleScope handle_scope;
   BytecodeGeneratorHelper helper;
 
+  // Binary operations record their feedback in a plain slot.
+  FeedbackVectorSpec feedback_spec(1);
+  Handle<i::TypeFeedbackVector> vector =
+      helper.factory()->NewTypeFeedbackVector(&feedback_spec);
+  int slot_index = vector->GetIndex(FeedbackVectorSlot(0));
+
   ExpectedSnippet<void*> snippets[] = {
       {"var x = 0; return x;",
        kPointerSize,
        1,
-       6,
+       4,
        {
            B(LdaZero),     //
            B(Star), R(0),  //
-           B(Ldar), R(0),  //
            B(Return)       //
        },
        0
@@ -127,15 +132,13 @@ TEST(PrimitiveExpressions) {
       {"var x = 0; return x + 3;",
        2 * kPointerSize,
        1,
-       12,
+       10,
        {
-           B(LdaZero),         //
-           B(Star), R(0),      //
-           B(Ldar), R(0),      // Easy to spot r1 not really needed here.
-           B(Star), R(1),      // Dead store.
-           B(LdaSmi8), U8(3),  //
-           B(Add), R(1),       //
-           B(Return)           //
+           B(LdaZero),                                //
+           B(Star), R(0),                             // Easy to spot r1 not
+           B(Star), R(1),                             // really needed here.
+           B(AddSmi8), R(1), U8(3), U8(slot_index),  // Dead store.
+           B(Return)                                  //
        },
        0
      }};
@@ -344,10 +347,9 @@ TEST(PropertyLoads) {
 
   ExpectedSnippet<const char*> snippets[] = {
       {"function f(a) { return a.name; }\nf({name : \"test\"})",
-       1 * kPointerSize, 2, 10,
+       1 * kPointerSize, 2, 9,
        {
-          B(Ldar), R(helper.kLastParamIndex),
-          B(Star), R(0),
+          B(LdarStar), R(helper.kLastParamIndex), R(0),
           B(LdaConstant), U8(0),
           B(LoadIC), R(0), U8(vector->first_ic_slot_index()),
           B(Return)
@@ -355,10 +357,9 @@ TEST(PropertyLoads) {
        1, { "name" }
       },
       {"function f(a) { return a[\"key\"]; }\nf({key : \"test\"})",
-       1 * kPointerSize, 2, 10,
+       1 * kPointerSize, 2, 9,
        {
-          B(Ldar), R(helper.kLastParamIndex),
-          B(Star), R(0),
+          B(LdarStar), R(helper.kLastParamIndex), R(0),
           B(LdaConstant), U8(0),
           B(LoadIC), R(0), U8(vector->first_ic_slot_index()),
           B(Return)
@@ -366,20 +367,18 @@ TEST(PropertyLoads) {
        1, { "key" }
       },
       {"function f(a) { return a[100]; }\nf({100 : \"test\"})",
-       1 * kPointerSize, 2, 10,
+       1 * kPointerSize, 2, 9,
        {
-          B(Ldar), R(helper.kLastParamIndex),
-          B(Star), R(0),
+          B(LdarStar), R(helper.kLastParamIndex), R(0),
           B(LdaSmi8), U8(100),
           B(KeyedLoadIC), R(0), U8(vector->first_ic_slot_index()),
           B(Return)
        }, 0
       },
       {"function f(a, b) { return a[b]; }\nf({arg : \"test\"}, \"arg\")",
-       1 * kPointerSize, 3, 10,
+       1 * kPointerSize, 3, 9,
        {
-          B(Ldar), R(helper.kLastParamIndex - 1),
-          B(Star), R(0),
+          B(LdarStar), R(helper.kLastParamIndex - 1), R(0),
           B(Ldar), R(helper.kLastParamIndex),
           B(KeyedLoadIC), R(0), U8(vector->first_ic_slot_index()),
           B(Return)
@@ -387,15 +386,13 @@ TEST(PropertyLoads) {
       },
       {"function f(a) { var b = a.name; return a[-124]; }\n"
        "f({\"-124\" : \"test\", name : 123 })",
-       2 * kPointerSize, 2, 21,
+       2 * kPointerSize, 2, 19,
        {
-          B(Ldar), R(helper.kLastParamIndex),
-          B(Star), R(1),
+          B(LdarStar), R(helper.kLastParamIndex), R(1),
           B(LdaConstant), U8(0),
           B(LoadIC), R(1), U8(vector->first_ic_slot_index()),
           B(Star), R(0),
-          B(Ldar), R(helper.kLastParamIndex),
-          B(Star), R(1),
+          B(LdarStar), R(helper.kLastParamIndex), R(1),
           B(LdaSmi8), U8(-124),
           B(KeyedLoadIC), R(1), U8(vector->first_ic_slot_index() + 2),
           B(Return)
@@ -433,10 +430,9 @@ TEST(PropertyStores) {
 
   ExpectedSnippet<const char*> snippets[] = {
       {"function f(a) { a.name = \"val\"; }\nf({name : \"test\"})",
-       2 * kPointerSize, 2, 16,
+       2 * kPointerSize, 2, 15,
        {
-          B(Ldar), R(helper.kLastParamIndex),
-          B(Star), R(0),
+          B(LdarStar), R(helper.kLastParamIndex), R(0),
           B(LdaConstant), U8(0),
           B(Star), R(1),
           B(LdaConstant), U8(1),
@@ -447,10 +443,9 @@ TEST(PropertyStores) {
        2, { "name", "val" }
       },
       {"function f(a) { a[\"key\"] = \"val\"; }\nf({key : \"test\"})",
-       2 * kPointerSize, 2, 16,
+       2 * kPointerSize, 2, 15,
        {
-          B(Ldar), R(helper.kLastParamIndex),
-          B(Star), R(0),
+          B(LdarStar), R(helper.kLastParamIndex), R(0),
           B(LdaConstant), U8(0),
           B(Star), R(1),
           B(LdaConstant), U8(1),
@@ -461,10 +456,9 @@ TEST(PropertyStores) {
        2, { "key", "val" }
       },
       {"function f(a) { a[100] = \"val\"; }\nf({100 : \"test\"})",
-       2 * kPointerSize, 2, 16,
+       2 * kPointerSize, 2, 15,
        {
-          B(Ldar), R(helper.kLastParamIndex),
-          B(Star), R(0),
+          B(LdarStar), R(helper.kLastParamIndex), R(0),
           B(LdaSmi8), U8(100),
           B(Star), R(1),
           B(LdaConstant), U8(0),
@@ -475,12 +469,10 @@ TEST(PropertyStores) {
        1, { "val" }
       },
       {"function f(a, b) { a[b] = \"val\"; }\nf({arg : \"test\"}, \"arg\")",
-       2 * kPointerSize, 3, 16,
+       2 * kPointerSize, 3, 14,
        {
-          B(Ldar), R(helper.kLastParamIndex - 1),
-          B(Star), R(0),
-          B(Ldar), R(helper.kLastParamIndex),
-          B(Star), R(1),
+          B(LdarStar), R(helper.kLastParamIndex - 1), R(0),
+          B(LdarStar), R(helper.kLastParamIndex), R(1),
           B(LdaConstant), U8(0),
           B(KeyedStoreIC), R(0), R(1), U8(vector->first_ic_slot_index()),
           B(LdaUndefined),
@@ -490,14 +482,12 @@ TEST(PropertyStores) {
       },
       {"function f(a) { a.name = a[-124]; }\n"
        "f({\"-124\" : \"test\", name : 123 })",
-       3 * kPointerSize, 2, 23,
+       3 * kPointerSize, 2, 21,
        {
-          B(Ldar), R(helper.kLastParamIndex),
-          B(Star), R(0),
+          B(LdarStar), R(helper.kLastParamIndex), R(0),
           B(LdaConstant), U8(0),
           B(Star), R(1),
-          B(Ldar), R(helper.kLastParamIndex),
-          B(Star), R(2),
+          B(LdarStar), R(helper.kLastParamIndex), R(2),
           B(LdaSmi8), U8(-124),
           B(KeyedLoadIC), R(2), U8(vector->first_ic_slot_index()),
           B(StoreIC), R(0), R(1), U8(vector->first_ic_slot_index() + 2),
@@ -525,6 +515,50 @@ TEST(PropertyStores) {
   }
 }
 
+
+TEST(ContextSlots) {
+  InitializedHandleScope handle_scope;
+  BytecodeGeneratorHelper helper;
+
+  // f has no context of its own and runs in the context of g, whose only
+  // context allocated variable is a.
+  ExpectedSnippet<int> snippets[] = {
+      {"function g() { var a = 1; function f() { return a; } return f; }\n"
+       "var f = g();\n"
+       "f();",
+       0, 1, 3,
+       {
+          B(LdaContextSlot), U8(Context::MIN_CONTEXT_SLOTS),
+          B(Return)
+       },
+       0
+      },
+      {"function g() { var a; function f(p) { a = p; } return f; }\n"
+       "var f = g();\n"
+       "f(1);",
+       0, 2, 6,
+       {
+          B(Ldar), R(helper.kLastParamIndex),
+          B(StaContextSlot), U8(Context::MIN_CONTEXT_SLOTS),
+          B(LdaUndefined),
+          B(Return)
+       },
+       0
+      }
+  };
+  size_t num_snippets = sizeof(snippets) / sizeof(snippets[0]);
+  for (size_t i = 0; i < num_snippets; i++) {
+    Handle<BytecodeArray> ba =
+        helper.MakeBytecode(snippets[i].code_snippet, "f");
+    CHECK_EQ(ba->frame_size(), snippets[i].frame_size);
+    CHECK_EQ(ba->parameter_count(), snippets[i].parameter_count);
+    CHECK_EQ(ba->length(), snippets[i].bytecode_length);
+    CHECK(!memcmp(ba->GetFirstBytecodeAddress(), snippets[i].bytecode,
+                  ba->length()));
+    CHECK_EQ(ba->constant_pool()->length(), snippets[i].constant_count);
+  }
+}
+
 }  // namespace interpreter
 }  // namespace internal
 }  // namespance v8
@@ -4,9 +4,11 @@
 
 #include "src/v8.h"
 
+#include "src/conversions.h"
 #include "src/execution.h"
 #include "src/handles.h"
 #include "src/interpreter/bytecode-array-builder.h"
+#include "src/interpreter/bytecode-array-iterator.h"
 #include "src/interpreter/interpreter.h"
 #include "test/cctest/cctest.h"
 
@@ -75,10 +77,14 @@ class InterpreterTester {
     return v8::Utils::OpenHandle(*CompileRun(script));
   }
 
+  // Makes the bytecode run in {context} instead of the script context.
+  void set_context(Handle<Context> context) { context_ = context; }
+
  private:
   Isolate* isolate_;
   Handle<BytecodeArray> bytecode_;
   MaybeHandle<TypeFeedbackVector> feedback_vector_;
+  MaybeHandle<Context> context_;
 
   template <class... A>
   Handle<JSFunction> GetBytecodeFunction() {
@@ -97,6 +103,9 @@ class InterpreterTester {
       function->shared()->set_feedback_vector(
           *feedback_vector_.ToHandleChecked());
     }
+    if (!context_.is_null()) {
+      function->set_context(*context_.ToHandleChecked());
+    }
     return function;
   }
 
@@ -115,6 +124,20 @@ using v8::internal::Smi;
 using v8::internal::Token;
 using namespace v8::internal::interpreter;
 
+
+// Returns a feedback vector with |slot_count| plain slots, for the binary
+// operations to record their feedback in.
+static Handle<i::TypeFeedbackVector> NewBinaryOpFeedbackVector(
+    i::Isolate* isolate, int slot_count) {
+  i::FeedbackVectorSpec feedback_spec(slot_count);
+  return isolate->factory()->NewTypeFeedbackVector(&feedback_spec);
+}
+
+
+static Smi* FeedbackSmi(BinaryOperationFeedback feedback) {
+  return Smi::FromInt(static_cast<int>(feedback));
+}
+
 TEST(InterpreterReturn) {
   HandleAndZoneScope handles;
   Handle<Object> undefined_value =
@@ -220,6 +243,202 @@ TEST(InterpreterLoadFalse) {
 }
 
 
+TEST(InterpreterReturnChargesInterruptBudget) {
+  HandleAndZoneScope handles;
+  BytecodeArrayBuilder builder(handles.main_isolate(), handles.main_zone());
+  builder.set_locals_count(0);
+  builder.set_parameter_count(1);
+  builder.LoadLiteral(Smi::FromInt(1)).Return();
+  Handle<BytecodeArray> bytecode_array = builder.ToBytecodeArray();
+  CHECK_EQ(i::FLAG_interrupt_budget, bytecode_array->interrupt_budget());
+
+  InterpreterTester tester(handles.main_isolate(), bytecode_array);
+  auto callable = tester.GetCallable<>();
+  callable().ToHandleChecked();
+  CHECK_EQ(i::FLAG_interrupt_budget - bytecode_array->length(),
+           bytecode_array->interrupt_budget());
+
+  // Exhausting the budget calls into the runtime profiler, which resets it.
+  bytecode_array->set_interrupt_budget(1);
+  Handle<Object> return_val = callable().ToHandleChecked();
+  CHECK_EQ(Smi::cast(*return_val), Smi::FromInt(1));
+  CHECK_EQ(i::FLAG_interrupt_budget, bytecode_array->interrupt_budget());
+}
+
+
+TEST(InterpreterProfileCountsBytecodesAndDispatches) {
+  bool old_ignition_profile = i::FLAG_ignition_profile;
+  i::FLAG_ignition_profile = true;
+  HandleAndZoneScope handles;
+  BytecodeArrayBuilder builder(handles.main_isolate(), handles.main_zone());
+  builder.set_locals_count(1);
+  builder.set_parameter_count(1);
+  Register reg(0);
+  Handle<i::TypeFeedbackVector> vector =
+      NewBinaryOpFeedbackVector(handles.main_isolate(), 1);
+  builder.LoadLiteral(Smi::FromInt(7))
+      .StoreAccumulatorInRegister(reg)
+      .LoadLiteral(Smi::FromInt(3))
+      .BinaryOperation(Token::Value::ADD, reg,
+                       vector->GetIndex(i::FeedbackVectorSlot(0)))
+      .Return();
+  Handle<BytecodeArray> bytecode_array = builder.ToBytecodeArray();
+
+  InterpreterTester tester(handles.main_isolate(), bytecode_array, vector);
+  Interpreter* interpreter = handles.main_isolate()->interpreter();
+  interpreter->ResetProfile();
+  auto callable = tester.GetCallable<>();
+  const int kCalls = 3;
+  for (int i = 0; i < kCalls; i++) {
+    Handle<Object> return_val = callable().ToHandleChecked();
+    CHECK_EQ(Smi::cast(*return_val), Smi::FromInt(10));
+  }
+
+  // Every bytecode is executed once per call, and dispatches straight to the
+  // next one.
+  BytecodeArrayIterator iterator(bytecode_array);
+  Bytecode previous = iterator.current_bytecode();
+  CHECK_EQ(static_cast<uint64_t>(kCalls),
+           interpreter->execution_count(previous));
+  for (iterator.Advance(); !iterator.done(); iterator.Advance()) {
+    Bytecode current = iterator.current_bytecode();
+    CHECK_EQ(static_cast<uint64_t>(kCalls),
+             interpreter->execution_count(current));
+    CHECK_EQ(static_cast<uint64_t>(kCalls),
+             interpreter->dispatch_count(previous, current));
+    previous = current;
+  }
+  CHECK_EQ(0u, interpreter->dispatch_count(Bytecode::kReturn,
+                                           Bytecode::kLdaZero));
+
+  std::ostringstream report;
+  interpreter->PrintAndResetProfile(report);
+  CHECK_NE(std::string::npos, report.str().find("Add"));
+  CHECK_EQ(0u, interpreter->execution_count(Bytecode::kReturn));
+  i::FLAG_ignition_profile = old_ignition_profile;
+}
+
+
+TEST(InterpreterProfileUnwindsHandlersThatThrew) {
+  bool old_ignition_profile = i::FLAG_ignition_profile;
+  i::FLAG_ignition_profile = true;
+  i::FLAG_ignition = true;
+  HandleAndZoneScope handles;
+  i::Isolate* isolate = handles.main_isolate();
+  Interpreter* interpreter = isolate->interpreter();
+  interpreter->Initialize();
+  interpreter->ResetProfile();
+
+  // Stand-ins for the register files of a caller and a deeper callee frame.
+  i::byte stack[2 * i::KB];
+  i::Address caller = stack + i::KB;
+  i::Address callee = stack;
+  intptr_t add_to_return = Interpreter::ProfileDispatchIndex(
+      Bytecode::kAdd, Interpreter::kNumberOfBytecodes);
+  for (int i = 0; i < 3; i++) {
+    // The callee's handler throws, and the exception is caught before it
+    // reaches the caller's Add handler, which then returns.
+    Interpreter::ProfileHandlerEntry(isolate, caller);
+    Interpreter::ProfileHandlerEntry(isolate, callee);
+    Interpreter::ProfileHandlerExit(isolate, add_to_return, caller);
+    CHECK_EQ(0u, interpreter->profile_stack_depth());
+  }
+  CHECK_EQ(3u, interpreter->execution_count(Bytecode::kAdd));
+
+  // A handler that threw in a frame which later continues is dropped too.
+  Interpreter::ProfileHandlerEntry(isolate, caller);
+  Interpreter::ProfileHandlerEntry(isolate, caller);
+  CHECK_EQ(1u, interpreter->profile_stack_depth());
+
+  interpreter->ResetProfile();
+  i::FLAG_ignition_profile = old_ignition_profile;
+}
+
+
+TEST(InterpreterSequenceStats) {
+  bool old_ignition_profile = i::FLAG_ignition_profile;
+  bool old_sequence_stats = i::FLAG_ignition_sequence_stats;
+  i::FLAG_ignition_profile = true;
+  i::FLAG_ignition_sequence_stats = true;
+  HandleAndZoneScope handles;
+  BytecodeArrayBuilder builder(handles.main_isolate(), handles.main_zone());
+  builder.set_locals_count(1);
+  builder.set_parameter_count(1);
+  Register reg(0);
+  Handle<i::TypeFeedbackVector> vector =
+      NewBinaryOpFeedbackVector(handles.main_isolate(), 1);
+  builder.LoadLiteral(Smi::FromInt(7))
+      .StoreAccumulatorInRegister(reg)
+      .LoadLiteral(Smi::FromInt(3))
+      .BinaryOperation(Token::Value::ADD, reg,
+                       vector->GetIndex(i::FeedbackVectorSlot(0)))
+      .Return();
+  Handle<BytecodeArray> bytecode_array = builder.ToBytecodeArray();
+
+  InterpreterTester tester(handles.main_isolate(), bytecode_array, vector);
+  Interpreter* interpreter = handles.main_isolate()->interpreter();
+  interpreter->ResetProfile();
+  auto callable = tester.GetCallable<>();
+  const int kCalls = 3;
+  for (int i = 0; i < kCalls; i++) {
+    callable().ToHandleChecked();
+  }
+
+  // Every executed pair and triple is counted once per call.
+  std::vector<Bytecode> bytecodes;
+  for (BytecodeArrayIterator iterator(bytecode_array); !iterator.done();
+       iterator.Advance()) {
+    bytecodes.push_back(iterator.current_bytecode());
+  }
+  CHECK_LE(3u, bytecodes.size());
+  for (size_t i = 0; i + 1 < bytecodes.size(); i++) {
+    uint64_t pairs = 0;
+    uint64_t triples = 0;
+    for (size_t j = 0; j + 1 < bytecodes.size(); j++) {
+      if (bytecodes[j] != bytecodes[i] ||
+          bytecodes[j + 1] != bytecodes[i + 1]) {
+        continue;
+      }
+      pairs += kCalls;
+      if (i + 2 < bytecodes.size() && j + 2 < bytecodes.size() &&
+          bytecodes[j + 2] == bytecodes[i + 2]) {
+        triples += kCalls;
+      }
+    }
+    CHECK_EQ(pairs,
+             interpreter->sequence_count(bytecodes[i], bytecodes[i + 1]));
+    if (i + 2 < bytecodes.size()) {
+      CHECK_EQ(triples, interpreter->sequence_count(
+                            bytecodes[i], bytecodes[i + 1], bytecodes[i + 2]));
+    }
+  }
+
+  // Triples save two dispatches per execution, so they come first.
+  std::vector<Interpreter::SuperinstructionCandidate> candidates =
+      interpreter->SuperinstructionCandidates();
+  CHECK_EQ(2 * bytecodes.size() - 3, candidates.size());
+  CHECK_EQ(3, candidates.front().length);
+  CHECK_EQ(static_cast<uint64_t>(2 * kCalls),
+           candidates.front().saved_dispatches());
+  CHECK_EQ(2, candidates.back().length);
+  CHECK_EQ(static_cast<uint64_t>(kCalls), candidates.back().count);
+
+  std::ostringstream report;
+  interpreter->PrintSuperinstructionCandidates(report);
+  CHECK_NE(std::string::npos, report.str().find("Superinstruction"));
+  CHECK_NE(std::string::npos,
+           report.str().find(Bytecodes::ToString(bytecodes[0])));
+
+  interpreter->ResetProfile();
+  CHECK_EQ(0u, interpreter->sequence_count(bytecodes[0], bytecodes[1]));
+  CHECK_EQ(0u, interpreter->sequence_count(bytecodes[0], bytecodes[1],
+                                           bytecodes[2]));
+  CHECK(interpreter->SuperinstructionCandidates().empty());
+  i::FLAG_ignition_sequence_stats = old_sequence_stats;
+  i::FLAG_ignition_profile = old_ignition_profile;
+}
+
+
 TEST(InterpreterLoadLiteral) {
   HandleAndZoneScope handles;
   i::Factory* factory = handles.main_isolate()->factory();
@@ -286,11 +505,16 @@ TEST(InterpreterLoadLiteral) {
 TEST(InterpreterLoadStoreRegisters) {
   HandleAndZoneScope handles;
   Handle<Object> true_value = handles.main_isolate()->factory()->true_value();
-  for (int i = 0; i <= Register::kMaxRegisterIndex; i++) {
+  // Registers with single byte operands, followed by registers which need a
+  // Wide or ExtraWide prefix.
+  int scaled_registers[] = {128, 1000, 32768, 32769, 40000};
+  int register_count = 128 + static_cast<int>(arraysize(scaled_registers));
+  for (int i = 0; i < register_count; i++) {
+    int index = i < 128 ? i : scaled_registers[i - 128];
     BytecodeArrayBuilder builder(handles.main_isolate(), handles.main_zone());
-    builder.set_locals_count(i + 1);
+    builder.set_locals_count(index + 1);
     builder.set_parameter_count(1);
-    Register reg(i);
+    Register reg(index);
     builder.LoadTrue()
         .StoreAccumulatorInRegister(reg)
         .LoadFalse()
@@ -306,22 +530,47 @@ TEST(InterpreterLoadStoreRegisters) {
 }
 
 
+TEST(InterpreterLoadConstantPoolEntryWithScaledIndex) {
+  HandleAndZoneScope handles;
+  i::Factory* factory = handles.main_isolate()->factory();
+  // Entries 256 and 65536 need a Wide and ExtraWide operand respectively.
+  int pool_sizes[] = {257, 65537};
+  for (size_t i = 0; i < arraysize(pool_sizes); i++) {
+    BytecodeArrayBuilder builder(handles.main_isolate(), handles.main_zone());
+    builder.set_locals_count(0);
+    builder.set_parameter_count(1);
+    for (int j = 0; j < pool_sizes[i]; j++) {
+      builder.LoadLiteral(factory->NewNumber(j + 0.5));
+    }
+    builder.Return();
+    Handle<BytecodeArray> bytecode_array = builder.ToBytecodeArray();
+    CHECK_EQ(bytecode_array->constant_pool()->length(), pool_sizes[i]);
+
+    InterpreterTester tester(handles.main_isolate(), bytecode_array);
+    auto callable = tester.GetCallable<>();
+    Handle<Object> return_val = callable().ToHandleChecked();
+    CHECK_EQ(return_val->Number(), pool_sizes[i] - 0.5);
+  }
+}
+
+
 TEST(InterpreterAdd) {
   HandleAndZoneScope handles;
-  // TODO(rmcilroy): Do add tests for heap numbers and strings once we support
-  // them.
   BytecodeArrayBuilder builder(handles.main_isolate(), handles.main_zone());
   builder.set_locals_count(1);
   builder.set_parameter_count(1);
   Register reg(0);
+  Handle<i::TypeFeedbackVector> vector =
+      NewBinaryOpFeedbackVector(handles.main_isolate(), 1);
   builder.LoadLiteral(Smi::FromInt(1))
       .StoreAccumulatorInRegister(reg)
       .LoadLiteral(Smi::FromInt(2))
-      .BinaryOperation(Token::Value::ADD, reg)
+      .BinaryOperation(Token::Value::ADD, reg,
+                       vector->GetIndex(i::FeedbackVectorSlot(0)))
       .Return();
   Handle<BytecodeArray> bytecode_array = builder.ToBytecodeArray();
 
-  InterpreterTester tester(handles.main_isolate(), bytecode_array);
+  InterpreterTester tester(handles.main_isolate(), bytecode_array, vector);
   auto callable = tester.GetCallable<>();
   Handle<Object> return_val = callable().ToHandleChecked();
   CHECK_EQ(Smi::cast(*return_val), Smi::FromInt(3));
@@ -330,40 +579,125 @@ TEST(InterpreterAdd) {
 
 TEST(InterpreterSub) {
   HandleAndZoneScope handles;
-  // TODO(rmcilroy): Do add tests for heap numbers once we support them.
   BytecodeArrayBuilder builder(handles.main_isolate(), handles.main_zone());
   builder.set_locals_count(1);
   builder.set_parameter_count(1);
   Register reg(0);
+  Handle<i::TypeFeedbackVector> vector =
+      NewBinaryOpFeedbackVector(handles.main_isolate(), 1);
   builder.LoadLiteral(Smi::FromInt(5))
       .StoreAccumulatorInRegister(reg)
       .LoadLiteral(Smi::FromInt(31))
-      .BinaryOperation(Token::Value::SUB, reg)
+      .BinaryOperation(Token::Value::SUB, reg,
+                       vector->GetIndex(i::FeedbackVectorSlot(0)))
       .Return();
   Handle<BytecodeArray> bytecode_array = builder.ToBytecodeArray();
 
-  InterpreterTester tester(handles.main_isolate(), bytecode_array);
+  InterpreterTester tester(handles.main_isolate(), bytecode_array, vector);
   auto callable = tester.GetCallable<>();
   Handle<Object> return_val = callable().ToHandleChecked();
   CHECK_EQ(Smi::cast(*return_val), Smi::FromInt(-26));
 }
 
 
+TEST(InterpreterAddSmi8) {
+  HandleAndZoneScope handles;
+  struct {
+    int lhs;
+    int rhs;
+    double expected;
+  } cases[] = {{1, 2, 3},
+               {-100, -28, -128},
+               {Smi::kMaxValue, 1, static_cast<double>(Smi::kMaxValue) + 1},
+               {Smi::kMinValue, -1, static_cast<double>(Smi::kMinValue) - 1}};
+
+  for (size_t i = 0; i < arraysize(cases); i++) {
+    BytecodeArrayBuilder builder(handles.main_isolate(), handles.main_zone());
+    builder.set_locals_count(1);
+    builder.set_parameter_count(1);
+    Register reg(0);
+    Handle<i::TypeFeedbackVector> vector =
+        NewBinaryOpFeedbackVector(handles.main_isolate(), 1);
+    // The small literal load is folded into an AddSmi8 bytecode.
+    builder.LoadLiteral(Smi::FromInt(cases[i].lhs))
+        .StoreAccumulatorInRegister(reg)
+        .LoadLiteral(Smi::FromInt(cases[i].rhs))
+        .BinaryOperation(Token::Value::ADD, reg,
+                         vector->GetIndex(i::FeedbackVectorSlot(0)))
+        .Return();
+    Handle<BytecodeArray> bytecode_array = builder.ToBytecodeArray();
+
+    InterpreterTester tester(handles.main_isolate(), bytecode_array, vector);
+    auto callable = tester.GetCallable<>();
+    Handle<Object> return_val = callable().ToHandleChecked();
+    CHECK_EQ(cases[i].expected, return_val->Number());
+  }
+}
+
+
+TEST(InterpreterAddSubOverflowAndNonSmi) {
+  HandleAndZoneScope handles;
+  i::Isolate* isolate = handles.main_isolate();
+  i::Factory* factory = isolate->factory();
+  Handle<Object> one = handle(Smi::FromInt(1), isolate);
+  Handle<Object> two = handle(Smi::FromInt(2), isolate);
+  struct {
+    Token::Value op;
+    Handle<Object> lhs;
+    Handle<Object> rhs;
+    double expected;
+  } cases[] = {
+      {Token::Value::ADD, handle(Smi::FromInt(Smi::kMaxValue), isolate), one,
+       static_cast<double>(Smi::kMaxValue) + 1},
+      {Token::Value::SUB, handle(Smi::FromInt(Smi::kMinValue), isolate), one,
+       static_cast<double>(Smi::kMinValue) - 1},
+      {Token::Value::ADD, factory->NewHeapNumber(1.5), two, 3.5},
+      {Token::Value::SUB, two, factory->NewHeapNumber(0.25), 1.75},
+      {Token::Value::ADD, factory->NewHeapNumber(1.5),
+       factory->NewHeapNumber(1.5), 3}};
+
+  for (size_t i = 0; i < arraysize(cases); i++) {
+    BytecodeArrayBuilder builder(handles.main_isolate(), handles.main_zone());
+    builder.set_locals_count(1);
+    builder.set_parameter_count(1);
+    Register reg(0);
+    Handle<i::TypeFeedbackVector> vector =
+        NewBinaryOpFeedbackVector(isolate, 1);
+    i::FeedbackVectorSlot slot(0);
+    builder.LoadLiteral(cases[i].lhs)
+        .StoreAccumulatorInRegister(reg)
+        .LoadLiteral(cases[i].rhs)
+        .BinaryOperation(cases[i].op, reg, vector->GetIndex(slot))
+        .Return();
+    Handle<BytecodeArray> bytecode_array = builder.ToBytecodeArray();
+
+    InterpreterTester tester(isolate, bytecode_array, vector);
+    auto callable = tester.GetCallable<>();
+    Handle<Object> return_val = callable().ToHandleChecked();
+    CHECK_EQ(cases[i].expected, return_val->Number());
+    // Overflowing Smi operations record number feedback too.
+    CHECK_EQ(FeedbackSmi(BinaryOperationFeedback::kNumber), vector->Get(slot));
+  }
+}
+
+
 TEST(InterpreterMul) {
   HandleAndZoneScope handles;
-  // TODO(rmcilroy): Do add tests for heap numbers once we support them.
   BytecodeArrayBuilder builder(handles.main_isolate(), handles.main_zone());
   builder.set_locals_count(1);
   builder.set_parameter_count(1);
   Register reg(0);
+  Handle<i::TypeFeedbackVector> vector =
+      NewBinaryOpFeedbackVector(handles.main_isolate(), 1);
   builder.LoadLiteral(Smi::FromInt(111))
       .StoreAccumulatorInRegister(reg)
       .LoadLiteral(Smi::FromInt(6))
-      .BinaryOperation(Token::Value::MUL, reg)
+      .BinaryOperation(Token::Value::MUL, reg,
+                       vector->GetIndex(i::FeedbackVectorSlot(0)))
       .Return();
   Handle<BytecodeArray> bytecode_array = builder.ToBytecodeArray();
 
-  InterpreterTester tester(handles.main_isolate(), bytecode_array);
+  InterpreterTester tester(handles.main_isolate(), bytecode_array, vector);
   auto callable = tester.GetCallable<>();
   Handle<Object> return_val = callable().ToHandleChecked();
   CHECK_EQ(Smi::cast(*return_val), Smi::FromInt(666));
@@ -372,19 +706,21 @@ TEST(InterpreterMul) {
 
 TEST(InterpreterDiv) {
   HandleAndZoneScope handles;
-  // TODO(rmcilroy): Do add tests for heap numbers once we support them.
   BytecodeArrayBuilder builder(handles.main_isolate(), handles.main_zone());
   builder.set_locals_count(1);
   builder.set_parameter_count(1);
   Register reg(0);
+  Handle<i::TypeFeedbackVector> vector =
+      NewBinaryOpFeedbackVector(handles.main_isolate(), 1);
   builder.LoadLiteral(Smi::FromInt(-20))
       .StoreAccumulatorInRegister(reg)
       .LoadLiteral(Smi::FromInt(5))
-      .BinaryOperation(Token::Value::DIV, reg)
+      .BinaryOperation(Token::Value::DIV, reg,
+                       vector->GetIndex(i::FeedbackVectorSlot(0)))
       .Return();
   Handle<BytecodeArray> bytecode_array = builder.ToBytecodeArray();
 
-  InterpreterTester tester(handles.main_isolate(), bytecode_array);
+  InterpreterTester tester(handles.main_isolate(), bytecode_array, vector);
   auto callable = tester.GetCallable<>();
   Handle<Object> return_val = callable().ToHandleChecked();
   CHECK_EQ(Smi::cast(*return_val), Smi::FromInt(-4));
@@ -393,25 +729,151 @@ TEST(InterpreterDiv) {
 
 TEST(InterpreterMod) {
   HandleAndZoneScope handles;
-  // TODO(rmcilroy): Do add tests for heap numbers once we support them.
   BytecodeArrayBuilder builder(handles.main_isolate(), handles.main_zone());
   builder.set_locals_count(1);
   builder.set_parameter_count(1);
   Register reg(0);
+  Handle<i::TypeFeedbackVector> vector =
+      NewBinaryOpFeedbackVector(handles.main_isolate(), 1);
   builder.LoadLiteral(Smi::FromInt(121))
       .StoreAccumulatorInRegister(reg)
       .LoadLiteral(Smi::FromInt(100))
-      .BinaryOperation(Token::Value::MOD, reg)
+      .BinaryOperation(Token::Value::MOD, reg,
+                       vector->GetIndex(i::FeedbackVectorSlot(0)))
       .Return();
   Handle<BytecodeArray> bytecode_array = builder.ToBytecodeArray();
 
-  InterpreterTester tester(handles.main_isolate(), bytecode_array);
+  InterpreterTester tester(handles.main_isolate(), bytecode_array, vector);
   auto callable = tester.GetCallable<>();
   Handle<Object> return_val = callable().ToHandleChecked();
   CHECK_EQ(Smi::cast(*return_val), Smi::FromInt(21));
 }
 
 
+TEST(InterpreterBinaryOpsOnNumbers) {
+  HandleAndZoneScope handles;
+  i::Isolate* isolate = handles.main_isolate();
+  i::Factory* factory = isolate->factory();
+  struct {
+    Token::Value op;
+    double lhs;
+    double rhs;
+    double expected;
+  } cases[] = {{Token::Value::MUL, 1.5, 4, 6},
+               {Token::Value::MUL, 0x10000, 0x10000, 4294967296.0},
+               {Token::Value::MUL, -1, 0, -0.0},
+               {Token::Value::DIV, 1, 4, 0.25},
+               {Token::Value::DIV, 7.5, 2.5, 3},
+               {Token::Value::MOD, 5.5, 2, 1.5},
+               {Token::Value::MOD, -4, 2, -0.0},
+               {Token::Value::SUB, 0.5, 1e300, -1e300},
+               {Token::Value::ADD, 0.1, 0.2, 0.1 + 0.2}};
+
+  for (size_t i = 0; i < arraysize(cases); i++) {
+    BytecodeArrayBuilder builder(isolate, handles.main_zone());
+    builder.set_locals_count(0);
+    builder.set_parameter_count(2);
+    Handle<i::TypeFeedbackVector> vector =
+        NewBinaryOpFeedbackVector(isolate, 1);
+    builder.LoadAccumulatorWithRegister(builder.Parameter(1))
+        .BinaryOperation(cases[i].op, builder.Parameter(0),
+                         vector->GetIndex(i::FeedbackVectorSlot(0)))
+        .Return();
+    Handle<BytecodeArray> bytecode_array = builder.ToBytecodeArray();
+
+    InterpreterTester tester(isolate, bytecode_array, vector);
+    auto callable = tester.GetCallable<Handle<Object>, Handle<Object>>();
+    Handle<Object> return_val =
+        callable(factory->NewNumber(cases[i].lhs),
+                 factory->NewNumber(cases[i].rhs)).ToHandleChecked();
+    CHECK_EQ(cases[i].expected, return_val->Number());
+    CHECK_EQ(i::IsMinusZero(cases[i].expected),
+             i::IsMinusZero(return_val->Number()));
+    // Results are Smis exactly when they can be.
+    CHECK_EQ(factory->NewNumber(cases[i].expected)->IsSmi(),
+             return_val->IsSmi());
+  }
+}
+
+
+TEST(InterpreterBinaryOpRecordsFeedback) {
+  HandleAndZoneScope handles;
+  i::Isolate* isolate = handles.main_isolate();
+  i::Factory* factory = isolate->factory();
+  Handle<Object> smi = handle(Smi::FromInt(6), isolate);
+  Handle<Object> other_smi = handle(Smi::FromInt(3), isolate);
+  Handle<Object> heap_number = factory->NewHeapNumber(1.5);
+  Handle<Object> string = factory->NewStringFromAsciiChecked("6");
+  Token::Value ops[] = {Token::Value::ADD, Token::Value::SUB,
+                        Token::Value::MUL, Token::Value::DIV,
+                        Token::Value::MOD};
+
+  for (size_t i = 0; i < arraysize(ops); i++) {
+    BytecodeArrayBuilder builder(isolate, handles.main_zone());
+    builder.set_locals_count(0);
+    builder.set_parameter_count(2);
+    Handle<i::TypeFeedbackVector> vector =
+        NewBinaryOpFeedbackVector(isolate, 1);
+    i::FeedbackVectorSlot slot(0);
+    builder.LoadAccumulatorWithRegister(builder.Parameter(1))
+        .BinaryOperation(ops[i], builder.Parameter(0), vector->GetIndex(slot))
+        .Return();
+    Handle<BytecodeArray> bytecode_array = builder.ToBytecodeArray();
+
+    InterpreterTester tester(isolate, bytecode_array, vector);
+    auto callable = tester.GetCallable<Handle<Object>, Handle<Object>>();
+    CHECK_EQ(*i::TypeFeedbackVector::UninitializedSentinel(isolate),
+             vector->Get(slot));
+
+    // The feedback only ever widens, from Smis to numbers to anything.
+    callable(smi, other_smi).ToHandleChecked();
+    CHECK_EQ(FeedbackSmi(BinaryOperationFeedback::kSignedSmall),
+             vector->Get(slot));
+    callable(heap_number, other_smi).ToHandleChecked();
+    CHECK_EQ(FeedbackSmi(BinaryOperationFeedback::kNumber), vector->Get(slot));
+    callable(smi, other_smi).ToHandleChecked();
+    CHECK_EQ(FeedbackSmi(BinaryOperationFeedback::kNumber), vector->Get(slot));
+    callable(string, other_smi).ToHandleChecked();
+    CHECK_EQ(FeedbackSmi(BinaryOperationFeedback::kAny), vector->Get(slot));
+    callable(heap_number, other_smi).ToHandleChecked();
+    CHECK_EQ(FeedbackSmi(BinaryOperationFeedback::kAny), vector->Get(slot));
+  }
+}
+
+
+TEST(InterpreterContextSlots) {
+  HandleAndZoneScope handles;
+  i::Isolate* isolate = handles.main_isolate();
+  // a is the only variable in the context of the closure get_a.
+  int slot_index = i::Context::MIN_CONTEXT_SLOTS;
+  Handle<i::TypeFeedbackVector> vector = NewBinaryOpFeedbackVector(isolate, 1);
+  BytecodeArrayBuilder builder(isolate, handles.main_zone());
+  builder.set_locals_count(1);
+  builder.set_parameter_count(1);
+  Register reg(0);
+  builder.LoadContextSlot(slot_index)
+      .StoreAccumulatorInRegister(reg)
+      .LoadLiteral(Smi::FromInt(1))
+      .BinaryOperation(Token::Value::ADD, reg,
+                       vector->GetIndex(i::FeedbackVectorSlot(0)))
+      .StoreContextSlot(slot_index)
+      .Return();
+  Handle<BytecodeArray> bytecode_array = builder.ToBytecodeArray();
+
+  InterpreterTester tester(isolate, bytecode_array, vector);
+  Handle<i::JSFunction> get_a = Handle<i::JSFunction>::cast(tester.NewObject(
+      "var get_a = (function() { var a = 41; return function() { return a; }; "
+      "})();\n"
+      "get_a"));
+  tester.set_context(handle(get_a->context(), isolate));
+  auto callable = tester.GetCallable<>();
+
+  CHECK_EQ(Smi::FromInt(42), *callable().ToHandleChecked());
+  CHECK_EQ(Smi::FromInt(43), *callable().ToHandleChecked());
+  CHECK_EQ(43, CompileRun("get_a()")->Int32Value());
+}
+
+
 TEST(InterpreterParameter1) {
   HandleAndZoneScope handles;
   BytecodeArrayBuilder builder(handles.main_isolate(), handles.main_zone());
@@ -440,18 +902,17 @@ TEST(InterpreterParameter8) {
   BytecodeArrayBuilder builder(handles.main_isolate(), handles.main_zone());
   builder.set_locals_count(0);
   builder.set_parameter_count(8);
-  builder.LoadAccumulatorWithRegister(builder.Parameter(0))
-      .BinaryOperation(Token::Value::ADD, builder.Parameter(1))
-      .BinaryOperation(Token::Value::ADD, builder.Parameter(2))
-      .BinaryOperation(Token::Value::ADD, builder.Parameter(3))
-      .BinaryOperation(Token::Value::ADD, builder.Parameter(4))
-      .BinaryOperation(Token::Value::ADD, builder.Parameter(5))
-      .BinaryOperation(Token::Value::ADD, builder.Parameter(6))
-      .BinaryOperation(Token::Value::ADD, builder.Parameter(7))
-      .Return();
+  Handle<i::TypeFeedbackVector> vector =
+      NewBinaryOpFeedbackVector(handles.main_isolate(), 7);
+  builder.LoadAccumulatorWithRegister(builder.Parameter(0));
+  for (int i = 1; i < 8; i++) {
+    builder.BinaryOperation(Token::Value::ADD, builder.Parameter(i),
+                            vector->GetIndex(i::FeedbackVectorSlot(i - 1)));
+  }
+  builder.Return();
   Handle<BytecodeArray> bytecode_array = builder.ToBytecodeArray();
 
-  InterpreterTester tester(handles.main_isolate(), bytecode_array);
+  InterpreterTester tester(handles.main_isolate(), bytecode_array, vector);
   typedef Handle<Object> H;
   auto callable = tester.GetCallable<H, H, H, H, H, H, H, H>();
 
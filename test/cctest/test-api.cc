@@ -15535,6 +15535,66 @@ THREADED_TEST(GetHeapStatistics) {
 }
 
 
+TEST(PooledZoneMemory) {
+  LocalContext c1;
+  v8::Isolate* isolate = c1->GetIsolate();
+  v8::HandleScope scope(isolate);
+  i::ZoneSegmentPool::Trim();
+  v8::HeapStatistics heap_statistics;
+  isolate->GetHeapStatistics(&heap_statistics);
+  size_t const baseline = heap_statistics.pooled_zone_memory();
+  // The first segment of a zone has the minimum zone segment size.
+  size_t const segment_size = 8 * i::KB;
+  {
+    i::Zone zone;
+    zone.New(100);
+  }
+  // The minimum-size segment of the dead zone is kept around for reuse.
+  isolate->GetHeapStatistics(&heap_statistics);
+  CHECK_EQ(baseline + segment_size, heap_statistics.pooled_zone_memory());
+  {
+    // A new zone takes the pooled segment instead of allocating a new one.
+    i::Zone zone;
+    zone.New(100);
+    isolate->GetHeapStatistics(&heap_statistics);
+    CHECK_EQ(baseline, heap_statistics.pooled_zone_memory());
+  }
+  isolate->GetHeapStatistics(&heap_statistics);
+  CHECK_EQ(baseline + segment_size, heap_statistics.pooled_zone_memory());
+  // The low memory notification empties the pool.
+  isolate->LowMemoryNotification();
+  isolate->GetHeapStatistics(&heap_statistics);
+  CHECK_EQ(0u, heap_statistics.pooled_zone_memory());
+}
+
+
+TEST(GetCompilationCacheStatistics) {
+  if (!i::FLAG_compilation_cache) return;
+  LocalContext c1;
+  v8::Isolate* isolate = c1->GetIsolate();
+  v8::HandleScope scope(isolate);
+  v8::CompilationCacheStatistics statistics;
+  CHECK(!isolate->GetCompilationCacheStatistics(
+      &statistics, isolate->NumberOfCompilationCaches()));
+
+  size_t regexp_index = isolate->NumberOfCompilationCaches();
+  for (size_t i = 0; i < isolate->NumberOfCompilationCaches(); i++) {
+    CHECK(isolate->GetCompilationCacheStatistics(&statistics, i));
+    if (strcmp(statistics.cache_name(), "regexp") == 0) regexp_index = i;
+  }
+  CHECK_LT(regexp_index, isolate->NumberOfCompilationCaches());
+  isolate->GetCompilationCacheStatistics(&statistics, regexp_index);
+  size_t hits = statistics.hits();
+  size_t misses = statistics.misses();
+
+  CompileRun("for (var i = 0; i < 3; i++) new RegExp('statistics');");
+  isolate->GetCompilationCacheStatistics(&statistics, regexp_index);
+  CHECK_EQ(hits + 2, statistics.hits());
+  CHECK_EQ(misses + 1, statistics.misses());
+  CHECK_LE(1u, statistics.number_of_entries());
+}
+
+
 class VisitorImpl : public v8::ExternalResourceVisitor {
  public:
   explicit VisitorImpl(TestResource** resource) {
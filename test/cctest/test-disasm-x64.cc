@@ -416,6 +416,8 @@ TEST(DisasmX64) {
     __ mulps(xmm1, Operand(rbx, rcx, times_4, 10000));
     __ divps(xmm1, xmm0);
     __ divps(xmm1, Operand(rbx, rcx, times_4, 10000));
+    __ movups(xmm1, Operand(rbx, rcx, times_4, 10000));
+    __ movups(Operand(rbx, rcx, times_4, 10000), xmm1);
 
     __ ucomiss(xmm0, xmm1);
     __ ucomiss(xmm0, Operand(rbx, rcx, times_4, 10000));
@@ -456,6 +458,8 @@ TEST(DisasmX64) {
     __ psrlq(xmm0, 6);
 
     __ pcmpeqd(xmm1, xmm0);
+    __ paddd(xmm1, xmm0);
+    __ psubd(xmm9, xmm15);
 
     __ punpckldq(xmm1, xmm11);
     __ punpckhdq(xmm8, xmm15);
@@ -489,6 +493,7 @@ TEST(DisasmX64) {
       __ pextrd(r12, xmm0, 1);
       __ pinsrd(xmm9, r9, 0);
       __ pinsrd(xmm5, rax, 1);
+      __ pmulld(xmm1, xmm12);
     }
   }
 
@@ -535,6 +540,17 @@ TEST(DisasmX64) {
       __ vandpd(xmm9, xmm1, Operand(rbx, rcx, times_4, 10000));
       __ vxorpd(xmm0, xmm1, xmm9);
       __ vxorpd(xmm0, xmm1, Operand(rbx, rcx, times_4, 10000));
+
+      __ vaddps(xmm0, xmm1, xmm9);
+      __ vaddps(xmm0, xmm1, Operand(rbx, rcx, times_4, 10000));
+      __ vsubps(xmm8, xmm1, xmm2);
+      __ vmulps(xmm0, xmm9, xmm2);
+      __ vaddpd(xmm0, xmm1, xmm9);
+      __ vsubpd(xmm8, xmm1, xmm2);
+      __ vmulpd(xmm0, xmm9, xmm2);
+      __ vpaddd(xmm0, xmm1, xmm9);
+      __ vpsubd(xmm8, xmm1, xmm2);
+      __ vpmulld(xmm0, xmm9, xmm2);
     }
   }
 
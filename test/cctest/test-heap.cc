@@ -36,6 +36,7 @@
 #include "src/global-handles.h"
 #include "src/heap/gc-tracer.h"
 #include "src/ic/ic.h"
+#include "src/interpreter/interpreter.h"
 #include "src/macro-assembler.h"
 #include "src/snapshot/snapshot.h"
 #include "test/cctest/cctest.h"
@@ -1384,6 +1385,62 @@ TEST(TestCodeFlushingPreAged) {
 }
 
 
+TEST(TestBytecodeFlushing) {
+  // If we do not flush code this test is invalid.
+  if (!FLAG_flush_code) return;
+  i::FLAG_vector_stores = true;
+  i::FLAG_ignition = true;
+  i::FLAG_ignition_filter = StrDup("foo");
+  i::FLAG_always_opt = false;
+  CcTest::InitializeVM();
+  Isolate* isolate = CcTest::i_isolate();
+  isolate->interpreter()->Initialize();
+  Factory* factory = isolate->factory();
+  v8::HandleScope scope(CcTest::isolate());
+  const char* source = "function foo() {"
+                       "  var x = 42;"
+                       "  var y = 42;"
+                       "  return x + y;"
+                       "};"
+                       "foo()";
+  Handle<String> foo_name = factory->InternalizeUtf8String("foo");
+
+  { v8::HandleScope scope(CcTest::isolate());
+    CompileRun(source);
+  }
+
+  // Check function is compiled to bytecode.
+  Handle<Object> func_value =
+      Object::GetProperty(isolate->global_object(), foo_name).ToHandleChecked();
+  CHECK(func_value->IsJSFunction());
+  Handle<JSFunction> function = Handle<JSFunction>::cast(func_value);
+  CHECK(function->shared()->HasBytecodeArray());
+  CHECK(function->shared()->is_compiled());
+
+  // The bytecode will survive at least two GCs.
+  CcTest::heap()->CollectAllGarbage();
+  CcTest::heap()->CollectAllGarbage();
+  CHECK(function->shared()->HasBytecodeArray());
+
+  // Simulate several GCs that use full marking.
+  const int kAgingThreshold = 6;
+  for (int i = 0; i < kAgingThreshold; i++) {
+    CcTest::heap()->CollectAllGarbage();
+  }
+
+  // The bytecode of foo should have been flushed.
+  CHECK(!function->shared()->HasBytecodeArray());
+  CHECK(!function->shared()->is_compiled());
+  CHECK(!function->is_compiled());
+
+  // Call foo to get it recompiled to bytecode.
+  v8::Local<v8::Value> result = CompileRun("foo()");
+  CHECK_EQ(84, result->Int32Value());
+  CHECK(function->shared()->HasBytecodeArray());
+  CHECK(function->is_compiled());
+}
+
+
 TEST(TestCodeFlushingIncremental) {
   // If we do not flush code this test is invalid.
   if (!FLAG_flush_code) return;
@@ -1694,6 +1751,100 @@ TEST(CompilationCacheCachingBehavior) {
 }
 
 
+TEST(CompilationCacheRegExpAging) {
+  if (!FLAG_compilation_cache) return;
+  CcTest::InitializeVM();
+  Isolate* isolate = CcTest::i_isolate();
+  Factory* factory = isolate->factory();
+  CompilationCache* compilation_cache = isolate->compilation_cache();
+
+  v8::HandleScope scope(CcTest::isolate());
+  CompileRun("var hot = /hot/; var cold = /cold/;");
+  Handle<String> hot = factory->InternalizeUtf8String("hot");
+  Handle<String> cold = factory->InternalizeUtf8String("cold");
+  JSRegExp::Flags flags(JSRegExp::NONE);
+
+  // Each lookup raises the hit score of the hot regexp.
+  for (int i = 0; i < 8; i++) {
+    CHECK(!compilation_cache->LookupRegExp(hot, flags).is_null());
+  }
+
+  // The cold regexp only survives the first aging after its insertion.
+  compilation_cache->MarkCompactPrologue();
+  compilation_cache->MarkCompactPrologue();
+  CHECK(compilation_cache->LookupRegExp(cold, flags).is_null());
+  CHECK(!compilation_cache->LookupRegExp(hot, flags).is_null());
+  // The regexp sub-cache is the last one.
+  CHECK_LE(1u, compilation_cache->subcache(3)->evictions());
+
+  // Without further hits, the score of the hot regexp decays as well.
+  for (int i = 0; i < 4; i++) {
+    compilation_cache->MarkCompactPrologue();
+  }
+  CHECK(compilation_cache->LookupRegExp(hot, flags).is_null());
+}
+
+
+TEST(CompilationCacheEvalAging) {
+  if (!FLAG_compilation_cache) return;
+  CcTest::InitializeVM();
+  Isolate* isolate = CcTest::i_isolate();
+  Factory* factory = isolate->factory();
+  CompilationCache* compilation_cache = isolate->compilation_cache();
+
+  v8::HandleScope scope(CcTest::isolate());
+  CompileRun(
+      "function hot() { return 1; }"
+      "function cold() { return 2; }"
+      "hot(); cold();");
+  Handle<JSFunction> hot_function = v8::Utils::OpenHandle(
+      *v8::Handle<v8::Function>::Cast(CcTest::global()->Get(v8_str("hot"))));
+  Handle<JSFunction> cold_function = v8::Utils::OpenHandle(
+      *v8::Handle<v8::Function>::Cast(CcTest::global()->Get(v8_str("cold"))));
+  Handle<SharedFunctionInfo> hot_info(hot_function->shared());
+  Handle<SharedFunctionInfo> cold_info(cold_function->shared());
+  if (hot_info->code()->kind() != Code::FUNCTION) return;
+  if (cold_info->code()->kind() != Code::FUNCTION) return;
+
+  Handle<Context> native_context = isolate->native_context();
+  Handle<SharedFunctionInfo> outer_info(native_context->closure()->shared());
+  Handle<String> hot = factory->InternalizeUtf8String("hot()");
+  Handle<String> cold = factory->InternalizeUtf8String("cold()");
+
+  // The first put only enters a hash, the second one the actual entry.
+  for (int i = 0; i < 2; i++) {
+    compilation_cache->PutEval(hot, outer_info, native_context, hot_info, 0);
+    compilation_cache->PutEval(cold, outer_info, native_context, cold_info,
+                               0);
+  }
+
+  // Each lookup raises the hit score of the hot eval code.
+  for (int i = 0; i < 8; i++) {
+    CHECK(!compilation_cache->LookupEval(hot, outer_info, native_context,
+                                         SLOPPY, 0).is_null());
+  }
+
+  // The cold eval code only survives the first aging after its insertion,
+  // although its code is not old.
+  compilation_cache->MarkCompactPrologue();
+  compilation_cache->MarkCompactPrologue();
+  CHECK(!cold_info->code()->IsOld());
+  CHECK(compilation_cache->LookupEval(cold, outer_info, native_context, SLOPPY,
+                                      0).is_null());
+  CHECK(!compilation_cache->LookupEval(hot, outer_info, native_context, SLOPPY,
+                                       0).is_null());
+  // The global eval sub-cache is the second one.
+  CHECK_LE(1u, compilation_cache->subcache(1)->evictions());
+
+  // Without further hits, the score of the hot eval code decays as well.
+  for (int i = 0; i < 4; i++) {
+    compilation_cache->MarkCompactPrologue();
+  }
+  CHECK(compilation_cache->LookupEval(hot, outer_info, native_context, SLOPPY,
+                                      0).is_null());
+}
+
+
 static void OptimizeEmptyFunction(const char* name) {
   HandleScope scope(CcTest::i_isolate());
   EmbeddedVector<char, 256> source;
@@ -185,6 +185,85 @@ TEST(ScanHTMLEndComments) {
 }
 
 
+TEST(ScanLongRuns) {
+  // Runs of whitespace, comment, identifier and string literal characters
+  // that are longer than the stream buffers are skipped in bulk, so they
+  // cross buffer boundaries.
+  std::string source(1000, ' ');
+  source += "\n// " + std::string(1000, 'x') + "\n";
+  source += "/* " + std::string(1000, 'y') + " * /\n*/";
+  source += std::string(700, 'a') + std::string(700, 'B') + " ";
+  source += "'" + std::string(1200, 'c') + "\"" + std::string(800, 'd');
+  source += "\\n\xe2\x82\xac' if";
+
+  i::UnicodeCache unicode_cache;
+  bool simd_scanner = i::FLAG_simd_scanner;
+  for (int i = 0; i < 2; i++) {
+    i::FLAG_simd_scanner = i == 0;
+    i::Utf8ToUtf16CharacterStream stream(
+        reinterpret_cast<const i::byte*>(source.c_str()),
+        static_cast<unsigned>(source.length()));
+    i::Scanner scanner(&unicode_cache);
+    scanner.Initialize(&stream);
+    i::Zone zone;
+    i::AstValueFactory ast_value_factory(&zone, 0);
+    CHECK_EQ(i::Token::IDENTIFIER, scanner.Next());
+    CHECK(scanner.HasAnyLineTerminatorBeforeNext());
+    const i::AstRawString* identifier =
+        scanner.CurrentSymbol(&ast_value_factory);
+    CHECK(identifier->is_one_byte());
+    CHECK_EQ(1400, identifier->length());
+    CHECK_EQ('B', identifier->raw_data()[1399]);
+    CHECK_EQ(i::Token::STRING, scanner.Next());
+    const i::AstRawString* string = scanner.CurrentSymbol(&ast_value_factory);
+    CHECK(!string->is_one_byte());
+    CHECK_EQ(1200 + 1 + 800 + 2, string->length());
+    CHECK_EQ(i::Token::IF, scanner.Next());
+    CHECK_EQ(i::Token::EOS, scanner.Next());
+  }
+  i::FLAG_simd_scanner = simd_scanner;
+}
+
+
+TEST(ScanLongRunsOneByte) {
+  // As above, but the ASCII-only source is scanned directly from its
+  // one-byte characters.
+  std::string source(1000, ' ');
+  source += "\n// " + std::string(1000, 'x') + "\n";
+  source += "/* " + std::string(1000, 'y') + " * /\n*/";
+  source += std::string(700, 'a') + std::string(700, 'B') + " ";
+  source += "'" + std::string(1200, 'c') + "\"" + std::string(800, 'd');
+  source += "' if";
+
+  i::UnicodeCache unicode_cache;
+  bool simd_scanner = i::FLAG_simd_scanner;
+  for (int i = 0; i < 2; i++) {
+    i::FLAG_simd_scanner = i == 0;
+    i::FlatStringUtf16CharacterStream stream(
+        reinterpret_cast<const i::byte*>(source.c_str()), 0, source.length());
+    i::Scanner scanner(&unicode_cache);
+    scanner.Initialize(&stream);
+    i::Zone zone;
+    i::AstValueFactory ast_value_factory(&zone, 0);
+    CHECK_EQ(i::Token::IDENTIFIER, scanner.Next());
+    CHECK(scanner.HasAnyLineTerminatorBeforeNext());
+    const i::AstRawString* identifier =
+        scanner.CurrentSymbol(&ast_value_factory);
+    CHECK(identifier->is_one_byte());
+    CHECK_EQ(1400, identifier->length());
+    CHECK_EQ('B', identifier->raw_data()[1399]);
+    CHECK_EQ(i::Token::STRING, scanner.Next());
+    const i::AstRawString* string = scanner.CurrentSymbol(&ast_value_factory);
+    CHECK(string->is_one_byte());
+    CHECK_EQ(1200 + 1 + 800, string->length());
+    CHECK_EQ('d', string->raw_data()[1200 + 800]);
+    CHECK_EQ(i::Token::IF, scanner.Next());
+    CHECK_EQ(i::Token::EOS, scanner.Next());
+  }
+  i::FLAG_simd_scanner = simd_scanner;
+}
+
+
 class ScriptResource : public v8::String::ExternalOneByteStringResource {
  public:
   ScriptResource(const char* data, size_t length)
@@ -297,6 +376,111 @@ TEST(PreparseFunctionDataIsUsed) {
 }
 
 
+TEST(PreparseDataSkipsInnerFunctions) {
+  // This tests that functions inside eagerly parsed functions are skipped
+  // when consuming cached data, and that the variables they refer to are
+  // still allocated in a context.
+  i::FLAG_min_preparse_length = 0;
+
+  v8::Isolate* isolate = CcTest::isolate();
+  v8::HandleScope handles(isolate);
+  v8::Local<v8::Context> context = v8::Context::New(isolate);
+  v8::Context::Scope context_scope(context);
+  CcTest::i_isolate()->stack_guard()->SetStackLimit(
+      i::GetCurrentStackPosition() - 128 * 1024);
+
+  const char* good_code =
+      "(function() { var x = 25; function lazy() { var a; } "
+      "function get() { return x; } return get(); })();";
+
+  // Insert a syntax error inside the inner lazy function.
+  const char* bad_code =
+      "(function() { var x = 25; function lazy() { if (   } "
+      "function get() { return x; } return get(); })();";
+
+  v8::ScriptCompiler::Source good_source(v8_str(good_code));
+  v8::ScriptCompiler::Compile(isolate, &good_source,
+                              v8::ScriptCompiler::kProduceParserCache);
+  const v8::ScriptCompiler::CachedData* cached_data =
+      good_source.GetCachedData();
+  CHECK(cached_data->data != NULL);
+  CHECK_GT(cached_data->length, 0);
+
+  v8::ScriptCompiler::Source bad_source(
+      v8_str(bad_code), new v8::ScriptCompiler::CachedData(
+                            cached_data->data, cached_data->length));
+  v8::Local<v8::Value> result =
+      v8::ScriptCompiler::Compile(isolate, &bad_source,
+                                  v8::ScriptCompiler::kConsumeParserCache)
+          ->Run();
+  CHECK(!bad_source.GetCachedData()->rejected);
+  CHECK(result->IsInt32());
+  CHECK_EQ(25, result->Int32Value());
+}
+
+
+static int parallel_preparse_skipped = 0;
+
+
+static int* LookupParallelPreparseCounter(const char* name) {
+  if (strcmp(name, "c:V8.ParallelPreparseSkipped") == 0) {
+    return &parallel_preparse_skipped;
+  }
+  return NULL;
+}
+
+
+TEST(ParallelPreparse) {
+  // This tests that top-level functions preparsed on background threads are
+  // skipped correctly, and that errors in them are still reported.
+  i::FLAG_parallel_preparse = true;
+  i::FLAG_parallel_preparse_min_length = 0;
+  i::FLAG_min_preparse_length = 0;
+
+  v8::Isolate* isolate = CcTest::isolate();
+  isolate->SetCounterFunction(LookupParallelPreparseCounter);
+  v8::HandleScope handles(isolate);
+  v8::Local<v8::Context> context = v8::Context::New(isolate);
+  v8::Context::Scope context_scope(context);
+
+  // Strings, comments, regular expressions and object literals that would
+  // confuse a naive search for function bodies.
+  std::string source =
+      "var o = { f: function(x) { return x; } };\n"
+      "var s = 'function g() {';  /* function h() { */\n"
+      "var r = /function k() \\{/.test(s) ? 1 : 0;\n";
+  for (int i = 0; i < 64; i++) {
+    i::EmbeddedVector<char, 128> function;
+    i::SNPrintF(function,
+                "function f%d(a, b) { var c = a + b; return c + %d; }\n", i,
+                i);
+    source += function.start();
+  }
+  source += "var sum = o.f(r);\n";
+  for (int i = 0; i < 64; i++) {
+    i::EmbeddedVector<char, 32> call;
+    i::SNPrintF(call, "sum += f%d(1, 2);\n", i);
+    source += call.start();
+  }
+  source += "sum;";
+  v8::Local<v8::Value> result = CompileRun(source.c_str());
+  CHECK(result->IsInt32());
+  // The regular expression does not match, so o.f(r) is 0.
+  CHECK_EQ(64 * 3 + 63 * 64 / 2, result->Int32Value());
+  // The functions were skipped using the preparsed entries.
+  CHECK_LT(64 * 30, parallel_preparse_skipped);
+
+  std::string bad_source = source + "\nfunction bad() { if ( }";
+  v8::TryCatch try_catch(isolate);
+  v8::ScriptCompiler::Source script_source(v8_str(bad_source.c_str()));
+  CHECK(v8::ScriptCompiler::Compile(context, &script_source).IsEmpty());
+  CHECK(try_catch.HasCaught());
+
+  isolate->SetCounterFunction(NULL);
+  i::FLAG_parallel_preparse = false;
+}
+
+
 TEST(StandAlonePreParser) {
   v8::V8::Initialize();
 
@@ -573,8 +757,18 @@ void TestCharacterStream(const char* one_byte_source, unsigned length,
 
   i::ExternalTwoByteStringUtf16CharacterStream uc16_stream(
       i::Handle<i::ExternalTwoByteString>::cast(uc16_string), start, end);
+  ScriptResource one_byte_resource(one_byte_source, length);
+  i::Handle<i::String> external_one_byte_string(
+      factory->NewExternalStringFromOneByte(&one_byte_resource)
+          .ToHandleChecked());
+  i::ExternalOneByteStringUtf16CharacterStream one_byte_stream(
+      i::Handle<i::ExternalOneByteString>::cast(external_one_byte_string),
+      start, end);
   i::GenericStringUtf16CharacterStream string_stream(one_byte_string, start,
                                                      end);
+  CHECK(one_byte_string->IsSeqOneByteString());
+  i::SeqOneByteStringUtf16CharacterStream seq_stream(
+      i::Handle<i::SeqOneByteString>::cast(one_byte_string), start, end);
   i::Utf8ToUtf16CharacterStream utf8_stream(
       reinterpret_cast<const i::byte*>(one_byte_source), end);
   utf8_stream.SeekForward(start);
@@ -583,17 +777,25 @@ void TestCharacterStream(const char* one_byte_source, unsigned length,
   while (i < end) {
     // Read streams one char at a time
     CHECK_EQU(i, uc16_stream.pos());
+    CHECK_EQU(i, one_byte_stream.pos());
+    CHECK_EQU(i, seq_stream.pos());
     CHECK_EQU(i, string_stream.pos());
     CHECK_EQU(i, utf8_stream.pos());
     int32_t c0 = one_byte_source[i];
     int32_t c1 = uc16_stream.Advance();
+    int32_t c4 = one_byte_stream.Advance();
+    int32_t c5 = seq_stream.Advance();
     int32_t c2 = string_stream.Advance();
     int32_t c3 = utf8_stream.Advance();
     i++;
     CHECK_EQ(c0, c1);
     CHECK_EQ(c0, c2);
     CHECK_EQ(c0, c3);
+    CHECK_EQ(c0, c4);
+    CHECK_EQ(c0, c5);
     CHECK_EQU(i, uc16_stream.pos());
+    CHECK_EQU(i, one_byte_stream.pos());
+    CHECK_EQU(i, seq_stream.pos());
     CHECK_EQU(i, string_stream.pos());
     CHECK_EQU(i, utf8_stream.pos());
   }
@@ -601,66 +803,101 @@ void TestCharacterStream(const char* one_byte_source, unsigned length,
     // Pushback, re-read, pushback again.
     int32_t c0 = one_byte_source[i - 1];
     CHECK_EQU(i, uc16_stream.pos());
+    CHECK_EQU(i, one_byte_stream.pos());
+    CHECK_EQU(i, seq_stream.pos());
     CHECK_EQU(i, string_stream.pos());
     CHECK_EQU(i, utf8_stream.pos());
     uc16_stream.PushBack(c0);
+    one_byte_stream.PushBack(c0);
+    seq_stream.PushBack(c0);
     string_stream.PushBack(c0);
     utf8_stream.PushBack(c0);
     i--;
     CHECK_EQU(i, uc16_stream.pos());
+    CHECK_EQU(i, one_byte_stream.pos());
+    CHECK_EQU(i, seq_stream.pos());
     CHECK_EQU(i, string_stream.pos());
     CHECK_EQU(i, utf8_stream.pos());
     int32_t c1 = uc16_stream.Advance();
+    int32_t c4 = one_byte_stream.Advance();
+    int32_t c5 = seq_stream.Advance();
     int32_t c2 = string_stream.Advance();
     int32_t c3 = utf8_stream.Advance();
     i++;
     CHECK_EQU(i, uc16_stream.pos());
+    CHECK_EQU(i, one_byte_stream.pos());
+    CHECK_EQU(i, seq_stream.pos());
     CHECK_EQU(i, string_stream.pos());
     CHECK_EQU(i, utf8_stream.pos());
     CHECK_EQ(c0, c1);
     CHECK_EQ(c0, c2);
     CHECK_EQ(c0, c3);
+    CHECK_EQ(c0, c4);
+    CHECK_EQ(c0, c5);
     uc16_stream.PushBack(c0);
+    one_byte_stream.PushBack(c0);
+    seq_stream.PushBack(c0);
     string_stream.PushBack(c0);
     utf8_stream.PushBack(c0);
     i--;
     CHECK_EQU(i, uc16_stream.pos());
+    CHECK_EQU(i, one_byte_stream.pos());
+    CHECK_EQU(i, seq_stream.pos());
     CHECK_EQU(i, string_stream.pos());
     CHECK_EQU(i, utf8_stream.pos());
   }
+  // The stream over the sequential string must follow it when it moves.
+  CcTest::heap()->CollectGarbage(i::NEW_SPACE);
+
   unsigned halfway = start + sub_length / 2;
   uc16_stream.SeekForward(halfway - i);
+  one_byte_stream.SeekForward(halfway - i);
+  seq_stream.SeekForward(halfway - i);
   string_stream.SeekForward(halfway - i);
   utf8_stream.SeekForward(halfway - i);
   i = halfway;
   CHECK_EQU(i, uc16_stream.pos());
+  CHECK_EQU(i, one_byte_stream.pos());
+  CHECK_EQU(i, seq_stream.pos());
   CHECK_EQU(i, string_stream.pos());
   CHECK_EQU(i, utf8_stream.pos());
 
   while (i < end) {
     // Read streams one char at a time
     CHECK_EQU(i, uc16_stream.pos());
+    CHECK_EQU(i, one_byte_stream.pos());
+    CHECK_EQU(i, seq_stream.pos());
     CHECK_EQU(i, string_stream.pos());
     CHECK_EQU(i, utf8_stream.pos());
     int32_t c0 = one_byte_source[i];
     int32_t c1 = uc16_stream.Advance();
+    int32_t c4 = one_byte_stream.Advance();
+    int32_t c5 = seq_stream.Advance();
     int32_t c2 = string_stream.Advance();
     int32_t c3 = utf8_stream.Advance();
     i++;
     CHECK_EQ(c0, c1);
     CHECK_EQ(c0, c2);
     CHECK_EQ(c0, c3);
+    CHECK_EQ(c0, c4);
+    CHECK_EQ(c0, c5);
     CHECK_EQU(i, uc16_stream.pos());
+    CHECK_EQU(i, one_byte_stream.pos());
+    CHECK_EQU(i, seq_stream.pos());
     CHECK_EQU(i, string_stream.pos());
     CHECK_EQU(i, utf8_stream.pos());
   }
 
   int32_t c1 = uc16_stream.Advance();
+  int32_t c4 = one_byte_stream.Advance();
+  int32_t c5 = seq_stream.Advance();
   int32_t c2 = string_stream.Advance();
   int32_t c3 = utf8_stream.Advance();
   CHECK_LT(c1, 0);
   CHECK_LT(c2, 0);
   CHECK_LT(c3, 0);
+  CHECK_LT(c4, 0);
+  CHECK_LT(c5, 0);
 }
 
 
@@ -31,6 +31,8 @@
 
 #include "src/v8.h"
 
+#include "src/base/utils/random-number-generator.h"
+
 #include "src/bootstrapper.h"
 #include "src/compilation-cache.h"
 #include "src/debug/debug.h"
@@ -42,6 +44,7 @@
 #include "src/snapshot/natives.h"
 #include "src/snapshot/serialize.h"
 #include "src/snapshot/snapshot.h"
+#include "src/snapshot/snapshot-compression.h"
 #include "test/cctest/cctest.h"
 
 using namespace v8::internal;
@@ -831,6 +834,228 @@ TEST(SnapshotBlobsStackOverflow) {
 }
 
 
+static void SerializedCallback(
+    const v8::FunctionCallbackInfo<v8::Value>& args) {
+  args.GetReturnValue().Set(v8_num(42));
+}
+
+
+static intptr_t snapshot_creator_external_references[] = {
+    reinterpret_cast<intptr_t>(SerializedCallback), 0};
+
+
+TEST(SnapshotCreatorExternalReferences) {
+  DisableTurbofan();
+  v8::StartupData blob;
+  {
+    v8::SnapshotCreator creator(snapshot_creator_external_references);
+    v8::Isolate* isolate = creator.GetIsolate();
+    {
+      v8::HandleScope handle_scope(isolate);
+      v8::Local<v8::Context> context = v8::Context::New(isolate);
+      v8::Context::Scope context_scope(context);
+      v8::Local<v8::FunctionTemplate> callback =
+          v8::FunctionTemplate::New(isolate, SerializedCallback);
+      v8::Local<v8::Value> function =
+          callback->GetFunction(context).ToLocalChecked();
+      CHECK(context->Global()->Set(context, v8_str("f"), function).FromJust());
+      CompileRun("var o = { value: f() + 1 };");
+      creator.SetDefaultContext(context);
+    }
+    blob = creator.CreateBlob();
+  }
+  CHECK_NOT_NULL(blob.data);
+
+  v8::Isolate::CreateParams params;
+  params.snapshot_blob = &blob;
+  params.array_buffer_allocator = CcTest::array_buffer_allocator();
+  params.external_references = snapshot_creator_external_references;
+  v8::Isolate* isolate = v8::Isolate::New(params);
+  {
+    v8::Isolate::Scope i_scope(isolate);
+    v8::HandleScope h_scope(isolate);
+    v8::Local<v8::Context> context = v8::Context::New(isolate);
+    v8::Context::Scope c_scope(context);
+    CHECK_EQ(43, CompileRun("o.value")->ToInt32(isolate)->Int32Value());
+    CHECK_EQ(42, CompileRun("f()")->ToInt32(isolate)->Int32Value());
+  }
+  isolate->Dispose();
+  delete[] blob.data;
+}
+
+
+static void CheckCompressionRoundTrip(Vector<const byte> data) {
+  List<byte> compressed;
+  SnapshotCompression::Compress(data, &compressed);
+  // Padding after the last block is ignored.
+  for (int padding = 0; padding < 2; padding++) {
+    Vector<byte> decompressed = Vector<byte>::New(data.length());
+    CHECK(SnapshotCompression::Decompress(compressed.ToConstVector(),
+                                          decompressed));
+    CHECK_EQ(0, memcmp(data.start(), decompressed.start(), data.length()));
+    decompressed.Dispose();
+    compressed.Add(0);
+  }
+}
+
+
+TEST(SnapshotCompression) {
+  CheckCompressionRoundTrip(Vector<const byte>());
+  CheckCompressionRoundTrip(STATIC_CHAR_VECTOR("abc"));
+  CheckCompressionRoundTrip(STATIC_CHAR_VECTOR("abcdabcdabcdabcdabcdabcd"));
+
+  const int kLength = 100000;
+  Vector<byte> data = Vector<byte>::New(kLength);
+  Vector<const byte> const_data(data.start(), kLength);
+  for (int i = 0; i < kLength; i++) data[i] = static_cast<byte>(i % 251);
+  List<byte> compressed;
+  SnapshotCompression::Compress(const_data, &compressed);
+  CHECK_LT(compressed.length(), kLength / 10);
+  CheckCompressionRoundTrip(const_data);
+  v8::base::RandomNumberGenerator rng(42);
+  rng.NextBytes(data.start(), kLength);
+  CheckCompressionRoundTrip(const_data);
+
+  // Malformed input is rejected: truncated data, and matches that refer to
+  // data before the start.
+  CHECK(!SnapshotCompression::Decompress(
+      compressed.ToConstVector().SubVector(0, compressed.length() / 2), data));
+  const byte bad_offset[] = {0x10, 'a', 0x02, 0x00};
+  CHECK(!SnapshotCompression::Decompress(
+      Vector<const byte>(bad_offset, arraysize(bad_offset)),
+      data.SubVector(0, 5)));
+  data.Dispose();
+}
+
+
+TEST(CompressedSnapshotBlob) {
+  DisableTurbofan();
+  const char* source =
+      "var a = [];"
+      "for (var i = 0; i < 1000; i++) a.push({ x: i, y: 'y' + i });"
+      "function f() { return a[999].x; }";
+
+  FLAG_compress_snapshot = false;
+  v8::StartupData uncompressed = v8::V8::CreateSnapshotDataBlob(source);
+  FLAG_compress_snapshot = true;
+  v8::StartupData compressed = v8::V8::CreateSnapshotDataBlob(source);
+  CHECK_LT(compressed.raw_size, uncompressed.raw_size);
+
+  v8::StartupData* blobs[] = {&uncompressed, &compressed};
+  for (size_t i = 0; i < arraysize(blobs); i++) {
+    v8::base::ElapsedTimer timer;
+    timer.Start();
+    v8::Isolate::CreateParams params;
+    params.snapshot_blob = blobs[i];
+    params.array_buffer_allocator = CcTest::array_buffer_allocator();
+    v8::Isolate* isolate = v8::Isolate::New(params);
+    {
+      v8::Isolate::Scope i_scope(isolate);
+      v8::HandleScope h_scope(isolate);
+      v8::Local<v8::Context> context = v8::Context::New(isolate);
+      v8::Context::Scope c_scope(context);
+      if (FLAG_profile_deserialization) {
+        PrintF("[Starting from a snapshot of %d bytes took %0.3f ms]\n",
+               blobs[i]->raw_size, timer.Elapsed().InMillisecondsF());
+      }
+      CHECK_EQ(999, CompileRun("f()")->ToInt32(isolate)->Int32Value());
+    }
+    isolate->Dispose();
+    delete[] blobs[i]->data;
+  }
+}
+
+
+UNINITIALIZED_TEST(CompressedSnapshotDataIsShared) {
+  DisableTurbofan();
+  if (DefaultSnapshotAvailable()) return;
+  bool const compress_snapshot = FLAG_compress_snapshot;
+  FLAG_compress_snapshot = true;
+  v8::Isolate* v8_isolate = TestIsolate::NewInitialized(true);
+  {
+    v8::Isolate::Scope isolate_scope(v8_isolate);
+    {
+      v8::HandleScope scope(v8_isolate);
+      v8::Context::New(v8_isolate);
+    }
+    Isolate* isolate = reinterpret_cast<Isolate*>(v8_isolate);
+    isolate->heap()->CollectAllAvailableGarbage("serialize");
+    SnapshotByteSink sink;
+    StartupSerializer ser(isolate, &sink);
+    ser.Serialize();
+    SnapshotData snapshot(ser);
+
+    // Two copies of the compressed data, as if they came from two blobs.
+    Vector<const byte> raw_data = snapshot.RawData();
+    Vector<byte> first = Vector<byte>::New(raw_data.length());
+    Vector<byte> second = Vector<byte>::New(raw_data.length());
+    CopyBytes(first.start(), raw_data.start(), raw_data.length());
+    CopyBytes(second.start(), raw_data.start(), raw_data.length());
+    {
+      SnapshotData first_data(
+          Vector<const byte>(first.start(), first.length()));
+      SnapshotData second_data(
+          Vector<const byte>(second.start(), second.length()));
+      // The data has been decompressed once, and the copy is shared.
+      CHECK(first.start() != first_data.RawData().start());
+      CHECK_EQ(first_data.RawData().start(), second_data.RawData().start());
+      CHECK_EQ(first_data.Payload().start(), second_data.Payload().start());
+    }
+    first.Dispose();
+    second.Dispose();
+  }
+  v8_isolate->Dispose();
+  FLAG_compress_snapshot = compress_snapshot;
+}
+
+
+TEST(SnapshotCreatorUnknownExternalReferences) {
+  DisableTurbofan();
+  v8::SnapshotCreator creator;
+  v8::Isolate* isolate = creator.GetIsolate();
+  {
+    v8::HandleScope handle_scope(isolate);
+    v8::Local<v8::Context> context = v8::Context::New(isolate);
+    v8::Context::Scope context_scope(context);
+    v8::Local<v8::FunctionTemplate> callback =
+        v8::FunctionTemplate::New(isolate, SerializedCallback);
+    v8::Local<v8::Value> function =
+        callback->GetFunction(context).ToLocalChecked();
+    CHECK(context->Global()->Set(context, v8_str("f"), function).FromJust());
+    creator.SetDefaultContext(context);
+  }
+  // SerializedCallback is not listed in the external references.
+  v8::StartupData blob = creator.CreateBlob();
+  CHECK_NULL(blob.data);
+  CHECK_EQ(0, blob.raw_size);
+}
+
+
+TEST(SnapshotCreatorInternalFieldPointers) {
+  DisableTurbofan();
+  static int embedder_data = 0;
+  v8::SnapshotCreator creator(snapshot_creator_external_references);
+  v8::Isolate* isolate = creator.GetIsolate();
+  {
+    v8::HandleScope handle_scope(isolate);
+    v8::Local<v8::Context> context = v8::Context::New(isolate);
+    v8::Context::Scope context_scope(context);
+    v8::Local<v8::ObjectTemplate> object_template =
+        v8::ObjectTemplate::New(isolate);
+    object_template->SetInternalFieldCount(1);
+    v8::Local<v8::Object> object =
+        object_template->NewInstance(context).ToLocalChecked();
+    object->SetAlignedPointerInInternalField(0, &embedder_data);
+    CHECK(context->Global()->Set(context, v8_str("o"), object).FromJust());
+    creator.SetDefaultContext(context);
+  }
+  // The pointer would dangle in any other process.
+  v8::StartupData blob = creator.CreateBlob();
+  CHECK_NULL(blob.data);
+  CHECK_EQ(0, blob.raw_size);
+}
+
+
 TEST(TestThatAlwaysSucceeds) {
 }
 
@@ -1117,6 +1342,52 @@ TEST(SerializeToplevelLargeStrings) {
 }
 
 
+TEST(SerializeToplevelCompressed) {
+  FLAG_serialize_toplevel = true;
+  LocalContext context;
+  Isolate* isolate = CcTest::i_isolate();
+  isolate->compilation_cache()->Disable();  // Disable same-isolate code cache.
+
+  v8::HandleScope scope(CcTest::isolate());
+
+  Vector<const uint8_t> source = ConstructSource(
+      STATIC_CHAR_VECTOR("var a = [];"),
+      STATIC_CHAR_VECTOR("a.push((function(x) { return x + 'abc'; })(1));"),
+      STATIC_CHAR_VECTOR("a.length"), 200);
+  Handle<String> source_str =
+      isolate->factory()->NewStringFromOneByte(source).ToHandleChecked();
+
+  ScriptData* uncompressed = NULL;
+  CompileScript(isolate, source_str, Handle<String>(), &uncompressed,
+                v8::ScriptCompiler::kProduceCodeCache);
+  FLAG_compress_code_cache = true;
+  ScriptData* cache = NULL;
+  CompileScript(isolate, source_str, Handle<String>(), &cache,
+                v8::ScriptCompiler::kProduceCodeCache);
+  CHECK_LT(cache->length(), uncompressed->length());
+
+  Handle<SharedFunctionInfo> copy;
+  {
+    DisallowCompilation no_compile_expected(isolate);
+    copy = CompileScript(isolate, source_str, Handle<String>(), &cache,
+                         v8::ScriptCompiler::kConsumeCodeCache);
+  }
+  CHECK(!cache->rejected());
+
+  Handle<JSFunction> copy_fun =
+      isolate->factory()->NewFunctionFromSharedFunctionInfo(
+          copy, isolate->native_context());
+  Handle<JSObject> global(isolate->context()->global_object());
+  Handle<Object> copy_result =
+      Execution::Call(isolate, copy_fun, global, 0, NULL).ToHandleChecked();
+  CHECK_EQ(200, Handle<Smi>::cast(copy_result)->value());
+
+  delete uncompressed;
+  delete cache;
+  source.Dispose();
+}
+
+
 TEST(SerializeToplevelThreeBigStrings) {
   FLAG_serialize_toplevel = true;
   LocalContext context;
@@ -1528,6 +1799,395 @@ TEST(SerializeToplevelBitFlip) {
 }
 
 
+static const char* kWarmUpSource =
+    "function f() { return 'abc'; }"
+    "function g(n) { return new Array(n); }"
+    "function h(o) { return o.x; }"
+    "function k(o) { return o.y; }"
+    "f() + 'def'";
+
+
+static bool IsCompiled(const char* name) {
+  return v8::Utils::OpenHandle(*v8::Local<v8::Function>::Cast(CompileRun(name)))
+      ->shared()
+      ->is_compiled();
+}
+
+
+// Consumes the cache if there is one, checks that the functions named by the
+// characters of expect_compiled come from it, runs the warm-up code and returns
+// a new cache created after execution.
+static v8::ScriptCompiler::CachedData* RunAndCreateCodeCache(
+    v8::ScriptCompiler::CachedData* cache, const char* warm_up,
+    const char* expect_compiled) {
+  v8::ScriptCompiler::CachedData* result;
+  v8::Isolate::CreateParams create_params;
+  create_params.array_buffer_allocator = CcTest::array_buffer_allocator();
+  v8::Isolate* isolate = v8::Isolate::New(create_params);
+  {
+    v8::Isolate::Scope iscope(isolate);
+    v8::HandleScope scope(isolate);
+    v8::Local<v8::Context> context = v8::Context::New(isolate);
+    v8::Context::Scope context_scope(context);
+
+    v8::Local<v8::String> source_str = v8_str(kWarmUpSource);
+    v8::ScriptOrigin origin(v8_str("test"));
+    v8::ScriptCompiler::Source source(source_str, origin, cache);
+    v8::ScriptCompiler::CompileOptions options =
+        cache == NULL ? v8::ScriptCompiler::kProduceCodeCache
+                      : v8::ScriptCompiler::kConsumeCodeCache;
+    v8::Local<v8::UnboundScript> script =
+        v8::ScriptCompiler::CompileUnbound(isolate, &source, options);
+    CHECK(cache == NULL || !cache->rejected);
+    v8::Local<v8::Value> value = script->BindToCurrentContext()->Run();
+    CHECK(value->ToString(isolate)->Equals(v8_str("abcdef")));
+    for (const char* name = expect_compiled; *name != '\0'; name++) {
+      char function_name[2] = {*name, '\0'};
+      CHECK(IsCompiled(function_name));
+    }
+    CompileRun(warm_up);
+
+    result = v8::ScriptCompiler::CreateCodeCache(script, source_str);
+    CHECK(result);
+  }
+  isolate->Dispose();
+  return result;
+}
+
+
+TEST(CodeCacheAfterExecution) {
+  FLAG_serialize_toplevel = true;
+  FLAG_always_opt = false;
+
+  // The first run compiles g and h lazily, the second one k.
+  v8::ScriptCompiler::CachedData* cache1 =
+      RunAndCreateCodeCache(NULL, "g(3); h({x: 1}); h({x: 2, z: 3})", "");
+  // Consumed caches are owned by the source they were consumed with.
+  v8::ScriptCompiler::CachedData* cache2 =
+      RunAndCreateCodeCache(cache1, "k({y: 1})", "fgh");
+  v8::ScriptCompiler::CachedData* cache3 =
+      RunAndCreateCodeCache(cache2, "g(1)", "fghk");
+  delete cache3;
+}
+
+
+TEST(CodeCacheAfterExecutionKeepsFeedback) {
+  FLAG_serialize_toplevel = true;
+  FLAG_always_opt = false;
+  LocalContext context;
+  Isolate* isolate = CcTest::i_isolate();
+  v8::HandleScope scope(context->GetIsolate());
+
+  v8::Local<v8::String> source_str = v8_str(kWarmUpSource);
+  v8::ScriptCompiler::Source source(source_str);
+  v8::Local<v8::UnboundScript> script = v8::ScriptCompiler::CompileUnbound(
+      context->GetIsolate(), &source, v8::ScriptCompiler::kProduceCodeCache);
+  script->BindToCurrentContext()->Run();
+  CompileRun("var o = {x: 1}; h(o); h(o);");
+
+  Handle<JSFunction> h = v8::Utils::OpenHandle(
+      *v8::Local<v8::Function>::Cast(CcTest::global()->Get(v8_str("h"))));
+  Handle<SharedFunctionInfo> shared(h->shared(), isolate);
+  Handle<Code> code(shared->code(), isolate);
+  Handle<TypeFeedbackVector> vector(shared->feedback_vector(), isolate);
+  LoadICNexus nexus(vector, FeedbackVectorICSlot(0));
+  CHECK_EQ(MONOMORPHIC, nexus.StateFromFeedback());
+
+  v8::ScriptCompiler::CachedData* cache =
+      v8::ScriptCompiler::CreateCodeCache(script, source_str);
+  CHECK(cache);
+  delete cache;
+
+  // The cache was made from copies. The running function keeps its code and
+  // its feedback.
+  CHECK_EQ(*code, shared->code());
+  CHECK_EQ(*vector, shared->feedback_vector());
+  CHECK_EQ(MONOMORPHIC, nexus.StateFromFeedback());
+  CHECK_EQ(2, CompileRun("h({x: 2})")->Int32Value());
+}
+
+
+// Consumes the compile profile if there is one, checks that the functions
+// named by the characters of expect_compiled were compiled eagerly, runs the
+// warm-up code and returns the profile created after execution.
+static v8::ScriptCompiler::CachedData* RunAndCreateCompileProfile(
+    v8::ScriptCompiler::CachedData* profile, const char* source,
+    const char* warm_up, const char* expect_compiled,
+    bool expect_rejected = false) {
+  v8::ScriptCompiler::CachedData* result;
+  v8::Isolate::CreateParams create_params;
+  create_params.array_buffer_allocator = CcTest::array_buffer_allocator();
+  v8::Isolate* isolate = v8::Isolate::New(create_params);
+  {
+    v8::Isolate::Scope iscope(isolate);
+    v8::HandleScope scope(isolate);
+    v8::Local<v8::Context> context = v8::Context::New(isolate);
+    v8::Context::Scope context_scope(context);
+
+    v8::ScriptOrigin origin(v8_str("test"));
+    v8::ScriptCompiler::Source script_source(v8_str(source), origin, profile);
+    v8::ScriptCompiler::CompileOptions options =
+        profile == NULL ? v8::ScriptCompiler::kNoCompileOptions
+                        : v8::ScriptCompiler::kConsumeCompileProfile;
+    v8::Local<v8::UnboundScript> script =
+        v8::ScriptCompiler::CompileUnbound(isolate, &script_source, options);
+    CHECK(profile == NULL || profile->rejected == expect_rejected);
+    v8::Local<v8::Value> value = script->BindToCurrentContext()->Run();
+    CHECK(value->ToString(isolate)->Equals(v8_str("abcdef")));
+    CHECK(!IsCompiled("k"));
+    for (const char* name = expect_compiled; *name != '\0'; name++) {
+      char function_name[2] = {*name, '\0'};
+      CHECK(IsCompiled(function_name));
+    }
+    CompileRun(warm_up);
+
+    result = v8::ScriptCompiler::CreateCompileProfile(script);
+    CHECK(result);
+  }
+  isolate->Dispose();
+  return result;
+}
+
+
+TEST(CompileProfile) {
+  FLAG_always_opt = false;
+  int window = FLAG_lazy_compile_profile_window;
+  FLAG_lazy_compile_profile_window = 60 * 1000;
+
+  // The first run compiles f, g and h lazily.
+  v8::ScriptCompiler::CachedData* profile1 =
+      RunAndCreateCompileProfile(NULL, kWarmUpSource, "g(3); h({x: 1})", "f");
+  // Consumed profiles are owned by the source they were consumed with. The
+  // functions of a consumed profile are carried over into the next one.
+  v8::ScriptCompiler::CachedData* profile2 =
+      RunAndCreateCompileProfile(profile1, kWarmUpSource, "", "fgh");
+  v8::ScriptCompiler::CachedData* profile3 =
+      RunAndCreateCompileProfile(profile2, kWarmUpSource, "g(1)", "fgh");
+
+  // A profile for a different source is rejected.
+  const char* other_source =
+      "function f() { return 'abc'; }"
+      "function g(n) { return new Array(n + 1); }"
+      "function k(o) { return o.y; }"
+      "f() + 'def'";
+  v8::ScriptCompiler::CachedData* profile4 =
+      RunAndCreateCompileProfile(profile3, other_source, "", "f", true);
+  delete profile4;
+
+  FLAG_lazy_compile_profile_window = window;
+}
+
+
+TEST(CompileProfileForgetsDeadScripts) {
+  FLAG_always_opt = false;
+  int window = FLAG_lazy_compile_profile_window;
+  FLAG_lazy_compile_profile_window = 60 * 1000;
+
+  v8::Isolate::CreateParams create_params;
+  create_params.array_buffer_allocator = CcTest::array_buffer_allocator();
+  v8::Isolate* isolate = v8::Isolate::New(create_params);
+  {
+    v8::Isolate::Scope iscope(isolate);
+    v8::HandleScope scope(isolate);
+    v8::Local<v8::Context> context = v8::Context::New(isolate);
+    v8::Context::Scope context_scope(context);
+    Isolate* i_isolate = reinterpret_cast<Isolate*>(isolate);
+    i_isolate->compilation_cache()->Disable();
+
+    // More scripts than the profiler keeps entries for each record a lazily
+    // compiled function, and then die.
+    for (int i = 0; i < 1100; i++) {
+      v8::HandleScope inner_scope(isolate);
+      EmbeddedVector<char, 128> source;
+      SNPrintF(source, "var o = {f: function() { return %d; }}; o.f(); o = 0;",
+               i);
+      CompileRun(source.start());
+    }
+    i_isolate->heap()->CollectAllAvailableGarbage("dead scripts");
+
+    // Their entries are dropped, so a new script is still recorded.
+    v8::ScriptOrigin origin(v8_str("test"));
+    v8::ScriptCompiler::Source script_source(v8_str(kWarmUpSource), origin);
+    v8::Local<v8::UnboundScript> script =
+        v8::ScriptCompiler::CompileUnbound(isolate, &script_source);
+    script->BindToCurrentContext()->Run();
+    CompileRun("g(3)");
+    v8::ScriptCompiler::CachedData* profile =
+        v8::ScriptCompiler::CreateCompileProfile(script);
+    CHECK(profile);
+    delete profile;
+  }
+  isolate->Dispose();
+
+  FLAG_lazy_compile_profile_window = window;
+}
+
+
+TEST(BackgroundLazyCompile) {
+  FLAG_always_opt = false;
+  FLAG_background_lazy_compile = true;
+  int window = FLAG_lazy_compile_profile_window;
+  FLAG_lazy_compile_profile_window = 60 * 1000;
+
+  v8::ScriptCompiler::CachedData* profile =
+      RunAndCreateCompileProfile(NULL, kWarmUpSource, "g(3); h({x: 1})", "f");
+
+  v8::Isolate::CreateParams create_params;
+  create_params.array_buffer_allocator = CcTest::array_buffer_allocator();
+  v8::Isolate* isolate = v8::Isolate::New(create_params);
+  {
+    v8::Isolate::Scope iscope(isolate);
+    v8::HandleScope scope(isolate);
+    v8::Local<v8::Context> context = v8::Context::New(isolate);
+    v8::Context::Scope context_scope(context);
+    Isolate* i_isolate = reinterpret_cast<Isolate*>(isolate);
+    CHECK(i_isolate->lazy_compile_queue() != NULL);
+
+    v8::ScriptOrigin origin(v8_str("test"));
+    v8::ScriptCompiler::Source script_source(v8_str(kWarmUpSource), origin,
+                                             profile);
+    v8::Local<v8::UnboundScript> script = v8::ScriptCompiler::CompileUnbound(
+        isolate, &script_source, v8::ScriptCompiler::kConsumeCompileProfile);
+    CHECK(!profile->rejected);
+    v8::Local<v8::Value> value = script->BindToCurrentContext()->Run();
+    CHECK(value->ToString(isolate)->Equals(v8_str("abcdef")));
+
+    // g and h are parsed in the background and compiled at an interrupt.
+    for (int i = 0; i < 10000 && !(IsCompiled("g") && IsCompiled("h")); i++) {
+      v8::base::OS::Sleep(v8::base::TimeDelta::FromMilliseconds(1));
+      i_isolate->stack_guard()->HandleInterrupts();
+    }
+    CHECK(IsCompiled("g"));
+    CHECK(IsCompiled("h"));
+    CHECK(!IsCompiled("k"));
+    CHECK_EQ(4, CompileRun("g(3).length + h({x: 1})")->Int32Value());
+  }
+  isolate->Dispose();
+
+  FLAG_lazy_compile_profile_window = window;
+  FLAG_background_lazy_compile = false;
+}
+
+
+TEST(BackgroundLazyCompileScriptScope) {
+  FLAG_always_opt = false;
+  FLAG_background_lazy_compile = true;
+  int window = FLAG_lazy_compile_profile_window;
+  FLAG_lazy_compile_profile_window = 60 * 1000;
+
+  // g and h use a script-level let, a const and a top-level var. Parsed in
+  // the background without a scope chain, they reach them through global ICs.
+  const char* source =
+      "'use strict';"
+      "let counter = 0;"
+      "const limit = 10;"
+      "var total = 1;"
+      "function f() { return 'abc'; }"
+      "function g(n) { counter += n; total *= 2; return counter + limit; }"
+      "function h(n) { limit = n; }"
+      "function k(o) { return o.y; }"
+      "f() + 'def'";
+  v8::ScriptCompiler::CachedData* profile = RunAndCreateCompileProfile(
+      NULL, source, "g(3); try { h(1); } catch (e) {}", "f");
+
+  v8::Isolate::CreateParams create_params;
+  create_params.array_buffer_allocator = CcTest::array_buffer_allocator();
+  v8::Isolate* isolate = v8::Isolate::New(create_params);
+  {
+    v8::Isolate::Scope iscope(isolate);
+    v8::HandleScope scope(isolate);
+    v8::Local<v8::Context> context = v8::Context::New(isolate);
+    v8::Context::Scope context_scope(context);
+    Isolate* i_isolate = reinterpret_cast<Isolate*>(isolate);
+
+    v8::ScriptOrigin origin(v8_str("test"));
+    v8::ScriptCompiler::Source script_source(v8_str(source), origin, profile);
+    v8::Local<v8::UnboundScript> script = v8::ScriptCompiler::CompileUnbound(
+        isolate, &script_source, v8::ScriptCompiler::kConsumeCompileProfile);
+    CHECK(!profile->rejected);
+    v8::Local<v8::Value> value = script->BindToCurrentContext()->Run();
+    CHECK(value->ToString(isolate)->Equals(v8_str("abcdef")));
+
+    for (int i = 0; i < 10000 && !(IsCompiled("g") && IsCompiled("h")); i++) {
+      v8::base::OS::Sleep(v8::base::TimeDelta::FromMilliseconds(1));
+      i_isolate->stack_guard()->HandleInterrupts();
+    }
+    CHECK(IsCompiled("g"));
+    CHECK(IsCompiled("h"));
+    CHECK(!IsCompiled("k"));
+
+    CHECK_EQ(13, CompileRun("g(3)")->Int32Value());
+    CHECK_EQ(15, CompileRun("g(2)")->Int32Value());
+    CHECK_EQ(5, CompileRun("counter")->Int32Value());
+    CHECK_EQ(4, CompileRun("total")->Int32Value());
+    CHECK(CompileRun("try { h(1); false } catch (e) { e instanceof TypeError }")
+              ->BooleanValue());
+    CHECK_EQ(10, CompileRun("limit")->Int32Value());
+  }
+  isolate->Dispose();
+
+  FLAG_lazy_compile_profile_window = window;
+  FLAG_background_lazy_compile = false;
+}
+
+
+// Compiles and runs the source in a new isolate. Returns whether the script
+// was deserialized.
+static bool CompileWithSharedCodeCache(const char* source, const char* name) {
+  bool deserialized;
+  v8::Isolate::CreateParams create_params;
+  create_params.array_buffer_allocator = CcTest::array_buffer_allocator();
+  v8::Isolate* isolate = v8::Isolate::New(create_params);
+  {
+    v8::Isolate::Scope iscope(isolate);
+    v8::HandleScope scope(isolate);
+    v8::Local<v8::Context> context = v8::Context::New(isolate);
+    v8::Context::Scope context_scope(context);
+
+    v8::ScriptOrigin origin(v8_str(name));
+    v8::ScriptCompiler::Source script_source(v8_str(source), origin);
+    v8::Local<v8::UnboundScript> script =
+        v8::ScriptCompiler::CompileUnbound(isolate, &script_source);
+    deserialized = Handle<SharedFunctionInfo>::cast(
+                       v8::Utils::OpenHandle(*script))->deserialized();
+    v8::Local<v8::Value> result = script->BindToCurrentContext()->Run();
+    CHECK(result->ToString(isolate)->Equals(v8_str("abcdef")));
+  }
+  isolate->Dispose();
+  return deserialized;
+}
+
+
+TEST(SharedCodeCache) {
+  FLAG_serialize_toplevel = true;
+  FLAG_shared_code_cache = true;
+  SharedCodeCache::Clear();
+
+  const char* source = "function f() { return 'abc'; }; f() + 'def'";
+  CHECK(!CompileWithSharedCodeCache(source, "test"));
+  size_t size = SharedCodeCache::size();
+  CHECK_LT(0u, size);
+  CHECK(CompileWithSharedCodeCache(source, "test"));
+  CHECK_EQ(size, SharedCodeCache::size());
+
+  // A different origin is a different script.
+  CHECK(!CompileWithSharedCodeCache(source, "other"));
+  CHECK_LT(size, SharedCodeCache::size());
+  CHECK(CompileWithSharedCodeCache(source, "other"));
+
+  // Entries beyond the memory budget are evicted.
+  int budget = FLAG_shared_code_cache_size;
+  FLAG_shared_code_cache_size = 0;
+  CHECK(!CompileWithSharedCodeCache("'abc' + 'def'", "test"));
+  CHECK_EQ(0u, SharedCodeCache::size());
+  CHECK(!CompileWithSharedCodeCache(source, "test"));
+
+  FLAG_shared_code_cache_size = budget;
+  FLAG_shared_code_cache = false;
+  SharedCodeCache::Clear();
+}
+
+
 TEST(SerializeWithHarmonyScoping) {
   FLAG_serialize_toplevel = true;
 
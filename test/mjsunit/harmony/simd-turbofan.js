@@ -0,0 +1,76 @@
+// Copyright 2015 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Flags: --harmony-simd --allow-natives-syntax --turbo-filter=*
+
+function extractLanes(a, b) {
+  var sum = SIMD.Float32x4.add(a, b);
+  return SIMD.Float32x4.extractLane(sum, 0) +
+         SIMD.Float32x4.extractLane(sum, 1) * 10 +
+         SIMD.Float32x4.extractLane(sum, 2) * 100 +
+         SIMD.Float32x4.extractLane(sum, 3) * 1000;
+}
+
+var a = SIMD.Float32x4(1, 2, 3, 4);
+var b = SIMD.Float32x4(0.5, 0.5, 0.5, 0.5);
+assertEquals(4321 + 555.5, extractLanes(a, b));
+assertEquals(4321 + 555.5, extractLanes(a, b));
+%OptimizeFunctionOnNextCall(extractLanes);
+assertEquals(4321 + 555.5, extractLanes(a, b));
+
+function extractInt32Lanes(a) {
+  var v = SIMD.Int32x4.check(SIMD.Int32x4.mul(a, a));
+  return [SIMD.Int32x4.extractLane(v, 0), SIMD.Int32x4.extractLane(v, 3)];
+}
+
+var c = SIMD.Int32x4(-3, 0, 0, 0x100);
+assertEquals([9, 65536], extractInt32Lanes(c));
+assertEquals([9, 65536], extractInt32Lanes(c));
+%OptimizeFunctionOnNextCall(extractInt32Lanes);
+assertEquals([9, 65536], extractInt32Lanes(c));
+
+function extractUint8Lane(a, lane) {
+  return SIMD.Uint8x16.extractLane(SIMD.Uint8x16.add(a, a), lane);
+}
+
+var d = SIMD.Uint8x16(200, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+assertEquals(144, extractUint8Lane(d, 0));
+assertEquals(30, extractUint8Lane(d, 15));
+%OptimizeFunctionOnNextCall(extractUint8Lane);
+assertEquals(144, extractUint8Lane(d, 0));
+assertThrows(function() { extractUint8Lane(d, 16); });
+
+function float32x4Arithmetic(a, b) {
+  a = SIMD.Float32x4.check(a);
+  b = SIMD.Float32x4.check(b);
+  var v = SIMD.Float32x4.mul(SIMD.Float32x4.sub(SIMD.Float32x4.add(a, b), a),
+                             SIMD.Float32x4.add(a, a));
+  return [SIMD.Float32x4.extractLane(v, 0), SIMD.Float32x4.extractLane(v, 1),
+          SIMD.Float32x4.extractLane(v, 2), SIMD.Float32x4.extractLane(v, 3)];
+}
+
+var e = SIMD.Float32x4(1, -2, 0.5, 1e30);
+var f = SIMD.Float32x4(3, 4, -0.25, 1e30);
+var expected = [6, -16, -0.25, Infinity];
+assertEquals(expected, float32x4Arithmetic(e, f));
+assertEquals(expected, float32x4Arithmetic(e, f));
+%OptimizeFunctionOnNextCall(float32x4Arithmetic);
+assertEquals(expected, float32x4Arithmetic(e, f));
+assertThrows(function() { float32x4Arithmetic(e, 1); });
+
+function int32x4Arithmetic(a, b) {
+  a = SIMD.Int32x4.check(a);
+  b = SIMD.Int32x4.check(b);
+  var v = SIMD.Int32x4.sub(SIMD.Int32x4.mul(a, b), SIMD.Int32x4.add(a, b));
+  return [SIMD.Int32x4.extractLane(v, 0), SIMD.Int32x4.extractLane(v, 1),
+          SIMD.Int32x4.extractLane(v, 2), SIMD.Int32x4.extractLane(v, 3)];
+}
+
+var g = SIMD.Int32x4(-3, 0x10000, 0x7fffffff, 5);
+var h = SIMD.Int32x4(7, 0x10000, 1, -5);
+var int_expected = [-25, -0x20000, -1, -25];
+assertEquals(int_expected, int32x4Arithmetic(g, h));
+assertEquals(int_expected, int32x4Arithmetic(g, h));
+%OptimizeFunctionOnNextCall(int32x4Arithmetic);
+assertEquals(int_expected, int32x4Arithmetic(g, h));
@@ -151,6 +151,49 @@ TARGET_TEST_F(InterpreterAssemblerTest, Dispatch) {
 }
 
 
+TARGET_TEST_F(InterpreterAssemblerTest, DispatchWide) {
+  interpreter::OperandScale operand_scales[] = {
+      interpreter::OperandScale::kDouble,
+      interpreter::OperandScale::kQuadruple};
+  for (interpreter::OperandScale operand_scale : operand_scales) {
+    interpreter::Bytecode prefix =
+        interpreter::Bytecodes::OperandScaleToPrefixBytecode(operand_scale);
+    InterpreterAssemblerForTest m(this, prefix);
+    m.DispatchWide(operand_scale);
+    Graph* graph = m.GetCompletedGraph();
+
+    Node* end = graph->end();
+    EXPECT_EQ(1, end->InputCount());
+    Node* tail_call_node = end->InputAt(0);
+
+    Matcher<Node*> next_bytecode_offset_matcher =
+        IsIntPtrAdd(IsParameter(Linkage::kInterpreterBytecodeOffsetParameter),
+                    IsInt32Constant(1));
+    Matcher<Node*> target_bytecode_matcher = m.IsLoad(
+        kMachUint8, IsParameter(Linkage::kInterpreterBytecodeArrayParameter),
+        next_bytecode_offset_matcher);
+    Matcher<Node*> table_index_matcher = IsInt32Add(
+        target_bytecode_matcher,
+        IsInt32Constant(
+            interpreter::Bytecodes::DispatchTableOffset(operand_scale)));
+    Matcher<Node*> code_target_matcher = m.IsLoad(
+        kMachPtr, IsParameter(Linkage::kInterpreterDispatchTableParameter),
+        IsWord32Shl(table_index_matcher, IsInt32Constant(kPointerSizeLog2)));
+
+    EXPECT_THAT(
+        tail_call_node,
+        IsTailCall(m.call_descriptor(), code_target_matcher,
+                   IsParameter(Linkage::kInterpreterAccumulatorParameter),
+                   IsParameter(Linkage::kInterpreterRegisterFileParameter),
+                   next_bytecode_offset_matcher,
+                   IsParameter(Linkage::kInterpreterBytecodeArrayParameter),
+                   IsParameter(Linkage::kInterpreterDispatchTableParameter),
+                   IsParameter(Linkage::kInterpreterContextParameter),
+                   graph->start(), graph->start()));
+  }
+}
+
+
 TARGET_TEST_F(InterpreterAssemblerTest, Return) {
   TRACED_FOREACH(interpreter::Bytecode, bytecode, kBytecodes) {
     InterpreterAssemblerForTest m(this, bytecode);
@@ -315,6 +358,29 @@ TARGET_TEST_F(InterpreterAssemblerTest, LoadContextSlot) {
 }
 
 
+TARGET_TEST_F(InterpreterAssemblerTest, LoadStoreContextSlotWithIndexNode) {
+  TRACED_FOREACH(interpreter::Bytecode, bytecode, kBytecodes) {
+    InterpreterAssemblerForTest m(this, bytecode);
+    Node* context = m.GetContext();
+    Node* slot_index = m.Int32Constant(22);
+    Matcher<Node*> offset_matcher = IsIntPtrAdd(
+        IsIntPtrConstant(Context::kHeaderSize - kHeapObjectTag),
+        IsWordShl(slot_index, IsInt32Constant(kPointerSizeLog2)));
+    EXPECT_THAT(m.LoadContextSlot(context, slot_index),
+                m.IsLoad(kMachAnyTagged,
+                         IsParameter(Linkage::kInterpreterContextParameter),
+                         offset_matcher));
+
+    Node* value = m.Int32Constant(0xdeadbeef);
+    EXPECT_THAT(
+        m.StoreContextSlot(context, slot_index, value),
+        m.IsStore(StoreRepresentation(kMachAnyTagged, kFullWriteBarrier),
+                  IsParameter(Linkage::kInterpreterContextParameter),
+                  offset_matcher, value));
+  }
+}
+
+
 TARGET_TEST_F(InterpreterAssemblerTest, LoadObjectField) {
   TRACED_FOREACH(interpreter::Bytecode, bytecode, kBytecodes) {
     InterpreterAssemblerForTest m(this, bytecode);
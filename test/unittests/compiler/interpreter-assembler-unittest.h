@@ -25,8 +25,11 @@ class InterpreterAssemblerTest : public TestWithIsolateAndZone {
   class InterpreterAssemblerForTest final : public InterpreterAssembler {
    public:
     InterpreterAssemblerForTest(InterpreterAssemblerTest* test,
-                                interpreter::Bytecode bytecode)
-        : InterpreterAssembler(test->isolate(), test->zone(), bytecode) {}
+                                interpreter::Bytecode bytecode,
+                                interpreter::OperandScale operand_scale =
+                                    interpreter::OperandScale::kSingle)
+        : InterpreterAssembler(test->isolate(), test->zone(), bytecode,
+                               operand_scale) {}
     ~InterpreterAssemblerForTest() override {}
 
     Graph* GetCompletedGraph();
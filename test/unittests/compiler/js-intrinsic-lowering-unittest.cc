@@ -459,6 +459,191 @@ TEST_F(JSIntrinsicLoweringTest, InlineValueOf) {
               AllOf(CaptureEq(&if_false0), IsIfFalse(CaptureEq(&branch0))))));
 }
 
+
+// -----------------------------------------------------------------------------
+// %_Float32x4Check
+
+
+TEST_F(JSIntrinsicLoweringTest, InlineFloat32x4CheckWithFloat32x4) {
+  Node* const input = Parameter(0);
+  Node* const context = Parameter(1);
+  Node* const effect = graph()->start();
+  Node* const control = graph()->start();
+  NodeProperties::SetBounds(
+      input, Bounds(Type::None(), Type::Float32x4(isolate(), zone())));
+  Reduction const r = Reduce(graph()->NewNode(
+      javascript()->CallRuntime(Runtime::kInlineFloat32x4Check, 1), input,
+      context, effect, control));
+  ASSERT_TRUE(r.Changed());
+  EXPECT_EQ(input, r.replacement());
+}
+
+
+TEST_F(JSIntrinsicLoweringTest, InlineFloat32x4CheckWithAny) {
+  Node* const input = Parameter(0);
+  Node* const context = Parameter(1);
+  Node* const effect = graph()->start();
+  Node* const control = graph()->start();
+  NodeProperties::SetBounds(input, Bounds::Unbounded());
+  Reduction const r = Reduce(graph()->NewNode(
+      javascript()->CallRuntime(Runtime::kInlineFloat32x4Check, 1), input,
+      context, effect, control));
+  ASSERT_FALSE(r.Changed());
+}
+
+
+// -----------------------------------------------------------------------------
+// %_Float32x4ExtractLane
+
+
+TEST_F(JSIntrinsicLoweringTest, InlineFloat32x4ExtractLane) {
+  Node* const input = Parameter(0);
+  Node* const context = Parameter(1);
+  Node* const effect = graph()->start();
+  Node* const control = graph()->start();
+  NodeProperties::SetBounds(
+      input, Bounds(Type::None(), Type::Float32x4(isolate(), zone())));
+  TRACED_FORRANGE(int, lane, 0, 3) {
+    Reduction const r = Reduce(graph()->NewNode(
+        javascript()->CallRuntime(Runtime::kInlineFloat32x4ExtractLane, 2),
+        input, NumberConstant(lane), context, effect, control));
+    ASSERT_TRUE(r.Changed());
+    EXPECT_THAT(r.replacement(),
+                IsLoadElement(
+                    AccessBuilder::ForSimd128ValueLane(kExternalFloat32Array),
+                    input, IsNumberConstant(lane), effect, control));
+  }
+}
+
+
+TEST_F(JSIntrinsicLoweringTest, InlineFloat32x4ExtractLaneOutOfRange) {
+  Node* const input = Parameter(0);
+  Node* const context = Parameter(1);
+  Node* const effect = graph()->start();
+  Node* const control = graph()->start();
+  NodeProperties::SetBounds(
+      input, Bounds(Type::None(), Type::Float32x4(isolate(), zone())));
+  Reduction const r = Reduce(graph()->NewNode(
+      javascript()->CallRuntime(Runtime::kInlineFloat32x4ExtractLane, 2),
+      input, NumberConstant(4), context, effect, control));
+  ASSERT_FALSE(r.Changed());
+}
+
+
+// -----------------------------------------------------------------------------
+// %_Float32x4Add
+
+
+TEST_F(JSIntrinsicLoweringTest, InlineFloat32x4Add) {
+  Node* const lhs = Parameter(0);
+  Node* const rhs = Parameter(1);
+  Node* const context = Parameter(2);
+  Node* const effect = graph()->start();
+  Node* const control = graph()->start();
+  Type* const type = Type::Float32x4(isolate(), zone());
+  NodeProperties::SetBounds(lhs, Bounds(Type::None(), type));
+  NodeProperties::SetBounds(rhs, Bounds(Type::None(), type));
+  Reduction const r = Reduce(
+      graph()->NewNode(
+          javascript()->CallRuntime(Runtime::kInlineFloat32x4Add, 2), lhs, rhs,
+          context, effect, control),
+      MachineOperatorBuilder::kFloat32x4Add);
+  ASSERT_TRUE(r.Changed());
+  Capture<Node*> allocation, lhs_load, rhs_load;
+  FieldAccess const access = AccessBuilder::ForSimd128ValuePayload();
+  EXPECT_THAT(
+      r.replacement(),
+      IsFinish(
+          AllOf(CaptureEq(&allocation),
+                IsAllocate(IsNumberConstant(Simd128Value::kSize),
+                           AllOf(CaptureEq(&rhs_load),
+                                 IsLoadField(access, rhs,
+                                             AllOf(CaptureEq(&lhs_load),
+                                                   IsLoadField(access, lhs,
+                                                               effect,
+                                                               control)),
+                                             control)),
+                           control)),
+          IsStoreField(
+              access, CaptureEq(&allocation),
+              IsFloat32x4Add(CaptureEq(&lhs_load), CaptureEq(&rhs_load)),
+              IsStoreField(AccessBuilder::ForMap(), CaptureEq(&allocation),
+                           IsHeapConstant(factory()->float32x4_map()),
+                           CaptureEq(&allocation), control),
+              control)));
+}
+
+
+TEST_F(JSIntrinsicLoweringTest, InlineFloat32x4AddWithoutMachineSupport) {
+  Node* const lhs = Parameter(0);
+  Node* const rhs = Parameter(1);
+  Node* const context = Parameter(2);
+  Node* const effect = graph()->start();
+  Node* const control = graph()->start();
+  Type* const type = Type::Float32x4(isolate(), zone());
+  NodeProperties::SetBounds(lhs, Bounds(Type::None(), type));
+  NodeProperties::SetBounds(rhs, Bounds(Type::None(), type));
+  Reduction const r = Reduce(graph()->NewNode(
+      javascript()->CallRuntime(Runtime::kInlineFloat32x4Add, 2), lhs, rhs,
+      context, effect, control));
+  ASSERT_FALSE(r.Changed());
+}
+
+
+TEST_F(JSIntrinsicLoweringTest, InlineFloat32x4AddWithAny) {
+  Node* const lhs = Parameter(0);
+  Node* const rhs = Parameter(1);
+  Node* const context = Parameter(2);
+  Node* const effect = graph()->start();
+  Node* const control = graph()->start();
+  NodeProperties::SetBounds(
+      lhs, Bounds(Type::None(), Type::Float32x4(isolate(), zone())));
+  NodeProperties::SetBounds(rhs, Bounds::Unbounded());
+  Reduction const r = Reduce(
+      graph()->NewNode(
+          javascript()->CallRuntime(Runtime::kInlineFloat32x4Add, 2), lhs, rhs,
+          context, effect, control),
+      MachineOperatorBuilder::kFloat32x4Add);
+  ASSERT_FALSE(r.Changed());
+}
+
+
+// -----------------------------------------------------------------------------
+// %_Int32x4Mul
+
+
+TEST_F(JSIntrinsicLoweringTest, InlineInt32x4Mul) {
+  Node* const lhs = Parameter(0);
+  Node* const rhs = Parameter(1);
+  Node* const context = Parameter(2);
+  Node* const effect = graph()->start();
+  Node* const control = graph()->start();
+  Type* const type = Type::Int32x4(isolate(), zone());
+  NodeProperties::SetBounds(lhs, Bounds(Type::None(), type));
+  NodeProperties::SetBounds(rhs, Bounds(Type::None(), type));
+  Reduction const r = Reduce(
+      graph()->NewNode(
+          javascript()->CallRuntime(Runtime::kInlineInt32x4Mul, 2), lhs, rhs,
+          context, effect, control),
+      MachineOperatorBuilder::kInt32x4Mul);
+  ASSERT_TRUE(r.Changed());
+  Capture<Node*> allocation;
+  FieldAccess const access = AccessBuilder::ForSimd128ValuePayload();
+  EXPECT_THAT(
+      r.replacement(),
+      IsFinish(
+          AllOf(CaptureEq(&allocation),
+                IsAllocate(IsNumberConstant(Simd128Value::kSize), _, control)),
+          IsStoreField(
+              access, CaptureEq(&allocation),
+              IsInt32x4Mul(IsLoadField(access, lhs, _, control),
+                           IsLoadField(access, rhs, _, control)),
+              IsStoreField(AccessBuilder::ForMap(), CaptureEq(&allocation),
+                           IsHeapConstant(factory()->int32x4_map()),
+                           CaptureEq(&allocation), control),
+              control)));
+}
+
 }  // namespace compiler
 }  // namespace internal
 }  // namespace v8
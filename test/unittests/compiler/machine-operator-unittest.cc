@@ -310,6 +310,12 @@ const OptionalOperatorEntry kOptionalOperators[] = {
     OPTIONAL_ENTRY(Float64RoundDown, 1, 0, 1),      // --
     OPTIONAL_ENTRY(Float64RoundTruncate, 1, 0, 1),  // --
     OPTIONAL_ENTRY(Float64RoundTiesAway, 1, 0, 1),  // --
+    OPTIONAL_ENTRY(Float32x4Add, 2, 0, 1),          // --
+    OPTIONAL_ENTRY(Float32x4Sub, 2, 0, 1),          // --
+    OPTIONAL_ENTRY(Float32x4Mul, 2, 0, 1),          // --
+    OPTIONAL_ENTRY(Int32x4Add, 2, 0, 1),            // --
+    OPTIONAL_ENTRY(Int32x4Sub, 2, 0, 1),            // --
+    OPTIONAL_ENTRY(Int32x4Mul, 2, 0, 1),            // --
 #undef OPTIONAL_ENTRY
 };
 }  // namespace
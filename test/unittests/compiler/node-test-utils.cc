@@ -2019,6 +2019,8 @@ IS_BINOP_MATCHER(Float64Min)
 IS_BINOP_MATCHER(Float64Sub)
 IS_BINOP_MATCHER(Float64InsertLowWord32)
 IS_BINOP_MATCHER(Float64InsertHighWord32)
+IS_BINOP_MATCHER(Float32x4Add)
+IS_BINOP_MATCHER(Int32x4Mul)
 #undef IS_BINOP_MATCHER
 
 
@@ -5,6 +5,7 @@
 #include "test/unittests/compiler/instruction-selector-unittest.h"
 
 #include "src/compiler/node-matchers.h"
+#include "src/flags.h"
 
 namespace v8 {
 namespace internal {
@@ -1094,6 +1095,79 @@ TEST_F(InstructionSelectorTest, Float64BinopArithmetic) {
 }
 
 
+// -----------------------------------------------------------------------------
+// 128-bit SIMD arithmetic.
+
+
+namespace {
+
+struct Simd128Binop {
+  const OptionalOperator (MachineOperatorBuilder::*constructor)();
+  const char* constructor_name;
+  ArchOpcode sse_opcode;
+  ArchOpcode avx_opcode;
+};
+
+
+std::ostream& operator<<(std::ostream& os, const Simd128Binop& binop) {
+  return os << binop.constructor_name;
+}
+
+
+const Simd128Binop kSimd128Binops[] = {
+    {&MachineOperatorBuilder::Float32x4Add, "Float32x4Add", kSSEFloat32x4Add,
+     kAVXFloat32x4Add},
+    {&MachineOperatorBuilder::Float32x4Sub, "Float32x4Sub", kSSEFloat32x4Sub,
+     kAVXFloat32x4Sub},
+    {&MachineOperatorBuilder::Float32x4Mul, "Float32x4Mul", kSSEFloat32x4Mul,
+     kAVXFloat32x4Mul},
+    {&MachineOperatorBuilder::Int32x4Add, "Int32x4Add", kSSEInt32x4Add,
+     kAVXInt32x4Add},
+    {&MachineOperatorBuilder::Int32x4Sub, "Int32x4Sub", kSSEInt32x4Sub,
+     kAVXInt32x4Sub},
+    {&MachineOperatorBuilder::Int32x4Mul, "Int32x4Mul", kSSEInt32x4Mul,
+     kAVXInt32x4Mul}};
+
+}  // namespace
+
+
+typedef InstructionSelectorTestWithParam<Simd128Binop>
+    InstructionSelectorSimd128BinopTest;
+
+
+TEST_P(InstructionSelectorSimd128BinopTest, WithLoadAndStore) {
+  const Simd128Binop binop = GetParam();
+  TRACED_FORRANGE(int, avx, 0, 1) {
+    StreamBuilder m(this, kMachInt32, kMachPtr, kMachPtr, kMachPtr);
+    Node* const lhs = m.Load(kMachSimd128, m.Parameter(0));
+    Node* const rhs = m.Load(kMachSimd128, m.Parameter(1));
+    Node* const n = m.NewNode((m.machine()->*binop.constructor)().op(), lhs,
+                              rhs);
+    m.Store(kMachSimd128, m.Parameter(2), n);
+    m.Return(m.Int32Constant(0));
+    // Int32x4Mul needs pmulld from SSE4.1 when AVX is not available.
+    Stream s = avx ? m.Build(AVX) : m.Build(SSE4_1);
+    ASSERT_EQ(4U, s.size());
+    EXPECT_EQ(kX64Movups, s[0]->arch_opcode());
+    EXPECT_EQ(kX64Movups, s[1]->arch_opcode());
+    EXPECT_EQ(avx ? binop.avx_opcode : binop.sse_opcode, s[2]->arch_opcode());
+    ASSERT_EQ(2U, s[2]->InputCount());
+    EXPECT_EQ(s.ToVreg(lhs), s.ToVreg(s[2]->InputAt(0)));
+    EXPECT_EQ(s.ToVreg(rhs), s.ToVreg(s[2]->InputAt(1)));
+    ASSERT_EQ(1U, s[2]->OutputCount());
+    EXPECT_EQ(s.ToVreg(n), s.ToVreg(s[2]->Output()));
+    EXPECT_TRUE(s.IsDouble(n));
+    EXPECT_EQ(kX64Movups, s[3]->arch_opcode());
+    EXPECT_EQ(0U, s[3]->OutputCount());
+  }
+}
+
+
+INSTANTIATE_TEST_CASE_P(InstructionSelectorTest,
+                        InstructionSelectorSimd128BinopTest,
+                        ::testing::ValuesIn(kSimd128Binops));
+
+
 TEST_F(InstructionSelectorTest, Float32SubWithMinusZeroAndParameter) {
   {
     StreamBuilder m(this, kMachFloat32, kMachFloat32);
@@ -1293,6 +1367,93 @@ TEST_F(InstructionSelectorTest, Word32Clz) {
   EXPECT_EQ(s.ToVreg(n), s.ToVreg(s[0]->Output()));
 }
 
+
+// -----------------------------------------------------------------------------
+// Instruction scheduling.
+
+
+namespace {
+
+class InstructionSchedulingScope {
+ public:
+  InstructionSchedulingScope() : saved_(FLAG_turbo_instruction_scheduling) {
+    FLAG_turbo_instruction_scheduling = true;
+  }
+  ~InstructionSchedulingScope() { FLAG_turbo_instruction_scheduling = saved_; }
+
+ private:
+  bool const saved_;
+};
+
+}  // namespace
+
+
+TEST_F(InstructionSelectorTest, SchedulingKeepsLoadBeforeStore) {
+  InstructionSchedulingScope scope;
+  StreamBuilder m(this, kMachInt32, kMachPtr, kMachPtr, kMachInt32);
+  Node* const p0 = m.Parameter(0);
+  Node* const p1 = m.Parameter(1);
+  Node* const p2 = m.Parameter(2);
+  Node* const base = m.Load(kMachPtr, p0);
+  Node* const n = m.Load(kMachInt32, base);
+  m.Store(kMachInt32, p1, p2);
+  m.Return(n);
+  Stream s = m.Build();
+  ASSERT_EQ(3U, s.size());
+  // Without the edge from pending loads to the next store, the store would
+  // fill the cycles in which the second load waits for its address.
+  EXPECT_EQ(kX64Movq, s[0]->arch_opcode());
+  ASSERT_EQ(1U, s[0]->OutputCount());
+  EXPECT_EQ(s.ToVreg(base), s.ToVreg(s[0]->Output()));
+  EXPECT_EQ(kX64Movl, s[1]->arch_opcode());
+  ASSERT_EQ(1U, s[1]->OutputCount());
+  EXPECT_EQ(s.ToVreg(n), s.ToVreg(s[1]->Output()));
+  EXPECT_EQ(kX64Movl, s[2]->arch_opcode());
+  EXPECT_EQ(0U, s[2]->OutputCount());
+}
+
+
+TEST_F(InstructionSelectorTest, SchedulingKeepsStoreBeforeLoad) {
+  InstructionSchedulingScope scope;
+  StreamBuilder m(this, kMachFloat64, kMachPtr, kMachInt32, kMachFloat64);
+  Node* const p0 = m.Parameter(0);
+  Node* const p1 = m.Parameter(1);
+  Node* const p2 = m.Parameter(2);
+  m.Store(kMachInt32, p0, p1);
+  Node* const n = m.Load(kMachInt32, p0);
+  m.Return(m.Float64Div(m.ChangeInt32ToFloat64(n), p2));
+  Stream s = m.Build();
+  ASSERT_EQ(4U, s.size());
+  // Without the edge from the store to the next load, the load would be
+  // hoisted above the store because it starts the critical path.
+  EXPECT_EQ(kX64Movl, s[0]->arch_opcode());
+  EXPECT_EQ(0U, s[0]->OutputCount());
+  EXPECT_EQ(kX64Movl, s[1]->arch_opcode());
+  ASSERT_EQ(1U, s[1]->OutputCount());
+  EXPECT_EQ(s.ToVreg(n), s.ToVreg(s[1]->Output()));
+  EXPECT_EQ(kSSEInt32ToFloat64, s[2]->arch_opcode());
+  EXPECT_EQ(kSSEFloat64Div, s[3]->arch_opcode());
+}
+
+
+TEST_F(InstructionSelectorTest, SchedulingPrefersCriticalPath) {
+  InstructionSchedulingScope scope;
+  StreamBuilder m(this, kMachFloat64, kMachFloat64, kMachFloat64, kMachInt32);
+  Node* const p0 = m.Parameter(0);
+  Node* const p1 = m.Parameter(1);
+  Node* const p2 = m.Parameter(2);
+  Node* const mul = m.Int32Mul(p2, p2);
+  Node* const div = m.Float64Div(p0, p1);
+  m.Return(m.Float64Add(div, m.ChangeInt32ToFloat64(mul)));
+  Stream s = m.Build();
+  ASSERT_EQ(4U, s.size());
+  // The long latency division is started before the integer computation.
+  EXPECT_EQ(kSSEFloat64Div, s[0]->arch_opcode());
+  EXPECT_EQ(kX64Imul32, s[1]->arch_opcode());
+  EXPECT_EQ(kSSEInt32ToFloat64, s[2]->arch_opcode());
+  EXPECT_EQ(kSSEFloat64Add, s[3]->arch_opcode());
+}
+
 }  // namespace compiler
 }  // namespace internal
 }  // namespace v8
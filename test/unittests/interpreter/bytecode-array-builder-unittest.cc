@@ -18,39 +18,79 @@ class BytecodeArrayBuilderTest : public TestWithIsolateAndZone {
 };
 
 
+// Sets a flag for the lifetime of the scope.
+class ScopedFlag {
+ public:
+  ScopedFlag(bool* flag, bool value) : flag_(flag), old_value_(*flag) {
+    *flag_ = value;
+  }
+  ~ScopedFlag() { *flag_ = old_value_; }
+
+ private:
+  bool* flag_;
+  bool old_value_;
+
+  DISALLOW_COPY_AND_ASSIGN(ScopedFlag);
+};
+
+
 TEST_F(BytecodeArrayBuilderTest, AllBytecodesGenerated) {
   BytecodeArrayBuilder builder(isolate(), zone());
 
-  builder.set_locals_count(1);
+  builder.set_locals_count(2);
   builder.set_parameter_count(0);
-  CHECK_EQ(builder.locals_count(), 1);
+  CHECK_EQ(builder.locals_count(), 2);
 
-  // Emit constant loads.
+  // Emit constant loads. Each one is stored so that it is not removed as a
+  // dead load by the peephole optimizer.
+  Register reg(0);
+  Register other(1);
   builder.LoadLiteral(Smi::FromInt(0))
+      .StoreAccumulatorInRegister(reg)
       .LoadLiteral(Smi::FromInt(8))
+      .StoreAccumulatorInRegister(reg)
       .LoadLiteral(Smi::FromInt(10000000))
+      .StoreAccumulatorInRegister(reg)
       .LoadUndefined()
+      .StoreAccumulatorInRegister(reg)
       .LoadNull()
+      .StoreAccumulatorInRegister(reg)
       .LoadTheHole()
+      .StoreAccumulatorInRegister(reg)
       .LoadTrue()
-      .LoadFalse();
+      .StoreAccumulatorInRegister(reg)
+      .LoadFalse()
+      .StoreAccumulatorInRegister(reg);
 
-  // Emit accumulator transfers.
-  Register reg(0);
-  builder.LoadAccumulatorWithRegister(reg).StoreAccumulatorInRegister(reg);
+  // Emit accumulator transfers. The store directly after the register load
+  // is fused into the LdarStar superinstruction.
+  builder.LoadAccumulatorWithRegister(other).StoreAccumulatorInRegister(reg);
+
+  // Emit context slot operations.
+  builder.LoadContextSlot(Context::MIN_CONTEXT_SLOTS)
+      .StoreContextSlot(Context::MIN_CONTEXT_SLOTS);
 
   // Emit load / store property operations.
   builder.LoadNamedProperty(reg, 0, LanguageMode::SLOPPY)
+      .LoadAccumulatorWithRegister(other)
       .LoadKeyedProperty(reg, 0, LanguageMode::SLOPPY)
       .StoreNamedProperty(reg, reg, 0, LanguageMode::SLOPPY)
       .StoreKeyedProperty(reg, reg, 0, LanguageMode::SLOPPY);
 
+  // Emit operations whose operands need a Wide or ExtraWide prefix.
+  builder.LoadNamedProperty(reg, 1000, LanguageMode::SLOPPY)
+      .LoadNamedProperty(reg, 100000, LanguageMode::SLOPPY);
+
   // Emit binary operators invocations.
-  builder.BinaryOperation(Token::Value::ADD, reg)
-      .BinaryOperation(Token::Value::SUB, reg)
-      .BinaryOperation(Token::Value::MUL, reg)
-      .BinaryOperation(Token::Value::DIV, reg)
-      .BinaryOperation(Token::Value::MOD, reg);
+  builder.BinaryOperation(Token::Value::ADD, reg, 0)
+      .BinaryOperation(Token::Value::SUB, reg, 0)
+      .BinaryOperation(Token::Value::MUL, reg, 0)
+      .BinaryOperation(Token::Value::DIV, reg, 0)
+      .BinaryOperation(Token::Value::MOD, reg, 0);
+
+  // Emit an addition of a small literal, which is folded into AddSmi8.
+  builder.LoadLiteral(Smi::FromInt(3))
+      .BinaryOperation(Token::Value::ADD, reg, 0);
 
   // Emit control flow. Return must be the last instruction.
   builder.Return();
@@ -62,13 +102,19 @@ TEST_F(BytecodeArrayBuilderTest, AllBytecodesGenerated) {
   // Build scorecard of bytecodes encountered in the BytecodeArray.
   std::vector<int> scorecard(Bytecodes::ToByte(Bytecode::kLast) + 1);
   Bytecode final_bytecode = Bytecode::kLdaZero;
-  for (int i = 0; i < the_array->length(); i++) {
-    uint8_t code = the_array->get(i);
-    scorecard[code] += 1;
-    int operands = Bytecodes::NumberOfOperands(Bytecodes::FromByte(code));
+  for (int i = 0; i < the_array->length();) {
+    Bytecode bytecode = Bytecodes::FromByte(the_array->get(i));
+    scorecard[Bytecodes::ToByte(bytecode)] += 1;
+    OperandScale operand_scale = OperandScale::kSingle;
+    if (Bytecodes::IsPrefixScalingBytecode(bytecode)) {
+      operand_scale = Bytecodes::PrefixBytecodeToOperandScale(bytecode);
+      bytecode = Bytecodes::FromByte(the_array->get(++i));
+      scorecard[Bytecodes::ToByte(bytecode)] += 1;
+    }
+    int operands = Bytecodes::NumberOfOperands(bytecode);
     CHECK_LE(operands, Bytecodes::MaximumNumberOfOperands());
-    final_bytecode = Bytecodes::FromByte(code);
-    i += operands;
+    final_bytecode = bytecode;
+    i += Bytecodes::Size(bytecode, operand_scale);
   }
 
   // Check return occurs at the end and only once in the BytecodeArray.
@@ -131,7 +177,7 @@ TEST_F(BytecodeArrayBuilderTest, TemporariesRecycled) {
 
 TEST_F(BytecodeArrayBuilderTest, RegisterValues) {
   int index = 1;
-  uint8_t operand = static_cast<uint8_t>(-index);
+  int operand = -index;
 
   Register the_register(index);
   CHECK_EQ(the_register.index(), index);
@@ -177,6 +223,212 @@ TEST_F(BytecodeArrayBuilderTest, Constants) {
   CHECK_EQ(array->constant_pool()->length(), 3);
 }
 
+
+TEST_F(BytecodeArrayBuilderTest, PeepholeElidesRedundantTransfers) {
+  BytecodeArrayBuilder builder(isolate(), zone());
+  builder.set_parameter_count(0);
+  builder.set_locals_count(2);
+
+  Register reg(0);
+  Register other(1);
+  builder.LoadTrue()
+      .LoadFalse()
+      .StoreAccumulatorInRegister(reg)
+      .StoreAccumulatorInRegister(reg)
+      .LoadAccumulatorWithRegister(reg)
+      .StoreAccumulatorInRegister(other)
+      .LoadLiteral(Smi::FromInt(3))
+      .BinaryOperation(Token::Value::ADD, other, 7)
+      .Return();
+
+  Handle<BytecodeArray> array = builder.ToBytecodeArray();
+  uint8_t expected[] = {Bytecodes::ToByte(Bytecode::kLdaFalse),
+                        Bytecodes::ToByte(Bytecode::kStar),
+                        static_cast<uint8_t>(reg.ToOperand()),
+                        Bytecodes::ToByte(Bytecode::kStar),
+                        static_cast<uint8_t>(other.ToOperand()),
+                        Bytecodes::ToByte(Bytecode::kAddSmi8),
+                        static_cast<uint8_t>(other.ToOperand()),
+                        3,
+                        7,
+                        Bytecodes::ToByte(Bytecode::kReturn)};
+  CHECK_EQ(array->length(), static_cast<int>(arraysize(expected)));
+  for (size_t i = 0; i < arraysize(expected); i++) {
+    CHECK_EQ(array->get(static_cast<int>(i)), expected[i]);
+  }
+}
+
+
+TEST_F(BytecodeArrayBuilderTest, PeepholeSelectsLdarStar) {
+  BytecodeArrayBuilder builder(isolate(), zone());
+  builder.set_parameter_count(1);
+  builder.set_locals_count(2);
+
+  Register param(builder.Parameter(0));
+  Register reg(0);
+  Register other(1);
+  builder.LoadAccumulatorWithRegister(param)
+      .StoreAccumulatorInRegister(reg)
+      .LoadAccumulatorWithRegister(reg)
+      .StoreAccumulatorInRegister(other)
+      .Return();
+
+  Handle<BytecodeArray> array = builder.ToBytecodeArray();
+  uint8_t expected[] = {Bytecodes::ToByte(Bytecode::kLdarStar),
+                        static_cast<uint8_t>(param.ToOperand()),
+                        static_cast<uint8_t>(reg.ToOperand()),
+                        Bytecodes::ToByte(Bytecode::kStar),
+                        static_cast<uint8_t>(other.ToOperand()),
+                        Bytecodes::ToByte(Bytecode::kReturn)};
+  CHECK_EQ(array->length(), static_cast<int>(arraysize(expected)));
+  for (size_t i = 0; i < arraysize(expected); i++) {
+    CHECK_EQ(array->get(static_cast<int>(i)), expected[i]);
+  }
+}
+
+
+TEST_F(BytecodeArrayBuilderTest, ScaledOperands) {
+  BytecodeArrayBuilder builder(isolate(), zone());
+  builder.set_parameter_count(0);
+  builder.set_locals_count(40000);
+
+  Register reg(0);
+  Register wide(1000);
+  Register extra_wide(39999);
+  builder.LoadAccumulatorWithRegister(wide)
+      .LoadNamedProperty(reg, 70000, LanguageMode::SLOPPY)
+      .StoreAccumulatorInRegister(extra_wide)
+      .Return();
+
+  // Operands are little-endian, -1000 is 0xfc18, 70000 is 0x00011170 and
+  // -39999 is 0xffff63c1.
+  Handle<BytecodeArray> array = builder.ToBytecodeArray();
+  uint8_t expected[] = {Bytecodes::ToByte(Bytecode::kWide),
+                        Bytecodes::ToByte(Bytecode::kLdar),
+                        0x18, 0xfc,
+                        Bytecodes::ToByte(Bytecode::kExtraWide),
+                        Bytecodes::ToByte(Bytecode::kLoadIC),
+                        0x00, 0x00, 0x00, 0x00,
+                        0x70, 0x11, 0x01, 0x00,
+                        Bytecodes::ToByte(Bytecode::kExtraWide),
+                        Bytecodes::ToByte(Bytecode::kStar),
+                        0xc1, 0x63, 0xff, 0xff,
+                        Bytecodes::ToByte(Bytecode::kReturn)};
+  CHECK_EQ(array->length(), static_cast<int>(arraysize(expected)));
+  for (size_t i = 0; i < arraysize(expected); i++) {
+    CHECK_EQ(array->get(static_cast<int>(i)), expected[i]);
+  }
+}
+
+
+TEST_F(BytecodeArrayBuilderTest, PeepholeHandlesScaledOperands) {
+  BytecodeArrayBuilder builder(isolate(), zone());
+  builder.set_parameter_count(0);
+  builder.set_locals_count(1001);
+
+  Register reg(0);
+  Register wide(1000);
+  builder.LoadAccumulatorWithRegister(wide)
+      .StoreAccumulatorInRegister(reg)
+      .LoadAccumulatorWithRegister(reg)
+      .Return();
+
+  Handle<BytecodeArray> array = builder.ToBytecodeArray();
+  uint8_t expected[] = {Bytecodes::ToByte(Bytecode::kWide),
+                        Bytecodes::ToByte(Bytecode::kLdarStar),
+                        0x18, 0xfc, 0x00, 0x00,
+                        Bytecodes::ToByte(Bytecode::kReturn)};
+  CHECK_EQ(array->length(), static_cast<int>(arraysize(expected)));
+  for (size_t i = 0; i < arraysize(expected); i++) {
+    CHECK_EQ(array->get(static_cast<int>(i)), expected[i]);
+  }
+}
+
+
+TEST_F(BytecodeArrayBuilderTest, PeepholeCanBeDisabled) {
+  ScopedFlag no_peephole(&FLAG_ignition_peephole, false);
+  BytecodeArrayBuilder builder(isolate(), zone());
+  builder.set_parameter_count(0);
+  builder.set_locals_count(1);
+
+  Register reg(0);
+  builder.LoadTrue()
+      .StoreAccumulatorInRegister(reg)
+      .LoadAccumulatorWithRegister(reg)
+      .Return();
+
+  Handle<BytecodeArray> array = builder.ToBytecodeArray();
+  CHECK_EQ(array->length(), 6);
+}
+
+
+TEST_F(BytecodeArrayBuilderTest, PeepholeRespectsLabels) {
+  BytecodeArrayBuilder builder(isolate(), zone());
+  builder.set_parameter_count(0);
+  builder.set_locals_count(1);
+
+  Register reg(0);
+  BytecodeLabel after_true;
+  BytecodeLabel before_load;
+  builder.LoadTrue()
+      .Bind(&after_true)
+      .LoadFalse()
+      .StoreAccumulatorInRegister(reg)
+      .Bind(&before_load)
+      .LoadAccumulatorWithRegister(reg)
+      .Return();
+  CHECK_EQ(after_true.offset(), 1u);
+  CHECK_EQ(before_load.offset(), 4u);
+
+  Handle<BytecodeArray> array = builder.ToBytecodeArray();
+  uint8_t expected[] = {Bytecodes::ToByte(Bytecode::kLdaTrue),
+                        Bytecodes::ToByte(Bytecode::kLdaFalse),
+                        Bytecodes::ToByte(Bytecode::kStar),
+                        static_cast<uint8_t>(reg.ToOperand()),
+                        Bytecodes::ToByte(Bytecode::kLdar),
+                        static_cast<uint8_t>(reg.ToOperand()),
+                        Bytecodes::ToByte(Bytecode::kReturn)};
+  CHECK_EQ(array->length(), static_cast<int>(arraysize(expected)));
+  for (size_t i = 0; i < arraysize(expected); i++) {
+    CHECK_EQ(array->get(static_cast<int>(i)), expected[i]);
+  }
+}
+
+
+TEST_F(BytecodeArrayBuilderTest, PeepholeKeepsSourcePositions) {
+  BytecodeArrayBuilder builder(isolate(), zone());
+  builder.set_parameter_count(0);
+  builder.set_locals_count(1);
+
+  Register reg(0);
+  builder.SetSourcePosition(10)
+      .LoadTrue()
+      .LoadFalse()
+      .StoreAccumulatorInRegister(reg)
+      .SetSourcePosition(20)
+      .LoadAccumulatorWithRegister(reg)
+      .Return();
+
+  Handle<BytecodeArray> array = builder.ToBytecodeArray();
+  uint8_t expected[] = {Bytecodes::ToByte(Bytecode::kLdaTrue),
+                        Bytecodes::ToByte(Bytecode::kLdaFalse),
+                        Bytecodes::ToByte(Bytecode::kStar),
+                        static_cast<uint8_t>(reg.ToOperand()),
+                        Bytecodes::ToByte(Bytecode::kLdar),
+                        static_cast<uint8_t>(reg.ToOperand()),
+                        Bytecodes::ToByte(Bytecode::kReturn)};
+  CHECK_EQ(array->length(), static_cast<int>(arraysize(expected)));
+  for (size_t i = 0; i < arraysize(expected); i++) {
+    CHECK_EQ(array->get(static_cast<int>(i)), expected[i]);
+  }
+
+  CHECK_EQ(builder.source_positions().size(), 2u);
+  CHECK_EQ(builder.source_positions()[0].bytecode_offset, 0u);
+  CHECK_EQ(builder.source_positions()[0].source_position, 10);
+  CHECK_EQ(builder.source_positions()[1].bytecode_offset, 4u);
+  CHECK_EQ(builder.source_positions()[1].source_position, 20);
+}
+
 }  // namespace interpreter
 }  // namespace internal
 }  // namespace v8
@@ -95,6 +95,45 @@ TEST_F(BytecodeArrayIteratorTest, IteratesBytecodeArray) {
   CHECK(iterator.done());
 }
 
+
+TEST_F(BytecodeArrayIteratorTest, IteratesScaledOperands) {
+  BytecodeArrayBuilder builder(isolate(), zone());
+  builder.set_parameter_count(1);
+  builder.set_locals_count(40000);
+
+  Register reg_0(0);
+  Register wide(1000);
+  Register extra_wide(39999);
+  int feedback_slot = 70000;
+
+  builder.LoadAccumulatorWithRegister(wide)
+      .LoadKeyedProperty(reg_0, feedback_slot, LanguageMode::SLOPPY)
+      .StoreAccumulatorInRegister(extra_wide)
+      .Return();
+
+  BytecodeArrayIterator iterator(builder.ToBytecodeArray());
+  CHECK_EQ(iterator.current_bytecode(), Bytecode::kLdar);
+  CHECK_EQ(iterator.current_operand_scale(), OperandScale::kDouble);
+  CHECK_EQ(iterator.GetRegisterOperand(0).index(), wide.index());
+  iterator.Advance();
+
+  CHECK_EQ(iterator.current_bytecode(), Bytecode::kKeyedLoadIC);
+  CHECK_EQ(iterator.current_operand_scale(), OperandScale::kQuadruple);
+  CHECK_EQ(iterator.GetRegisterOperand(0).index(), reg_0.index());
+  CHECK_EQ(iterator.GetIndexOperand(1), feedback_slot);
+  iterator.Advance();
+
+  CHECK_EQ(iterator.current_bytecode(), Bytecode::kStar);
+  CHECK_EQ(iterator.current_operand_scale(), OperandScale::kQuadruple);
+  CHECK_EQ(iterator.GetRegisterOperand(0).index(), extra_wide.index());
+  iterator.Advance();
+
+  CHECK_EQ(iterator.current_bytecode(), Bytecode::kReturn);
+  CHECK_EQ(iterator.current_operand_scale(), OperandScale::kSingle);
+  iterator.Advance();
+  CHECK(iterator.done());
+}
+
 }  // namespace interpreter
 }  // namespace internal
 }  // namespace v8
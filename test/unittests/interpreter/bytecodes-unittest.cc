@@ -16,7 +16,7 @@ namespace interpreter {
 
 TEST(OperandConversion, Registers) {
   for (int i = 0; i < 128; i++) {
-    uint8_t operand_value = Register(i).ToOperand();
+    int32_t operand_value = Register(i).ToOperand();
     Register r = Register::FromOperand(operand_value);
     CHECK_EQ(i, r.index());
   }
@@ -31,7 +31,7 @@ TEST(OperandConversion, Parameters) {
     int parameter_count = parameter_counts[p];
     for (int i = 0; i < parameter_count; i++) {
       Register r = Register::FromParameterIndex(i, parameter_count);
-      uint8_t operand_value = r.ToOperand();
+      int32_t operand_value = r.ToOperand();
       Register s = Register::FromOperand(operand_value);
       CHECK_EQ(i, s.ToParameterIndex(parameter_count));
     }
@@ -40,21 +40,87 @@ TEST(OperandConversion, Parameters) {
 
 
 TEST(OperandConversion, RegistersParametersNoOverlap) {
+  // Check the operands which fit in a single byte.
   std::vector<uint8_t> operand_count(256);
 
-  for (int i = 0; i <= Register::kMaxRegisterIndex; i++) {
+  for (int i = 0; i < 128; i++) {
     Register r = Register(i);
-    uint8_t operand = r.ToOperand();
+    uint8_t operand = static_cast<uint8_t>(r.ToOperand());
     operand_count[operand] += 1;
     CHECK_EQ(operand_count[operand], 1);
   }
 
-  int parameter_count = Register::MaxParameterIndex() + 1;
+  int parameter_count = 256;
   for (int i = 0; i < parameter_count; i++) {
     Register r = Register::FromParameterIndex(i, parameter_count);
-    uint8_t operand = r.ToOperand();
-    operand_count[operand] += 1;
-    CHECK_EQ(operand_count[operand], 1);
+    int32_t operand = r.ToOperand();
+    if (Bytecodes::ScaleForSignedOperand(operand) != OperandScale::kSingle) {
+      continue;
+    }
+    operand_count[static_cast<uint8_t>(operand)] += 1;
+    CHECK_EQ(operand_count[static_cast<uint8_t>(operand)], 1);
+  }
+}
+
+
+TEST(OperandConversion, ScaledRegisters) {
+  int indices[] = {128, 1000, 32768, 32769, 100000,
+                   Register::kMaxRegisterIndex};
+  for (size_t i = 0; i < arraysize(indices); i++) {
+    Register r(indices[i]);
+    CHECK_EQ(indices[i], Register::FromOperand(r.ToOperand()).index());
+  }
+  CHECK_EQ(Bytecodes::ScaleForSignedOperand(Register(127).ToOperand()),
+           OperandScale::kSingle);
+  CHECK_EQ(Bytecodes::ScaleForSignedOperand(Register(128).ToOperand()),
+           OperandScale::kDouble);
+  CHECK_EQ(Bytecodes::ScaleForSignedOperand(Register(32768).ToOperand()),
+           OperandScale::kDouble);
+  CHECK_EQ(Bytecodes::ScaleForSignedOperand(Register(32769).ToOperand()),
+           OperandScale::kQuadruple);
+}
+
+
+TEST(OperandScaling, DecodeOperands) {
+  const uint8_t bytes[] = {0xfe, 0xff, 0x7f, 0x80};
+  CHECK_EQ(Bytecodes::DecodeUnsignedOperand(bytes, OperandScale::kSingle),
+           0xfeu);
+  CHECK_EQ(Bytecodes::DecodeSignedOperand(bytes, OperandScale::kSingle), -2);
+  CHECK_EQ(Bytecodes::DecodeUnsignedOperand(bytes, OperandScale::kDouble),
+           0xfffeu);
+  CHECK_EQ(Bytecodes::DecodeSignedOperand(bytes, OperandScale::kDouble), -2);
+  CHECK_EQ(Bytecodes::DecodeUnsignedOperand(bytes, OperandScale::kQuadruple),
+           0x807ffffeu);
+  CHECK_EQ(Bytecodes::DecodeSignedOperand(bytes, OperandScale::kQuadruple),
+           static_cast<int32_t>(0x807ffffe));
+}
+
+
+TEST(OperandScaling, UnsignedOperandScales) {
+  CHECK_EQ(Bytecodes::ScaleForUnsignedOperand(255), OperandScale::kSingle);
+  CHECK_EQ(Bytecodes::ScaleForUnsignedOperand(256), OperandScale::kDouble);
+  CHECK_EQ(Bytecodes::ScaleForUnsignedOperand(65535), OperandScale::kDouble);
+  CHECK_EQ(Bytecodes::ScaleForUnsignedOperand(65536),
+           OperandScale::kQuadruple);
+  CHECK_EQ(Bytecodes::Size(Bytecode::kStar, OperandScale::kQuadruple), 5);
+  CHECK_EQ(Bytecodes::Size(Bytecode::kStoreIC, OperandScale::kDouble), 7);
+}
+
+
+TEST(OperandScaling, DispatchTableIndices) {
+  std::vector<int> seen(Bytecodes::DispatchTableSize());
+  OperandScale scales[] = {OperandScale::kSingle, OperandScale::kDouble,
+                           OperandScale::kQuadruple};
+  for (OperandScale scale : scales) {
+#define CHECK_INDEX(Name, ...)                                  \
+  {                                                             \
+    Bytecode bytecode = Bytecode::k##Name;                      \
+    int index = Bytecodes::DispatchTableIndex(bytecode, scale); \
+    CHECK_LT(index, Bytecodes::DispatchTableSize());            \
+    CHECK_EQ(seen[index]++, 0);                                 \
+  }
+    BYTECODE_LIST(CHECK_INDEX)
+#undef CHECK_INDEX
   }
 }
 
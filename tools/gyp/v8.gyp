@@ -507,6 +507,8 @@
         '../../src/compiler/greedy-allocator.cc',
         '../../src/compiler/greedy-allocator.h',
         '../../src/compiler/instruction-codes.h',
+        '../../src/compiler/instruction-scheduler.cc',
+        '../../src/compiler/instruction-scheduler.h',
         '../../src/compiler/instruction-selector-impl.h',
         '../../src/compiler/instruction-selector.cc',
         '../../src/compiler/instruction-selector.h',
@@ -831,6 +833,10 @@
         '../../src/layout-descriptor-inl.h',
         '../../src/layout-descriptor.cc',
         '../../src/layout-descriptor.h',
+        '../../src/lazy-compile-profiler.cc',
+        '../../src/lazy-compile-profiler.h',
+        '../../src/lazy-compile-queue.cc',
+        '../../src/lazy-compile-queue.h',
         '../../src/list-inl.h',
         '../../src/list.h',
         '../../src/lithium-allocator-inl.h',
@@ -864,6 +870,8 @@
         '../../src/optimizing-compile-dispatcher.h',
         '../../src/ostreams.cc',
         '../../src/ostreams.h',
+        '../../src/parallel-preparser.cc',
+        '../../src/parallel-preparser.h',
         '../../src/pattern-rewriter.cc',
         '../../src/parser.cc',
         '../../src/parser.h',
@@ -956,6 +964,8 @@
         '../../src/snapshot/serialize.h',
         '../../src/snapshot/snapshot.h',
         '../../src/snapshot/snapshot-common.cc',
+        '../../src/snapshot/snapshot-compression.cc',
+        '../../src/snapshot/snapshot-compression.h',
         '../../src/snapshot/snapshot-source-sink.cc',
         '../../src/snapshot/snapshot-source-sink.h',
         '../../src/splay-tree.h',
@@ -1328,6 +1338,7 @@
           'sources': [
             '../../src/compiler/x64/code-generator-x64.cc',
             '../../src/compiler/x64/instruction-codes-x64.h',
+            '../../src/compiler/x64/instruction-scheduler-x64.cc',
             '../../src/compiler/x64/instruction-selector-x64.cc',
           ],
         }],
@@ -69,9 +69,11 @@ class StringResource8 : public v8::String::ExternalOneByteStringResource {
 
 std::pair<v8::base::TimeDelta, v8::base::TimeDelta> RunBaselineParser(
     const char* fname, Encoding encoding, int repeat, v8::Isolate* isolate,
-    v8::Local<v8::Context> context) {
+    v8::Local<v8::Context> context, int* source_length,
+    v8::base::TimeDelta* lazy_parse_time) {
   int length = 0;
   const byte* source = ReadFileAndRepeat(fname, &length, repeat);
+  *source_length = length;
   v8::Local<v8::String> source_handle;
   switch (encoding) {
     case UTF8: {
@@ -136,6 +138,23 @@ std::pair<v8::base::TimeDelta, v8::base::TimeDelta> RunBaselineParser(
       return std::make_pair(v8::base::TimeDelta(), v8::base::TimeDelta());
     }
   }
+  // Third round of parsing (no parser cache, like the first compile of a
+  // script). Only this round can preparse on background threads; compare
+  // with --parallel-preparse.
+  {
+    Zone zone;
+    ParseInfo info(&zone, script);
+    info.set_global();
+    v8::base::ElapsedTimer timer;
+    timer.Start();
+    info.set_allow_lazy_parsing();
+    bool success = Parser::ParseStatic(&info);
+    *lazy_parse_time = timer.Elapsed();
+    if (!success) {
+      fprintf(stderr, "Parsing failed\n");
+      return std::make_pair(v8::base::TimeDelta(), v8::base::TimeDelta());
+    }
+  }
   return std::make_pair(parse_time1, parse_time2);
 }
 
@@ -182,18 +201,33 @@ int main(int argc, char* argv[]) {
       v8::Context::Scope scope(context);
       double first_parse_total = 0;
       double second_parse_total = 0;
+      double lazy_parse_total = 0;
+      double source_length_total = 0;
       for (size_t i = 0; i < fnames.size(); i++) {
+        int source_length = 0;
+        v8::base::TimeDelta lazy_parse_time;
         std::pair<v8::base::TimeDelta, v8::base::TimeDelta> time =
             RunBaselineParser(fnames[i].c_str(), encoding, repeat, isolate,
-                              context);
+                              context, &source_length, &lazy_parse_time);
         first_parse_total += time.first.InMillisecondsF();
         second_parse_total += time.second.InMillisecondsF();
+        lazy_parse_total += lazy_parse_time.InMillisecondsF();
+        source_length_total += source_length;
       }
       if (benchmark.empty()) benchmark = "Baseline";
       printf("%s(FirstParseRunTime): %.f ms\n", benchmark.c_str(),
              first_parse_total);
       printf("%s(SecondParseRunTime): %.f ms\n", benchmark.c_str(),
              second_parse_total);
+      printf("%s(UncachedParseRunTime): %.f ms\n", benchmark.c_str(),
+             lazy_parse_total);
+      // Source bytes per second of the first round, which scans everything;
+      // compare with --no-simd-scanner to see the effect of the scanner's
+      // bulk paths.
+      if (first_parse_total > 0) {
+        printf("%s(FirstParseThroughput): %.1f MB/s\n", benchmark.c_str(),
+               source_length_total / MB / (first_parse_total / 1000));
+      }
     }
   }
   v8::V8::Dispose();